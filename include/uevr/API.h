@@ -36,7 +36,7 @@ SOFTWARE.
 #define UEVR_OUT
 
 #define UEVR_PLUGIN_VERSION_MAJOR 2
-#define UEVR_PLUGIN_VERSION_MINOR 29
+#define UEVR_PLUGIN_VERSION_MINOR 35
 #define UEVR_PLUGIN_VERSION_PATCH 0
 
 #define UEVR_RENDERER_D3D11 0
@@ -73,6 +73,7 @@ DECLARE_UEVR_HANDLE(UEVR_FConsoleManagerHandle);
 DECLARE_UEVR_HANDLE(UEVR_IConsoleObjectHandle);
 DECLARE_UEVR_HANDLE(UEVR_IConsoleCommandHandle);
 DECLARE_UEVR_HANDLE(UEVR_IConsoleVariableHandle);
+DECLARE_UEVR_HANDLE(UEVR_ModValueHandle);
 DECLARE_UEVR_HANDLE(UEVR_TArrayHandle);
 DECLARE_UEVR_HANDLE(UEVR_FMallocHandle);
 DECLARE_UEVR_HANDLE(UEVR_FRHITexture2DHandle);
@@ -151,6 +152,39 @@ typedef struct {
     double m[4][4];
 } UEVR_Matrix4x4d;
 
+typedef struct {
+    UEVR_Vector3f position;
+    UEVR_Quaternionf rotation;
+    UEVR_Matrix4x4f transform;
+} UEVR_Pose;
+
+/* One device out of UEVR_PoseSnapshot. Everything is identity/zero if index is -1 (device not present). */
+typedef struct {
+    UEVR_TrackedDeviceIndex index;
+
+    /* OpenVR/OpenXR space, same as get_grip_transform/get_aim_transform and friends */
+    UEVR_Pose grip;
+    UEVR_Pose aim; /* same as grip for the HMD */
+    UEVR_Vector3f velocity;
+    UEVR_Vector3f angular_velocity;
+
+    /* Relative to the standing origin with the rotation offset applied, in meters (world scale isn't applied) */
+    UEVR_Pose world_grip;
+    UEVR_Pose world_aim;
+    UEVR_Vector3f world_velocity;
+    UEVR_Vector3f world_angular_velocity;
+} UEVR_DevicePose;
+
+/* Filled by get_pose_snapshot in UEVR_VRData, all of it comes from the same pose update */
+typedef struct {
+    UEVR_DevicePose hmd;
+    UEVR_DevicePose left;
+    UEVR_DevicePose right;
+
+    UEVR_Vector3f standing_origin;
+    UEVR_Quaternionf rotation_offset;
+} UEVR_PoseSnapshot;
+
 /* Generic DX renderer callbacks */
 typedef void (*UEVR_OnPresentCb)();
 typedef void (*UEVR_OnDeviceResetCb)();
@@ -165,6 +199,31 @@ typedef bool (*UEVR_OnMessageCb)(void*, unsigned int, unsigned long long, long l
 typedef void (*UEVR_OnXInputGetStateCb)(unsigned int*, unsigned int, void*); /* retval, dwUserIndex, pState, read MSDN for details */
 typedef void (*UEVR_OnXInputSetStateCb)(unsigned int*, unsigned int, void*); /* retval, dwUserIndex, pVibration, read MSDN for details */
 
+/* Shared ImGui callbacks, these run inside the framework's ImGui frame (between NewFrame and Render) */
+/* so plugins can build windows without running their own context, font atlas or render pass. */
+/* Plugins must call ImGui::SetCurrentContext(context) and ImGui::SetAllocatorFunctions(alloc_func, free_func, alloc_user_data) */
+/* before calling into ImGui, and should compare imgui_version against their own IMGUI_VERSION_NUM. */
+typedef struct {
+    void* context; /* ImGuiContext* */
+    void* alloc_func; /* ImGuiMemAllocFunc */
+    void* free_func; /* ImGuiMemFreeFunc */
+    void* alloc_user_data;
+    int imgui_version;
+    bool drawing_ui; /* whether the UEVR menu is open */
+} UEVR_ImGuiFrameData;
+
+typedef void (*UEVR_OnImGuiFrameCb)(const UEVR_ImGuiFrameData*);
+
+/* Mod values, see find_mod_value in UEVR_VRData */
+#define UEVR_MOD_VALUE_TYPE_UNKNOWN 0
+#define UEVR_MOD_VALUE_TYPE_BOOL 1
+#define UEVR_MOD_VALUE_TYPE_INT 2
+#define UEVR_MOD_VALUE_TYPE_FLOAT 3
+#define UEVR_MOD_VALUE_TYPE_STRING 4
+
+/* Called once per frame for every mod value that changed since the last frame, key is the config name */
+typedef void (*UEVR_OnModValueChangedCb)(const char* key, UEVR_ModValueHandle value);
+
 /* UE Callbacks */
 typedef void (*UEVR_Engine_TickCb)(UEVR_UGameEngineHandle engine, float delta_seconds);
 typedef void (*UEVR_Slate_DrawWindow_RenderThreadCb)(UEVR_FSlateRHIRendererHandle renderer, UEVR_FViewportInfoHandle viewport_info);
@@ -187,6 +246,10 @@ typedef bool (*UEVR_OnMessageFn)(UEVR_OnMessageCb);
 typedef bool (*UEVR_OnXInputGetStateFn)(UEVR_OnXInputGetStateCb);
 typedef bool (*UEVR_OnXInputSetStateFn)(UEVR_OnXInputSetStateCb);
 
+/* Shared ImGui */
+typedef bool (*UEVR_OnImGuiFrameFn)(UEVR_OnImGuiFrameCb);
+typedef bool (*UEVR_OnModValueChangedFn)(UEVR_OnModValueChangedCb);
+
 /* Engine */
 typedef bool (*UEVR_Engine_TickFn)(UEVR_Engine_TickCb);
 typedef bool (*UEVR_Slate_DrawWindow_RenderThreadFn)(UEVR_Slate_DrawWindow_RenderThreadCb);
@@ -206,6 +269,9 @@ typedef struct {
     UEVR_OnXInputSetStateFn on_xinput_set_state;
     UEVR_OnPostRenderVRFrameworkDX11Fn on_post_render_vr_framework_dx11;
     UEVR_OnPostRenderVRFrameworkDX12Fn on_post_render_vr_framework_dx12;
+    UEVR_OnImGuiFrameFn on_imgui_frame; /* every framework ImGui frame, use for overlay windows */
+    UEVR_OnImGuiFrameFn on_imgui_draw_ui; /* inside the Plugins section of the UEVR menu */
+    UEVR_OnModValueChangedFn on_mod_value_changed;
 } UEVR_PluginCallbacks;
 
 typedef struct {
@@ -412,6 +478,86 @@ typedef struct {
     int (*get_struct_size)(UEVR_UScriptStructHandle script_struct);
 } UEVR_UScriptStructFunctions;
 
+DECLARE_UEVR_HANDLE(UEVR_MemoryPoolHandle);
+
+/* Backed by FMalloc, falls back to the CRT if FMalloc has not been found yet */
+typedef struct {
+    /* Per-thread bump allocators. Memory is only valid until the end of the frame: */
+    /* frame_alloc is reset after on_post_engine_tick */
+    /* render_frame_alloc is reset after on_post_slate_draw_window_render_thread */
+    /* alignment of 0 means 16, max alignment is 64 */
+    void* (*frame_alloc)(unsigned int size, unsigned int alignment);
+    void* (*render_frame_alloc)(unsigned int size, unsigned int alignment);
+
+    /* Persistent fixed-size allocator, thread safe */
+    UEVR_MemoryPoolHandle (*create_pool)(unsigned int element_size, unsigned int alignment);
+    void (*destroy_pool)(UEVR_MemoryPoolHandle pool);
+    void* (*pool_alloc)(UEVR_MemoryPoolHandle pool);
+    void (*pool_free)(UEVR_MemoryPoolHandle pool, void* ptr);
+} UEVR_AllocatorFunctions;
+
+DECLARE_UEVR_HANDLE(UEVR_ObjectPoolHandle);
+
+/* Called on release, before the object goes back into the pool */
+typedef void (*UEVR_ObjectPoolResetCb)(UEVR_UObjectHandle object, void* user_data);
+
+typedef struct {
+    UEVR_UClassHandle klass;
+    UEVR_UObjectHandle outer;
+    unsigned int prewarm; /* spawned right away */
+    unsigned int max_size; /* free + in use, 0 for no limit */
+    unsigned int grow_by; /* spawned at once when nothing is free, 0 grows by half the current size */
+    unsigned int keep_free; /* trimming never goes below this */
+    float trim_after_seconds; /* free objects unused for this long get dropped, 0 to never trim */
+    UEVR_ObjectPoolResetCb on_release; /* can be null */
+    void* user_data;
+} UEVR_ObjectPoolDesc;
+
+typedef struct {
+    unsigned int free;
+    unsigned int in_use;
+    unsigned int peak_in_use;
+    unsigned long long acquires;
+    unsigned long long reused; /* acquires that didn't have to spawn anything */
+    unsigned long long spawned;
+    unsigned long long spawn_failures;
+    unsigned long long exhausted; /* acquires that failed because of max_size */
+    unsigned long long releases;
+    unsigned long long bad_releases; /* not from this pool, or released twice */
+    unsigned long long trimmed;
+    unsigned long long lost; /* destroyed by the engine while pooled */
+} UEVR_ObjectPoolStats;
+
+/* Reuses spawn_object results instead of spawning a new object every time. */
+/* Free objects are kept in the root set so the GC leaves them alone, acquired ones are taken out of it again */
+/* and have to be kept referenced like any other spawned object. Objects the engine destroyed anyway are */
+/* noticed on acquire or release and replaced. Create, acquire and release on the game thread. */
+typedef struct {
+    UEVR_ObjectPoolHandle (*create)(const UEVR_ObjectPoolDesc* desc);
+    void (*destroy)(UEVR_ObjectPoolHandle pool); /* objects still in use are left alone */
+    UEVR_UObjectHandle (*acquire)(UEVR_ObjectPoolHandle pool); /* null if the pool is at max_size */
+    bool (*release)(UEVR_ObjectPoolHandle pool, UEVR_UObjectHandle object);
+    void (*get_stats)(UEVR_ObjectPoolHandle pool, UEVR_ObjectPoolStats* out_stats);
+} UEVR_ObjectPoolFunctions;
+
+DECLARE_UEVR_HANDLE(UEVR_PreparedCommandHandle);
+
+typedef struct {
+    unsigned long long direct; /* ran through the console variable or command it resolved to */
+    unsigned long long exec; /* went through execute_command */
+    unsigned long long resolves;
+} UEVR_PreparedCommandStats;
+
+/* A console command line that's parsed and looked up once, then run straight through the console */
+/* variable or command it names. Lines that don't name one (stat, exec chain commands) go through execute_command. */
+/* Execute on the game thread. */
+typedef struct {
+    UEVR_PreparedCommandHandle (*create)(const wchar_t* command);
+    void (*destroy)(UEVR_PreparedCommandHandle cmd);
+    bool (*execute)(UEVR_PreparedCommandHandle cmd); /* false if nothing could run it */
+    void (*get_stats)(UEVR_PreparedCommandHandle cmd, UEVR_PreparedCommandStats* out_stats);
+} UEVR_PreparedCommandFunctions;
+
 typedef struct {
     UEVR_FPropertyHandle (*get_inner)(UEVR_FArrayPropertyHandle prop);
 } UEVR_FArrayPropertyFunctions;
@@ -460,6 +606,9 @@ typedef struct {
     const UEVR_FStructPropertyFunctions* fstructproperty;
     const UEVR_FEnumPropertyFunctions* fenumproperty;
     const UEVR_UFieldFunctions* ufield;
+    const UEVR_AllocatorFunctions* allocator;
+    const UEVR_ObjectPoolFunctions* object_pool;
+    const UEVR_PreparedCommandFunctions* prepared_command;
 } UEVR_SDKData;
 
 DECLARE_UEVR_HANDLE(UEVR_IVRSystem);
@@ -585,6 +734,23 @@ typedef struct {
     void (*get_mod_value)(const char* key, char* value, unsigned int value_size);
     void (*save_config)();
     void (*reload_config)();
+
+    /* Typed access to mod values. Resolve the handle once, it stays valid for the lifetime of UEVR. */
+    /* Getters return 0/false and setters do nothing if the value is of a different type. */
+    UEVR_ModValueHandle (*find_mod_value)(const char* key); /* null if there's no such value */
+    int (*get_mod_value_type)(UEVR_ModValueHandle value); /* UEVR_MOD_VALUE_TYPE_* */
+    bool (*get_mod_value_bool)(UEVR_ModValueHandle value);
+    void (*set_mod_value_bool)(UEVR_ModValueHandle value, bool new_value);
+    int (*get_mod_value_int)(UEVR_ModValueHandle value);
+    void (*set_mod_value_int)(UEVR_ModValueHandle value, int new_value);
+    float (*get_mod_value_float)(UEVR_ModValueHandle value);
+    void (*set_mod_value_float)(UEVR_ModValueHandle value, float new_value);
+    /* Returns the length of the whole string, which can be more than what fit into out_value */
+    unsigned int (*get_mod_value_string)(UEVR_ModValueHandle value, char* out_value, unsigned int value_size);
+    void (*set_mod_value_string)(UEVR_ModValueHandle value, const char* new_value);
+
+    /* Every device pose at once, all from the same pose update. Calling get_pose/get_transform for each of them can mix two updates */
+    void (*get_pose_snapshot)(UEVR_PoseSnapshot* out_snapshot);
 } UEVR_VRData;
 
 typedef struct {
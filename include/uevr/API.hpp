@@ -235,6 +235,176 @@ public:
         }
     };
 
+    // Scratch memory backed by FMalloc, only valid until the end of the frame it was allocated in
+    // Nothing is constructed or destructed, so only use this for trivial types
+    struct Allocator {
+        // Reset after on_post_engine_tick
+        static void* frame_alloc(uint32_t size, uint32_t alignment = 0) {
+            static const auto fn = initialize()->frame_alloc;
+            return fn(size, alignment);
+        }
+
+        // Reset after on_post_slate_draw_window_render_thread
+        static void* render_frame_alloc(uint32_t size, uint32_t alignment = 0) {
+            static const auto fn = initialize()->render_frame_alloc;
+            return fn(size, alignment);
+        }
+
+        template<typename T>
+        static T* frame_alloc_array(uint32_t count) {
+            return (T*)frame_alloc(sizeof(T) * count, alignof(T));
+        }
+
+        template<typename T>
+        static T* render_frame_alloc_array(uint32_t count) {
+            return (T*)render_frame_alloc(sizeof(T) * count, alignof(T));
+        }
+
+    private:
+        static inline const UEVR_AllocatorFunctions* s_functions{nullptr};
+        static inline const UEVR_AllocatorFunctions* initialize() {
+            if (s_functions == nullptr) {
+                s_functions = API::get()->sdk()->allocator;
+            }
+
+            return s_functions;
+        }
+    };
+
+    // Persistent fixed-size allocator, thread safe
+    struct MemoryPool {
+        inline UEVR_MemoryPoolHandle to_handle() { return (UEVR_MemoryPoolHandle)this; }
+        inline UEVR_MemoryPoolHandle to_handle() const { return (UEVR_MemoryPoolHandle)this; }
+
+        static MemoryPool* create(uint32_t element_size, uint32_t alignment = 0) {
+            static const auto fn = initialize()->create_pool;
+            return (MemoryPool*)fn(element_size, alignment);
+        }
+
+        template<typename T>
+        static MemoryPool* create() {
+            return create(sizeof(T), alignof(T));
+        }
+
+        // Frees every element allocated from this pool
+        void destroy() {
+            static const auto fn = initialize()->destroy_pool;
+            fn(to_handle());
+        }
+
+        void* alloc() {
+            static const auto fn = initialize()->pool_alloc;
+            return fn(to_handle());
+        }
+
+        void free(void* ptr) {
+            static const auto fn = initialize()->pool_free;
+            fn(to_handle(), ptr);
+        }
+
+    private:
+        static inline const UEVR_AllocatorFunctions* s_functions{nullptr};
+        static inline const UEVR_AllocatorFunctions* initialize() {
+            if (s_functions == nullptr) {
+                s_functions = API::get()->sdk()->allocator;
+            }
+
+            return s_functions;
+        }
+    };
+
+    // Reuses spawned objects instead of spawning a new one every time, see UEVR_ObjectPoolFunctions
+    struct ObjectPool {
+        inline UEVR_ObjectPoolHandle to_handle() { return (UEVR_ObjectPoolHandle)this; }
+        inline UEVR_ObjectPoolHandle to_handle() const { return (UEVR_ObjectPoolHandle)this; }
+
+        using Desc = UEVR_ObjectPoolDesc;
+        using Stats = UEVR_ObjectPoolStats;
+
+        static ObjectPool* create(const Desc& desc) {
+            static const auto fn = initialize()->create;
+            return (ObjectPool*)fn(&desc);
+        }
+
+        // Objects still in use are left alone
+        void destroy() {
+            static const auto fn = initialize()->destroy;
+            fn(to_handle());
+        }
+
+        // Null if the pool is at max_size
+        template<typename T = UObject>
+        T* acquire() {
+            static const auto fn = initialize()->acquire;
+            return (T*)fn(to_handle());
+        }
+
+        bool release(UObject* object) {
+            static const auto fn = initialize()->release;
+            return fn(to_handle(), (UEVR_UObjectHandle)object);
+        }
+
+        Stats get_stats() const {
+            static const auto fn = initialize()->get_stats;
+            Stats result{};
+
+            fn(to_handle(), &result);
+            return result;
+        }
+
+    private:
+        static inline const UEVR_ObjectPoolFunctions* s_functions{nullptr};
+        static inline const UEVR_ObjectPoolFunctions* initialize() {
+            if (s_functions == nullptr) {
+                s_functions = API::get()->sdk()->object_pool;
+            }
+
+            return s_functions;
+        }
+    };
+
+    // Console command that's looked up once instead of on every execute, see UEVR_PreparedCommandFunctions
+    struct PreparedCommand {
+        inline UEVR_PreparedCommandHandle to_handle() { return (UEVR_PreparedCommandHandle)this; }
+        inline UEVR_PreparedCommandHandle to_handle() const { return (UEVR_PreparedCommandHandle)this; }
+
+        using Stats = UEVR_PreparedCommandStats;
+
+        static PreparedCommand* create(std::wstring_view command) {
+            static const auto fn = initialize()->create;
+            return (PreparedCommand*)fn(std::wstring{command}.c_str());
+        }
+
+        void destroy() {
+            static const auto fn = initialize()->destroy;
+            fn(to_handle());
+        }
+
+        // False if nothing could run it
+        bool execute() {
+            static const auto fn = initialize()->execute;
+            return fn(to_handle());
+        }
+
+        Stats get_stats() const {
+            static const auto fn = initialize()->get_stats;
+            Stats result{};
+
+            fn(to_handle(), &result);
+            return result;
+        }
+
+    private:
+        static inline const UEVR_PreparedCommandFunctions* s_functions{nullptr};
+        static inline const UEVR_PreparedCommandFunctions* initialize() {
+            if (s_functions == nullptr) {
+                s_functions = API::get()->sdk()->prepared_command;
+            }
+
+            return s_functions;
+        }
+    };
+
     struct FName {
         inline UEVR_FNameHandle to_handle() { return (UEVR_FNameHandle)this; }
         inline UEVR_FNameHandle to_handle() const { return (UEVR_FNameHandle)this; }
@@ -1232,6 +1402,19 @@ public:
             return result;
         }
 
+        // HMD, both controllers, the standing origin and rotation offset in one call.
+        static UEVR_PoseSnapshot get_pose_snapshot() {
+            UEVR_PoseSnapshot result{};
+            get_pose_snapshot(result);
+            return result;
+        }
+
+        // For reusing the same snapshot every tick.
+        static void get_pose_snapshot(UEVR_PoseSnapshot& out) {
+            static const auto fn = initialize()->get_pose_snapshot;
+            fn(&out);
+        }
+
         enum class Eye : int32_t {
             LEFT,
             RIGHT
@@ -1437,6 +1620,59 @@ public:
             return T{};
         }
 
+        // Resolve once and keep the handle, the typed accessors below skip the lookup and the string conversions.
+        static UEVR_ModValueHandle find_mod_value(std::string_view key) {
+            static const auto fn = initialize()->find_mod_value;
+            return fn(key.data());
+        }
+
+        static int get_mod_value_type(UEVR_ModValueHandle value) {
+            static const auto fn = initialize()->get_mod_value_type;
+            return fn(value);
+        }
+
+        template<typename T>
+        static T get_mod_value(UEVR_ModValueHandle value) {
+            if constexpr (std::is_same_v<T, bool>) {
+                static const auto fn = initialize()->get_mod_value_bool;
+                return fn(value);
+            } else if constexpr (std::is_integral_v<T>) {
+                static const auto fn = initialize()->get_mod_value_int;
+                return (T)fn(value);
+            } else if constexpr (std::is_floating_point_v<T>) {
+                static const auto fn = initialize()->get_mod_value_float;
+                return (T)fn(value);
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                static const auto fn = initialize()->get_mod_value_string;
+                std::string result{};
+                result.resize(fn(value, nullptr, 0));
+                fn(value, result.data(), (unsigned int)result.size() + 1);
+                return result;
+            } else {
+                static_assert(std::is_same_v<T, void>, "Unsupported type for get_mod_value");
+            }
+        }
+
+        template<typename T>
+        static void set_mod_value(UEVR_ModValueHandle value, const T& new_value) {
+            if constexpr (std::is_same_v<T, bool>) {
+                static const auto fn = initialize()->set_mod_value_bool;
+                fn(value, new_value);
+            } else if constexpr (std::is_integral_v<T>) {
+                static const auto fn = initialize()->set_mod_value_int;
+                fn(value, (int)new_value);
+            } else if constexpr (std::is_floating_point_v<T>) {
+                static const auto fn = initialize()->set_mod_value_float;
+                fn(value, (float)new_value);
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                static const auto fn = initialize()->set_mod_value_string;
+                fn(value, new_value.c_str());
+            } else {
+                static const auto fn = initialize()->set_mod_value_string;
+                fn(value, new_value);
+            }
+        }
+
         static void save_config() {
             static const auto fn = initialize()->save_config;
             fn();
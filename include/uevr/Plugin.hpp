@@ -60,6 +60,14 @@ public:
     virtual void on_xinput_get_state(uint32_t* retval, uint32_t user_index, XINPUT_STATE* state) {}
     virtual void on_xinput_set_state(uint32_t* retval, uint32_t user_index, XINPUT_VIBRATION* vibration) {}
 
+    // Shared ImGui callbacks, drawn in UEVR's own ImGui context and render pass.
+    // Call ImGui::SetCurrentContext/SetAllocatorFunctions with the passed data before using ImGui.
+    virtual void on_imgui_frame(const UEVR_ImGuiFrameData* data) {}
+    virtual void on_imgui_draw_ui(const UEVR_ImGuiFrameData* data) {}
+
+    // Once per frame for every mod value that changed, resolve handles up front with API::VR::find_mod_value to compare against.
+    virtual void on_mod_value_changed(const char* key, UEVR_ModValueHandle value) {}
+
     // Game/Engine callbacks
     virtual void on_pre_engine_tick(API::UGameEngine* engine, float delta) {}
     virtual void on_post_engine_tick(API::UGameEngine* engine, float delta) {}
@@ -118,6 +126,18 @@ extern "C" __declspec(dllexport) bool uevr_plugin_initialize(const UEVR_PluginIn
         uevr::detail::g_plugin->on_xinput_set_state(retval, user_index, (XINPUT_VIBRATION*)vibration);
     });
 
+    callbacks->on_imgui_frame([](const UEVR_ImGuiFrameData* data) {
+        uevr::detail::g_plugin->on_imgui_frame(data);
+    });
+
+    callbacks->on_imgui_draw_ui([](const UEVR_ImGuiFrameData* data) {
+        uevr::detail::g_plugin->on_imgui_draw_ui(data);
+    });
+
+    callbacks->on_mod_value_changed([](const char* key, UEVR_ModValueHandle value) {
+        uevr::detail::g_plugin->on_mod_value_changed(key, value);
+    });
+
     sdk_callbacks->on_pre_engine_tick([](UEVR_UGameEngineHandle engine, float delta) {
         uevr::detail::g_plugin->on_pre_engine_tick((uevr::API::UGameEngine*)engine, delta);
     });
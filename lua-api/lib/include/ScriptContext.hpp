@@ -9,6 +9,8 @@
 
 #include <vector>
 
+#include "datatypes/StructObject.hpp"
+
 namespace uevr {
 class ScriptContext : public std::enable_shared_from_this<ScriptContext> {
 public:
@@ -107,6 +109,7 @@ private:
     UEVR_PluginInitializeParam* m_plugin_initialize_param{nullptr};
     std::vector<sol::protected_function> m_on_xinput_get_state_callbacks{};
     std::vector<sol::protected_function> m_on_xinput_set_state_callbacks{};
+    std::vector<sol::protected_function> m_on_mod_value_changed_callbacks{};
     std::vector<sol::protected_function> m_on_pre_engine_tick_callbacks{};
     std::vector<sol::protected_function> m_on_post_engine_tick_callbacks{};
     std::vector<sol::protected_function> m_on_pre_slate_draw_window_render_thread_callbacks{};
@@ -124,8 +127,45 @@ private:
     struct UFunctionHookState {
         std::vector<sol::protected_function> pre_hooks{};
         std::vector<sol::protected_function> post_hooks{};
+
+        // Parameter layout of the hooked function, so the callbacks don't look every param up by name.
+        // Rebuilt if the function died and something else got hooked at the same address.
+        std::unique_ptr<lua::datatypes::StructLayout> layout{};
+
+        // The locals object handed to the callbacks, reused between calls instead of creating a new userdata every time.
+        // One per nesting level, the function can end up calling itself from inside a callback.
+        struct Locals {
+            std::unique_ptr<lua::datatypes::StructObject> object{};
+            sol::object lua_object{};
+        };
+
+        std::vector<Locals> locals_pool{};
+        size_t locals_depth{0};
+
+        sol::object acquire_locals(lua_State* l, uevr::API::UFunction* fn, void* locals);
+        void release_locals() {
+            --locals_depth;
+        }
     };
 
+    // Pools created from Lua. Destroyed along with the context so on_release can't outlive the state,
+    // destroy() from Lua only releases the pool itself since the script can still hold on to this.
+    struct LuaObjectPool {
+        uevr::API::ObjectPool* pool{nullptr};
+        sol::protected_function on_release{};
+        ScriptContext* ctx{nullptr};
+    };
+
+    std::vector<std::unique_ptr<LuaObjectPool>> m_object_pools{};
+    static void on_object_pool_release(UEVR_UObjectHandle object, void* user_data);
+
+    // Prepared commands created from Lua, destroyed along with the context the same way as the pools.
+    struct LuaPreparedCommand {
+        uevr::API::PreparedCommand* command{nullptr};
+    };
+
+    std::vector<std::unique_ptr<LuaPreparedCommand>> m_prepared_commands{};
+
     std::shared_mutex m_ufunction_hooks_mtx{};
     std::unordered_map<uevr::API::UFunction*, std::unique_ptr<UFunctionHookState>> m_ufunction_hooks{};
     static bool global_ufunction_pre_handler(uevr::API::UFunction* fn, uevr::API::UObject* obj, void* params, void* result);
@@ -133,6 +173,7 @@ private:
 
     static void on_xinput_get_state(uint32_t* retval, uint32_t user_index, void* state);
     static void on_xinput_set_state(uint32_t* retval, uint32_t user_index, void* vibration);
+    static void on_mod_value_changed(const char* key, UEVR_ModValueHandle value);
     static void on_pre_engine_tick(UEVR_UGameEngineHandle engine, float delta_seconds);
     static void on_post_engine_tick(UEVR_UGameEngineHandle engine, float delta_seconds);
     static void on_pre_slate_draw_window_render_thread(UEVR_FSlateRHIRendererHandle renderer, UEVR_FViewportInfoHandle viewport_info);
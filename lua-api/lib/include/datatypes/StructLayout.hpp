@@ -0,0 +1,29 @@
+#pragma once
+
+#include <uevr/API.hpp>
+
+#include <string>
+#include <unordered_map>
+
+namespace lua::datatypes {
+    // Name to property lookup for one struct, built once so hot paths (hooked UFunction params)
+    // don't walk the property list and widen the name on every access.
+    struct StructLayout {
+        StructLayout(uevr::API::UStruct* def);
+
+        // False once the struct went away and something else was allocated in its place.
+        bool matches(uevr::API::UStruct* def) const;
+
+        uevr::API::FProperty* find_property(const std::string& name) const {
+            if (auto it = properties.find(name); it != properties.end()) {
+                return it->second;
+            }
+
+            return nullptr;
+        }
+
+        uevr::API::UStruct* desc{ nullptr };
+        uevr::API::FField* first_property{ nullptr };
+        std::unordered_map<std::string, uevr::API::FProperty*> properties{};
+    };
+}
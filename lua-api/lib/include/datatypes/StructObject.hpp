@@ -3,9 +3,14 @@
 #include <uevr/API.hpp>
 #include <sol/sol.hpp>
 
+#include <string>
+
+#include "StructLayout.hpp"
+
 namespace lua::datatypes {
     struct StructObject {
         StructObject(void* obj, uevr::API::UStruct* def) : object{ obj }, desc{ def } {}
+        StructObject(void* obj, const StructLayout* layout) : object{ obj }, desc{ layout->desc }, layout{ layout } {}
         StructObject(uevr::API::UStruct* def); // Allocates a new structure given a definition
         StructObject(uevr::API::UObject* obj);
         ~StructObject();
@@ -16,6 +21,7 @@ namespace lua::datatypes {
         uevr::API::UStruct* desc{ nullptr };
 
         std::vector<uint8_t> created_object{}; // Only used when the object is created by second constructor
+        const StructLayout* layout{ nullptr }; // Optional, falls back to looking properties up by name
     };
 
     void bind_struct_object(sol::state_view& lua);
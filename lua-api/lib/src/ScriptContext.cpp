@@ -72,6 +72,20 @@ ScriptContext::~ScriptContext() {
     std::scoped_lock _{m_mtx};
     ScriptContext::log("ScriptContext destructor called");
 
+    for (auto& pool : m_object_pools) {
+        if (pool->pool != nullptr) {
+            pool->pool->destroy();
+            pool->pool = nullptr;
+        }
+    }
+
+    for (auto& cmd : m_prepared_commands) {
+        if (cmd->command != nullptr) {
+            cmd->command->destroy();
+            cmd->command = nullptr;
+        }
+    }
+
     // TODO: this probably does not support multiple states
     // Addendum: I decided this is not necessary, for now...
     // because all of the functions are static
@@ -90,6 +104,24 @@ void ScriptContext::log(const std::string& message) {
     API::get()->log_info("[LuaVR] %s", message.c_str());
 }
 
+void ScriptContext::on_object_pool_release(UEVR_UObjectHandle object, void* user_data) {
+    auto pool = (LuaObjectPool*)user_data;
+
+    if (!pool->on_release.valid()) {
+        return;
+    }
+
+    std::scoped_lock _{ pool->ctx->m_mtx };
+
+    try {
+        pool->ctx->handle_protected_result(pool->on_release((uevr::API::UObject*)object));
+    } catch (const std::exception& e) {
+        ScriptContext::log("Exception in object pool on_release: " + std::string(e.what()));
+    } catch (...) {
+        ScriptContext::log("Unknown exception in object pool on_release");
+    }
+}
+
 void ScriptContext::setup_callback_bindings() {
     std::scoped_lock _{ m_mtx };
 
@@ -106,6 +138,7 @@ void ScriptContext::setup_callback_bindings() {
 
         add_callback(m_plugin_initialize_param->callbacks->on_xinput_get_state, on_xinput_get_state);
         add_callback(m_plugin_initialize_param->callbacks->on_xinput_set_state, on_xinput_set_state);
+        add_callback(m_plugin_initialize_param->callbacks->on_mod_value_changed, on_mod_value_changed);
         add_callback(cbs->on_pre_engine_tick, on_pre_engine_tick);
         add_callback(cbs->on_post_engine_tick, on_post_engine_tick);
         add_callback(cbs->on_pre_slate_draw_window_render_thread, on_pre_slate_draw_window_render_thread);
@@ -125,6 +158,10 @@ void ScriptContext::setup_callback_bindings() {
             std::scoped_lock _{ m_mtx };
             m_on_xinput_set_state_callbacks.push_back(fn);
         },
+        "on_mod_value_changed", [this](sol::function fn) {
+            std::scoped_lock _{ m_mtx };
+            m_on_mod_value_changed_callbacks.push_back(fn);
+        },
         "on_pre_engine_tick", [this](sol::function fn) {
             std::scoped_lock _{ m_mtx };
             m_on_pre_engine_tick_callbacks.push_back(fn);
@@ -287,15 +324,41 @@ int ScriptContext::setup_bindings() {
         "set_snap_turn_enabled", &UEVR_VRData::set_snap_turn_enabled,
         "set_decoupled_pitch_enabled", &UEVR_VRData::set_decoupled_pitch_enabled,
         "set_mod_value", &UEVR_VRData::set_mod_value,
-        "get_mod_value", [](UEVR_VRData& self, const char* name) {
-            std::string out{};
-            out.resize(256);
+        "get_mod_value", [](UEVR_VRData& self, const char* name) -> const char* {
+            thread_local char out[256]{};
 
-            self.get_mod_value(name, out.data(), out.size());
+            self.get_mod_value(name, out, sizeof(out));
             return out;
         },
         "save_config", &UEVR_VRData::save_config,
-        "reload_config", &UEVR_VRData::reload_config
+        "reload_config", &UEVR_VRData::reload_config,
+        "find_mod_value", &UEVR_VRData::find_mod_value,
+        "get_mod_value_type", &UEVR_VRData::get_mod_value_type,
+        "get_mod_value_bool", &UEVR_VRData::get_mod_value_bool,
+        "set_mod_value_bool", &UEVR_VRData::set_mod_value_bool,
+        "get_mod_value_int", &UEVR_VRData::get_mod_value_int,
+        "set_mod_value_int", &UEVR_VRData::set_mod_value_int,
+        "get_mod_value_float", &UEVR_VRData::get_mod_value_float,
+        "set_mod_value_float", &UEVR_VRData::set_mod_value_float,
+        "get_mod_value_string", [](UEVR_VRData& self, UEVR_ModValueHandle value) -> const char* {
+            thread_local std::string out{};
+
+            out.resize(self.get_mod_value_string(value, nullptr, 0));
+            self.get_mod_value_string(value, out.data(), (unsigned int)out.size() + 1);
+            return out.c_str();
+        },
+        "set_mod_value_string", &UEVR_VRData::set_mod_value_string,
+        "get_pose_snapshot", sol::overload(
+            [](UEVR_VRData& self) {
+                UEVR_PoseSnapshot out{};
+                self.get_pose_snapshot(&out);
+                return out;
+            },
+            // Refills an existing snapshot instead of allocating a new one every call
+            [](UEVR_VRData& self, UEVR_PoseSnapshot& out) {
+                self.get_pose_snapshot(&out);
+            }
+        )
     );
 
     // TODO: Add operators to these types
@@ -374,6 +437,33 @@ int ScriptContext::setup_bindings() {
         }
     );
 
+    m_lua.new_usertype<UEVR_Pose>("UEVR_Pose",
+        "position", &UEVR_Pose::position,
+        "rotation", &UEVR_Pose::rotation,
+        "transform", &UEVR_Pose::transform
+    );
+
+    m_lua.new_usertype<UEVR_DevicePose>("UEVR_DevicePose",
+        "index", &UEVR_DevicePose::index,
+        "grip", &UEVR_DevicePose::grip,
+        "aim", &UEVR_DevicePose::aim,
+        "velocity", &UEVR_DevicePose::velocity,
+        "angular_velocity", &UEVR_DevicePose::angular_velocity,
+        "world_grip", &UEVR_DevicePose::world_grip,
+        "world_aim", &UEVR_DevicePose::world_aim,
+        "world_velocity", &UEVR_DevicePose::world_velocity,
+        "world_angular_velocity", &UEVR_DevicePose::world_angular_velocity
+    );
+
+    m_lua.new_usertype<UEVR_PoseSnapshot>("UEVR_PoseSnapshot",
+        sol::constructors<UEVR_PoseSnapshot()>(),
+        "hmd", &UEVR_PoseSnapshot::hmd,
+        "left", &UEVR_PoseSnapshot::left,
+        "right", &UEVR_PoseSnapshot::right,
+        "standing_origin", &UEVR_PoseSnapshot::standing_origin,
+        "rotation_offset", &UEVR_PoseSnapshot::rotation_offset
+    );
+
     m_lua.new_usertype<uevr::API::FName>("UEVR_FName",
         "to_string", &uevr::API::FName::to_string
     );
@@ -671,6 +761,56 @@ int ScriptContext::setup_bindings() {
         "get_motion_controller_state", &uevr::API::UObjectHook::get_motion_controller_state
     );
 
+    m_lua.new_usertype<LuaObjectPool>("UEVR_ObjectPool",
+        "acquire", [](LuaObjectPool& self) -> uevr::API::UObject* {
+            return self.pool != nullptr ? self.pool->acquire() : nullptr;
+        },
+        "release", [](LuaObjectPool& self, uevr::API::UObject* object) -> bool {
+            return self.pool != nullptr && self.pool->release(object);
+        },
+        "get_stats", [](sol::this_state s, LuaObjectPool& self) -> sol::object {
+            if (self.pool == nullptr) {
+                return sol::make_object(s, sol::lua_nil);
+            }
+
+            const auto stats = self.pool->get_stats();
+            sol::state_view lua{s};
+
+            return sol::make_object(s, lua.create_table_with(
+                "free", stats.free,
+                "in_use", stats.in_use,
+                "peak_in_use", stats.peak_in_use,
+                "acquires", stats.acquires,
+                "reused", stats.reused,
+                "spawned", stats.spawned,
+                "spawn_failures", stats.spawn_failures,
+                "exhausted", stats.exhausted,
+                "releases", stats.releases,
+                "bad_releases", stats.bad_releases,
+                "trimmed", stats.trimmed,
+                "lost", stats.lost
+            ));
+        },
+        "destroy", [](LuaObjectPool& self) {
+            if (self.pool != nullptr) {
+                self.pool->destroy();
+                self.pool = nullptr;
+            }
+        }
+    );
+
+    m_lua.new_usertype<LuaPreparedCommand>("UEVR_PreparedCommand",
+        "execute", [](LuaPreparedCommand& self) -> bool {
+            return self.command != nullptr && self.command->execute();
+        },
+        "destroy", [](LuaPreparedCommand& self) {
+            if (self.command != nullptr) {
+                self.command->destroy();
+                self.command = nullptr;
+            }
+        }
+    );
+
     m_lua.new_usertype<uevr::API>("UEVR_API",
         "sdk", &uevr::API::sdk,
         "find_uobject", [](sol::this_state s, uevr::API* api, const std::wstring& name) -> sol::object {
@@ -690,7 +830,59 @@ int ScriptContext::setup_bindings() {
         "get_player_controller", &uevr::API::get_player_controller,
         "get_local_pawn", &uevr::API::get_local_pawn,
         "spawn_object", &uevr::API::spawn_object,
+        // options: outer, prewarm, max_size, grow_by, keep_free, trim_after (seconds), on_release = function(object)
+        "create_object_pool", [this](uevr::API* api, uevr::API::UClass* klass, sol::optional<sol::table> options) -> LuaObjectPool* {
+            if (klass == nullptr) {
+                return nullptr;
+            }
+
+            auto lua_pool = std::make_unique<LuaObjectPool>();
+            lua_pool->ctx = this;
+
+            UEVR_ObjectPoolDesc desc{};
+            desc.klass = klass->to_handle();
+            desc.on_release = &ScriptContext::on_object_pool_release;
+            desc.user_data = lua_pool.get();
+
+            if (options) {
+                const auto& opts = *options;
+
+                if (sol::optional<uevr::API::UObject*> outer = opts["outer"]; outer && *outer != nullptr) {
+                    desc.outer = (*outer)->to_handle();
+                }
+
+                desc.prewarm = opts.get_or("prewarm", 0u);
+                desc.max_size = opts.get_or("max_size", 0u);
+                desc.grow_by = opts.get_or("grow_by", 0u);
+                desc.keep_free = opts.get_or("keep_free", 0u);
+                desc.trim_after_seconds = opts.get_or("trim_after", 0.0f);
+
+                if (sol::optional<sol::protected_function> on_release = opts["on_release"]; on_release) {
+                    lua_pool->on_release = *on_release;
+                }
+            }
+
+            lua_pool->pool = uevr::API::ObjectPool::create(desc);
+
+            if (lua_pool->pool == nullptr) {
+                return nullptr;
+            }
+
+            std::scoped_lock _{ m_mtx };
+            return m_object_pools.emplace_back(std::move(lua_pool)).get();
+        },
         "execute_command", [](uevr::API* api, const std::wstring& s) { api->execute_command(s.data()); },
+        "prepare_command", [this](uevr::API* api, const std::wstring& s) -> LuaPreparedCommand* {
+            auto lua_cmd = std::make_unique<LuaPreparedCommand>();
+            lua_cmd->command = uevr::API::PreparedCommand::create(s);
+
+            if (lua_cmd->command == nullptr) {
+                return nullptr;
+            }
+
+            std::scoped_lock _{ m_mtx };
+            return m_prepared_commands.emplace_back(std::move(lua_cmd)).get();
+        },
         "get_uobject_array", &uevr::API::get_uobject_array,
         "get_console_manager", &uevr::API::get_console_manager
     );
@@ -722,6 +914,29 @@ int ScriptContext::setup_bindings() {
     return out.push(m_lua.lua_state());
 }
 
+sol::object ScriptContext::UFunctionHookState::acquire_locals(lua_State* l, uevr::API::UFunction* fn, void* locals) {
+    // Can't swap the layout out from under an outer call that's still using it
+    if (locals_depth == 0 && (layout == nullptr || !layout->matches(fn))) {
+        layout = std::make_unique<lua::datatypes::StructLayout>(fn);
+
+        for (auto& entry : locals_pool) {
+            entry.object->desc = fn;
+            entry.object->layout = layout.get();
+        }
+    }
+
+    if (locals_depth >= locals_pool.size()) {
+        auto& entry = locals_pool.emplace_back();
+        entry.object = std::make_unique<lua::datatypes::StructObject>(locals, layout.get());
+        entry.lua_object = sol::make_object(l, entry.object.get());
+    }
+
+    auto& entry = locals_pool[locals_depth++];
+    entry.object->object = locals;
+
+    return entry.lua_object;
+}
+
 bool ScriptContext::global_ufunction_pre_handler(uevr::API::UFunction* fn, uevr::API::UObject* obj, void* frame, void* out_result) {
     bool any_false = false;
 
@@ -732,11 +947,11 @@ bool ScriptContext::global_ufunction_pre_handler(uevr::API::UFunction* fn, uevr:
         auto it = ctx->m_ufunction_hooks.find(fn);
 
         if (it != ctx->m_ufunction_hooks.end()) {
+            auto& hook = *it->second;
             auto fframe = (lua::datatypes::FFrame*)frame;
-            auto locals = lua::datatypes::StructObject{fframe->locals, fn};
-            auto locals_obj = sol::make_object(ctx->m_lua.lua_state(), &locals);
+            auto locals_obj = hook.acquire_locals(ctx->m_lua.lua_state(), fn, fframe->locals);
 
-            for (auto& cb : it->second->pre_hooks) try {
+            for (auto& cb : hook.pre_hooks) try {
                 if (sol::object result = ctx->handle_protected_result(cb(fn, obj, locals_obj, out_result)); !result.is<sol::nil_t>() && result.is<bool>() && result.as<bool>() == false) {
                     any_false = true;
                 }
@@ -745,6 +960,8 @@ bool ScriptContext::global_ufunction_pre_handler(uevr::API::UFunction* fn, uevr:
             } catch (...) {
                 ScriptContext::log("Unknown exception in global_ufunction_pre_handler");
             }
+
+            hook.release_locals();
         }
     });
 
@@ -759,17 +976,19 @@ void ScriptContext::global_ufunction_post_handler(uevr::API::UFunction* fn, uevr
         auto it = ctx->m_ufunction_hooks.find(fn);
 
         if (it != ctx->m_ufunction_hooks.end()) {
+            auto& hook = *it->second;
             auto fframe = (lua::datatypes::FFrame*)frame;
-            auto locals = lua::datatypes::StructObject{fframe->locals, fn};
-            auto locals_obj = sol::make_object(ctx->m_lua.lua_state(), &locals);
+            auto locals_obj = hook.acquire_locals(ctx->m_lua.lua_state(), fn, fframe->locals);
 
-            for (auto& cb : it->second->post_hooks) try {
+            for (auto& cb : hook.post_hooks) try {
                 ctx->handle_protected_result(cb(fn, obj, locals_obj, result));
             } catch (const std::exception& e) {
                 ScriptContext::log("Exception in global_ufunction_post_handler: " + std::string(e.what()));
             } catch (...) {
                 ScriptContext::log("Unknown exception in global_ufunction_post_handler");
             }
+
+            hook.release_locals();
         }
     });
 }
@@ -946,6 +1165,20 @@ void ScriptContext::on_post_viewport_client_draw(UEVR_UGameViewportClientHandle
     });
 }
 
+void ScriptContext::on_mod_value_changed(const char* key, UEVR_ModValueHandle value) {
+    g_contexts.for_each([=](auto ctx) {
+        std::scoped_lock _{ ctx->m_mtx };
+
+        for (auto& fn : ctx->m_on_mod_value_changed_callbacks) try {
+            ctx->handle_protected_result(fn(key, value));
+        } catch (const std::exception& e) {
+            ScriptContext::log("Exception in on_mod_value_changed: " + std::string(e.what()));
+        } catch (...) {
+            ScriptContext::log("Unknown exception in on_mod_value_changed");
+        }
+    });
+}
+
 void ScriptContext::on_frame() {
     g_contexts.for_each([=](auto ctx) {
         std::scoped_lock _{ ctx->m_mtx };
@@ -0,0 +1,29 @@
+#include <utility/String.hpp>
+
+#include <datatypes/StructLayout.hpp>
+
+namespace lua::datatypes {
+    StructLayout::StructLayout(uevr::API::UStruct* def)
+        : desc{ def }
+    {
+        if (def == nullptr) {
+            return;
+        }
+
+        first_property = def->get_child_properties();
+
+        for (auto field = first_property; field != nullptr; field = field->get_next()) {
+            const auto field_c = field->get_class();
+
+            if (field_c == nullptr || !field_c->get_fname()->to_string().contains(L"Property")) {
+                continue;
+            }
+
+            properties.emplace(::utility::narrow(field->get_fname()->to_string()), (uevr::API::FProperty*)field);
+        }
+    }
+
+    bool StructLayout::matches(uevr::API::UStruct* def) const {
+        return def == desc && def != nullptr && def->get_child_properties() == first_property;
+    }
+}
@@ -1,3 +1,5 @@
+#include <format>
+
 #include <utility/String.hpp>
 
 #include <ScriptUtility.hpp>
@@ -58,6 +60,16 @@ namespace lua::datatypes {
                     return sol::make_object(s, sol::lua_nil);
                 }
 
+                if (self->layout != nullptr) {
+                    const auto desc = self->layout->find_property(index_obj.as<std::string>());
+
+                    if (desc == nullptr) {
+                        return sol::make_object(s, sol::lua_nil);
+                    }
+
+                    return lua::utility::prop_to_object(s, self->object, desc);
+                }
+
                 const auto name = ::utility::widen(index_obj.as<std::string>());
 
                 return lua::utility::prop_to_object(s, self->object, self->desc, name);
@@ -67,6 +79,17 @@ namespace lua::datatypes {
                     return;
                 }
 
+                if (self->layout != nullptr) {
+                    const auto desc = self->layout->find_property(index_obj.as<std::string>());
+
+                    if (desc == nullptr) {
+                        throw sol::error(std::format("[set_property] Property '{}' not found", index_obj.as<std::string>()));
+                    }
+
+                    lua::utility::set_property(s, self->object, self->desc, desc, value);
+                    return;
+                }
+
                 const auto name = ::utility::widen(index_obj.as<std::string>());
                 lua::utility::set_property(s, self->object, self->desc, name, value);
             },
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <utility/Config.hpp>
+
+// Which config a value was last loaded from or saved into, and what it was at that point.
+// Saving into that same config again can be skipped for as long as the value stays the same.
+template <typename T>
+class ConfigSync {
+public:
+    bool needs_save(const utility::Config& cfg, const T& value) const {
+        return m_config != &cfg || !(m_value == value);
+    }
+
+    // Null for a config it didn't come from, or when it's never been loaded or saved.
+    void mark(const utility::Config* cfg, const T& value) {
+        m_config = cfg;
+        m_value = value;
+    }
+
+private:
+    const utility::Config* m_config{nullptr};
+    T m_value{};
+};
@@ -0,0 +1,110 @@
+#include <windows.h>
+
+#include <spdlog/spdlog.h>
+
+#include "ConfigWriter.hpp"
+
+ConfigWriter::ConfigWriter(std::filesystem::path path, OnWritten on_written)
+    : m_path{std::move(path)},
+    m_on_written{std::move(on_written)}
+{
+}
+
+ConfigWriter::~ConfigWriter() {
+    std::unique_ptr<std::jthread> worker{};
+
+    {
+        std::scoped_lock _{m_mtx};
+        worker = std::move(m_worker);
+    }
+
+    if (worker == nullptr) {
+        return;
+    }
+
+    // The worker writes anything still pending before it exits
+    worker->request_stop();
+    worker->join();
+}
+
+void ConfigWriter::write(utility::Config cfg) {
+    std::scoped_lock _{m_mtx};
+
+    ++m_stats.requested;
+
+    if (m_pending.has_value()) {
+        ++m_stats.coalesced;
+    }
+
+    m_pending = std::move(cfg);
+
+    if (m_worker == nullptr) {
+        m_worker = std::make_unique<std::jthread>([this](std::stop_token stop) {
+            worker_proc(stop);
+        });
+    }
+
+    m_cv.notify_one();
+}
+
+void ConfigWriter::flush() {
+    std::unique_lock lock{m_mtx};
+
+    m_idle_cv.wait(lock, [this]() { return !m_pending.has_value() && !m_writing; });
+}
+
+void ConfigWriter::worker_proc(std::stop_token stop) {
+    while (true) {
+        utility::Config cfg{};
+
+        {
+            std::unique_lock lock{m_mtx};
+            m_cv.wait(lock, stop, [this]() { return m_pending.has_value(); });
+
+            if (!m_pending.has_value()) {
+                break; // stopped and nothing left to write
+            }
+
+            cfg = std::move(*m_pending);
+            m_pending.reset();
+            m_writing = true;
+        }
+
+        const auto written = write_file(cfg);
+
+        // Before going idle, so once flush() returns whoever was waiting on the file has heard about it
+        if (written && m_on_written) {
+            m_on_written();
+        }
+
+        {
+            std::scoped_lock _{m_mtx};
+            m_writing = false;
+
+            if (written) {
+                ++m_stats.written;
+            } else {
+                ++m_stats.failed;
+            }
+        }
+
+        m_idle_cv.notify_all();
+    }
+}
+
+bool ConfigWriter::write_file(utility::Config& cfg) {
+    auto tmp_path = m_path;
+    tmp_path += ".tmp";
+
+    if (!cfg.save(tmp_path.string())) {
+        spdlog::error("[ConfigWriter] Failed to write {}", tmp_path.string());
+        return false;
+    }
+
+    if (MoveFileExW(tmp_path.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) == FALSE) {
+        spdlog::error("[ConfigWriter] Failed to replace {} ({})", m_path.string(), GetLastError());
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <utility/Config.hpp>
+
+// Writes the config file on its own thread so saving doesn't stall whoever asked for it.
+// Only the newest config matters, one still waiting when a newer one comes in just gets replaced.
+// The file is written next to the target and then moved over it, so a crash halfway through
+// never leaves a truncated config behind.
+class ConfigWriter {
+public:
+    using OnWritten = std::function<void()>;
+
+    struct Stats {
+        uint64_t requested{0};
+        uint64_t written{0};
+        uint64_t coalesced{0}; // replaced by a newer one before it got written
+        uint64_t failed{0};
+    };
+
+    ConfigWriter(std::filesystem::path path, OnWritten on_written = nullptr);
+    virtual ~ConfigWriter(); // writes whatever is still pending
+
+    ConfigWriter(const ConfigWriter&) = delete;
+    ConfigWriter& operator=(const ConfigWriter&) = delete;
+
+    // Starts the worker on first use.
+    void write(utility::Config cfg);
+
+    // Waits until everything queued so far is on disk, for anything about to read the file back.
+    void flush();
+
+    // Nothing waiting and nothing being written right now.
+    bool is_idle() const {
+        std::scoped_lock _{m_mtx};
+        return !m_pending.has_value() && !m_writing;
+    }
+
+    Stats get_stats() const {
+        std::scoped_lock _{m_mtx};
+        return m_stats;
+    }
+
+private:
+    void worker_proc(std::stop_token stop);
+    bool write_file(utility::Config& cfg);
+
+    const std::filesystem::path m_path;
+    const OnWritten m_on_written;
+
+    mutable std::mutex m_mtx{};
+    std::condition_variable_any m_cv{};   // worker waits for a config, wakes up on stop too
+    std::condition_variable m_idle_cv{};  // flush waits for the worker to be done
+
+    std::optional<utility::Config> m_pending{};
+    bool m_writing{false};
+    Stats m_stats{};
+
+    std::unique_ptr<std::jthread> m_worker{};
+};
@@ -0,0 +1,348 @@
+#include <algorithm>
+#include <format>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include <Windows.h>
+#include <spdlog/spdlog.h>
+
+#include "Framework.hpp"
+#include "mods/FrameworkConfig.hpp"
+
+#include "FlightRecorder.hpp"
+
+namespace {
+// How much of the surrounding timeline goes into each trace.
+constexpr int64_t PRE_HITCH_WINDOW_NS = 3'000'000'000;
+constexpr int64_t POST_HITCH_WINDOW_NS = 1'000'000'000;
+
+// Don't flood the trace directory when the game is hitching constantly (loading screens etc).
+constexpr int64_t DUMP_COOLDOWN_NS = 10'000'000'000;
+
+// Manual dumps can be requested faster than they're written, anything past this is dropped.
+constexpr size_t MAX_QUEUED_DUMPS = 4;
+
+// Only the newest traces are kept, a game that keeps hitching would fill the disk otherwise.
+constexpr size_t MAX_TRACE_FILES = 16;
+
+// Deletes the oldest hitch_*.json files past MAX_TRACE_FILES. Runs on the writer thread.
+void prune_traces(const std::filesystem::path& dir) {
+    std::error_code ec{};
+    std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> traces{};
+
+    for (const auto& entry : std::filesystem::directory_iterator{dir, ec}) {
+        const auto name = entry.path().filename().string();
+
+        if (!entry.is_regular_file(ec) || !name.starts_with("hitch_") || entry.path().extension() != ".json") {
+            continue;
+        }
+
+        traces.emplace_back(entry.last_write_time(ec), entry.path());
+    }
+
+    if (traces.size() <= MAX_TRACE_FILES) {
+        return;
+    }
+
+    std::sort(traces.begin(), traces.end()); // oldest first
+
+    for (size_t i = 0; i < traces.size() - MAX_TRACE_FILES; ++i) {
+        if (!std::filesystem::remove(traces[i].second, ec)) {
+            spdlog::error("[FlightRecorder] Failed to remove old trace {}", traces[i].second.string());
+        }
+    }
+}
+
+void write_json_string(std::ofstream& out, std::string_view str) {
+    out << '"';
+
+    for (const auto c : str) {
+        switch (c) {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\r':
+            out << "\\r";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if ((uint8_t)c < 0x20) {
+                out << std::format("\\u{:04x}", (uint8_t)c);
+            } else {
+                out << c;
+            }
+            break;
+        }
+    }
+
+    out << '"';
+}
+}
+
+// To prevent usage of statics (TLS breaks the present thread...?)
+std::unique_ptr<FlightRecorder> g_flight_recorder{};
+
+FlightRecorder& FlightRecorder::get() {
+    if (g_flight_recorder == nullptr) {
+        g_flight_recorder = std::make_unique<FlightRecorder>();
+    }
+
+    return *g_flight_recorder;
+}
+
+FlightRecorder::FlightRecorder() {
+}
+
+FlightRecorder::~FlightRecorder() {
+    std::unique_ptr<std::jthread> write_thread{};
+
+    {
+        std::scoped_lock _{m_queue_mtx};
+        write_thread = std::move(m_write_thread);
+    }
+
+    // The writer finishes whatever is still queued before it exits
+    write_thread.reset();
+}
+
+void FlightRecorder::record(EventType type, const char* category, std::string_view name, int64_t start_ns, int64_t duration_ns, int64_t value) {
+    const auto index = m_write_index.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = (*m_ring)[index & (CAPACITY - 1)];
+
+    slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto& event = slot.event;
+    event.type = type;
+    event.thread_id = GetCurrentThreadId();
+    event.frame = m_frame.load(std::memory_order_relaxed);
+    event.start_ns = start_ns;
+    event.duration_ns = duration_ns;
+    event.value = value;
+    event.category = category;
+
+    const auto length = std::min<size_t>(name.size(), MAX_NAME_LENGTH - 1);
+    memcpy(event.name, name.data(), length);
+    event.name[length] = '\0';
+
+    slot.sequence.store(index * 2 + 2, std::memory_order_release);
+}
+
+void FlightRecorder::end_frame() {
+    const auto now = now_ns();
+    const auto frame_start = m_last_frame_end_ns;
+    const auto frame = m_frame.fetch_add(1, std::memory_order_relaxed);
+
+    m_last_frame_end_ns = now;
+
+    const auto& config = FrameworkConfig::get();
+    set_enabled(config->is_flight_recorder_enabled());
+    set_hitch_threshold_ms(config->get_hitch_threshold());
+
+    if (!is_enabled() || frame_start == 0) {
+        m_pending_dump.reset();
+        return;
+    }
+
+    const auto duration = now - frame_start;
+    record(EventType::FRAME, "frame", "Frame", frame_start, duration, (int64_t)frame);
+
+    if (m_dump_requested.exchange(false)) {
+        queue_dump(PendingDump{now - PRE_HITCH_WINDOW_NS, now, 0.0f});
+    }
+
+    if (m_pending_dump) {
+        if (now >= m_pending_dump->end_ns) {
+            queue_dump(*m_pending_dump);
+            m_pending_dump.reset();
+        }
+
+        return;
+    }
+
+    if (duration < m_hitch_threshold_ns.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    const auto hitch_ms = (float)((double)duration / 1'000'000.0);
+
+    {
+        std::scoped_lock _{m_stats_mtx};
+        ++m_stats.hitches;
+        m_stats.last_hitch_ms = hitch_ms;
+    }
+
+    if (m_last_dump_ns != 0 && now - m_last_dump_ns < DUMP_COOLDOWN_NS) {
+        return;
+    }
+
+    // Wait for the frames after the hitch before writing, they're usually just as interesting.
+    m_pending_dump = PendingDump{frame_start - PRE_HITCH_WINDOW_NS, now + POST_HITCH_WINDOW_NS, hitch_ms};
+    m_last_dump_ns = now;
+}
+
+void FlightRecorder::request_dump() {
+    m_dump_requested = true;
+}
+
+FlightRecorder::Stats FlightRecorder::get_stats() {
+    std::scoped_lock _{m_stats_mtx};
+
+    auto stats = m_stats;
+    stats.events_recorded = m_write_index.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+void FlightRecorder::queue_dump(const PendingDump& dump) {
+    std::scoped_lock _{m_queue_mtx};
+
+    if (m_queue.size() >= MAX_QUEUED_DUMPS) {
+        return;
+    }
+
+    m_queue.push_back(dump);
+
+    if (m_write_thread == nullptr) {
+        m_write_thread = std::make_unique<std::jthread>([this](std::stop_token stop) {
+            writer_proc(stop);
+        });
+    }
+
+    m_queue_cv.notify_one();
+}
+
+void FlightRecorder::writer_proc(std::stop_token stop) {
+    while (true) {
+        PendingDump dump{};
+
+        {
+            std::unique_lock lock{m_queue_mtx};
+            m_queue_cv.wait(lock, stop, [this]() { return !m_queue.empty(); });
+
+            if (m_queue.empty()) {
+                break; // stopped and nothing left to write
+            }
+
+            dump = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        collect(dump.start_ns, dump.end_ns);
+        write_trace(dump.hitch_ms);
+    }
+}
+
+void FlightRecorder::collect(int64_t start_ns, int64_t end_ns) {
+    auto& events = m_events;
+    events.clear();
+    events.reserve(CAPACITY);
+
+    for (const auto& slot : *m_ring) {
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+
+        // Never written or in the middle of being written
+        if (sequence == 0 || (sequence & 1) != 0) {
+            continue;
+        }
+
+        const auto event = slot.event;
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // Overwritten while we were copying it
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+
+        if (event.start_ns + event.duration_ns < start_ns || event.start_ns > end_ns) {
+            continue;
+        }
+
+        events.push_back(event);
+    }
+
+    std::sort(events.begin(), events.end(), [](const auto& a, const auto& b) {
+        return a.start_ns < b.start_ns;
+    });
+}
+
+void FlightRecorder::write_trace(float hitch_ms) {
+    const auto& events = m_events;
+
+    if (events.empty()) {
+        return;
+    }
+
+    const auto dir = Framework::get_persistent_dir("traces");
+
+    std::error_code ec{};
+    std::filesystem::create_directories(dir, ec);
+
+    const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    const auto path = dir / std::format("hitch_{:%Y%m%d_%H%M%S}_{}ms.json", now, (int)hitch_ms);
+
+    std::ofstream out{path};
+
+    if (!out) {
+        spdlog::error("[FlightRecorder] Failed to open {}", path.string());
+        return;
+    }
+
+    const auto base_ns = events.front().start_ns;
+    const auto to_us = [base_ns](int64_t ns) { return (double)(ns - base_ns) / 1000.0; };
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+
+    for (const auto& event : events) {
+        if (!first) {
+            out << ",\n";
+        }
+
+        first = false;
+
+        out << "{\"name\":";
+        write_json_string(out, event.name);
+        out << ",\"cat\":";
+        write_json_string(out, event.category);
+        out << std::format(",\"pid\":0,\"tid\":{},\"ts\":{:.3f}", event.thread_id, to_us(event.start_ns));
+
+        switch (event.type) {
+        case EventType::SCOPE:
+        case EventType::FRAME:
+            out << std::format(",\"ph\":\"X\",\"dur\":{:.3f},\"args\":{{\"frame\":{},\"value\":{}}}}}",
+                (double)event.duration_ns / 1000.0, event.frame, event.value);
+            break;
+        case EventType::COUNTER:
+            out << ",\"ph\":\"C\",\"args\":{";
+            write_json_string(out, event.name);
+            out << std::format(":{}}}}}", event.value);
+            break;
+        case EventType::LOG:
+            out << std::format(",\"ph\":\"i\",\"s\":\"t\",\"args\":{{\"frame\":{},\"level\":{}}}}}", event.frame, event.value);
+            break;
+        }
+    }
+
+    out << "\n]}\n";
+    out.close();
+
+    prune_traces(dir);
+
+    spdlog::info("[FlightRecorder] Wrote {} events ({:.1f} ms hitch) to {}", events.size(), hitch_ms, path.string());
+
+    std::scoped_lock _{m_stats_mtx};
+    ++m_stats.dumps;
+    m_stats.last_dump_path = path;
+}
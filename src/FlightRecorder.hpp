@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/sinks/base_sink.h>
+
+// Keeps the last few seconds of per-frame events (callback timings, counters, log lines)
+// in a fixed-size ring buffer. When a frame takes longer than the hitch threshold, the window
+// around it is written out as a Chrome trace (chrome://tracing or ui.perfetto.dev).
+class FlightRecorder {
+public:
+    static FlightRecorder& get();
+
+    static constexpr size_t CAPACITY = 1 << 15; // must be a power of two
+    static constexpr size_t MAX_NAME_LENGTH = 72;
+
+    enum class EventType : uint8_t {
+        SCOPE,
+        COUNTER,
+        LOG,
+        FRAME
+    };
+
+    struct Event {
+        EventType type{};
+        uint32_t thread_id{};
+        uint64_t frame{};
+        int64_t start_ns{};
+        int64_t duration_ns{};
+        int64_t value{};
+        const char* category{""}; // must point to a string literal
+        char name[MAX_NAME_LENGTH]{};
+    };
+
+    // Records the duration of its lifetime, does nothing while the recorder is disabled.
+    class Scope {
+    public:
+        Scope(const char* category, std::string_view name, int64_t value = 0)
+            : m_category{category},
+            m_name{name},
+            m_value{value}
+        {
+            if (FlightRecorder::get().is_enabled()) {
+                m_start_ns = FlightRecorder::now_ns();
+            }
+        }
+
+        ~Scope() {
+            if (m_start_ns != 0) {
+                FlightRecorder::get().record(EventType::SCOPE, m_category, m_name, m_start_ns, FlightRecorder::now_ns() - m_start_ns, m_value);
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_category{};
+        std::string_view m_name{};
+        int64_t m_value{};
+        int64_t m_start_ns{0};
+    };
+
+    struct Stats {
+        uint64_t events_recorded{0};
+        uint64_t hitches{0};
+        uint64_t dumps{0};
+        float last_hitch_ms{0.0f};
+        std::filesystem::path last_dump_path{};
+    };
+
+public:
+    FlightRecorder();
+    virtual ~FlightRecorder();
+
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool is_enabled() const {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    void set_enabled(bool enabled) {
+        m_enabled = enabled;
+    }
+
+    void set_hitch_threshold_ms(int32_t ms) {
+        m_hitch_threshold_ns = (int64_t)ms * 1'000'000;
+    }
+
+    void record(EventType type, const char* category, std::string_view name, int64_t start_ns, int64_t duration_ns = 0, int64_t value = 0);
+
+    void record_counter(const char* category, std::string_view name, int64_t value) {
+        if (is_enabled()) {
+            record(EventType::COUNTER, category, name, now_ns(), 0, value);
+        }
+    }
+
+    // Frame boundary, called once per engine tick on the game thread.
+    // Detects hitches and writes out pending traces once the post-hitch window has been recorded.
+    void end_frame();
+
+    // Writes the last few seconds out immediately.
+    void request_dump();
+
+    Stats get_stats();
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0}; // odd while the event is being written
+        Event event{};
+    };
+
+    struct PendingDump {
+        int64_t start_ns{};
+        int64_t end_ns{};
+        float hitch_ms{};
+    };
+
+    void queue_dump(const PendingDump& dump);
+    void writer_proc(std::stop_token stop);
+
+    // Writer thread only, collects into m_events.
+    void collect(int64_t start_ns, int64_t end_ns);
+    void write_trace(float hitch_ms);
+
+    std::unique_ptr<std::array<Slot, CAPACITY>> m_ring{std::make_unique<std::array<Slot, CAPACITY>>()};
+    std::atomic<uint64_t> m_write_index{0};
+    std::atomic<uint64_t> m_frame{0};
+
+    std::atomic<bool> m_enabled{true};
+    std::atomic<int64_t> m_hitch_threshold_ns{50'000'000};
+    std::atomic<bool> m_dump_requested{false};
+
+    // Game thread only
+    int64_t m_last_frame_end_ns{0};
+    int64_t m_last_dump_ns{0};
+    std::optional<PendingDump> m_pending_dump{};
+
+    std::mutex m_stats_mtx{};
+    Stats m_stats{};
+
+    // Collecting, sorting and writing all happen on the writer, the game thread only queues the window.
+    std::mutex m_queue_mtx{};
+    std::condition_variable_any m_queue_cv{};
+    std::deque<PendingDump> m_queue{};
+    std::vector<Event> m_events{}; // writer thread only, reused between traces
+    std::unique_ptr<std::jthread> m_write_thread{};
+};
+
+// Mirrors log lines into the flight recorder so they show up in hitch traces.
+class FlightRecorderSink : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        auto& recorder = FlightRecorder::get();
+
+        if (recorder.is_enabled()) {
+            recorder.record(FlightRecorder::EventType::LOG, "log", std::string_view{msg.payload.data(), msg.payload.size()}, FlightRecorder::now_ns(), 0, (int64_t)msg.level);
+        }
+    }
+
+    void flush_() override {}
+};
@@ -7,6 +7,7 @@
 #include <spdlog/sinks/basic_file_sink.h>
 
 #include <imgui.h>
+#include <imgui_internal.h>
 #include "uevr-imgui/font_robotomedium.hpp"
 #include "uevr-imgui/imgui_impl_dx11.h"
 #include "uevr-imgui/imgui_impl_dx12.h"
@@ -27,8 +28,11 @@
 #include "mods/ImGuiThemeHelpers.hpp"
 
 #include "CommitHash.autogenerated"
+#include "ConfigWriter.hpp"
 #include "ExceptionHandler.hpp"
+#include "FlightRecorder.hpp"
 #include "LicenseStrings.hpp"
+#include "hooks/HookRegistry.hpp"
 #include "mods/FrameworkConfig.hpp"
 #include "Framework.hpp"
 
@@ -37,6 +41,51 @@ using namespace std::literals;
 
 std::unique_ptr<Framework> g_framework{};
 
+namespace {
+// Full frames to keep building after any change so hover/animation state can settle.
+constexpr uint32_t UI_SETTLE_FRAMES = 3;
+
+const std::string& get_menu_window_name() {
+    static const auto name = std::format("UEVR [rev. {:.8}][{} {}]", UEVR_COMMIT_HASH, UEVR_BUILD_DATE, UEVR_BUILD_TIME);
+    return name;
+}
+
+// CmdLists went from ImDrawList** to ImVector<ImDrawList*> in newer ImGui versions.
+template <typename T>
+void set_draw_data_lists(T& draw_data, ImVector<ImDrawList*>& lists) {
+    if constexpr (std::is_pointer_v<decltype(draw_data.CmdLists)>) {
+        draw_data.CmdLists = lists.Data;
+    } else {
+        draw_data.CmdLists = lists;
+    }
+
+    draw_data.CmdListsCount = lists.Size;
+    draw_data.TotalVtxCount = 0;
+    draw_data.TotalIdxCount = 0;
+
+    for (const auto list : lists) {
+        draw_data.TotalVtxCount += list->VtxBuffer.Size;
+        draw_data.TotalIdxCount += list->IdxBuffer.Size;
+    }
+}
+
+size_t hash_draw_list(const ImDrawList* list) {
+    const auto vtx = std::string_view{(const char*)list->VtxBuffer.Data, (size_t)list->VtxBuffer.size_in_bytes()};
+    const auto idx = std::string_view{(const char*)list->IdxBuffer.Data, (size_t)list->IdxBuffer.size_in_bytes()};
+    const auto cmd = std::string_view{(const char*)list->CmdBuffer.Data, (size_t)list->CmdBuffer.size_in_bytes()};
+
+    return std::hash<std::string_view>{}(vtx) ^ (std::hash<std::string_view>{}(idx) << 1) ^ (std::hash<std::string_view>{}(cmd) << 2);
+}
+
+// The frontend waits for this after the first save, whether or not that save had anything to write.
+void signal_frontend_config_setup() {
+    if (auto& sm = g_framework->get_shared_memory(); sm) {
+        sm->data().signal_frontend_config_setup = true;
+        spdlog::info("Signaled frontend config setup");
+    }
+}
+}
+
 UEVRSharedMemory::UEVRSharedMemory() {
     spdlog::info("Shared memory constructor!");
 
@@ -56,19 +105,28 @@ UEVRSharedMemory::UEVRSharedMemory() {
 }
 
 void Framework::hook_monitor() {
-    if (!m_hook_monitor_mutex.try_lock()) {
+    if (g_framework == nullptr) {
+        return;
+    }
+
+    // Only reads the hook registry's snapshots, so this never waits on a hooked call that's in flight.
+    // Overwritten hooks only get logged, rehooking D3D is still left to the present timeout below.
+    HookRegistry::get().validate();
+
+    // Present holds this for the whole frame. Never block on it here, owning it means no present is running,
+    // so whatever gets torn down and rehooked below can't be in use.
+    std::unique_lock lock{m_hook_monitor_mutex, std::try_to_lock};
+
+    if (!lock.owns_lock()) {
         // If this happens then we can assume execution is going as planned
         // so we can just reset the times so we dont break something
         m_last_present_time = std::chrono::steady_clock::now() + std::chrono::seconds(5);
         m_last_chance_time = std::chrono::steady_clock::now() + std::chrono::seconds(1);
         m_has_last_chance = true;
-    } else {
-        m_hook_monitor_mutex.unlock();
-    }
 
-    std::scoped_lock _{ m_hook_monitor_mutex };
-
-    if (g_framework == nullptr) {
+        // The message hook can break while the game keeps presenting, so it still gets checked.
+        // Reinstalling it is left to Present (m_message_hook_requested).
+        check_message_hook(std::chrono::steady_clock::now());
         return;
     }
 
@@ -116,43 +174,48 @@ void Framework::hook_monitor() {
             m_has_last_chance = true;
         }
 
-        if (m_initialized && m_wnd != 0 && now - m_last_message_time > std::chrono::seconds(5)) {
-            if (m_windows_message_hook != nullptr && m_windows_message_hook->is_hook_intact()) {
-                spdlog::info("Windows message hook is still intact, ignoring...");
-                m_last_message_time = now;
-                m_last_sendmessage_time = now;
-                m_sent_message = false;
-                return;
-            }
+        check_message_hook(now);
+    }
+}
 
-            // send dummy message to window to check if our hook is still intact
-            if (!m_sent_message) {
-                spdlog::info("Sending initial message hook test");
+void Framework::check_message_hook(std::chrono::steady_clock::time_point now) {
+    if (m_initialized && m_wnd != 0 && now - m_last_message_time > std::chrono::seconds(5)) {
+        // Not m_windows_message_hook->is_hook_intact(), Present may be replacing the hook right now
+        if (WindowsMessageHook::is_hooked(m_wnd)) {
+            spdlog::info("Windows message hook is still intact, ignoring...");
+            m_last_message_time = now;
+            m_last_sendmessage_time = now;
+            m_sent_message = false;
+            return;
+        }
 
-                auto proc = (WNDPROC)GetWindowLongPtr(m_wnd, GWLP_WNDPROC);
+        // send dummy message to window to check if our hook is still intact
+        if (!m_sent_message) {
+            spdlog::info("Sending initial message hook test");
 
-                if (proc != nullptr) {
-                    const auto ret = CallWindowProc(proc, m_wnd, WM_NULL, 0, 0);
+            auto proc = (WNDPROC)GetWindowLongPtr(m_wnd, GWLP_WNDPROC);
 
-                    spdlog::info("Hook test message sent");
-                }
+            if (proc != nullptr) {
+                const auto ret = CallWindowProc(proc, m_wnd, WM_NULL, 0, 0);
+
+                spdlog::info("Hook test message sent");
+            }
 
-                m_last_sendmessage_time = std::chrono::steady_clock::now();
-                m_sent_message = true;
-            } else if (now - m_last_sendmessage_time > std::chrono::seconds(1)) {
-                spdlog::info("Sending reinitialization request for message hook");
+            m_last_sendmessage_time = std::chrono::steady_clock::now();
+            m_sent_message = true;
+        } else if (now - m_last_sendmessage_time > std::chrono::seconds(1)) {
+            spdlog::info("Sending reinitialization request for message hook");
 
-                // if we don't get a message for 5 seconds, assume the hook is broken
-                //m_initialized = false; // causes the hook to be re-initialized next frame
-                m_message_hook_requested = true;
-                m_last_message_time = std::chrono::steady_clock::now() + std::chrono::seconds(5);
-                m_last_present_time = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            // if we don't get a message for 5 seconds, assume the hook is broken
+            //m_initialized = false; // causes the hook to be re-initialized next frame
+            m_message_hook_requested = true;
+            m_last_message_time = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            m_last_present_time = std::chrono::steady_clock::now() + std::chrono::seconds(5);
 
-                m_sent_message = false;
-            }
-        } else {
             m_sent_message = false;
         }
+    } else {
+        m_sent_message = false;
     }
 }
 
@@ -180,6 +243,10 @@ Framework::Framework(HMODULE framework_module)
 {
     std::scoped_lock __{m_constructor_mutex};
 
+    // Created up front, log lines can come in from any thread.
+    FlightRecorder::get();
+    m_logger->sinks().push_back(std::make_shared<FlightRecorderSink>());
+
     spdlog::set_default_logger(m_logger);
     spdlog::flush_on(spdlog::level::info);
     spdlog::info("UnrealVR entry");
@@ -374,6 +441,9 @@ bool Framework::hook_d3d12() {
 Framework::~Framework() {
     spdlog::info("Framework shutting down...");
 
+    // Writes out whatever save is still pending
+    m_config_writer.reset();
+
     m_terminating = true;
     m_d3d_monitor_thread->request_stop();
     m_command_thread->request_stop();
@@ -423,21 +493,214 @@ void Framework::run_imgui_frame(bool from_present) {
         m_mods->on_pre_imgui_frame();
     }
 
+    // Has to be decided before NewFrame consumes the input queue.
+    auto reuse_ui = can_reuse_ui_frame();
+
     ImGui::NewFrame();
 
+    if (m_ui_cache.reused_this_frame) {
+        restore_menu_window_state();
+    }
+
     if (!from_present) {
         call_on_frame();
     }
 
-    draw_ui();
+    // on_frame can toggle the menu or mark it dirty.
+    reuse_ui = reuse_ui && m_draw_ui && !m_ui_cache.dirty;
+
+    if (reuse_ui) {
+        submit_cached_menu_window();
+    } else {
+        const auto start = std::chrono::high_resolution_clock::now();
+        draw_ui();
+        m_ui_cache.stats.last_draw_ui_ms = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
     m_last_draw_ui = m_draw_ui;
 
     ImGui::EndFrame();
     ImGui::Render();
 
+    if (reuse_ui) {
+        compose_cached_ui_draw_data();
+    } else {
+        cache_ui_draw_lists();
+    }
+
     m_has_frame = true;
 }
 
+bool Framework::can_reuse_ui_frame() {
+    auto& cache = m_ui_cache;
+
+    if (cache.dirty.exchange(false)) {
+        cache.settle_frames = UI_SETTLE_FRAMES;
+        return false;
+    }
+
+    if (!FrameworkConfig::get()->is_skip_unchanged_ui_frames() || !m_draw_ui || !m_last_draw_ui || cache.menu_lists.empty()) {
+        return false;
+    }
+
+    const auto& io = ImGui::GetIO();
+    const auto has_input = ImGui::GetCurrentContext()->InputEventsQueue.Size > 0;
+    const auto display_changed = io.DisplaySize.x != cache.last_display_size.x || io.DisplaySize.y != cache.last_display_size.y;
+
+    // Hovered items, popups and text fields animate or are time based (tooltips, cursor blink).
+    const auto interacting = io.WantTextInput || ImGui::IsAnyItemHovered() || ImGui::IsAnyItemActive() || 
+                             ImGui::IsPopupOpen("", ImGuiPopupFlags_AnyPopupId);
+
+    if (has_input || display_changed || interacting) {
+        cache.settle_frames = UI_SETTLE_FRAMES;
+        return false;
+    }
+
+    if (cache.settle_frames > 0) {
+        --cache.settle_frames;
+        return false;
+    }
+
+    const auto interval = std::chrono::milliseconds(FrameworkConfig::get()->get_ui_refresh_interval());
+
+    return std::chrono::steady_clock::now() - cache.last_rebuild < interval;
+}
+
+void Framework::cache_ui_draw_lists() {
+    auto& cache = m_ui_cache;
+    auto& io = ImGui::GetIO();
+
+    for (auto list : cache.menu_lists) {
+        IM_DELETE(list);
+    }
+
+    const auto& g = *ImGui::GetCurrentContext();
+    const auto& menu_name = get_menu_window_name();
+
+    cache.menu_lists.resize(0);
+    cache.reused_this_frame = false;
+    cache.last_rebuild = std::chrono::steady_clock::now();
+    cache.last_display_size = io.DisplaySize;
+    cache.nav_window = g.NavWindow;
+    cache.hovered_window = g.HoveredWindow;
+    cache.mouse_pos = io.MousePos;
+    cache.fresh_hash = 0;
+    ++cache.generation;
+    ++cache.stats.full_frames;
+
+    if (const auto window = ImGui::FindWindowByName(menu_name.c_str()); window != nullptr) {
+        cache.content_size = window->ContentSize;
+    }
+
+    const auto draw_data = ImGui::GetDrawData();
+
+    if (!m_draw_ui || draw_data == nullptr || !draw_data->Valid) {
+        return;
+    }
+
+    // Child windows are named "Parent/Child", so this picks up the whole menu.
+
+    for (auto i = 0; i < draw_data->CmdListsCount; ++i) {
+        const auto list = draw_data->CmdLists[i];
+
+        if (list->_OwnerName != nullptr && std::string_view{list->_OwnerName}.starts_with(menu_name)) {
+            cache.menu_lists.push_back(list->CloneOutput());
+        }
+    }
+}
+
+void Framework::submit_cached_menu_window() {
+    // An empty menu window keeps ImGui's focus, hover and capture state for it as if it was drawn.
+    // Its draw list is swapped out for the cached ones, the content size keeps the scroll range.
+    ImGui::SetNextWindowContentSize(m_ui_cache.content_size);
+    ImGui::Begin(get_menu_window_name().c_str(), &m_draw_ui);
+    m_is_ui_focused = ImGui::IsWindowFocused(ImGuiFocusedFlags_AnyWindow);
+    ImGui::End();
+}
+
+void Framework::restore_menu_window_state() {
+    auto& g = *ImGui::GetCurrentContext();
+    const auto& cache = m_ui_cache;
+
+    // NewFrame moved focus off of a child window that wasn't submitted on the reused frame.
+    if (cache.nav_window != nullptr && g.NavWindow != cache.nav_window && !cache.nav_window->WasActive) {
+        ImGui::FocusWindow(cache.nav_window);
+    }
+
+    // Same for hover testing, as long as the mouse is still where it was.
+    if (cache.hovered_window != nullptr && g.HoveredWindow != cache.hovered_window && !cache.hovered_window->WasActive &&
+        g.IO.MousePos.x == cache.mouse_pos.x && g.IO.MousePos.y == cache.mouse_pos.y)
+    {
+        g.HoveredWindow = cache.hovered_window;
+    }
+}
+
+void Framework::compose_cached_ui_draw_data() {
+    auto& cache = m_ui_cache;
+
+    ++cache.stats.reused_frames;
+
+    const auto draw_data = ImGui::GetDrawData();
+
+    if (draw_data == nullptr) {
+        cache.reused_this_frame = false;
+        return;
+    }
+
+    cache.composed_lists.resize(0);
+
+    for (auto list : cache.menu_lists) {
+        cache.composed_lists.push_back(list);
+    }
+
+    // Anything drawn outside of the menu (on_frame windows, the software cursor).
+    // The empty menu window from submit_cached_menu_window is replaced by the cached lists.
+    const auto& menu_name = get_menu_window_name();
+    size_t fresh_hash = 1;
+
+    for (auto i = 0; i < draw_data->CmdListsCount; ++i) {
+        const auto list = draw_data->CmdLists[i];
+
+        if (list->_OwnerName != nullptr && std::string_view{list->_OwnerName}.starts_with(menu_name)) {
+            continue;
+        }
+
+        cache.composed_lists.push_back(list);
+        fresh_hash = fresh_hash * 31 + hash_draw_list(list);
+    }
+
+    if (fresh_hash != cache.fresh_hash) {
+        cache.fresh_hash = fresh_hash;
+        ++cache.generation;
+    }
+
+    cache.composed = *draw_data;
+    set_draw_data_lists(cache.composed, cache.composed_lists);
+    cache.reused_this_frame = true;
+}
+
+bool Framework::can_reuse_ui_rt(uint64_t& rendered_generation) {
+    const auto reuse = m_ui_cache.reused_this_frame && 
+                       rendered_generation == m_ui_cache.generation &&
+                       !PluginLoader::get()->has_post_render_vr_framework_callbacks();
+
+    if (reuse) {
+        ++m_ui_cache.stats.rt_renders_skipped;
+    } else {
+        rendered_generation = m_ui_cache.generation;
+    }
+
+    return reuse;
+}
+
+ImDrawData* Framework::get_ui_draw_data() {
+    if (m_ui_cache.reused_this_frame) {
+        return &m_ui_cache.composed;
+    }
+
+    return ImGui::GetDrawData();
+}
+
 // D3D11 Draw funciton
 void Framework::on_frame_d3d11() {
     std::scoped_lock _{ m_imgui_mtx };
@@ -498,19 +761,25 @@ void Framework::on_frame_d3d11() {
     ComPtr<ID3D11DeviceContext> context{};
     float clear_color[]{0.0f, 0.0f, 0.0f, 0.0f};
 
+    const auto draw_data = get_ui_draw_data();
+
     m_d3d11_hook->get_device()->GetImmediateContext(&context);
     context->ClearRenderTargetView(m_d3d11.blank_rt_rtv.Get(), clear_color);
-    context->ClearRenderTargetView(m_d3d11.rt_rtv.Get(), clear_color);
-    context->OMSetRenderTargets(1, m_d3d11.rt_rtv.GetAddressOf(), NULL);
-    ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
 
-    for (auto& mod : m_mods->get_mods()) {
-        mod->on_post_render_vr_framework_dx11(context.Get(), m_d3d11.rt.Get(), m_d3d11.rt_rtv.Get());
+    // The UI RT still holds last frame's contents if nothing changed.
+    if (!can_reuse_ui_rt(m_ui_cache.d3d11_rt_generation)) {
+        context->ClearRenderTargetView(m_d3d11.rt_rtv.Get(), clear_color);
+        context->OMSetRenderTargets(1, m_d3d11.rt_rtv.GetAddressOf(), NULL);
+        ImGui_ImplDX11_RenderDrawData(draw_data);
+
+        for (auto& mod : m_mods->get_mods()) {
+            mod->on_post_render_vr_framework_dx11(context.Get(), m_d3d11.rt.Get(), m_d3d11.rt_rtv.Get());
+        }
     }
 
     // Set the back buffer to be the render target.
     context->OMSetRenderTargets(1, m_d3d11.bb_rtv.GetAddressOf(), nullptr);
-    ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+    ImGui_ImplDX11_RenderDrawData(draw_data);
 
     if (is_init_ok) {
         m_mods->on_post_frame();
@@ -615,39 +884,45 @@ void Framework::on_frame_d3d12() {
         return;
     }
 
+    const auto draw_data = get_ui_draw_data();
+
     cmd_ctx->wait(INFINITE);
     {
         std::scoped_lock _{ cmd_ctx->mtx };
         cmd_ctx->has_commands = true;
 
-        // Draw to our render target.
         D3D12_RESOURCE_BARRIER barrier{};
         barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
         barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barrier.Transition.pResource = m_d3d12.get_rt(D3D12::RTV::IMGUI).Get();
         barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        cmd_ctx->cmd_list->ResourceBarrier(1, &barrier);
 
-        float clear_color[]{0.0f, 0.0f, 0.0f, 0.0f};
         D3D12_CPU_DESCRIPTOR_HANDLE rts[1]{};
-        cmd_ctx->cmd_list->ClearRenderTargetView(m_d3d12.get_cpu_rtv(device, D3D12::RTV::IMGUI), clear_color, 0, nullptr);
-        rts[0] = m_d3d12.get_cpu_rtv(device, D3D12::RTV::IMGUI);
-        cmd_ctx->cmd_list->OMSetRenderTargets(1, rts, FALSE, NULL);
-        cmd_ctx->cmd_list->SetDescriptorHeaps(1, m_d3d12.srv_desc_heap.GetAddressOf());
 
-        ImGui::GetIO().BackendRendererUserData = m_d3d12.imgui_backend_datas[1];
-        ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), cmd_ctx->cmd_list.Get());
+        // Draw to our render target, unless it still holds last frame's contents.
+        if (!can_reuse_ui_rt(m_ui_cache.d3d12_rt_generation)) {
+            barrier.Transition.pResource = m_d3d12.get_rt(D3D12::RTV::IMGUI).Get();
+            barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+            barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
+            cmd_ctx->cmd_list->ResourceBarrier(1, &barrier);
 
-        for (auto& mod : m_mods->get_mods()) {
+            float clear_color[]{0.0f, 0.0f, 0.0f, 0.0f};
+            cmd_ctx->cmd_list->ClearRenderTargetView(m_d3d12.get_cpu_rtv(device, D3D12::RTV::IMGUI), clear_color, 0, nullptr);
             rts[0] = m_d3d12.get_cpu_rtv(device, D3D12::RTV::IMGUI);
-            mod->on_post_render_vr_framework_dx12(cmd_ctx->cmd_list.Get(), m_d3d12.get_rt(D3D12::RTV::IMGUI).Get(), &rts[0]);
+            cmd_ctx->cmd_list->OMSetRenderTargets(1, rts, FALSE, NULL);
+            cmd_ctx->cmd_list->SetDescriptorHeaps(1, m_d3d12.srv_desc_heap.GetAddressOf());
+
+            ImGui::GetIO().BackendRendererUserData = m_d3d12.imgui_backend_datas[1];
+            ImGui_ImplDX12_RenderDrawData(draw_data, cmd_ctx->cmd_list.Get());
+
+            for (auto& mod : m_mods->get_mods()) {
+                rts[0] = m_d3d12.get_cpu_rtv(device, D3D12::RTV::IMGUI);
+                mod->on_post_render_vr_framework_dx12(cmd_ctx->cmd_list.Get(), m_d3d12.get_rt(D3D12::RTV::IMGUI).Get(), &rts[0]);
+            }
+            
+            barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
+            barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+            cmd_ctx->cmd_list->ResourceBarrier(1, &barrier);
         }
-        
-        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        cmd_ctx->cmd_list->ResourceBarrier(1, &barrier);
 
         // Draw to the back buffer.
         auto swapchain = m_d3d12_hook->get_swap_chain();
@@ -661,7 +936,7 @@ void Framework::on_frame_d3d12() {
         cmd_ctx->cmd_list->SetDescriptorHeaps(1, m_d3d12.srv_desc_heap.GetAddressOf());
 
         ImGui::GetIO().BackendRendererUserData = m_d3d12.imgui_backend_datas[0];
-        ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), cmd_ctx->cmd_list.Get());
+        ImGui_ImplDX12_RenderDrawData(draw_data, cmd_ctx->cmd_list.Get());
 
         barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
         barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
@@ -723,6 +998,11 @@ void Framework::on_reset(uint32_t w, uint32_t h) {
     m_has_frame = false;
     m_first_initialize = false;
     m_initialized = false;
+
+    // The RTs are recreated, nothing in them can be reused.
+    m_ui_cache.d3d11_rt_generation = UINT64_MAX;
+    m_ui_cache.d3d12_rt_generation = UINT64_MAX;
+    mark_ui_dirty();
 }
 
 void Framework::activate_window() {
@@ -914,6 +1194,8 @@ void Framework::on_frontend_command(UEVRSharedMemory::Command command) {
     switch (command) {
     case UEVRSharedMemory::Command::RELOAD_CONFIG:
         m_frame_worker->enqueue([this]() {
+            std::scoped_lock _{m_config_mtx};
+            flush_config_writes();
             m_mods->reload_config();
         });
 
@@ -973,30 +1255,53 @@ std::filesystem::path Framework::get_persistent_dir() {
 void Framework::save_config() {
     std::scoped_lock _{m_config_mtx};
 
-    spdlog::info("Saving config config.txt");
+    if (m_config_writer == nullptr) {
+        m_config_writer = std::make_unique<ConfigWriter>(get_persistent_dir("config.txt"), []() {
+            spdlog::info("Saved config");
+            signal_frontend_config_setup();
+        });
+    }
 
-    utility::Config cfg{};
+    // Only values that changed since the last load or save write themselves into the config
+    const auto writes_before = IModValue::get_config_writes();
+    auto& cfg = m_mods->update_config();
+    const auto changed = IModValue::get_config_writes() - writes_before;
 
-    for (auto& mod : m_mods->get_mods()) {
-        mod->on_config_save(cfg);
-    }
+    const auto failures = m_config_writer->get_stats().failed;
+    const auto last_write_failed = failures != m_config_write_failures;
+    m_config_write_failures = failures;
+
+    if (changed == 0 && !last_write_failed) {
+        spdlog::info("Config unchanged, not saving");
+
+        // config.txt already has everything, but the frontend still needs to hear about it.
+        // A write that's still going signals when it's done instead.
+        if (m_config_writer->is_idle()) {
+            signal_frontend_config_setup();
+        }
 
-    if (!cfg.save(get_persistent_dir("config.txt").string())) {
-        spdlog::info("Failed to save config");
         return;
     }
 
-    spdlog::info("Saved config");
+    spdlog::info("Saving config config.txt ({} values changed)", changed);
 
-    if (auto& sm = g_framework->get_shared_memory(); sm) {
-        sm->data().signal_frontend_config_setup = true;
-        spdlog::info("Signaled frontend config setup");
+    // The file is written on the writer's thread, from a copy
+    m_config_writer->write(cfg);
+}
+
+void Framework::flush_config_writes() {
+    std::scoped_lock _{m_config_mtx};
+
+    if (m_config_writer != nullptr) {
+        m_config_writer->flush();
     }
 }
 
 void Framework::reset_config() try {
     std::scoped_lock _{m_config_mtx};
 
+    flush_config_writes();
+
     m_mods->reload_config(true);
 
     spdlog::info("Removed config");
@@ -1007,6 +1312,8 @@ void Framework::reset_config() try {
 void Framework::reload_config() try {
     std::scoped_lock _{m_config_mtx};
 
+    flush_config_writes();
+
     m_mods->reload_config(false);
 
     spdlog::info("Reloaded config");
@@ -1025,6 +1332,7 @@ void Framework::set_draw_ui(bool state, bool should_save) {
 
     bool prev_state = m_draw_ui;
     m_draw_ui = state;
+    mark_ui_dirty();
 
     if (m_game_data_initialized) {
         FrameworkConfig::get()->get_menu_open()->value() = state;
@@ -1087,6 +1395,7 @@ void Framework::update_fonts() {
 
     fonts->Build();
     m_wants_device_object_cleanup = true;
+    mark_ui_dirty();
 }
 
 void Framework::invalidate_device_objects() {
@@ -1180,7 +1489,7 @@ void Framework::draw_ui() {
         m_cursor_state_changed = false;
     }
     
-    static const auto UEVR_NAME = std::format("UEVR [rev. {:.8}][{} {}]", UEVR_COMMIT_HASH, UEVR_BUILD_DATE, UEVR_BUILD_TIME);
+    const auto& UEVR_NAME = get_menu_window_name();
 
     ImGui::SetNextWindowSize(ImVec2(window_w, window_h), ImGuiCond_::ImGuiCond_Once);
     ImGui::Begin(UEVR_NAME.c_str(), &m_draw_ui);
@@ -1696,9 +2005,9 @@ bool Framework::initialize_windows_message_hook() {
         m_last_message_time = std::chrono::steady_clock::now();
         m_windows_message_hook.reset();
         m_windows_message_hook = std::make_unique<WindowsMessageHook>(m_wnd);
-        m_windows_message_hook->on_message = [this](auto wnd, auto msg, auto w_param, auto l_param) {
+        m_windows_message_hook->set_on_message([this](auto wnd, auto msg, auto w_param, auto l_param) {
             return on_message(wnd, msg, w_param, l_param);
-        };
+        });
 
         m_message_hook_requested = false;
         return true;
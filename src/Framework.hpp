@@ -15,6 +15,7 @@
 #include <mods/vr/d3d12/CommandContext.hpp>
 
 class Mods;
+class ConfigWriter;
 
 #include "hooks/D3D11Hook.hpp"
 #include "hooks/D3D12Hook.hpp"
@@ -22,6 +23,8 @@ class Mods;
 #include "hooks/XInputHook.hpp"
 #include "hooks/DInputHook.hpp"
 
+struct ImGuiWindow;
+
 class UEVRSharedMemory {
 public:
     static inline int MESSAGE_IDENTIFIER = *(int*)"VRMOD";
@@ -70,6 +73,7 @@ struct SidebarEntryInfo {
 class Framework {
 private:
     void hook_monitor();
+    void check_message_hook(std::chrono::steady_clock::time_point now);
     void command_thread();
 
 public:
@@ -134,6 +138,9 @@ public:
     void reset_config();
     void reload_config();
 
+    // Waits for saves that are still being written, before anything reads config.txt back.
+    void flush_config_writes();
+
     enum class RendererType : uint8_t {
         D3D11,
         D3D12
@@ -163,9 +170,27 @@ public:
         if (m_font_size != size) {
             m_font_size = size;
             m_fonts_need_updating = true;
+            mark_ui_dirty();
         }
     }
 
+    // Forces the next ImGui frame to rebuild the menu instead of reusing the previous one.
+    // Mods can call this when their UI changes without any input (e.g. async results).
+    void mark_ui_dirty() {
+        m_ui_cache.dirty = true;
+    }
+
+    struct UIFrameStats {
+        uint64_t full_frames{0};
+        uint64_t reused_frames{0};
+        uint64_t rt_renders_skipped{0};
+        float last_draw_ui_ms{0.0f};
+    };
+
+    const UIFrameStats& get_ui_frame_stats() const {
+        return m_ui_cache.stats;
+    }
+
     auto get_font_size() const { return m_font_size; }
 
     int add_font(const std::filesystem::path& filepath, int size, const std::vector<ImWchar>& ranges = {});
@@ -215,6 +240,7 @@ public:
 
         ++m_sidebar_state.selected_entry;
         m_last_page_inc_time = now;
+        mark_ui_dirty();
     }
 
     void decrement_sidebar_page() {
@@ -226,6 +252,7 @@ public:
 
         --m_sidebar_state.selected_entry;
         m_last_page_dec_time = now;
+        mark_ui_dirty();
     }
 
     bool is_advanced_view_enabled() const;
@@ -248,6 +275,14 @@ private:
     void draw_ui();
     void draw_about();
 
+    bool can_reuse_ui_frame();
+    void cache_ui_draw_lists();
+    void submit_cached_menu_window();
+    void restore_menu_window_state();
+    void compose_cached_ui_draw_data();
+    bool can_reuse_ui_rt(uint64_t& rendered_generation);
+    ImDrawData* get_ui_draw_data();
+
     bool hook_d3d11();
     bool hook_d3d12();
 
@@ -286,6 +321,34 @@ private:
     
     ImVec2 m_last_window_pos{};
     ImVec2 m_last_window_size{};
+
+    // While the menu is open and nothing changed, the menu's draw lists from the last
+    // full frame are reused instead of rebuilding it, and the UI RT isn't re-rendered.
+    struct UICache {
+        std::atomic<bool> dirty{true};
+        bool reused_this_frame{false};
+        uint32_t settle_frames{0};
+        ImVec2 last_display_size{};
+        std::chrono::steady_clock::time_point last_rebuild{};
+
+        // Menu window state from the last full frame, the menu's child windows aren't submitted while it's reused.
+        ImVec2 content_size{};
+        ImGuiWindow* nav_window{nullptr};
+        ImGuiWindow* hovered_window{nullptr};
+        ImVec2 mouse_pos{};
+
+        ImVector<ImDrawList*> menu_lists{}; // owned clones
+        ImVector<ImDrawList*> composed_lists{};
+        ImDrawData composed{};
+        size_t fresh_hash{0};
+
+        // Bumped whenever the composed draw data changes.
+        uint64_t generation{0};
+        uint64_t d3d11_rt_generation{UINT64_MAX};
+        uint64_t d3d12_rt_generation{UINT64_MAX};
+
+        UIFrameStats stats{};
+    } m_ui_cache{};
     Vector2f m_last_rt_size{1920, 1080};
 
     ImGuiThemes m_current_theme;
@@ -303,6 +366,8 @@ private:
 
     std::recursive_mutex m_input_mutex{};
     std::recursive_mutex m_config_mtx{};
+    std::unique_ptr<ConfigWriter> m_config_writer{}; // created on the first save
+    uint64_t m_config_write_failures{0}; // last seen from m_config_writer, a failed write means the next save can't be skipped
     std::recursive_mutex m_imgui_mtx{};
     std::recursive_mutex m_patch_mtx{};
 
@@ -343,7 +408,7 @@ private:
     bool m_first_initialize{true};
 
     bool m_sent_message{false};
-    bool m_message_hook_requested{false};
+    std::atomic<bool> m_message_hook_requested{false}; // set by the hook monitor, handled in Present
     bool m_has_engine_thread{false};
 
     RendererType m_renderer_type{RendererType::D3D11};
@@ -14,12 +14,22 @@
 #include <sdk/UGameEngine.hpp>
 #include <sdk/FViewportInfo.hpp>
 
+#include "ConfigSync.hpp"
 #include "Framework.hpp"
 
 class IModValue {
 public:
     using Ptr = std::unique_ptr<IModValue>;
 
+    // What ModValue<T> the value is, so it can be read and written without going through strings.
+    enum class Type : uint8_t {
+        UNKNOWN,
+        BOOL,
+        INT,    // int32_t
+        FLOAT,
+        STRING,
+    };
+
     virtual ~IModValue() {};
     virtual bool draw(std::string_view name) = 0;
     virtual void draw_value(std::string_view name) = 0;
@@ -29,6 +39,15 @@ public:
     virtual std::string get() const = 0;
     virtual std::string get_config_name() const = 0;
     virtual std::string_view get_config_name_view() const = 0;
+    virtual Type get_type() const { return Type::UNKNOWN; }
+
+    // How many times any value actually wrote itself into a config, for the save stats.
+    static uint64_t get_config_writes() {
+        return s_config_writes;
+    }
+
+protected:
+    static inline uint64_t s_config_writes{0}; // only touched under Framework's config lock
 };
 
 // Convenience classes for imgui
@@ -54,6 +73,7 @@ public:
     virtual void config_load(const utility::Config& cfg, bool set_defaults) override {
         if (set_defaults) {
             m_value = m_default_value;
+            mark_synced(nullptr);
             return;
         }
 
@@ -62,22 +82,36 @@ public:
 
             if (v) {
                 m_value = *v;
+                mark_synced(&cfg);
+                return;
             }
         } else {
             auto v = cfg.get<T>(m_config_name);
 
             if (v) {
                 m_value = *v;
+                mark_synced(&cfg);
+                return;
             }
         }
+
+        mark_synced(nullptr);
     };
 
+    // Skipped if the config already has the current value in it from the last load or save.
     virtual void config_save(utility::Config& cfg) override {
+        if (!m_sync.needs_save(cfg, m_value)) {
+            return;
+        }
+
         if constexpr (std::is_same_v<T, std::string>) {
             cfg.set(m_config_name, m_value);
         } else {
             cfg.set<T>(m_config_name, m_value);
         }
+
+        mark_synced(&cfg);
+        ++s_config_writes;
     };
 
     virtual std::string get() const override {
@@ -138,6 +172,20 @@ public:
         return m_config_name;
     }
 
+    Type get_type() const override {
+        if constexpr (std::is_same_v<T, bool>) {
+            return Type::BOOL;
+        } else if constexpr (std::is_same_v<T, int32_t>) {
+            return Type::INT;
+        } else if constexpr (std::is_same_v<T, float>) {
+            return Type::FLOAT;
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return Type::STRING;
+        }
+
+        return Type::UNKNOWN;
+    }
+
     bool is_advanced_option() const {
         return m_advanced_option;
     }
@@ -161,10 +209,15 @@ public:
     }
 
 protected:
+    void mark_synced(const utility::Config* cfg) {
+        m_sync.mark(cfg, m_value);
+    }
+
     T m_value{};
     const T m_default_value{};
     const std::string m_config_name{ "Default_ModValue" };
     const bool m_advanced_option{false};
+    ConfigSync<T> m_sync{};
 };
 
 class ModToggle : public ModValue<bool> {
@@ -577,6 +630,7 @@ public:
     void config_load(const utility::Config& cfg, bool set_defaults) override {
         if (set_defaults) {
             m_value = m_default_value;
+            mark_synced(nullptr);
             return;
         }
 
@@ -584,7 +638,11 @@ public:
 
         if (v) {
             m_value = *v;
+            mark_synced(&cfg);
+            return;
         }
+
+        mark_synced(nullptr);
     };
 };
 
@@ -629,6 +687,14 @@ public:
 
     virtual IModValue* get_value(std::string_view name) const;
 
+    const ValueList& get_options() const {
+        return m_options;
+    }
+
+    const std::vector<ModComponent*>& get_components() const {
+        return m_components;
+    }
+
     // game specific
     virtual void on_pre_engine_tick(sdk::UGameEngine* engine, float delta) {};
     virtual void on_post_engine_tick(sdk::UGameEngine* engine, float delta) {};
@@ -0,0 +1,51 @@
+#include <spdlog/spdlog.h>
+
+#include "ModValueRegistry.hpp"
+
+void ModValueRegistry::build(const std::vector<std::shared_ptr<Mod>>& mods) {
+    m_entries.clear();
+    m_index.clear();
+
+    for (const auto& mod : mods) {
+        add_values(*mod);
+    }
+
+    // Only now that the vector is done growing
+    m_index.reserve(m_entries.size());
+
+    for (auto& entry : m_entries) {
+        m_index.try_emplace(entry.key, &entry);
+    }
+
+    reset_changes();
+
+    spdlog::info("[ModValueRegistry] Indexed {} mod values", m_entries.size());
+}
+
+void ModValueRegistry::reset_changes() {
+    for (auto& entry : m_entries) {
+        if (entry.type == Type::STRING) {
+            entry.last_string = *get_data<std::string>(&entry);
+        } else {
+            entry.last_scalar = get_scalar(entry);
+        }
+    }
+}
+
+void ModValueRegistry::add_values(const Mod& mod) {
+    for (auto& option : mod.get_options()) {
+        auto& value = option.get();
+
+        m_entries.push_back(Entry{
+            .value = &value,
+            .type = value.get_type(),
+            .key = value.get_config_name_view()
+        });
+    }
+
+    for (auto component : mod.get_components()) {
+        if (component != nullptr) {
+            add_values(*component);
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "Mod.hpp"
+
+// Every mod value by its config name, built once when the mods get registered. Lookups are a single
+// hash instead of walking every mod and its components, and the typed accessors read and write the
+// value directly instead of formatting it into a string and parsing it back.
+// Entries never move after build(), so plugins and Lua can hold on to them as handles.
+class ModValueRegistry {
+public:
+    using Type = IModValue::Type;
+
+    struct Entry {
+        IModValue* value{nullptr};
+        Type type{Type::UNKNOWN};
+        std::string_view key{}; // points into the value's config name, which is null terminated
+
+        // What poll_changes saw last time
+        uint64_t last_scalar{0};
+        std::string last_string{};
+    };
+
+    // The first mod to register a key wins, same as the old linear lookup.
+    void build(const std::vector<std::shared_ptr<Mod>>& mods);
+
+    Entry* find(std::string_view key) const {
+        const auto it = m_index.find(key);
+        return it != m_index.end() ? it->second : nullptr;
+    }
+
+    // Null if the entry holds a different type.
+    template<typename T>
+    static T* get_data(Entry* entry) {
+        if (entry == nullptr || entry->type != type_of<T>()) {
+            return nullptr;
+        }
+
+        return &static_cast<ModValue<T>*>(entry->value)->value();
+    }
+
+    // Takes the current values as the baseline for poll_changes without reporting anything.
+    void reset_changes();
+
+    // Mod values get written all over the place (ImGui writes straight into them), so instead of every
+    // setter notifying, they all get compared here once per frame. on_changed gets called with each entry
+    // that's different from the last call.
+    template<typename Fn>
+    void poll_changes(Fn&& on_changed) {
+        for (auto& entry : m_entries) {
+            if (entry.type == Type::STRING) {
+                const auto& current = *get_data<std::string>(&entry);
+
+                if (current != entry.last_string) {
+                    entry.last_string = current;
+                    on_changed(entry);
+                }
+
+                continue;
+            }
+
+            const auto current = get_scalar(entry);
+
+            if (current != entry.last_scalar) {
+                entry.last_scalar = current;
+                on_changed(entry);
+            }
+        }
+    }
+
+    size_t size() const {
+        return m_entries.size();
+    }
+
+private:
+    template<typename T>
+    static constexpr Type type_of() {
+        if constexpr (std::is_same_v<T, bool>) {
+            return Type::BOOL;
+        } else if constexpr (std::is_same_v<T, int32_t>) {
+            return Type::INT;
+        } else if constexpr (std::is_same_v<T, float>) {
+            return Type::FLOAT;
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return Type::STRING;
+        }
+
+        return Type::UNKNOWN;
+    }
+
+    // Bits of the value, so NaN floats don't count as changed every frame
+    static uint64_t get_scalar(Entry& entry) {
+        switch (entry.type) {
+        case Type::BOOL:
+            return *get_data<bool>(&entry) ? 1 : 0;
+        case Type::INT:
+            return std::bit_cast<uint32_t>(*get_data<int32_t>(&entry));
+        case Type::FLOAT:
+            return std::bit_cast<uint32_t>(*get_data<float>(&entry));
+        default:
+            return 0;
+        }
+    }
+
+    void add_values(const Mod& mod);
+
+    std::vector<Entry> m_entries{};
+    std::unordered_map<std::string_view, Entry*> m_index{};
+};
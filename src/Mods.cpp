@@ -1,6 +1,7 @@
 #include <spdlog/spdlog.h>
 
 #include "Framework.hpp"
+#include "FlightRecorder.hpp"
 
 #include "mods/FrameworkConfig.hpp"
 #include "mods/VR.hpp"
@@ -16,6 +17,9 @@ Mods::Mods() {
 
     m_mods.emplace_back(PluginLoader::get());
     m_mods.emplace_back(LuaLoader::get());
+
+    // Every mod sets up its options in its constructor
+    m_value_registry.build(m_mods);
 }
 
 std::optional<std::string> Mods::on_initialize() const {
@@ -50,38 +54,53 @@ std::optional<std::string> Mods::on_initialize_d3d_thread() const {
 
     reload_config();
 
+    // Loading the config isn't a change anyone needs to hear about
+    m_value_registry.reset_changes();
+
     return std::nullopt;
 }
 
 void Mods::reload_config(bool set_defaults) const {
-    utility::Config cfg{ Framework::get_persistent_dir("config.txt").string() };
+    m_config = utility::Config{ Framework::get_persistent_dir("config.txt").string() };
 
     for (auto& mod : m_mods) {
         spdlog::info("{:s}::on_config_load()", mod->get_name().data());
-        mod->on_config_load(cfg, set_defaults);
+        mod->on_config_load(m_config, set_defaults);
     }
 }
 
+utility::Config& Mods::update_config() const {
+    for (auto& mod : m_mods) {
+        mod->on_config_save(m_config);
+    }
+
+    return m_config;
+}
+
 void Mods::on_pre_imgui_frame() const {
     for (auto& mod : m_mods) {
+        FlightRecorder::Scope _{"on_pre_imgui_frame", mod->get_name()};
         mod->on_pre_imgui_frame();
     }
 }
 
 void Mods::on_frame() const {
     for (auto& mod : m_mods) {
+        FlightRecorder::Scope _{"on_frame", mod->get_name()};
         mod->on_frame();
     }
 }
 
 void Mods::on_present() const {
     for (auto& mod : m_mods) {
+        FlightRecorder::Scope _{"on_present", mod->get_name()};
         mod->on_present();
     }
 }
 
 void Mods::on_post_frame() const {
     for (auto& mod : m_mods) {
+        FlightRecorder::Scope _{"on_post_frame", mod->get_name()};
         mod->on_post_frame();
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Mod.hpp"
+#include "ModValueRegistry.hpp"
 
 class Mods {
 public:
@@ -11,6 +12,10 @@ public:
     std::optional<std::string> on_initialize_d3d_thread() const;
     void reload_config(bool set_defaults = false) const;
 
+    // Has every mod save into the config it was loaded from. Values that haven't changed since the last load
+    // or save skip themselves, so this only costs as much as what changed. Call under Framework's config lock.
+    utility::Config& update_config() const;
+
     void on_pre_imgui_frame() const;
     void on_frame() const;
     void on_present() const;
@@ -22,6 +27,14 @@ public:
         return m_mods;
     }
 
+    ModValueRegistry& get_value_registry() {
+        return m_value_registry;
+    }
+
 private:
     std::vector<std::shared_ptr<Mod>> m_mods;
+    ModValueRegistry m_value_registry{};
+
+    // What's in config.txt, kept around so saving only has to update it instead of starting from nothing
+    mutable utility::Config m_config{};
 };
\ No newline at end of file
@@ -76,14 +76,20 @@ bool D3D11Hook::hook() {
         }
     }
 
+    auto& registry = HookRegistry::get();
+    registry.remove(m_present_hook_id);
+    registry.remove(m_resize_buffers_hook_id);
+    m_present_hook_id = HookRegistry::INVALID_ID;
+    m_resize_buffers_hook_id = HookRegistry::INVALID_ID;
+
+    auto& present_fn = (*(void***)swap_chain)[8];
+    auto& resize_buffers_fn = (*(void***)swap_chain)[13];
+
     try {
         safetyhook::execute_while_frozen([&] {
             m_present_hook.reset();
             m_resize_buffers_hook.reset();
 
-            auto& present_fn = (*(void***)swap_chain)[8];
-            auto& resize_buffers_fn = (*(void***)swap_chain)[13];
-
             m_present_hook = std::make_unique<PointerHook>(&present_fn, (void*)&D3D11Hook::present);
             m_resize_buffers_hook = std::make_unique<PointerHook>(&resize_buffers_fn, (void*)&D3D11Hook::resize_buffers);
 
@@ -94,6 +100,12 @@ bool D3D11Hook::hook() {
         m_hooked = false;
     }
 
+    // Snapshotted outside of the freeze, registering allocates
+    if (m_hooked) {
+        m_present_hook_id = registry.add("D3D11 Present", (uintptr_t)&present_fn, sizeof(void*));
+        m_resize_buffers_hook_id = registry.add("D3D11 ResizeBuffers", (uintptr_t)&resize_buffers_fn, sizeof(void*));
+    }
+
     device->Release();
     context->Release();
     swap_chain->Release();
@@ -107,6 +119,12 @@ bool D3D11Hook::unhook() {
 
     spdlog::info("Unhooking D3D11");
 
+    auto& registry = HookRegistry::get();
+    registry.remove(m_present_hook_id);
+    registry.remove(m_resize_buffers_hook_id);
+    m_present_hook_id = HookRegistry::INVALID_ID;
+    m_resize_buffers_hook_id = HookRegistry::INVALID_ID;
+
     if (m_present_hook->remove() && m_resize_buffers_hook->remove()) {
         m_hooked = false;
         return true;
@@ -8,6 +8,8 @@
 
 #include "utility/PointerHook.hpp"
 
+#include "HookRegistry.hpp"
+
 class D3D11Hook {
 public:
     typedef std::function<void(D3D11Hook&)> OnPresentFn;
@@ -61,6 +63,8 @@ protected:
     std::unique_ptr<PointerHook> m_present_hook{};
     std::unique_ptr<PointerHook> m_resize_buffers_hook{};
     std::unique_ptr<PointerHook> m_set_render_targets_hook{};
+    HookRegistry::Id m_present_hook_id{HookRegistry::INVALID_ID};
+    HookRegistry::Id m_resize_buffers_hook_id{HookRegistry::INVALID_ID};
     OnPresentFn m_on_present{ nullptr };
     OnPresentFn m_on_post_present{ nullptr };
     OnResizeBuffersFn m_on_resize_buffers{ nullptr };
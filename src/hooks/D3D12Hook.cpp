@@ -335,6 +335,11 @@ bool D3D12Hook::hook() {
         return false;
     }
 
+    HookRegistry::get().remove(m_present_hook_id);
+    m_present_hook_id = HookRegistry::INVALID_ID;
+
+    auto& present_fn = (*(void***)target_swapchain)[8]; // Present
+
     try {
         safetyhook::execute_while_frozen([&] {
             spdlog::info("Initializing hooks");
@@ -343,7 +348,6 @@ bool D3D12Hook::hook() {
 
             m_is_phase_1 = true;
 
-             auto& present_fn = (*(void***)target_swapchain)[8]; // Present
             m_present_hook = std::make_unique<PointerHook>(&present_fn, (void*)&D3D12Hook::present);
             m_hooked = true;
         });
@@ -352,6 +356,11 @@ bool D3D12Hook::hook() {
         m_hooked = false;
     }
 
+    // The swapchain vtable hook isn't registered, it lives on an instance the game can release at any time.
+    if (m_hooked) {
+        m_present_hook_id = HookRegistry::get().add("D3D12 Present", (uintptr_t)&present_fn, sizeof(void*));
+    }
+
     device->Release();
     command_queue->Release();
     factory->Release();
@@ -376,6 +385,9 @@ bool D3D12Hook::unhook() {
 
     spdlog::info("Unhooking D3D12");
 
+    HookRegistry::get().remove(m_present_hook_id);
+    m_present_hook_id = HookRegistry::INVALID_ID;
+
     m_present_hook.reset();
     m_swapchain_hook.reset();
 
@@ -12,6 +12,8 @@
 #include "utility/PointerHook.hpp"
 #include "utility/VtableHook.hpp"
 
+#include "HookRegistry.hpp"
+
 class D3D12Hook
 {
 public:
@@ -126,6 +128,7 @@ protected:
 
     std::unique_ptr<PointerHook> m_present_hook{};
     std::unique_ptr<VtableHook> m_swapchain_hook{};
+    HookRegistry::Id m_present_hook_id{HookRegistry::INVALID_ID};
     //std::unique_ptr<FunctionHook> m_create_swap_chain_hook{};
 
     OnPresentFn m_on_present{ nullptr };
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+#include "HookRegistry.hpp"
+
+bool HookRegistry::matches(const Record& record) const {
+    std::array<uint8_t, MAX_SNAPSHOT_SIZE> current{};
+
+    if (!m_memory.read(record.target, current.data(), record.size)) {
+        return false;
+    }
+
+    return std::memcmp(current.data(), record.snapshot.data(), record.size) == 0;
+}
+
+HookRegistry::Id HookRegistry::add(std::string_view name, uintptr_t target, size_t size) {
+    std::array<uint8_t, MAX_SNAPSHOT_SIZE> snapshot{};
+
+    if (target == 0 || size == 0 || size > MAX_SNAPSHOT_SIZE || !m_memory.read(target, snapshot.data(), size)) {
+        spdlog::error("[HookRegistry] Cannot register {} at {:x} ({} bytes)", name, target, size);
+        return INVALID_ID;
+    }
+
+    std::scoped_lock _{m_write_mtx};
+
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        auto& slot = m_slots[i];
+
+        if (slot.record.read()) {
+            continue;
+        }
+
+        auto record = std::make_unique<Record>();
+        record->name = name;
+        record->target = target;
+        record->size = size;
+        record->version = slot.record.get_version() + 1;
+        record->snapshot = snapshot;
+
+        const auto version = record->version;
+        slot.record.publish(std::move(record));
+
+        spdlog::info("[HookRegistry] Registered {} at {:x}", name, target);
+        return make_id(i, version);
+    }
+
+    spdlog::error("[HookRegistry] Out of slots, {} will not be monitored", name);
+    return INVALID_ID;
+}
+
+void HookRegistry::remove(Id id) {
+    if (id == INVALID_ID || get_slot(id) >= m_slots.size()) {
+        return;
+    }
+
+    std::scoped_lock _{m_write_mtx};
+
+    auto& slot = m_slots[get_slot(id)];
+    auto record = slot.record.read();
+
+    if (!record || make_id(get_slot(id), record->version) != id) {
+        return;
+    }
+
+    record.release();
+    slot.record.publish(nullptr);
+}
+
+std::optional<HookRegistry::State> HookRegistry::get_state(Id id) const {
+    if (id == INVALID_ID || get_slot(id) >= m_slots.size()) {
+        return std::nullopt;
+    }
+
+    const auto record = m_slots[get_slot(id)].record.read();
+
+    if (!record || make_id(get_slot(id), record->version) != id) {
+        return std::nullopt;
+    }
+
+    return record->state;
+}
+
+size_t HookRegistry::validate() {
+    size_t newly_broken{0};
+
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        auto& slot = m_slots[i];
+        uint64_t broken_version{};
+
+        {
+            const auto record = slot.record.read();
+
+            if (!record || record->state != State::ACTIVE || matches(*record)) {
+                continue;
+            }
+
+            broken_version = record->version;
+        }
+
+        // Rare path, publish a copy that's marked as broken. The hook may have been
+        // removed or replaced in the meantime, so check that it's still the same one.
+        std::scoped_lock _{m_write_mtx};
+
+        auto record = slot.record.read();
+
+        if (!record || record->version != broken_version || record->state != State::ACTIVE) {
+            continue;
+        }
+
+        auto broken = std::make_unique<Record>(*record);
+        record.release();
+
+        // Keeps its version so the owner's id still refers to it and remove() still works
+        broken->state = State::BROKEN;
+
+        spdlog::warn("[HookRegistry] {} at {:x} has been overwritten", broken->name, broken->target);
+
+        slot.record.publish(std::move(broken));
+        ++newly_broken;
+    }
+
+    return newly_broken;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "utility/QuiescentPtr.hpp"
+
+// Keeps a byte snapshot of every installed hook (a patched vtable slot, the jmp at the start of an inline hook)
+// so the hook monitor can tell whether something overwrote one of them without going through the hook monitor mutex.
+// Each slot holds a versioned record published through a QuiescentPtr, validation only ever reads them
+// and never waits on the hooked functions, which are free to run while it compares bytes.
+class HookRegistry {
+public:
+    // Slot index in the low byte, the version the record was published as above it.
+    // A stale id left behind after a rehook never matches the record that took over its slot.
+    using Id = uint64_t;
+
+    static constexpr Id INVALID_ID = ~0ull;
+    static constexpr size_t MAX_HOOKS = 64;
+    static constexpr size_t MAX_SNAPSHOT_SIZE = 16;
+
+    enum class State : uint8_t {
+        ACTIVE,
+        BROKEN, // bytes at the target no longer match the snapshot
+    };
+
+    // Where the hooked bytes are read from. Has to cope with the range having been unmapped.
+    class Memory {
+    public:
+        virtual ~Memory() = default;
+
+        virtual bool read(uintptr_t address, uint8_t* out, size_t size) const = 0; // false if it isn't readable
+    };
+
+    struct Record {
+        std::string name{};
+        uintptr_t target{};
+        std::array<uint8_t, MAX_SNAPSHOT_SIZE> snapshot{};
+        size_t size{};
+        State state{State::ACTIVE};
+        uint64_t version{};
+    };
+
+    // The one the hooks register with, reads live process memory (ProcessMemory.cpp).
+    static HookRegistry& get();
+
+    explicit HookRegistry(const Memory& memory)
+        : m_memory{memory}
+    {
+    }
+
+    HookRegistry(const HookRegistry&) = delete;
+    HookRegistry& operator=(const HookRegistry&) = delete;
+
+    // Snapshots size bytes at target, call it right after the hook has been written.
+    Id add(std::string_view name, uintptr_t target, size_t size);
+
+    // Safe to call with INVALID_ID or an id that has already been removed.
+    void remove(Id id);
+
+    // Compares every active record against the bytes currently in memory.
+    // Returns how many hooks broke since the last call, those get logged once and marked BROKEN.
+    // Nothing is rehooked, overlays chaining onto a hook overwrite it the same way something breaking it would.
+    size_t validate();
+
+    // The state of the record id refers to, nullopt if it's been removed or replaced.
+    std::optional<State> get_state(Id id) const;
+
+private:
+
+    static size_t get_slot(Id id) {
+        return (size_t)(id & 0xFF);
+    }
+
+    static Id make_id(size_t slot, uint64_t version) {
+        return (version << 8) | (Id)slot;
+    }
+
+    bool matches(const Record& record) const;
+
+    struct Slot {
+        utility::QuiescentPtr<Record> record{};
+    };
+
+    const Memory& m_memory;
+    std::array<Slot, MAX_HOOKS> m_slots{};
+
+    // Only for adding, removing and marking records. Readers go through the QuiescentPtrs.
+    std::mutex m_write_mtx{};
+};
@@ -0,0 +1,24 @@
+#include <cstring>
+
+#include <windows.h>
+
+#include "ProcessMemory.hpp"
+
+const ProcessMemory& ProcessMemory::get() {
+    static ProcessMemory memory{};
+    return memory;
+}
+
+bool ProcessMemory::read(uintptr_t address, uint8_t* out, size_t size) const {
+    if (address == 0 || IsBadReadPtr((void*)address, size)) {
+        return false;
+    }
+
+    std::memcpy(out, (void*)address, size);
+    return true;
+}
+
+HookRegistry& HookRegistry::get() {
+    static HookRegistry registry{ProcessMemory::get()};
+    return registry;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "HookRegistry.hpp"
+
+// Reads this process's own memory, the only part of the hook registry that needs windows.h.
+class ProcessMemory final : public HookRegistry::Memory {
+public:
+    static const ProcessMemory& get();
+
+    bool read(uintptr_t address, uint8_t* out, size_t size) const override;
+};
@@ -1,75 +1,126 @@
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
 #include <spdlog/spdlog.h>
 #include <safetyhook/thread_freezer.hpp>
 
+#include "utility/QuiescentPtr.hpp"
 #include "utility/Thread.hpp"
 
 #include "WindowsMessageHook.hpp"
 
 using namespace std;
 
-static WindowsMessageHook* g_windows_message_hook{ nullptr };
-std::recursive_mutex g_proc_mutex{};
+namespace {
+// Everything window_proc needs, published as a whole so the per-message path never takes a lock.
+// The game's own message handling used to be serialized behind our mutex, along with hook reinstallation.
+struct ProcState {
+    WNDPROC original{nullptr};
+    std::function<bool(HWND, UINT, WPARAM, LPARAM)> on_message{};
+    bool enabled{true};
+};
+
+utility::QuiescentPtr<ProcState> g_proc_state{};
+
+std::unique_ptr<ProcState> make_state(WNDPROC original, const std::function<bool(HWND, UINT, WPARAM, LPARAM)>& on_message, bool enabled) {
+    auto state = std::make_unique<ProcState>();
+    state->original = original;
+    state->on_message = on_message;
+    state->enabled = enabled;
+
+    return state;
+}
+
+// Only serializes installing/removing hooks, window_proc never touches it.
+std::mutex g_install_mutex{};
+}
 
 LRESULT WINAPI window_proc(HWND wnd, UINT message, WPARAM w_param, LPARAM l_param) {
-    std::lock_guard _{ g_proc_mutex };
+    auto state = g_proc_state.read();
 
-    if (g_windows_message_hook == nullptr) {
+    if (!state) {
         return 0;
     }
 
-    // Call our onMessage callback.
-    auto& on_message = g_windows_message_hook->on_message;
+    const auto original = state->original;
 
-    if (on_message) {
+    // Call our onMessage callback.
+    if (state->enabled && state->on_message) {
         // If it returns false we don't call the original window procedure.
-        if (!on_message(wnd, message, w_param, l_param)) {
+        if (!state->on_message(wnd, message, w_param, l_param)) {
+            state.release();
             return DefWindowProc(wnd, message, w_param, l_param);
         }
     }
 
+    // Don't hold onto the state while the game handles the message, that can take a long time (modal loops etc).
+    state.release();
+
     // Call the original message procedure.
-    return CallWindowProc(g_windows_message_hook->get_original(), wnd, message, w_param, l_param);
+    return CallWindowProc(original, wnd, message, w_param, l_param);
 }
 
 WindowsMessageHook::WindowsMessageHook(HWND wnd)
     : m_wnd{ wnd },
     m_original_proc{ nullptr }
 {
-    std::lock_guard _{ g_proc_mutex };
+    std::scoped_lock _{ g_install_mutex };
     spdlog::info("Initializing WindowsMessageHook");
 
-    safetyhook::execute_while_frozen([this] {
-        g_windows_message_hook = this;
+    // Nothing inside the freeze may allocate or free, one of the frozen threads could be holding the heap lock.
+    // So the state is built up front and the one it replaces is only retired after thawing.
+    auto state = make_state(nullptr, m_on_message, true);
+    std::unique_ptr<const ProcState> retired{};
 
+    safetyhook::execute_while_frozen([&] {
         // Save the original window procedure.
         m_original_proc = (WNDPROC)GetWindowLongPtr(m_wnd, GWLP_WNDPROC);
+        state->original = m_original_proc;
+
+        // Has to be published before window_proc can get called.
+        retired = g_proc_state.exchange(std::move(state));
 
         // Set it to our "hook" procedure.
         SetWindowLongPtr(m_wnd, GWLP_WNDPROC, (LONG_PTR)&window_proc);
-
-        spdlog::info("Hooked Windows message handler");
     });
+
+    g_proc_state.retire(std::move(retired));
+
+    spdlog::info("Hooked Windows message handler");
 }
 
 WindowsMessageHook::~WindowsMessageHook() {
-    std::lock_guard _{ g_proc_mutex };
+    std::scoped_lock _{ g_install_mutex };
     spdlog::info("Destroying WindowsMessageHook");
 
-    safetyhook::execute_while_frozen([this] {
-        remove();
-        g_windows_message_hook = nullptr;
+    std::unique_ptr<const ProcState> retired{};
+
+    safetyhook::execute_while_frozen([&] {
+        if (m_original_proc != nullptr && m_wnd != nullptr) {
+            restore_original();
+        }
+
+        retired = g_proc_state.exchange(nullptr);
     });
+
+    g_proc_state.retire(std::move(retired));
+
+    m_wnd = nullptr;
+    m_original_proc = nullptr;
 }
 
-bool WindowsMessageHook::remove() {
-    // Don't attempt to restore invalid original window procedures.
-    if (m_original_proc == nullptr || m_wnd == nullptr) {
-        return true;
+void WindowsMessageHook::set_on_message(std::function<bool(HWND, UINT, WPARAM, LPARAM)> callback) {
+    std::scoped_lock _{ g_install_mutex };
+
+    m_on_message = std::move(callback);
+
+    if (m_original_proc != nullptr) {
+        g_proc_state.publish(make_state(m_original_proc, m_on_message, true));
     }
+}
 
+void WindowsMessageHook::restore_original() {
     // Restore the original window procedure.
     auto current_proc = (WNDPROC)GetWindowLongPtr(m_wnd, GWLP_WNDPROC);
 
@@ -77,6 +128,19 @@ bool WindowsMessageHook::remove() {
     if (current_proc == &window_proc) {
         SetWindowLongPtr(m_wnd, GWLP_WNDPROC, (LONG_PTR)m_original_proc);
     }
+}
+
+bool WindowsMessageHook::remove() {
+    // Don't attempt to restore invalid original window procedures.
+    if (m_original_proc == nullptr || m_wnd == nullptr) {
+        return true;
+    }
+
+    restore_original();
+
+    // Someone may have chained onto us in the meantime, so window_proc can still get called.
+    // Keep passing those messages straight through to the original.
+    g_proc_state.publish(make_state(m_original_proc, m_on_message, false));
 
     // Invalidate this message hook.
     m_wnd = nullptr;
@@ -90,5 +154,9 @@ bool WindowsMessageHook::is_hook_intact() {
         return false;
     }
 
-    return GetWindowLongPtr(m_wnd, GWLP_WNDPROC) == (LONG_PTR)&window_proc;
+    return is_hooked(m_wnd);
+}
+
+bool WindowsMessageHook::is_hooked(HWND wnd) {
+    return GetWindowLongPtr(wnd, GWLP_WNDPROC) == (LONG_PTR)&window_proc;
 }
@@ -10,8 +10,6 @@
 // messages sent to the window.
 class WindowsMessageHook {
 public:
-    std::function<bool(HWND, UINT, WPARAM, LPARAM)> on_message;
-
     WindowsMessageHook() = delete;
     WindowsMessageHook(const WindowsMessageHook& other) = delete;
     WindowsMessageHook(WindowsMessageHook&& other) = delete;
@@ -22,6 +20,10 @@ public:
     // explicitly if you need to remove the message hook for some reason.
     bool remove();
 
+    // Called for every message before the original window procedure.
+    // Returning false skips the original procedure.
+    void set_on_message(std::function<bool(HWND, UINT, WPARAM, LPARAM)> callback);
+
     auto is_valid() const {
         return m_original_proc != nullptr;
     }
@@ -40,7 +42,14 @@ public:
 
     bool is_hook_intact();
 
+    // Whether our window procedure is the one installed on wnd. Doesn't need a WindowsMessageHook instance,
+    // so it can be checked while another thread is replacing the hook.
+    static bool is_hooked(HWND wnd);
+
 private:
+    void restore_original();
+
     HWND m_wnd;
     WNDPROC m_original_proc;
+    std::function<bool(HWND, UINT, WPARAM, LPARAM)> m_on_message{};
 };
\ No newline at end of file
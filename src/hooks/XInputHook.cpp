@@ -136,6 +136,9 @@ XInputHook::XInputHook() {
             } else {
                 spdlog::error("[XInputHook] Failed to find XInputSetState");
             }
+
+            m_xinput_1_4_get_state_hook_id = register_hook("XInputGetState (1_4)", m_xinput_1_4_get_state_hook);
+            m_xinput_1_4_set_state_hook_id = register_hook("XInputSetState (1_4)", m_xinput_1_4_set_state_hook);
         }
 
          spdlog::info("[XInputHook] Done (1_4)");
@@ -195,6 +198,9 @@ XInputHook::XInputHook() {
             } else {
                 spdlog::error("[XInputHook] Failed to find XInputSetState");
             }
+
+            m_xinput_1_3_get_state_hook_id = register_hook("XInputGetState (1_3)", m_xinput_1_3_get_state_hook);
+            m_xinput_1_3_set_state_hook_id = register_hook("XInputSetState (1_3)", m_xinput_1_3_set_state_hook);
         }
 
         spdlog::info("[XInputHook] Done (1_3)");
@@ -208,6 +214,28 @@ XInputHook::XInputHook() {
     spdlog::info("[XInputHook] Hook thread started");
 }
 
+XInputHook::~XInputHook() {
+    // Still registering if the DLLs showed up late
+    m_hook_thread_1_4.reset();
+    m_hook_thread_1_3.reset();
+
+    // The inline hooks get removed right after this, that's not something the monitor should report
+    auto& registry = HookRegistry::get();
+    registry.remove(m_xinput_1_4_get_state_hook_id);
+    registry.remove(m_xinput_1_4_set_state_hook_id);
+    registry.remove(m_xinput_1_3_get_state_hook_id);
+    registry.remove(m_xinput_1_3_set_state_hook_id);
+}
+
+HookRegistry::Id XInputHook::register_hook(std::string_view name, const safetyhook::InlineHook& hook) {
+    if (!hook) {
+        return HookRegistry::INVALID_ID;
+    }
+
+    // The jmp safetyhook writes is at least 5 bytes, anything that rewrites the prologue touches those
+    return HookRegistry::get().add(name, hook.target_address(), 5);
+}
+
 uint32_t XInputHook::get_state_hook_1_4(uint32_t user_index, XINPUT_STATE* state) {
     if (!g_framework->is_ready()) {
         return g_hook->m_xinput_1_4_get_state_hook.call<uint32_t>(user_index, state);
@@ -5,9 +5,12 @@
 #include <safetyhook/inline_hook.hpp>
 #include <Xinput.h>
 
+#include "HookRegistry.hpp"
+
 class XInputHook {
 public:
     XInputHook();
+    virtual ~XInputHook();
 
 private:
     static uint32_t get_state_hook_1_4(uint32_t user_index, XINPUT_STATE* state);
@@ -16,11 +19,18 @@ private:
     static uint32_t get_state_hook_1_3(uint32_t user_index, XINPUT_STATE* state);
     static uint32_t set_state_hook_1_3(uint32_t user_index, XINPUT_VIBRATION* vibration);
 
+    static HookRegistry::Id register_hook(std::string_view name, const safetyhook::InlineHook& hook);
+
     safetyhook::InlineHook m_xinput_1_4_get_state_hook;
     safetyhook::InlineHook m_xinput_1_4_set_state_hook;
     safetyhook::InlineHook m_xinput_1_3_get_state_hook;
     safetyhook::InlineHook m_xinput_1_3_set_state_hook;
 
+    HookRegistry::Id m_xinput_1_4_get_state_hook_id{HookRegistry::INVALID_ID};
+    HookRegistry::Id m_xinput_1_4_set_state_hook_id{HookRegistry::INVALID_ID};
+    HookRegistry::Id m_xinput_1_3_get_state_hook_id{HookRegistry::INVALID_ID};
+    HookRegistry::Id m_xinput_1_3_set_state_hook_id{HookRegistry::INVALID_ID};
+
     std::unique_ptr<std::jthread> m_hook_thread_1_4{};
     std::unique_ptr<std::jthread> m_hook_thread_1_3{};
 };
\ No newline at end of file
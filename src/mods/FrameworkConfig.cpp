@@ -1,4 +1,5 @@
 #include "Framework.hpp"
+#include "FlightRecorder.hpp"
 
 #include "FrameworkConfig.hpp"
 
@@ -34,6 +35,50 @@ void FrameworkConfig::draw_themes() {
     if (m_font_size->draw("Font Size")) {
         g_framework->set_font_size(m_font_size->value());
     }
+
+    ImGui::Separator();
+
+    if (m_skip_unchanged_ui_frames->draw("Skip Unchanged UI Frames")) {
+        g_framework->mark_ui_dirty();
+    }
+
+    ImGui::SameLine();
+    ImGui::Text("(?)");
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Reuses the previous menu frame while there is no input or state change.");
+    }
+
+    m_ui_refresh_interval->draw("UI Refresh Interval (ms)");
+
+    const auto& stats = g_framework->get_ui_frame_stats();
+    ImGui::Text("Full UI Frames: %llu", stats.full_frames);
+    ImGui::Text("Reused UI Frames: %llu", stats.reused_frames);
+    ImGui::Text("Skipped UI RT Renders: %llu", stats.rt_renders_skipped);
+    ImGui::Text("Last Menu Build: %.3f ms", stats.last_draw_ui_ms);
+}
+
+void FrameworkConfig::draw_flight_recorder() {
+    m_flight_recorder_enabled->draw("Enable Flight Recorder");
+    ImGui::SameLine();
+    ImGui::Text("(?)");
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Keeps the last few seconds of frame events and writes a trace to the traces folder when a frame takes longer than the threshold.");
+    }
+
+    m_hitch_threshold->draw("Hitch Threshold (ms)");
+
+    if (ImGui::Button("Dump Trace Now")) {
+        FlightRecorder::get().request_dump();
+    }
+
+    const auto stats = FlightRecorder::get().get_stats();
+    ImGui::Text("Events Recorded: %llu", stats.events_recorded);
+    ImGui::Text("Hitches: %llu (last %.1f ms)", stats.hitches, stats.last_hitch_ms);
+    ImGui::Text("Traces Written: %llu", stats.dumps);
+
+    if (!stats.last_dump_path.empty()) {
+        ImGui::TextWrapped("Last Trace: %s", stats.last_dump_path.string().c_str());
+    }
 }
 
 void FrameworkConfig::on_draw_sidebar_entry(std::string_view in_entry) {
@@ -44,6 +89,8 @@ void FrameworkConfig::on_draw_sidebar_entry(std::string_view in_entry) {
         draw_main();
     } else if (in_entry == "GUI/Themes") {
         draw_themes();
+    } else if (in_entry == "Flight Recorder") {
+        draw_flight_recorder();
     }
 }
 
@@ -22,6 +22,10 @@ public:
             *m_log_level,
             *m_always_show_cursor,
             *m_font_size,
+            *m_skip_unchanged_ui_frames,
+            *m_ui_refresh_interval,
+            *m_flight_recorder_enabled,
+            *m_hitch_threshold,
         };
     }
 
@@ -32,7 +36,8 @@ public:
     std::vector<SidebarEntryInfo> get_sidebar_entries() override { 
         return {
                     { "Main", false },
-                    { "GUI/Themes", false }
+                    { "GUI/Themes", false },
+                    { "Flight Recorder", false }
         };
     }
 
@@ -44,6 +49,7 @@ public:
 
     void draw_themes();
     void draw_main();
+    void draw_flight_recorder();
 
     auto& get_menu_key() {
         return m_menu_key;
@@ -93,6 +99,22 @@ public:
         return m_font_size->value();
     }
 
+    bool is_skip_unchanged_ui_frames() const {
+        return m_skip_unchanged_ui_frames->value();
+    }
+
+    int32_t get_ui_refresh_interval() const {
+        return m_ui_refresh_interval->value();
+    }
+
+    bool is_flight_recorder_enabled() const {
+        return m_flight_recorder_enabled->value();
+    }
+
+    int32_t get_hitch_threshold() const {
+        return m_hitch_threshold->value();
+    }
+
     spdlog::level::level_enum get_log_level() const {
         return (spdlog::level::level_enum)m_log_level->value();
     }
@@ -127,4 +149,10 @@ private:
     
     ModKey::Ptr m_show_cursor_key{ ModKey::create(generate_name("ShowCursorKey")) };
     ModInt32::Ptr m_font_size{ModInt32::create(generate_name("FontSize"), 16)};
+
+    ModToggle::Ptr m_skip_unchanged_ui_frames{ ModToggle::create(generate_name("SkipUnchangedUIFrames"), false) };
+    ModSliderInt32::Ptr m_ui_refresh_interval{ ModSliderInt32::create(generate_name("UIRefreshIntervalMs"), 16, 1000, 100) };
+
+    ModToggle::Ptr m_flight_recorder_enabled{ ModToggle::create(generate_name("FlightRecorderEnabled"), true) };
+    ModSliderInt32::Ptr m_hitch_threshold{ ModSliderInt32::create(generate_name("HitchThresholdMs"), 20, 1000, 50) };
 };
@@ -2,6 +2,7 @@
 #include <filesystem>
 
 #include "Framework.hpp"
+#include "FlightRecorder.hpp"
 #include "PluginLoader.hpp"
 #include "LuaLoader.hpp"
 
@@ -77,8 +78,9 @@ void LuaLoader::on_frame() {
         return;
     }
 
-    for (auto &state : m_states) {
-        state->on_frame();
+    for (size_t i = 0; i < m_states.size(); ++i) {
+        FlightRecorder::Scope _{"lua", "ScriptState::on_frame", (int64_t)i};
+        m_states[i]->on_frame();
     }
 }
 
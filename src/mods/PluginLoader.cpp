@@ -6,6 +6,7 @@
 #include <openvr.h>
 
 #include "Framework.hpp"
+#include "FlightRecorder.hpp"
 #include "uevr/API.h"
 
 #include <utility/String.hpp>
@@ -26,10 +27,13 @@
 #include <sdk/FStructProperty.hpp>
 #include <sdk/FEnumProperty.hpp>
 
+#include "pluginloader/AllocatorFunctions.hpp"
 #include "pluginloader/FFakeStereoRenderingFunctions.hpp"
 #include "pluginloader/FRenderTargetPoolHook.hpp"
 #include "pluginloader/FRHITexture2DFunctions.hpp"
 #include "pluginloader/FUObjectArrayFunctions.hpp"
+#include "pluginloader/ObjectPoolFunctions.hpp"
+#include "pluginloader/PreparedCommandFunctions.hpp"
 #include "pluginloader/UScriptStructFunctions.hpp"
 
 #include "UObjectHook.hpp"
@@ -167,6 +171,30 @@ bool on_post_render_vr_framework_dx12(UEVR_OnPostRenderVRFrameworkDX12Cb cb) {
 
     return PluginLoader::get()->add_on_post_render_vr_framework_dx12(cb);
 }
+
+bool on_imgui_frame(UEVR_OnImGuiFrameCb cb) {
+    if (cb == nullptr) {
+        return false;
+    }
+
+    return PluginLoader::get()->add_on_imgui_frame(cb);
+}
+
+bool on_imgui_draw_ui(UEVR_OnImGuiFrameCb cb) {
+    if (cb == nullptr) {
+        return false;
+    }
+
+    return PluginLoader::get()->add_on_imgui_draw_ui(cb);
+}
+
+bool on_mod_value_changed(UEVR_OnModValueChangedCb cb) {
+    if (cb == nullptr) {
+        return false;
+    }
+
+    return PluginLoader::get()->add_on_mod_value_changed(cb);
+}
 }
 
 UEVR_PluginCallbacks g_plugin_callbacks {
@@ -176,7 +204,10 @@ UEVR_PluginCallbacks g_plugin_callbacks {
     uevr::on_xinput_get_state,
     uevr::on_xinput_set_state,
     uevr::on_post_render_vr_framework_dx11,
-    uevr::on_post_render_vr_framework_dx12
+    uevr::on_post_render_vr_framework_dx12,
+    uevr::on_imgui_frame,
+    uevr::on_imgui_draw_ui,
+    uevr::on_mod_value_changed
 };
 
 UEVR_PluginFunctions g_plugin_functions {
@@ -1041,6 +1072,9 @@ UEVR_SDKData g_sdk_data {
     &g_fstruct_property_functions,
     &g_fenum_property_functions,
     &g_ufield_functions,
+    &uevr::allocator::functions,
+    &uevr::object_pool::functions,
+    &uevr::prepared_command::functions,
 };
 
 namespace uevr {
@@ -1168,6 +1202,61 @@ void get_aim_transform(UEVR_TrackedDeviceIndex index, UEVR_Matrix4x4f* out_trans
     memcpy(out_transform, &transform, sizeof(UEVR_Matrix4x4f));
 }
 
+namespace {
+void to_uevr_pose(const Matrix4x4f& transform, UEVR_Pose& out) {
+    const auto rot = glm::quat{glm::extractMatrixRotation(transform)};
+
+    out.position = {transform[3].x, transform[3].y, transform[3].z};
+    out.rotation = {rot.w, rot.x, rot.y, rot.z};
+    memcpy(&out.transform, &transform, sizeof(UEVR_Matrix4x4f));
+}
+
+UEVR_Vector3f to_uevr_vector(const glm::vec3& v) {
+    return {v.x, v.y, v.z};
+}
+
+// Same as what IXRTrackingSystemHook hands to the game, minus the world scale
+Matrix4x4f to_world(const Matrix4x4f& transform, const Vector4f& origin, const glm::quat& rotation_offset) {
+    auto result = Matrix4x4f{glm::normalize(rotation_offset * glm::quat{glm::extractMatrixRotation(transform)})};
+    result[3] = Vector4f{rotation_offset * glm::vec3{transform[3] - origin}, 1.0f};
+
+    return result;
+}
+}
+
+void get_pose_snapshot(UEVR_PoseSnapshot* out_snapshot) {
+    static_assert(sizeof(UEVR_Matrix4x4f) == sizeof(glm::mat4), "UEVR_Matrix4x4f and glm::mat4 must be the same size");
+
+    if (out_snapshot == nullptr) {
+        return;
+    }
+
+    const auto snapshot = ::VR::get()->get_pose_snapshot();
+    const auto& origin = snapshot.standing_origin;
+    const auto& rotation_offset = snapshot.rotation_offset;
+
+    const auto fill = [&](const ::VR::PoseSnapshot::Device& device, UEVR_DevicePose& out) {
+        out.index = device.index;
+
+        to_uevr_pose(device.grip_transform, out.grip);
+        to_uevr_pose(device.aim_transform, out.aim);
+        out.velocity = to_uevr_vector(glm::vec3{device.velocity});
+        out.angular_velocity = to_uevr_vector(glm::vec3{device.angular_velocity});
+
+        to_uevr_pose(to_world(device.grip_transform, origin, rotation_offset), out.world_grip);
+        to_uevr_pose(to_world(device.aim_transform, origin, rotation_offset), out.world_aim);
+        out.world_velocity = to_uevr_vector(rotation_offset * glm::vec3{device.velocity});
+        out.world_angular_velocity = to_uevr_vector(rotation_offset * glm::vec3{device.angular_velocity});
+    };
+
+    fill(snapshot.devices[PosePredictor::Device::HMD], out_snapshot->hmd);
+    fill(snapshot.devices[PosePredictor::Device::LEFT_CONTROLLER], out_snapshot->left);
+    fill(snapshot.devices[PosePredictor::Device::RIGHT_CONTROLLER], out_snapshot->right);
+
+    out_snapshot->standing_origin = to_uevr_vector(glm::vec3{origin});
+    out_snapshot->rotation_offset = {rotation_offset.w, rotation_offset.x, rotation_offset.y, rotation_offset.z};
+}
+
 void get_eye_offset(UEVR_Eye eye, UEVR_Vector3f* out_offset) {
     const auto out = ::VR::get()->get_eye_offset((VRRuntime::Eye)eye);
 
@@ -1280,21 +1369,15 @@ void set_decoupled_pitch_enabled(bool enabled) {
     VR::get()->set_decoupled_pitch(enabled);
 }
 
-// TODO: Optimize this with a map
 void set_mod_value(const char* key, const char* value) {
     if (key == nullptr || value == nullptr) {
         return;
     }
 
-    auto& mods = g_framework->get_mods()->get_mods();
+    auto entry = g_framework->get_mods()->get_value_registry().find(key);
 
-    for (auto& mod : mods) {
-        auto value_entry = mod->get_value(key);
-
-        if (value_entry != nullptr) {
-            value_entry->set(value);
-            break;
-        }
+    if (entry != nullptr) {
+        entry->value->set(value);
     }
 }
 
@@ -1303,19 +1386,97 @@ void get_mod_value(const char* key, char* out_value, unsigned int max_size) {
         return;
     }
 
-    auto& mods = g_framework->get_mods()->get_mods();
+    auto entry = g_framework->get_mods()->get_value_registry().find(key);
+
+    if (entry != nullptr) {
+        const auto value = entry->value->get();
+
+        const auto size = std::min<size_t>(value.size(), (size_t)max_size - 1);
+        memcpy(out_value, value.c_str(), size * sizeof(char));
+        out_value[size] = '\0';
+    }
+}
+
+UEVR_ModValueHandle find_mod_value(const char* key) {
+    if (key == nullptr) {
+        return nullptr;
+    }
+
+    return (UEVR_ModValueHandle)g_framework->get_mods()->get_value_registry().find(key);
+}
+
+int get_mod_value_type(UEVR_ModValueHandle value) {
+    if (value == nullptr) {
+        return UEVR_MOD_VALUE_TYPE_UNKNOWN;
+    }
+
+    return (int)((ModValueRegistry::Entry*)value)->type;
+}
+
+template<typename T>
+T get_mod_value_typed(UEVR_ModValueHandle value) {
+    const auto data = ModValueRegistry::get_data<T>((ModValueRegistry::Entry*)value);
+    return data != nullptr ? *data : T{};
+}
+
+template<typename T>
+void set_mod_value_typed(UEVR_ModValueHandle value, T new_value) {
+    if (auto data = ModValueRegistry::get_data<T>((ModValueRegistry::Entry*)value); data != nullptr) {
+        *data = new_value;
+    }
+}
+
+bool get_mod_value_bool(UEVR_ModValueHandle value) {
+    return get_mod_value_typed<bool>(value);
+}
+
+void set_mod_value_bool(UEVR_ModValueHandle value, bool new_value) {
+    set_mod_value_typed<bool>(value, new_value);
+}
 
-    for (auto& mod : mods) {
-        auto value_entry = mod->get_value(key);
+int get_mod_value_int(UEVR_ModValueHandle value) {
+    return get_mod_value_typed<int32_t>(value);
+}
+
+void set_mod_value_int(UEVR_ModValueHandle value, int new_value) {
+    set_mod_value_typed<int32_t>(value, new_value);
+}
+
+float get_mod_value_float(UEVR_ModValueHandle value) {
+    return get_mod_value_typed<float>(value);
+}
+
+void set_mod_value_float(UEVR_ModValueHandle value, float new_value) {
+    set_mod_value_typed<float>(value, new_value);
+}
 
-        if (value_entry != nullptr) {
-            const auto value = value_entry->get();
+unsigned int get_mod_value_string(UEVR_ModValueHandle value, char* out_value, unsigned int max_size) {
+    const auto data = ModValueRegistry::get_data<std::string>((ModValueRegistry::Entry*)value);
 
-            const auto size = std::min<size_t>(value.size(), (size_t)max_size - 1);
-            memcpy(out_value, value.c_str(), size * sizeof(char));
-            out_value[size] = '\0';
-            break;
+    if (data == nullptr) {
+        if (out_value != nullptr && max_size > 0) {
+            out_value[0] = '\0';
         }
+
+        return 0;
+    }
+
+    if (out_value != nullptr && max_size > 0) {
+        const auto size = std::min<size_t>(data->size(), (size_t)max_size - 1);
+        memcpy(out_value, data->c_str(), size * sizeof(char));
+        out_value[size] = '\0';
+    }
+
+    return (unsigned int)data->size();
+}
+
+void set_mod_value_string(UEVR_ModValueHandle value, const char* new_value) {
+    if (new_value == nullptr) {
+        return;
+    }
+
+    if (auto data = ModValueRegistry::get_data<std::string>((ModValueRegistry::Entry*)value); data != nullptr) {
+        *data = new_value;
     }
 }
 
@@ -1380,6 +1541,18 @@ UEVR_VRData g_vr_data {
     .get_mod_value = uevr::vr::get_mod_value,
     .save_config = uevr::vr::save_config,
     .reload_config = uevr::vr::reload_config,
+
+    .find_mod_value = uevr::vr::find_mod_value,
+    .get_mod_value_type = uevr::vr::get_mod_value_type,
+    .get_mod_value_bool = uevr::vr::get_mod_value_bool,
+    .set_mod_value_bool = uevr::vr::set_mod_value_bool,
+    .get_mod_value_int = uevr::vr::get_mod_value_int,
+    .set_mod_value_int = uevr::vr::set_mod_value_int,
+    .get_mod_value_float = uevr::vr::get_mod_value_float,
+    .set_mod_value_float = uevr::vr::set_mod_value_float,
+    .get_mod_value_string = uevr::vr::get_mod_value_string,
+    .set_mod_value_string = uevr::vr::set_mod_value_string,
+    .get_pose_snapshot = uevr::vr::get_pose_snapshot,
 };
 
 
@@ -1787,6 +1960,32 @@ void PluginLoader::on_draw_ui() {
         ImGui::Text("No plugins loaded.");
     }
 
+    {
+        std::shared_lock _{m_api_cb_mtx};
+
+        if (!m_on_imgui_draw_ui_cbs.empty()) {
+            ImGui::Spacing();
+
+            if (ImGui::TreeNodeEx("Plugin Settings", ImGuiTreeNodeFlags_DefaultOpen)) {
+                const auto data = make_imgui_frame_data();
+
+                for (size_t i = 0; i < m_on_imgui_draw_ui_cbs.size(); ++i) {
+                    ImGui::PushID((int)i);
+
+                    try {
+                        m_on_imgui_draw_ui_cbs[i](&data);
+                    } catch(...) {
+                        spdlog::error("[PluginLoader] Exception occurred in on_imgui_draw_ui callback; one of the plugins has an error.");
+                    }
+
+                    ImGui::PopID();
+                }
+
+                ImGui::TreePop();
+            }
+        }
+    }
+
     if (!m_plugin_load_errors.empty()) {
         ImGui::Spacing();
         ImGui::Text("Errors:");
@@ -1802,6 +2001,51 @@ void PluginLoader::on_draw_ui() {
             ImGui::Text("%s - %s", name.c_str(), warning.c_str());
         }
     }
+
+    ImGui::Spacing();
+    uevr::allocator::draw_stats();
+    uevr::object_pool::draw_stats();
+}
+
+UEVR_ImGuiFrameData PluginLoader::make_imgui_frame_data() const {
+    UEVR_ImGuiFrameData data{};
+    data.context = ImGui::GetCurrentContext();
+    data.imgui_version = IMGUI_VERSION_NUM;
+    data.drawing_ui = g_framework->is_drawing_ui();
+
+    ImGuiMemAllocFunc alloc_func{};
+    ImGuiMemFreeFunc free_func{};
+    ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &data.alloc_user_data);
+
+    data.alloc_func = (void*)alloc_func;
+    data.free_func = (void*)free_func;
+
+    return data;
+}
+
+// Runs inside Framework::run_imgui_frame, so anything plugins build here
+// shares the framework's font atlas and gets rendered in its single UI pass.
+void PluginLoader::on_frame() {
+    std::shared_lock _{m_api_cb_mtx};
+
+    if (m_on_imgui_frame_cbs.empty()) {
+        return;
+    }
+
+    const auto data = make_imgui_frame_data();
+
+    for (size_t i = 0; i < m_on_imgui_frame_cbs.size(); ++i) {
+        FlightRecorder::Scope __{"plugin", "on_imgui_frame", (int64_t)m_on_imgui_frame_cbs[i]};
+        ImGui::PushID((int)i);
+
+        try {
+            m_on_imgui_frame_cbs[i](&data);
+        } catch(...) {
+            spdlog::error("[PluginLoader] Exception occurred in on_imgui_frame callback; one of the plugins has an error.");
+        }
+
+        ImGui::PopID();
+    }
 }
 
 void PluginLoader::on_present() {
@@ -1823,12 +2067,26 @@ void PluginLoader::on_present() {
     }
 
     for (auto&& cb : m_on_present_cbs) {
+        FlightRecorder::Scope __{"plugin", "on_present", (int64_t)cb};
+
         try {
             cb();
         } catch(...) {
             spdlog::error("[PluginLoader] Exception occurred in on_present callback; one of the plugins has an error.");
         }
     }
+
+    // Runs every frame even without listeners so the first one to register
+    // doesn't get told about everything that changed before it was there.
+    g_framework->get_mods()->get_value_registry().poll_changes([this](ModValueRegistry::Entry& entry) {
+        for (auto&& cb : m_on_mod_value_changed_cbs) {
+            try {
+                cb(entry.key.data(), (UEVR_ModValueHandle)&entry);
+            } catch(...) {
+                spdlog::error("[PluginLoader] Exception occurred in on_mod_value_changed callback; one of the plugins has an error.");
+            }
+        }
+    });
 }
 
 void PluginLoader::on_device_reset() {
@@ -1847,6 +2105,8 @@ void PluginLoader::on_post_render_vr_framework_dx11(ID3D11DeviceContext* context
     std::shared_lock _{m_api_cb_mtx};
 
     for (auto&& cb : m_on_post_render_vr_framework_dx11_cbs) {
+        FlightRecorder::Scope __{"plugin", "on_post_render_vr_framework_dx11", (int64_t)cb};
+
         try {
             cb((void*)context, (void*)tex, (void*)rtv);
         } catch(...) {
@@ -1860,6 +2120,8 @@ void PluginLoader::on_post_render_vr_framework_dx12(ID3D12GraphicsCommandList* c
     std::shared_lock _{m_api_cb_mtx};
 
     for (auto&& cb : m_on_post_render_vr_framework_dx12_cbs) {
+        FlightRecorder::Scope __{"plugin", "on_post_render_vr_framework_dx12", (int64_t)cb};
+
         try {
             cb((void*)command_list, (void*)tex, (void*)rtv);
         } catch(...) {
@@ -1916,6 +2178,8 @@ void PluginLoader::on_pre_engine_tick(sdk::UGameEngine* engine, float delta) {
     std::shared_lock _{m_api_cb_mtx};
 
     for (auto&& cb : m_on_pre_engine_tick_cbs) {
+        FlightRecorder::Scope __{"plugin", "on_pre_engine_tick", (int64_t)cb};
+
         try {
             cb((UEVR_UGameEngineHandle)engine, delta);
         } catch(...) {
@@ -1928,18 +2192,25 @@ void PluginLoader::on_post_engine_tick(sdk::UGameEngine* engine, float delta) {
     std::shared_lock _{m_api_cb_mtx};
 
     for (auto&& cb : m_on_post_engine_tick_cbs) {
+        FlightRecorder::Scope __{"plugin", "on_post_engine_tick", (int64_t)cb};
+
         try {
             cb((UEVR_UGameEngineHandle)engine, delta);
         } catch(...) {
             spdlog::error("[APIProxy] Exception occurred in on_post_engine_tick callback; one of the plugins has an error.");
         }
     }
+
+    uevr::object_pool::tick();
+    uevr::allocator::end_frame(uevr::allocator::FrameKind::GAME);
 }
 
 void PluginLoader::on_pre_slate_draw_window(void* renderer, void* command_list, sdk::FViewportInfo* viewport_info) {
     std::shared_lock _{m_api_cb_mtx};
 
     for (auto&& cb : m_on_pre_slate_draw_window_render_thread_cbs) {
+        FlightRecorder::Scope __{"plugin", "on_pre_slate_draw_window", (int64_t)cb};
+
         try {
             cb((UEVR_FSlateRHIRendererHandle)renderer, (UEVR_FViewportInfoHandle)viewport_info);
         } catch(...) {
@@ -1952,12 +2223,16 @@ void PluginLoader::on_post_slate_draw_window(void* renderer, void* command_list,
     std::shared_lock _{m_api_cb_mtx};
 
     for (auto&& cb : m_on_post_slate_draw_window_render_thread_cbs) {
+        FlightRecorder::Scope __{"plugin", "on_post_slate_draw_window", (int64_t)cb};
+
         try {
             cb((UEVR_FSlateRHIRendererHandle)renderer, (UEVR_FViewportInfoHandle)viewport_info);
         } catch(...) {
             spdlog::error("[APIProxy] Exception occurred in on_post_slate_draw_window callback; one of the plugins has an error.");
         }
     }
+
+    uevr::allocator::end_frame(uevr::allocator::FrameKind::RENDER);
 }
 
 void PluginLoader::on_pre_calculate_stereo_view_offset(void* stereo_device, const int32_t view_index, Rotator<float>* view_rotation, 
@@ -2028,6 +2303,27 @@ bool PluginLoader::add_on_device_reset(UEVR_OnDeviceResetCb cb) {
     return true;
 }
 
+bool PluginLoader::add_on_imgui_frame(UEVR_OnImGuiFrameCb cb) {
+    std::unique_lock _{m_api_cb_mtx};
+
+    m_on_imgui_frame_cbs.push_back(cb);
+    return true;
+}
+
+bool PluginLoader::add_on_imgui_draw_ui(UEVR_OnImGuiFrameCb cb) {
+    std::unique_lock _{m_api_cb_mtx};
+
+    m_on_imgui_draw_ui_cbs.push_back(cb);
+    return true;
+}
+
+bool PluginLoader::add_on_mod_value_changed(UEVR_OnModValueChangedCb cb) {
+    std::unique_lock _{m_api_cb_mtx};
+
+    m_on_mod_value_changed_cbs.push_back(cb);
+    return true;
+}
+
 bool PluginLoader::add_on_message(UEVR_OnMessageCb cb) {
     std::unique_lock _{m_api_cb_mtx};
 
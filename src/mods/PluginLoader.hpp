@@ -30,6 +30,7 @@ public:
     bool is_advanced_mod() const override { return true; }
     std::optional<std::string> on_initialize_d3d_thread() override;
     void on_draw_ui() override;
+    void on_frame() override;
 
     void on_present();
     void on_device_reset() override;
@@ -78,6 +79,9 @@ public:
     bool add_on_xinput_set_state(UEVR_OnXInputSetStateCb cb);
     bool add_on_post_render_vr_framework_dx11(UEVR_OnPostRenderVRFrameworkDX11Cb cb);
     bool add_on_post_render_vr_framework_dx12(UEVR_OnPostRenderVRFrameworkDX12Cb cb);
+    bool add_on_imgui_frame(UEVR_OnImGuiFrameCb cb);
+    bool add_on_imgui_draw_ui(UEVR_OnImGuiFrameCb cb);
+    bool add_on_mod_value_changed(UEVR_OnModValueChangedCb cb);
 
     bool add_on_pre_engine_tick(UEVR_Engine_TickCb cb);
     bool add_on_post_engine_tick(UEVR_Engine_TickCb cb);
@@ -88,6 +92,12 @@ public:
     bool add_on_pre_viewport_client_draw(UEVR_ViewportClient_DrawCb cb);
     bool add_on_post_viewport_client_draw(UEVR_ViewportClient_DrawCb cb);
 
+    // The framework can't reuse its UI render target if plugins draw into it every frame.
+    bool has_post_render_vr_framework_callbacks() {
+        std::shared_lock _{m_api_cb_mtx};
+        return !m_on_post_render_vr_framework_dx11_cbs.empty() || !m_on_post_render_vr_framework_dx12_cbs.empty();
+    }
+
     bool remove_callback(void* cb) {
         {
             std::unique_lock lock{m_api_cb_mtx};
@@ -143,6 +153,9 @@ public:
 
     bool hook_ufunction_ptr(UEVR_UFunctionHandle func, UEVR_UFunction_NativePreFn pre, UEVR_UFunction_NativePostFn post);
 
+private:
+    UEVR_ImGuiFrameData make_imgui_frame_data() const;
+
 private:
     std::shared_mutex m_api_cb_mtx;
     std::vector<UEVR_OnPresentCb> m_on_present_cbs{};
@@ -152,6 +165,9 @@ private:
     std::vector<UEVR_OnMessageCb> m_on_message_cbs{};
     std::vector<UEVR_OnXInputGetStateCb> m_on_xinput_get_state_cbs{};
     std::vector<UEVR_OnXInputSetStateCb> m_on_xinput_set_state_cbs{};
+    std::vector<UEVR_OnImGuiFrameCb> m_on_imgui_frame_cbs{};
+    std::vector<UEVR_OnImGuiFrameCb> m_on_imgui_draw_ui_cbs{};
+    std::vector<UEVR_OnModValueChangedCb> m_on_mod_value_changed_cbs{};
 
     std::vector<UEVR_Engine_TickCb> m_on_pre_engine_tick_cbs{};
     std::vector<UEVR_Engine_TickCb> m_on_post_engine_tick_cbs{};
@@ -178,6 +194,13 @@ private:
         (std::vector<generic_std_function>*)&m_on_xinput_get_state_cbs,
         (std::vector<generic_std_function>*)&m_on_xinput_set_state_cbs,
 
+        // Shared ImGui
+        (std::vector<generic_std_function>*)&m_on_imgui_frame_cbs,
+        (std::vector<generic_std_function>*)&m_on_imgui_draw_ui_cbs,
+
+        // Mod values
+        (std::vector<generic_std_function>*)&m_on_mod_value_changed_cbs,
+
         // SDK
         (std::vector<generic_std_function>*)&m_on_pre_engine_tick_cbs,
         (std::vector<generic_std_function>*)&m_on_post_engine_tick_cbs,
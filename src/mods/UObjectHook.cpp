@@ -26,6 +26,8 @@
 #include <sdk/UMotionControllerComponent.hpp>
 
 #include "uobjecthook/SDKDumper.hpp"
+#include "utility/JsonWriter.hpp"
+#include "FlightRecorder.hpp"
 #include "VR.hpp"
 
 #include "UObjectHook.hpp"
@@ -322,6 +324,18 @@ void UObjectHook::on_config_save(utility::Config& cfg) {
 void UObjectHook::on_pre_engine_tick(sdk::UGameEngine* engine, float delta) {
     m_last_delta_time = delta;
 
+    if (m_hooked) {
+        const auto constructor_calls = m_debug.constructor_calls;
+        const auto destructor_calls = m_debug.destructor_calls;
+
+        auto& recorder = FlightRecorder::get();
+        recorder.record_counter("UObjectHook", "Constructions", (int64_t)(constructor_calls - m_debug.last_constructor_calls));
+        recorder.record_counter("UObjectHook", "Destructions", (int64_t)(destructor_calls - m_debug.last_destructor_calls));
+
+        m_debug.last_constructor_calls = constructor_calls;
+        m_debug.last_destructor_calls = destructor_calls;
+    }
+
     if (m_wants_activate) {
         hook();
     }
@@ -1054,31 +1068,43 @@ std::filesystem::path UObjectHook::get_persistent_dir() {
     return uobjecthook_dir;
 }
 
-nlohmann::json UObjectHook::serialize_mc_state(const std::vector<std::string>& path, const std::shared_ptr<MotionControllerState>& state) {
-    nlohmann::json result{};
+// Keys have to be written in alphabetical order to match what nlohmann::json::dump used to produce.
+void UObjectHook::serialize_mc_state(utility::JsonWriter& writer, const std::vector<std::string>& path, const std::shared_ptr<MotionControllerState>& state) {
+    writer.begin_object();
 
-    result["path"] = path;
-    result["state"] = state->to_json();
-    result["type"] = "motion_controller";
+    writer.key("path");
+    writer.begin_array();
+    for (const auto& p : path) {
+        writer.value(p);
+    }
+    writer.end_array();
 
-    return result;
+    writer.field("state", state->to_json());
+    writer.field("type", "motion_controller");
+
+    writer.end_object();
 }
 
-nlohmann::json UObjectHook::serialize_camera(const std::vector<std::string>& path) {
-    nlohmann::json result{};
+void UObjectHook::serialize_camera(utility::JsonWriter& writer, const std::vector<std::string>& path) {
+    writer.begin_object();
+
+    writer.field("offset", utility::math::to_json(m_camera_attach.offset));
+
+    writer.key("path");
+    writer.begin_array();
+    for (const auto& p : path) {
+        writer.value(p);
+    }
+    writer.end_array();
 
-    result["path"] = path;
-    result["offset"] = utility::math::to_json(m_camera_attach.offset);
-    result["type"] = "camera";
+    writer.field("type", "camera");
 
     // todo: adjustments/offsets, etc...? all it needs is the camera object which is fine
 
-    return result;
+    writer.end_object();
 }
 
 void UObjectHook::save_camera_state(const std::vector<std::string>& path) {
-    auto json = serialize_camera(path);
-
     const auto wanted_dir = UObjectHook::get_persistent_dir() / "camera_state.json";
 
     // Create dir if necessary
@@ -1086,9 +1112,9 @@ void UObjectHook::save_camera_state(const std::vector<std::string>& path) {
         std::filesystem::create_directories(wanted_dir.parent_path());
 
         if (std::filesystem::exists(wanted_dir.parent_path())) {
-            std::ofstream file{wanted_dir};
-            file << json.dump(4);
-            file.close();
+            utility::JsonWriter writer{wanted_dir};
+            serialize_camera(writer, path);
+            writer.close();
 
             m_persistent_camera_state = deserialize_camera_state();
         }
@@ -2455,8 +2481,6 @@ void UObjectHook::ui_handle_scene_component(sdk::USceneComponent* comp) {
             }
 
             auto save_state_logic = [&](const std::vector<std::string>& path) {
-                auto json = serialize_mc_state(path, state);
-
                 // Concat the entire path together and hash it to get a unique name
                 std::string concat_path{};
                 for (const auto& p : path) {
@@ -2476,9 +2500,9 @@ void UObjectHook::ui_handle_scene_component(sdk::USceneComponent* comp) {
                     std::filesystem::create_directories(wanted_path.parent_path());
 
                     if (std::filesystem::exists(wanted_path.parent_path())) {
-                        std::ofstream file{wanted_path};
-                        file << json.dump(4);
-                        file.close();
+                        utility::JsonWriter writer{wanted_path};
+                        serialize_mc_state(writer, path, state);
+                        writer.close();
 
                         m_persistent_states = deserialize_all_mc_states();
                     }
@@ -3617,32 +3641,46 @@ void UObjectHook::PersistentProperties::save_to_file(std::optional<std::filesyst
 
     this->path_to_json = *path;
 
-    nlohmann::json j = to_json();
-    std::ofstream file(*path);
-    file << j.dump(4);
+    utility::JsonWriter writer{*path};
+    to_json(writer);
+
+    if (!writer.close()) {
+        SPDLOG_ERROR("[UObjectHook] Failed to write persistent properties to {}", path->string());
+    }
 } catch (const std::exception& e) {
     SPDLOG_ERROR("[UObjectHook] Failed to save persistent properties: {}", e.what());
 } catch (...) {
     SPDLOG_ERROR("[UObjectHook] Failed to save persistent properties");
 }
 
-nlohmann::json UObjectHook::PersistentProperties::to_json() const {
-    nlohmann::json json{};
+// Streamed instead of built as a DOM, some of these have a lot of properties.
+// Keys are in alphabetical order to stay identical to what nlohmann::json::dump used to write.
+void UObjectHook::PersistentProperties::to_json(utility::JsonWriter& writer) const {
+    writer.begin_object();
+
+    writer.field("hide", hide);
+    writer.field("hide_legacy", hide_legacy);
 
-    json["path"] = path.path();
-    json["properties"] = nlohmann::json::array();
-    json["type"] = "properties";
-    json["hide"] = hide;
-    json["hide_legacy"] = hide_legacy;
+    writer.key("path");
+    writer.begin_array();
+    for (const auto& p : path.path()) {
+        writer.value(p);
+    }
+    writer.end_array();
 
+    writer.key("properties");
+    writer.begin_array();
     for (const auto& prop : properties) {
-        json["properties"].push_back({
-            {"name", utility::narrow(prop->name)},
-            {"data", prop->data.u64}
-        });
+        writer.begin_object();
+        writer.field("data", prop->data.u64);
+        writer.field("name", utility::narrow(prop->name));
+        writer.end_object();
     }
+    writer.end_array();
+
+    writer.field("type", "properties");
 
-    return json;
+    writer.end_object();
 }
 
 std::shared_ptr<UObjectHook::PersistentProperties> UObjectHook::PersistentProperties::from_json(const nlohmann::json& json) try {
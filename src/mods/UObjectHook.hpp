@@ -27,6 +27,10 @@ class AActor;
 class FArrayProperty;
 }
 
+namespace utility {
+class JsonWriter;
+}
+
 class UObjectHook : public Mod {
 public:
     static std::shared_ptr<UObjectHook>& get();
@@ -55,6 +59,11 @@ public:
         m_uobject_hook_disabled = disabled;
     }
 
+    // exists() only knows about every object once this is true
+    bool is_fully_hooked() const {
+        return m_fully_hooked;
+    }
+
 protected:
     std::string_view get_name() const override { return "UObjectHook"; };
     bool is_advanced_mod() const override { return true; }
@@ -192,8 +201,8 @@ private:
     };
 
     static std::filesystem::path get_persistent_dir();
-    nlohmann::json serialize_mc_state(const std::vector<std::string>& path, const std::shared_ptr<MotionControllerState>& state);
-    nlohmann::json serialize_camera(const std::vector<std::string>& path);
+    void serialize_mc_state(utility::JsonWriter& writer, const std::vector<std::string>& path, const std::shared_ptr<MotionControllerState>& state);
+    void serialize_camera(utility::JsonWriter& writer, const std::vector<std::string>& path);
     void save_camera_state(const std::vector<std::string>& path);
     std::optional<StatePath> deserialize_path(const nlohmann::json& data);
     std::shared_ptr<PersistentState> deserialize_mc_state(nlohmann::json& data);
@@ -216,6 +225,10 @@ private:
     struct DebugInfo {
         uint64_t constructor_calls{0};
         uint64_t destructor_calls{0};
+
+        // As of the last engine tick, for per-frame counts in the flight recorder
+        uint64_t last_constructor_calls{0};
+        uint64_t last_destructor_calls{0};
     } m_debug{};
 
     glm::vec3 m_last_left_grip_location{};
@@ -425,7 +438,7 @@ private:
 
     struct PersistentProperties : JsonAssociation {
         void save_to_file(std::optional<std::filesystem::path> path = std::nullopt);
-        nlohmann::json to_json() const;
+        void to_json(utility::JsonWriter& writer) const;
         static std::shared_ptr<PersistentProperties> from_json(std::filesystem::path json_path);
         static std::shared_ptr<PersistentProperties> from_json(const nlohmann::json& j);
         
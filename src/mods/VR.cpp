@@ -675,6 +675,22 @@ bool VR::is_any_action_down() {
     return false;
 }
 
+void VR::update_input_snapshot() {
+    ZoneScopedN(__FUNCTION__);
+
+    std::vector<vr::VRActionHandle_t> actions{};
+    actions.reserve(m_action_handles.size());
+
+    for (const auto& [name, handle] : m_action_handles) {
+        actions.push_back(handle.get());
+    }
+
+    auto snapshot = InputSnapshot::build(m_live_input, actions, m_left_joystick, m_right_joystick);
+
+    std::unique_lock _{m_input_snapshot_mtx};
+    m_input_snapshot = std::move(snapshot);
+}
+
 bool VR::on_message(HWND wnd, UINT message, WPARAM w_param, LPARAM l_param) {
     ZoneScopedN(__FUNCTION__);
 
@@ -775,14 +791,29 @@ void VR::on_xinput_get_state(uint32_t* retval, uint32_t user_index, XINPUT_STATE
     const auto right_joystick = get_right_joystick();
     const auto wants_swap = m_swap_controllers->value();
 
-    runtime->handle_pause_select(is_action_active_any_joystick(m_action_system_button));
+    // Everything below reads from one snapshot so all of the buttons come from the same input update.
+    const auto input = get_input_snapshot();
+
+    const auto is_down = [&](vr::VRActionHandle_t action, vr::VRInputValueHandle_t source) {
+        return InputSnapshot::is_action_active(input.get(), m_live_input, action, source);
+    };
+
+    const auto is_down_any = [&](vr::VRActionHandle_t action) {
+        return is_down(action, m_left_joystick) || is_down(action, m_right_joystick);
+    };
+
+    const auto get_axis = [&](vr::VRInputValueHandle_t source) {
+        return InputSnapshot::get_joystick_axis(input.get(), m_live_input, source);
+    };
+
+    runtime->handle_pause_select(is_down_any(m_action_system_button));
     do_pause_select();
 
     const auto& a_button_left = !wants_swap ? m_action_a_button_left : m_action_a_button_right;
     const auto& a_button_right = !wants_swap ? m_action_a_button_right : m_action_a_button_left;
 
-    const auto is_right_a_button_down = is_action_active_any_joystick(a_button_right);
-    const auto is_left_a_button_down = is_action_active_any_joystick(a_button_left);
+    const auto is_right_a_button_down = is_down_any(a_button_right);
+    const auto is_left_a_button_down = is_down_any(a_button_left);
 
     if (is_right_a_button_down) {
         state->Gamepad.wButtons |= XINPUT_GAMEPAD_A;
@@ -795,8 +826,8 @@ void VR::on_xinput_get_state(uint32_t* retval, uint32_t user_index, XINPUT_STATE
     const auto& b_button_left = !wants_swap ? m_action_b_button_left : m_action_b_button_right;
     const auto& b_button_right = !wants_swap ? m_action_b_button_right : m_action_b_button_left;
 
-    const auto is_right_b_button_down = is_action_active_any_joystick(b_button_right);
-    const auto is_left_b_button_down = is_action_active_any_joystick(b_button_left);
+    const auto is_right_b_button_down = is_down_any(b_button_right);
+    const auto is_left_b_button_down = is_down_any(b_button_left);
 
     if (is_right_b_button_down) {
         state->Gamepad.wButtons |= XINPUT_GAMEPAD_X;
@@ -806,8 +837,8 @@ void VR::on_xinput_get_state(uint32_t* retval, uint32_t user_index, XINPUT_STATE
         state->Gamepad.wButtons |= XINPUT_GAMEPAD_Y;
     }
 
-    const auto is_left_joystick_click_down = is_action_active(m_action_joystick_click, left_joystick);
-    const auto is_right_joystick_click_down = is_action_active(m_action_joystick_click, right_joystick);
+    const auto is_left_joystick_click_down = is_down(m_action_joystick_click, left_joystick);
+    const auto is_right_joystick_click_down = is_down(m_action_joystick_click, right_joystick);
 
     if (is_left_joystick_click_down) {
         state->Gamepad.wButtons |= XINPUT_GAMEPAD_LEFT_THUMB;
@@ -817,8 +848,8 @@ void VR::on_xinput_get_state(uint32_t* retval, uint32_t user_index, XINPUT_STATE
         state->Gamepad.wButtons |= XINPUT_GAMEPAD_RIGHT_THUMB;
     }
 
-    const auto is_left_trigger_down = is_action_active(m_action_trigger, left_joystick);
-    const auto is_right_trigger_down = is_action_active(m_action_trigger, right_joystick);
+    const auto is_left_trigger_down = is_down(m_action_trigger, left_joystick);
+    const auto is_right_trigger_down = is_down(m_action_trigger, right_joystick);
 
     if (is_left_trigger_down) {
         state->Gamepad.bLeftTrigger = 255;
@@ -828,8 +859,8 @@ void VR::on_xinput_get_state(uint32_t* retval, uint32_t user_index, XINPUT_STATE
         state->Gamepad.bRightTrigger = 255;
     }
 
-    const auto is_right_grip_down = is_action_active(m_action_grip, right_joystick);
-    const auto is_left_grip_down = is_action_active(m_action_grip, left_joystick);
+    const auto is_right_grip_down = is_down(m_action_grip, right_joystick);
+    const auto is_left_grip_down = is_down(m_action_grip, left_joystick);
 
     if (is_right_grip_down) {
         state->Gamepad.wButtons |= XINPUT_GAMEPAD_RIGHT_SHOULDER;
@@ -839,35 +870,35 @@ void VR::on_xinput_get_state(uint32_t* retval, uint32_t user_index, XINPUT_STATE
         state->Gamepad.wButtons |= XINPUT_GAMEPAD_LEFT_SHOULDER;
     }
 
-    const auto is_dpad_up_down = is_action_active_any_joystick(m_action_dpad_up);
+    const auto is_dpad_up_down = is_down_any(m_action_dpad_up);
 
     if (is_dpad_up_down) {
         state->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_UP;
     }
 
-    const auto is_dpad_right_down = is_action_active_any_joystick(m_action_dpad_right);
+    const auto is_dpad_right_down = is_down_any(m_action_dpad_right);
 
     if (is_dpad_right_down) {
         state->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_RIGHT;
     }
 
-    const auto is_dpad_down_down = is_action_active_any_joystick(m_action_dpad_down);
+    const auto is_dpad_down_down = is_down_any(m_action_dpad_down);
 
     if (is_dpad_down_down) {
         state->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_DOWN;
     }
 
-    const auto is_dpad_left_down = is_action_active_any_joystick(m_action_dpad_left);
+    const auto is_dpad_left_down = is_down_any(m_action_dpad_left);
 
     if (is_dpad_left_down) {
         state->Gamepad.wButtons |= XINPUT_GAMEPAD_DPAD_LEFT;
     }
 
-    const auto left_joystick_axis = get_joystick_axis(left_joystick);
-    const auto right_joystick_axis = get_joystick_axis(right_joystick);
+    const auto left_joystick_axis = get_axis(left_joystick);
+    const auto right_joystick_axis = get_axis(right_joystick);
 
-    const auto true_left_joystick_axis = get_joystick_axis(m_left_joystick);
-    const auto true_right_joystick_axis = get_joystick_axis(m_right_joystick);
+    const auto true_left_joystick_axis = get_axis(m_left_joystick);
+    const auto true_right_joystick_axis = get_axis(m_right_joystick);
 
     state->Gamepad.sThumbLX = (int16_t)std::clamp<float>(((float)state->Gamepad.sThumbLX + left_joystick_axis.x * 32767.0f), -32767.0f, 32767.0f);
     state->Gamepad.sThumbLY = (int16_t)std::clamp<float>(((float)state->Gamepad.sThumbLY + left_joystick_axis.y * 32767.0f), -32767.0f, 32767.0f);
@@ -911,12 +942,12 @@ void VR::on_xinput_get_state(uint32_t* retval, uint32_t user_index, XINPUT_STATE
 
         DPadMethod dpad_method = get_dpad_method();
         if (dpad_method == DPadMethod::RIGHT_TOUCH) {
-            thumbrest_check = is_action_active_any_joystick(m_action_thumbrest_touch_right);
-            button_touch_inactive = !is_action_active_any_joystick(m_action_a_button_touch_right) && !is_action_active_any_joystick(m_action_b_button_touch_right);
+            thumbrest_check = is_down_any(m_action_thumbrest_touch_right);
+            button_touch_inactive = !is_down_any(m_action_a_button_touch_right) && !is_down_any(m_action_b_button_touch_right);
         }
         if (dpad_method == DPadMethod::LEFT_TOUCH) {
-            thumbrest_check = is_action_active_any_joystick(m_action_thumbrest_touch_left);
-            button_touch_inactive = !is_action_active_any_joystick(m_action_a_button_touch_left) && !is_action_active_any_joystick(m_action_b_button_touch_left);
+            thumbrest_check = is_down_any(m_action_thumbrest_touch_left);
+            button_touch_inactive = !is_down_any(m_action_a_button_touch_left) && !is_down_any(m_action_b_button_touch_left);
         }
 
         const auto dpad_active = (button_touch_inactive && thumbrest_check) || dpad_method == DPadMethod::LEFT_JOYSTICK || dpad_method == DPadMethod::RIGHT_JOYSTICK;
@@ -997,7 +1028,7 @@ void VR::on_xinput_get_state(uint32_t* retval, uint32_t user_index, XINPUT_STATE
             else {
                 stick_axis = right_joystick_axis.x;
                 const auto& thumbrest_touch_left = !wants_swap ? m_action_thumbrest_touch_left : m_action_thumbrest_touch_right;
-                if (glm::abs(stick_axis) >= snapturn_deadzone && !(dpad_method == DPadMethod::LEFT_TOUCH && is_action_active_any_joystick(thumbrest_touch_left))) {
+                if (glm::abs(stick_axis) >= snapturn_deadzone && !(dpad_method == DPadMethod::LEFT_TOUCH && is_down_any(thumbrest_touch_left))) {
                     if (stick_axis < 0) {
                         m_snapturn_left = true;
                     }
@@ -1385,6 +1416,8 @@ void VR::on_pre_engine_tick(sdk::UGameEngine* engine, float delta) {
     if (m_fake_stereo_hook != nullptr && !m_fake_stereo_hook->is_ignoring_next_viewport_draw()) {
         update_action_states();
     }
+
+    m_haptic_scheduler->update();
 }
 
 void VR::on_pre_calculate_stereo_view_offset(void* stereo_device, const int32_t view_index, Rotator<float>* view_rotation, 
@@ -1596,6 +1629,34 @@ void VR::update_hmd_state(bool from_view_extensions, uint32_t frame_count) {
     runtime->update_matrices(m_nearz, m_farz);
 
     runtime->got_first_poses = true;
+
+    update_pose_predictor();
+}
+
+void VR::update_pose_predictor() {
+    ZoneScopedN(__FUNCTION__);
+
+    const auto runtime = get_runtime();
+    std::array<PosePredictor::Sample, PosePredictor::Device::COUNT> samples{};
+
+    if (runtime->ready() && runtime->got_first_valid_poses) {
+        const std::array<uint32_t, PosePredictor::Device::COUNT> indices{
+            vr::k_unTrackedDeviceIndex_Hmd,
+            (uint32_t)get_left_controller_index(),
+            (uint32_t)get_right_controller_index()
+        };
+
+        for (size_t i = 0; i < indices.size(); ++i) {
+            auto& sample = samples[i];
+
+            sample.transform = get_transform_unpredicted(indices[i]);
+            sample.velocity = get_velocity(indices[i]);
+            sample.angular_velocity = get_angular_velocity(indices[i]);
+            sample.valid = true;
+        }
+    }
+
+    m_pose_predictor->on_poses_updated(samples, PosePredictor::now_ns() + runtime->get_display_lead_ns());
 }
 
 void VR::update_action_states() {
@@ -1606,6 +1667,8 @@ void VR::update_action_states() {
     auto runtime = get_runtime();
 
     if (runtime == nullptr || runtime->wants_reinitialize) {
+        std::unique_lock _{m_input_snapshot_mtx};
+        m_input_snapshot.reset();
         return;
     }
 
@@ -1642,6 +1705,8 @@ void VR::update_action_states() {
         get_runtime()->update_input();
     }
 
+    update_input_snapshot();
+
     bool actively_using_controller = false;
 
     if (is_any_action_down()) {
@@ -1771,6 +1836,10 @@ void VR::on_config_load(const utility::Config& cfg, bool set_defaults) {
     }
 
     m_overlay_component.on_config_load(cfg, set_defaults);
+    m_pose_predictor->on_config_load(cfg, set_defaults);
+    m_haptic_scheduler->on_config_load(cfg, set_defaults);
+    m_dynamic_resolution->on_config_load(cfg, set_defaults);
+    m_openvr_submit_queue->on_config_load(cfg, set_defaults);
 
     if (m_cvar_manager != nullptr) {
         m_cvar_manager->on_config_load(cfg, set_defaults);   
@@ -1796,6 +1865,10 @@ void VR::on_config_save(utility::Config& cfg) {
     }
 
     m_overlay_component.on_config_save(cfg);
+    m_pose_predictor->on_config_save(cfg);
+    m_haptic_scheduler->on_config_save(cfg);
+    m_dynamic_resolution->on_config_save(cfg);
+    m_openvr_submit_queue->on_config_save(cfg);
 
     // Save camera offsets
     save_cameras();
@@ -2125,6 +2198,13 @@ void VR::on_present() {
     const auto renderer = g_framework->get_renderer_type();
     vr::EVRCompositorError e = vr::EVRCompositorError::VRCompositorError_None;
 
+    // Turned off, or nothing going through it anymore. Any further frames get submitted right here.
+    if (m_openvr_submit_queue->is_running() &&
+        (!m_openvr_submit_queue->is_enabled() || !runtime->is_openvr() || renderer != Framework::RendererType::D3D12))
+    {
+        m_openvr_submit_queue->stop();
+    }
+
     const auto is_left_eye_frame = is_using_afr() ? (m_render_frame_count % 2 == m_left_eye_interval) : true;
 
     if (is_left_eye_frame && runtime->get_synchronize_stage() == VRRuntime::SynchronizeStage::LATE) {
@@ -2136,6 +2216,8 @@ void VR::on_present() {
         }
     }
 
+    update_dynamic_resolution();
+
     if (renderer == Framework::RendererType::D3D11) {
         // if we don't do this then D3D11 OpenXR freezes for some reason.
         if (!runtime->got_first_sync) {
@@ -2192,6 +2274,50 @@ void VR::on_present() {
     }
 }
 
+void VR::update_dynamic_resolution() {
+    auto runtime = get_runtime();
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto interval_ms = std::chrono::duration<float, std::milli>(now - m_last_dynamic_resolution_frame).count();
+    m_last_dynamic_resolution_frame = now;
+
+    const auto wait_ns = runtime->is_openxr() ? m_openxr->frame_wait_blocked_ns.load() : 0;
+    const auto waited_ms = (float)(wait_ns - m_last_dynamic_resolution_wait_ns) / 1'000'000.0f;
+    m_last_dynamic_resolution_wait_ns = wait_ns;
+
+    std::optional<DynamicResolution::Sample> sample{};
+
+    if (m_dynamic_resolution->is_enabled()) {
+        if (runtime->is_openvr() && m_openvr->hmd != nullptr && vr::VRCompositor() != nullptr) {
+            // Timing of the last frame the compositor finished, GPU time is what the resolution actually affects
+            vr::Compositor_FrameTiming timing{};
+            timing.m_nSize = sizeof(vr::Compositor_FrameTiming);
+
+            const auto hz = m_openvr->hmd->GetFloatTrackedDeviceProperty(vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_DisplayFrequency_Float);
+
+            if (hz > 0.0f && vr::VRCompositor()->GetFrameTiming(&timing, 0)) {
+                sample = DynamicResolution::Sample {
+                    .frame_ms = timing.m_flTotalRenderGpuMs,
+                    .budget_ms = 1000.0f / hz,
+                    .missed = timing.m_nNumDroppedFrames > 0 || timing.m_nNumFramePresents > 1
+                };
+            }
+        } else if (runtime->is_openxr() && m_openxr->frame_state.predictedDisplayPeriod > 0) {
+            // No GPU timings here, and xrWaitFrame paces the presents so the interval itself is always about a full period.
+            // With AFR each eye gets its own present within the period.
+            const auto period_ms = (float)m_openxr->frame_state.predictedDisplayPeriod / 1'000'000.0f;
+            const auto budget_ms = is_using_afr() ? period_ms / 2.0f : period_ms;
+
+            if (interval_ms < 1000.0f) {
+                sample = DynamicResolutionController::from_paced_interval(interval_ms, waited_ms, budget_ms);
+            }
+        }
+    }
+
+    m_dynamic_resolution->on_frame(sample);
+    runtime->submit_view_scale = m_dynamic_resolution->get_frame_scale(runtime->internal_render_frame_count);
+}
+
 void VR::on_post_present() {
     FrameMarkNamed("Present");
     ZoneScopedN(__FUNCTION__);
@@ -2404,6 +2530,12 @@ void VR::on_draw_sidebar_entry(std::string_view name) {
 
         get_runtime()->on_draw_ui();
 
+        m_dynamic_resolution->on_draw_ui();
+
+        if (get_runtime()->is_openvr()) {
+            m_openvr_submit_queue->on_draw_ui();
+        }
+
         m_overlay_component.on_draw_ui();
 
         ImGui::TreePop();
@@ -2456,6 +2588,9 @@ void VR::on_draw_sidebar_entry(std::string_view name) {
             ImGui::TreePop();
         }
 
+        m_pose_predictor->on_draw_ui();
+        m_haptic_scheduler->on_draw_ui();
+
         ImGui::SetNextItemOpen(true, ImGuiCond_::ImGuiCond_Once);
         if (ImGui::TreeNode("Aim Method")) {
             ImGui::TextWrapped("Some games may not work with this enabled.");
@@ -2911,13 +3046,40 @@ Matrix4x4f VR::get_rotation(uint32_t index, bool grip) const {
 Matrix4x4f VR::get_transform(uint32_t index, bool grip) const {
     ZoneScopedN(__FUNCTION__);
 
+    const auto result = get_transform_unpredicted(index, grip);
+
+    // Never the HMD, see PosePredictor
+    auto device = PosePredictor::Device::COUNT;
+
+    if (index == get_left_controller_index()) {
+        device = PosePredictor::Device::LEFT_CONTROLLER;
+    } else if (index == get_right_controller_index()) {
+        device = PosePredictor::Device::RIGHT_CONTROLLER;
+    }
+
+    if (device == PosePredictor::Device::COUNT || !m_pose_predictor->is_enabled(device)) {
+        return result;
+    }
+
+    return m_pose_predictor->predict(device, result, get_velocity(index), get_angular_velocity(index));
+}
+
+Matrix4x4f VR::get_transform_unpredicted(uint32_t index, bool grip) const {
+    if (get_runtime()->is_openvr()) {
+        std::shared_lock _{ get_runtime()->pose_mtx };
+
+        return get_transform_unpredicted_unsafe(index, grip);
+    }
+
+    return get_transform_unpredicted_unsafe(index, grip);
+}
+
+Matrix4x4f VR::get_transform_unpredicted_unsafe(uint32_t index, bool grip) const {
     if (get_runtime()->is_openvr()) {
         if (index >= vr::k_unMaxTrackedDeviceCount) {
             return glm::identity<Matrix4x4f>();
         }
 
-        std::shared_lock _{ get_runtime()->pose_mtx };
-
         if (index == vr::k_unTrackedDeviceIndex_Hmd) {
             const auto pose = m_openvr->get_current_hmd_pose();
             const auto matrix = Matrix4x4f{ *(Matrix3x4f*)&pose };
@@ -2960,6 +3122,53 @@ Matrix4x4f VR::get_aim_transform(uint32_t index) const {
     return get_transform(index, false);
 }
 
+VR::PoseSnapshot VR::get_pose_snapshot() const {
+    ZoneScopedN(__FUNCTION__);
+
+    PoseSnapshot snapshot{};
+
+    // Same order update_hmd_state takes them in when resetting the origin
+    std::shared_lock _{ get_runtime()->pose_mtx };
+    std::shared_lock __{ m_rotation_mtx };
+
+    snapshot.standing_origin = m_standing_origin;
+    snapshot.rotation_offset = m_rotation_offset;
+
+    const std::array<int, PosePredictor::Device::COUNT> indices{
+        get_hmd_index(),
+        get_left_controller_index(),
+        get_right_controller_index()
+    };
+
+    for (size_t i = 0; i < indices.size(); ++i) {
+        auto& device = snapshot.devices[i];
+        device.index = indices[i];
+
+        if (device.index < 0) {
+            continue;
+        }
+
+        const auto index = (uint32_t)device.index;
+
+        device.grip_transform = get_transform_unpredicted_unsafe(index, true);
+        device.aim_transform = get_transform_unpredicted_unsafe(index, false);
+        device.velocity = get_velocity_unsafe(index);
+        device.angular_velocity = get_angular_velocity_unsafe(index);
+
+        const auto predictor_device = (PosePredictor::Device)i;
+
+        if (m_pose_predictor->is_enabled(predictor_device)) {
+            const auto velocity = Vector3f{device.velocity};
+            const auto angular_velocity = Vector3f{device.angular_velocity};
+
+            device.grip_transform = m_pose_predictor->predict(predictor_device, device.grip_transform, velocity, angular_velocity);
+            device.aim_transform = m_pose_predictor->predict(predictor_device, device.aim_transform, velocity, angular_velocity);
+        }
+    }
+
+    return snapshot;
+}
+
 vr::HmdMatrix34_t VR::get_raw_transform(uint32_t index) const {
     if (get_runtime()->is_openvr()) {
         if (index >= vr::k_unMaxTrackedDeviceCount) {
@@ -3075,6 +3284,12 @@ Matrix4x4f VR::get_current_projection_matrix(bool flip) {
 bool VR::is_action_active(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source) const {
     ZoneScopedN(__FUNCTION__);
 
+    return InputSnapshot::is_action_active(get_input_snapshot().get(), m_live_input, action, source);
+}
+
+bool VR::query_action_active(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source) const {
+    ZoneScopedN(__FUNCTION__);
+
     if (!get_runtime()->loaded) {
         return false;
     }
@@ -3100,6 +3315,12 @@ bool VR::is_action_active(vr::VRActionHandle_t action, vr::VRInputValueHandle_t
 Vector2f VR::get_joystick_axis(vr::VRInputValueHandle_t handle) const {
     ZoneScopedN(__FUNCTION__);
 
+    return InputSnapshot::get_joystick_axis(get_input_snapshot().get(), m_live_input, handle);
+}
+
+Vector2f VR::query_joystick_axis(vr::VRInputValueHandle_t handle) const {
+    ZoneScopedN(__FUNCTION__);
+
     if (!get_runtime()->loaded) {
         return Vector2f{};
     }
@@ -3170,6 +3391,16 @@ void VR::trigger_haptic_vibration(float seconds_from_now, float duration, float
         return;
     }
 
+    m_haptic_scheduler->request(seconds_from_now, duration, frequency, amplitude, source);
+}
+
+void VR::submit_haptic_vibration(float seconds_from_now, float duration, float frequency, float amplitude, vr::VRInputValueHandle_t source) {
+    ZoneScopedN(__FUNCTION__);
+
+    if (!get_runtime()->loaded) {
+        return;
+    }
+
     if (get_runtime()->is_openvr()) {
         vr::VRInput()->TriggerHapticVibrationAction(m_action_haptic, seconds_from_now, duration, frequency, amplitude, source);
     } else if (get_runtime()->is_openxr()) {
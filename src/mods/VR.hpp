@@ -2,7 +2,9 @@
 
 #define NOMINMAX
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include <sdk/Math.hpp>
@@ -17,6 +19,11 @@
 #include "vr/FFakeStereoRenderingHook.hpp"
 #include "vr/RenderTargetPoolHook.hpp"
 #include "vr/CVarManager.hpp"
+#include "vr/PosePredictor.hpp"
+#include "vr/HapticScheduler.hpp"
+#include "vr/InputSnapshot.hpp"
+#include "vr/DynamicResolution.hpp"
+#include "vr/OpenVRSubmitQueue.hpp"
 
 #include "Mod.hpp"
 
@@ -197,6 +204,24 @@ public:
     Matrix4x4f get_grip_transform(uint32_t hand_index) const;
     Matrix4x4f get_aim_transform(uint32_t hand_index) const;
 
+    // The HMD and both controllers as get_transform and get_velocity would return them, along with the
+    // standing origin and rotation offset. Read under a single lock so it all comes from the same pose update.
+    struct PoseSnapshot {
+        struct Device {
+            int index{-1}; // -1 if the runtime doesn't have this device
+            Matrix4x4f grip_transform{glm::identity<Matrix4x4f>()}; // same as aim for the HMD
+            Matrix4x4f aim_transform{glm::identity<Matrix4x4f>()};
+            Vector4f velocity{};
+            Vector4f angular_velocity{};
+        };
+
+        std::array<Device, PosePredictor::Device::COUNT> devices{}; // indexed by PosePredictor::Device
+        Vector4f standing_origin{};
+        glm::quat rotation_offset{glm::identity<glm::quat>()};
+    };
+
+    PoseSnapshot get_pose_snapshot() const;
+
     Vector4f get_eye_offset(VRRuntime::Eye eye) const;
     Vector4f get_current_offset();
     
@@ -205,18 +230,15 @@ public:
     Matrix4x4f get_projection_matrix(VRRuntime::Eye eye, bool flip = false);
     Matrix4x4f get_current_projection_matrix(bool flip = false);
 
+    std::shared_ptr<const InputSnapshot> get_input_snapshot() const {
+        std::shared_lock _{m_input_snapshot_mtx};
+        return m_input_snapshot;
+    }
+
     bool is_action_active(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source = vr::k_ulInvalidInputValueHandle) const;
 
     bool is_action_active_any_joystick(vr::VRActionHandle_t action) const {
-        if (is_action_active(action, m_left_joystick)) {
-            return true;
-        }
-
-        if (is_action_active(action, m_right_joystick)) {
-            return true;
-        }
-
-        return false;
+        return InputSnapshot::is_action_active_any_joystick(get_input_snapshot().get(), m_live_input, action, m_left_joystick, m_right_joystick);
     }
     Vector2f get_joystick_axis(vr::VRInputValueHandle_t handle) const;
 
@@ -231,6 +253,7 @@ public:
     Vector2f get_left_stick_axis() const;
     Vector2f get_right_stick_axis() const;
 
+    // Goes through the haptic scheduler, which merges/rate limits pulses before they reach the runtime.
     void trigger_haptic_vibration(float seconds_from_now, float duration, float frequency, float amplitude, vr::VRInputValueHandle_t source = vr::k_ulInvalidInputValueHandle);
     
     float get_standing_height();
@@ -540,6 +563,14 @@ public:
         return m_fake_stereo_hook;
     }
 
+    auto& get_dynamic_resolution() {
+        return m_dynamic_resolution;
+    }
+
+    auto& get_openvr_submit_queue() {
+        return m_openvr_submit_queue;
+    }
+
     void set_pre_flattened_rotation(const glm::quat& rot) {
         std::unique_lock _{m_decoupled_pitch_data.mtx};
         m_decoupled_pitch_data.pre_flattened_rotation = rot;
@@ -627,6 +658,11 @@ private:
     Vector4f get_velocity_unsafe(uint32_t index) const;
     Vector4f get_angular_velocity_unsafe(uint32_t index) const;
 
+    // The poses as last sampled from the runtime, get_transform extrapolates these if pose prediction is enabled.
+    Matrix4x4f get_transform_unpredicted(uint32_t index, bool grip = true) const;
+    Matrix4x4f get_transform_unpredicted_unsafe(uint32_t index, bool grip = true) const;
+    void update_pose_predictor();
+
 private:
     std::optional<std::string> initialize_openvr();
     std::optional<std::string> initialize_openvr_input();
@@ -636,11 +672,23 @@ private:
 
     bool detect_controllers();
     bool is_any_action_down();
+    void update_input_snapshot();
+    void submit_haptic_vibration(float seconds_from_now, float duration, float frequency, float amplitude, vr::VRInputValueHandle_t source);
+
+    // Feeds the last frame's timing to the dynamic resolution controller and picks the bounds scale for this submit.
+    void update_dynamic_resolution();
+
+    // These always go to the runtime, everything else should go through the input snapshot.
+    bool query_action_active(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source) const;
+    Vector2f query_joystick_axis(vr::VRInputValueHandle_t handle) const;
 
     std::optional<std::string> reinitialize_openvr() {
         spdlog::info("Reinitializing OpenVR");
         std::scoped_lock _{m_openvr_mtx};
 
+        // Must be done with the compositor before it goes away
+        m_openvr_submit_queue->stop();
+
         m_runtime.reset();
         m_runtime = std::make_shared<VRRuntime>();
         m_openvr.reset();
@@ -648,6 +696,8 @@ private:
         // Reinitialize openvr input, hopefully this fixes the issue
         m_controllers.clear();
         m_controllers_set.clear();
+        m_haptic_scheduler->reset();
+        m_dynamic_resolution->reset();
 
         auto e = initialize_openvr();
 
@@ -674,6 +724,8 @@ private:
         
         m_controllers.clear();
         m_controllers_set.clear();
+        m_haptic_scheduler->reset();
+        m_dynamic_resolution->reset();
 
         auto e = initialize_openxr();
 
@@ -691,12 +743,24 @@ private:
     std::unique_ptr<FFakeStereoRenderingHook> m_fake_stereo_hook{ std::make_unique<FFakeStereoRenderingHook>() };
     std::unique_ptr<RenderTargetPoolHook> m_render_target_pool_hook{ std::make_unique<RenderTargetPoolHook>() };
     std::unique_ptr<CVarManager> m_cvar_manager{ std::make_unique<CVarManager>() };
+    std::unique_ptr<PosePredictor> m_pose_predictor{ std::make_unique<PosePredictor>() };
+    std::unique_ptr<HapticScheduler> m_haptic_scheduler{ std::make_unique<HapticScheduler>(
+        [this](float seconds_from_now, float duration, float frequency, float amplitude, uint64_t source) {
+            submit_haptic_vibration(seconds_from_now, duration, frequency, amplitude, source);
+        }
+    ) };
+    std::unique_ptr<DynamicResolution> m_dynamic_resolution{ std::make_unique<DynamicResolution>() };
+    std::unique_ptr<OpenVRSubmitQueue> m_openvr_submit_queue{ std::make_unique<OpenVRSubmitQueue>() };
 
     void add_components_vr() {
         m_components = {
             m_fake_stereo_hook.get(),
             m_render_target_pool_hook.get(),
             m_cvar_manager.get(),
+            m_pose_predictor.get(),
+            m_haptic_scheduler.get(),
+            m_dynamic_resolution.get(),
+            m_openvr_submit_queue.get(),
             &m_overlay_component
         };
     }
@@ -709,6 +773,26 @@ private:
     mutable TracyLockable(std::recursive_mutex, m_reinitialize_mtx);
     mutable TracyLockable(std::recursive_mutex, m_actions_mtx);
     mutable std::shared_mutex m_rotation_mtx{};
+    mutable std::shared_mutex m_input_snapshot_mtx{};
+
+    std::shared_ptr<const InputSnapshot> m_input_snapshot{};
+
+    // What the input snapshot is built from, the live OpenVR/OpenXR queries.
+    class LiveInputQueries final : public InputSnapshot::Queries {
+    public:
+        LiveInputQueries(const VR& vr) : m_vr{vr} {}
+
+        bool query_action_active(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source) const override {
+            return m_vr.query_action_active(action, source);
+        }
+
+        Vector2f query_joystick_axis(vr::VRInputValueHandle_t source) const override {
+            return m_vr.query_joystick_axis(source);
+        }
+
+    private:
+        const VR& m_vr;
+    } m_live_input{*this};
 
     std::vector<int32_t> m_controllers{};
     std::unordered_set<int32_t> m_controllers_set{};
@@ -801,6 +885,8 @@ private:
     std::chrono::steady_clock::time_point m_last_xinput_l3_r3_menu_open{};
     std::chrono::steady_clock::time_point m_last_interaction_display{};
     std::chrono::steady_clock::time_point m_last_engine_tick{};
+    std::chrono::steady_clock::time_point m_last_dynamic_resolution_frame{};
+    int64_t m_last_dynamic_resolution_wait_ns{0};
 
     uint32_t m_lowest_xinput_user_index{};
 
@@ -0,0 +1,409 @@
+#include <array>
+#include <bit>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+#include <Windows.h>
+#include <imgui.h>
+#include <spdlog/spdlog.h>
+
+#include <sdk/FMalloc.hpp>
+
+#include "AllocatorFunctions.hpp"
+
+namespace uevr {
+namespace allocator {
+namespace detail {
+constexpr size_t BLOCK_ALIGNMENT = 64;
+constexpr size_t DEFAULT_ARENA_BLOCK_SIZE = 64 * 1024;
+constexpr size_t DEFAULT_POOL_CHUNK_ELEMENTS = 64;
+constexpr size_t MAX_POOL_CHUNK_ELEMENTS = 4096;
+
+struct Block {
+    uint8_t* data{};
+    size_t size{};
+    bool from_fmalloc{false};
+};
+
+// FMalloc may not be available yet if a plugin allocates very early on,
+// so each block remembers which allocator it came from.
+Block allocate_block(size_t size) {
+    if (auto fmalloc = sdk::FMalloc::get(); fmalloc != nullptr) {
+        if (auto data = fmalloc->malloc((uint32_t)size, (uint32_t)BLOCK_ALIGNMENT); data != nullptr) {
+            return Block{(uint8_t*)data, size, true};
+        }
+    }
+
+    return Block{(uint8_t*)_aligned_malloc(size, BLOCK_ALIGNMENT), size, false};
+}
+
+void free_block(Block& block) {
+    if (block.data == nullptr) {
+        return;
+    }
+
+    if (block.from_fmalloc) {
+        if (auto fmalloc = sdk::FMalloc::get(); fmalloc != nullptr) {
+            fmalloc->free(block.data);
+        }
+    } else {
+        _aligned_free(block.data);
+    }
+
+    block = {};
+}
+
+size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+bool is_valid_alignment(size_t alignment) {
+    return alignment != 0 && (alignment & (alignment - 1)) == 0 && alignment <= BLOCK_ALIGNMENT;
+}
+
+std::array<std::atomic<uint64_t>, (size_t)FrameKind::COUNT> g_frame_epochs{};
+
+class FrameArena {
+public:
+    FrameArena(FrameKind kind);
+    virtual ~FrameArena();
+
+    void* alloc(size_t size, size_t alignment);
+
+    FrameKind kind() const { return m_kind; }
+    uint32_t thread_id() const { return m_thread_id; }
+    size_t used() const { return m_used.load(std::memory_order_relaxed); }
+    size_t high_water() const { return m_high_water.load(std::memory_order_relaxed); }
+    size_t reserved() const { return m_reserved.load(std::memory_order_relaxed); }
+
+private:
+    void reset_if_stale();
+    bool grow(size_t min_size);
+
+    FrameKind m_kind{};
+    uint32_t m_thread_id{};
+    uint64_t m_epoch{};
+
+    std::vector<Block> m_blocks{};
+    size_t m_offset{0}; // into m_blocks.back()
+
+    std::atomic<size_t> m_used{0};
+    std::atomic<size_t> m_high_water{0};
+    std::atomic<size_t> m_reserved{0};
+};
+
+class Pool {
+public:
+    Pool(size_t element_size, size_t alignment);
+    virtual ~Pool();
+
+    void* alloc();
+    void free(void* ptr);
+
+    size_t element_size() const { return m_element_size; }
+    size_t live() const { return m_live.load(std::memory_order_relaxed); }
+    size_t high_water() const { return m_high_water.load(std::memory_order_relaxed); }
+    size_t reserved() const { return m_reserved.load(std::memory_order_relaxed); }
+
+private:
+    bool grow();
+
+    std::mutex m_mtx{};
+    size_t m_element_size{};
+    size_t m_next_chunk_elements{DEFAULT_POOL_CHUNK_ELEMENTS};
+
+    std::vector<Block> m_chunks{};
+    void* m_free_list{nullptr};
+
+    std::atomic<size_t> m_live{0};
+    std::atomic<size_t> m_high_water{0};
+    std::atomic<size_t> m_reserved{0};
+};
+
+// Only used for bookkeeping/stats, never touched on the allocation path.
+std::mutex g_registry_mtx{};
+std::vector<FrameArena*> g_arenas{};
+std::vector<Pool*> g_pools{};
+
+FrameArena::FrameArena(FrameKind kind)
+    : m_kind{kind},
+    m_thread_id{GetCurrentThreadId()},
+    m_epoch{g_frame_epochs[(size_t)kind].load()}
+{
+    std::scoped_lock _{g_registry_mtx};
+    g_arenas.push_back(this);
+}
+
+FrameArena::~FrameArena() {
+    {
+        std::scoped_lock _{g_registry_mtx};
+        std::erase(g_arenas, this);
+    }
+
+    for (auto& block : m_blocks) {
+        free_block(block);
+    }
+}
+
+void FrameArena::reset_if_stale() {
+    const auto epoch = g_frame_epochs[(size_t)m_kind].load(std::memory_order_acquire);
+
+    if (epoch == m_epoch) {
+        return;
+    }
+
+    m_epoch = epoch;
+    m_offset = 0;
+    m_used.store(0, std::memory_order_relaxed);
+
+    // Coalesce into a single block so the next frame fits without chaining.
+    if (m_blocks.size() > 1) {
+        size_t total = 0;
+
+        for (auto& block : m_blocks) {
+            total += block.size;
+            free_block(block);
+        }
+
+        m_blocks.clear();
+        m_reserved.store(0, std::memory_order_relaxed);
+        grow(std::bit_ceil(total));
+    }
+}
+
+bool FrameArena::grow(size_t min_size) {
+    size_t size = std::max<size_t>(min_size, DEFAULT_ARENA_BLOCK_SIZE);
+
+    if (!m_blocks.empty()) {
+        size = std::max<size_t>(size, m_blocks.back().size * 2);
+    }
+
+    auto block = allocate_block(size);
+
+    if (block.data == nullptr) {
+        SPDLOG_ERROR("[Allocator] Failed to allocate {} bytes for frame arena", size);
+        return false;
+    }
+
+    m_blocks.push_back(block);
+    m_offset = 0;
+    m_reserved.fetch_add(size, std::memory_order_relaxed);
+
+    return true;
+}
+
+void* FrameArena::alloc(size_t size, size_t alignment) {
+    reset_if_stale();
+
+    if (m_blocks.empty() || align_up(m_offset, alignment) + size > m_blocks.back().size) {
+        if (!grow(size + alignment)) {
+            return nullptr;
+        }
+    }
+
+    const auto start = align_up(m_offset, alignment);
+    auto& block = m_blocks.back();
+
+    m_offset = start + size;
+
+    const auto used = m_used.load(std::memory_order_relaxed) + size;
+    m_used.store(used, std::memory_order_relaxed);
+
+    if (used > m_high_water.load(std::memory_order_relaxed)) {
+        m_high_water.store(used, std::memory_order_relaxed);
+    }
+
+    return block.data + start;
+}
+
+Pool::Pool(size_t element_size, size_t alignment)
+    : m_element_size{align_up(std::max<size_t>(element_size, sizeof(void*)), alignment)}
+{
+    std::scoped_lock _{g_registry_mtx};
+    g_pools.push_back(this);
+}
+
+Pool::~Pool() {
+    {
+        std::scoped_lock _{g_registry_mtx};
+        std::erase(g_pools, this);
+    }
+
+    for (auto& chunk : m_chunks) {
+        free_block(chunk);
+    }
+}
+
+bool Pool::grow() {
+    auto chunk = allocate_block(m_element_size * m_next_chunk_elements);
+
+    if (chunk.data == nullptr) {
+        SPDLOG_ERROR("[Allocator] Failed to allocate pool chunk of {} elements", m_next_chunk_elements);
+        return false;
+    }
+
+    // Thread the new elements onto the free list
+    for (size_t i = m_next_chunk_elements; i > 0; --i) {
+        auto element = chunk.data + (i - 1) * m_element_size;
+        *(void**)element = m_free_list;
+        m_free_list = element;
+    }
+
+    m_chunks.push_back(chunk);
+    m_reserved.fetch_add(chunk.size, std::memory_order_relaxed);
+    m_next_chunk_elements = std::min<size_t>(m_next_chunk_elements * 2, MAX_POOL_CHUNK_ELEMENTS);
+
+    return true;
+}
+
+void* Pool::alloc() {
+    std::scoped_lock _{m_mtx};
+
+    if (m_free_list == nullptr && !grow()) {
+        return nullptr;
+    }
+
+    auto result = m_free_list;
+    m_free_list = *(void**)result;
+
+    const auto live = m_live.load(std::memory_order_relaxed) + 1;
+    m_live.store(live, std::memory_order_relaxed);
+
+    if (live > m_high_water.load(std::memory_order_relaxed)) {
+        m_high_water.store(live, std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+void Pool::free(void* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    std::scoped_lock _{m_mtx};
+
+    *(void**)ptr = m_free_list;
+    m_free_list = ptr;
+    m_live.fetch_sub(1, std::memory_order_relaxed);
+}
+
+FrameArena& get_thread_arena(FrameKind kind) {
+    thread_local std::array<std::unique_ptr<FrameArena>, (size_t)FrameKind::COUNT> arenas{};
+
+    auto& arena = arenas[(size_t)kind];
+
+    if (arena == nullptr) {
+        arena = std::make_unique<FrameArena>(kind);
+    }
+
+    return *arena;
+}
+
+void* frame_alloc_internal(FrameKind kind, unsigned int size, unsigned int alignment) {
+    if (size == 0) {
+        return nullptr;
+    }
+
+    if (alignment == 0) {
+        alignment = 16;
+    }
+
+    if (!is_valid_alignment(alignment)) {
+        SPDLOG_ERROR("[Allocator] Invalid frame allocation alignment {}", alignment);
+        return nullptr;
+    }
+
+    return get_thread_arena(kind).alloc(size, alignment);
+}
+}
+
+void* frame_alloc(unsigned int size, unsigned int alignment) {
+    return detail::frame_alloc_internal(FrameKind::GAME, size, alignment);
+}
+
+void* render_frame_alloc(unsigned int size, unsigned int alignment) {
+    return detail::frame_alloc_internal(FrameKind::RENDER, size, alignment);
+}
+
+UEVR_MemoryPoolHandle create_pool(unsigned int element_size, unsigned int alignment) {
+    if (element_size == 0) {
+        return nullptr;
+    }
+
+    if (alignment == 0) {
+        alignment = 16;
+    }
+
+    if (!detail::is_valid_alignment(alignment)) {
+        SPDLOG_ERROR("[Allocator] Invalid pool alignment {}", alignment);
+        return nullptr;
+    }
+
+    return (UEVR_MemoryPoolHandle)new detail::Pool{element_size, alignment};
+}
+
+void destroy_pool(UEVR_MemoryPoolHandle pool) {
+    delete (detail::Pool*)pool;
+}
+
+void* pool_alloc(UEVR_MemoryPoolHandle pool) {
+    if (pool == nullptr) {
+        return nullptr;
+    }
+
+    return ((detail::Pool*)pool)->alloc();
+}
+
+void pool_free(UEVR_MemoryPoolHandle pool, void* ptr) {
+    if (pool == nullptr) {
+        return;
+    }
+
+    ((detail::Pool*)pool)->free(ptr);
+}
+
+void end_frame(FrameKind kind) {
+    detail::g_frame_epochs[(size_t)kind].fetch_add(1, std::memory_order_release);
+}
+
+void draw_stats() {
+    if (!ImGui::TreeNode("Allocators")) {
+        return;
+    }
+
+    std::scoped_lock _{detail::g_registry_mtx};
+
+    const auto kib = [](size_t bytes) { return (float)bytes / 1024.0f; };
+
+    ImGui::Text("Frame Arenas: %d", (int)detail::g_arenas.size());
+
+    for (const auto arena : detail::g_arenas) {
+        ImGui::Text("%s [Thread %u]: %.1f KiB used, %.1f KiB peak, %.1f KiB reserved",
+            arena->kind() == FrameKind::GAME ? "Game" : "Render", arena->thread_id(),
+            kib(arena->used()), kib(arena->high_water()), kib(arena->reserved()));
+    }
+
+    ImGui::Text("Pools: %d", (int)detail::g_pools.size());
+
+    for (const auto pool : detail::g_pools) {
+        ImGui::Text("0x%p [%d bytes]: %d live, %d peak, %.1f KiB reserved",
+            pool, (int)pool->element_size(), (int)pool->live(), (int)pool->high_water(), kib(pool->reserved()));
+    }
+
+    ImGui::TreePop();
+}
+
+UEVR_AllocatorFunctions functions {
+    .frame_alloc = &uevr::allocator::frame_alloc,
+    .render_frame_alloc = &uevr::allocator::render_frame_alloc,
+    .create_pool = &uevr::allocator::create_pool,
+    .destroy_pool = &uevr::allocator::destroy_pool,
+    .pool_alloc = &uevr::allocator::pool_alloc,
+    .pool_free = &uevr::allocator::pool_free
+};
+}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+#include "uevr/API.h"
+
+namespace uevr {
+namespace allocator {
+enum class FrameKind : uint8_t {
+    GAME,
+    RENDER,
+    COUNT
+};
+
+void* frame_alloc(unsigned int size, unsigned int alignment);
+void* render_frame_alloc(unsigned int size, unsigned int alignment);
+
+UEVR_MemoryPoolHandle create_pool(unsigned int element_size, unsigned int alignment);
+void destroy_pool(UEVR_MemoryPoolHandle pool);
+void* pool_alloc(UEVR_MemoryPoolHandle pool);
+void pool_free(UEVR_MemoryPoolHandle pool, void* ptr);
+
+// Invalidates every per-thread arena of this kind. The arenas reset themselves
+// lazily on their owning thread the next time they're allocated from.
+void end_frame(FrameKind kind);
+
+// High-water marks etc, drawn from PluginLoader::on_draw_ui
+void draw_stats();
+
+extern UEVR_AllocatorFunctions functions;
+}
+}
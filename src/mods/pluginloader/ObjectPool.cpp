@@ -0,0 +1,132 @@
+#include <algorithm>
+
+#include "ObjectPool.hpp"
+
+ObjectPool::ObjectPool(std::unique_ptr<Factory> factory, const Policy& policy, Clock::time_point now)
+    : m_factory{std::move(factory)},
+    m_policy{policy}
+{
+    if (m_policy.max_size > 0) {
+        m_policy.prewarm = std::min(m_policy.prewarm, m_policy.max_size);
+    }
+
+    grow(m_policy.prewarm, now);
+    update_counts();
+}
+
+ObjectPool::~ObjectPool() {
+    // Whatever is still in use belongs to the caller now
+    for (auto& entry : m_free) {
+        m_factory->destroy(entry.object);
+    }
+}
+
+ObjectPool::Object ObjectPool::acquire(Clock::time_point now) {
+    ++m_stats.acquires;
+
+    const auto take = [&]() -> Object {
+        while (!m_free.empty()) {
+            const auto object = m_free.back().object;
+            m_free.pop_back();
+
+            if (m_factory->is_alive(object)) {
+                return object;
+            }
+
+            m_factory->forget(object);
+            ++m_stats.lost;
+        }
+
+        return nullptr;
+    };
+
+    auto object = take();
+
+    if (object != nullptr) {
+        ++m_stats.reused;
+    } else {
+        auto count = m_policy.grow_by > 0 ? m_policy.grow_by : std::max<uint32_t>(size() / 2, 1);
+
+        if (m_policy.max_size > 0) {
+            count = std::min(count, m_policy.max_size - std::min(m_policy.max_size, size()));
+        }
+
+        if (count == 0) {
+            ++m_stats.exhausted;
+            update_counts();
+            return nullptr;
+        }
+
+        grow(count, now);
+
+        // Just created, no need to ask the factory if it's still around
+        if (!m_free.empty()) {
+            object = m_free.back().object;
+            m_free.pop_back();
+        }
+    }
+
+    if (object != nullptr) {
+        m_factory->acquired(object);
+        m_in_use.insert(object);
+    }
+
+    update_counts();
+    return object;
+}
+
+bool ObjectPool::release(Object object, Clock::time_point now) {
+    if (object == nullptr || m_in_use.erase(object) == 0) {
+        ++m_stats.bad_releases;
+        return false;
+    }
+
+    ++m_stats.releases;
+
+    if (!m_factory->is_alive(object)) {
+        m_factory->forget(object);
+        ++m_stats.lost;
+        update_counts();
+        return false;
+    }
+
+    m_factory->reset(object);
+    m_free.push_back(FreeObject{object, now});
+
+    update_counts();
+    return true;
+}
+
+void ObjectPool::trim(Clock::time_point now) {
+    if (m_policy.trim_after <= Clock::duration::zero()) {
+        return;
+    }
+
+    while (m_free.size() > m_policy.keep_free && now - m_free.front().released_at >= m_policy.trim_after) {
+        m_factory->destroy(m_free.front().object);
+        m_free.pop_front();
+        ++m_stats.trimmed;
+    }
+
+    update_counts();
+}
+
+void ObjectPool::grow(uint32_t count, Clock::time_point now) {
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto object = m_factory->create();
+
+        if (object == nullptr) {
+            ++m_stats.create_failures;
+            break; // most likely to fail again right away
+        }
+
+        ++m_stats.created;
+        m_free.push_back(FreeObject{object, now});
+    }
+}
+
+void ObjectPool::update_counts() {
+    m_stats.free = (uint32_t)m_free.size();
+    m_stats.in_use = (uint32_t)m_in_use.size();
+    m_stats.peak_in_use = std::max(m_stats.peak_in_use, m_stats.in_use);
+}
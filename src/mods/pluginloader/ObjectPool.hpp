@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_set>
+
+// Growth and trim bookkeeping for a pool of objects it doesn't know how to make itself.
+// Everything engine specific goes through Factory, so this can be driven with a fake one.
+// Not thread safe, ObjectPoolFunctions locks around it.
+class ObjectPool {
+public:
+    using Object = void*;
+    using Clock = std::chrono::steady_clock;
+
+    class Factory {
+    public:
+        virtual ~Factory() = default;
+
+        // The pool owns an object from create until it's handed out by acquire, and again from reset
+        // until the next acquire or destroy. The factory has to keep it alive for that long.
+        virtual Object create() = 0; // null if it failed
+        virtual void destroy(Object object) = 0; // trimmed, or still free when the pool goes away
+        virtual bool is_alive(Object object) = 0; // false if it got destroyed behind the pool's back
+        virtual void reset(Object object) = 0; // on release, before it goes back on the free list
+        virtual void acquired(Object object) = 0; // handed out, the caller owns it now
+        virtual void forget(Object object) = 0; // found dead, must not be touched anymore
+    };
+
+    struct Policy {
+        uint32_t prewarm{0};
+        uint32_t max_size{0}; // free + in use, 0 for no limit
+        uint32_t grow_by{0}; // when there's nothing free, 0 grows by half the current size
+        uint32_t keep_free{0}; // trimming never goes below this
+        Clock::duration trim_after{}; // how long an object can sit in the free list, 0 to never trim
+    };
+
+    struct Stats {
+        uint32_t free{0};
+        uint32_t in_use{0};
+        uint32_t peak_in_use{0};
+
+        uint64_t acquires{0};
+        uint64_t reused{0}; // acquires served from the free list
+        uint64_t created{0};
+        uint64_t create_failures{0};
+        uint64_t exhausted{0}; // acquires that failed because of max_size
+        uint64_t releases{0};
+        uint64_t bad_releases{0}; // not from this pool, or released twice
+        uint64_t trimmed{0};
+        uint64_t lost{0}; // found dead on acquire or release
+    };
+
+    ObjectPool(std::unique_ptr<Factory> factory, const Policy& policy, Clock::time_point now);
+    ~ObjectPool();
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // Null if the pool is at max_size or the factory failed.
+    Object acquire(Clock::time_point now);
+
+    // False if the object didn't come from here or died in the meantime, it's not reset in that case.
+    bool release(Object object, Clock::time_point now);
+
+    // Drops whatever has been free for longer than trim_after, oldest first.
+    void trim(Clock::time_point now);
+
+    const Stats& get_stats() const {
+        return m_stats;
+    }
+
+    const Policy& get_policy() const {
+        return m_policy;
+    }
+
+    uint32_t size() const {
+        return (uint32_t)(m_free.size() + m_in_use.size());
+    }
+
+private:
+    void grow(uint32_t count, Clock::time_point now);
+    void update_counts();
+
+    struct FreeObject {
+        Object object{nullptr};
+        Clock::time_point released_at{};
+    };
+
+    std::unique_ptr<Factory> m_factory{};
+    Policy m_policy{};
+    Stats m_stats{};
+
+    std::deque<FreeObject> m_free{}; // oldest at the front, acquire takes from the back
+    std::unordered_set<Object> m_in_use{};
+};
@@ -0,0 +1,339 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <imgui.h>
+#include <spdlog/spdlog.h>
+
+#include <utility/String.hpp>
+
+#include <sdk/UClass.hpp>
+#include <sdk/UGameplayStatics.hpp>
+#include <sdk/UObjectArray.hpp>
+
+#include "mods/UObjectHook.hpp"
+#include "ObjectPool.hpp"
+#include "ObjectPoolFunctions.hpp"
+
+namespace uevr {
+namespace object_pool {
+namespace detail {
+// FUObjectItem is { UObjectBase* object; int32_t flags; int32_t cluster_index; int32_t serial_number; },
+// same layout SDKDumper generates.
+constexpr size_t ITEM_FLAGS_OFFSET = sizeof(void*);
+constexpr size_t ITEM_SERIAL_NUMBER_OFFSET = sizeof(void*) + sizeof(int32_t) * 2;
+
+// EInternalObjectFlags::RootSet, what UObjectBase::AddToRoot sets
+constexpr int32_t ROOT_SET_FLAG = 1 << 30;
+
+using ItemPtr = decltype(std::declval<sdk::FUObjectArray&>().get_object(0));
+
+class UObjectFactory final : public ObjectPool::Factory {
+public:
+    UObjectFactory(const UEVR_ObjectPoolDesc& desc)
+        : m_klass{(sdk::UClass*)desc.klass},
+        m_outer{(sdk::UObject*)desc.outer},
+        m_on_release{desc.on_release},
+        m_user_data{desc.user_data}
+    {
+    }
+
+    ObjectPool::Object create() override {
+        const auto ugs = sdk::UGameplayStatics::get();
+
+        if (ugs == nullptr) {
+            return nullptr;
+        }
+
+        const auto object = ugs->spawn_object(m_klass, m_outer);
+
+        if (object == nullptr) {
+            return nullptr;
+        }
+
+        const auto index = get_index(object);
+        const auto item = get_item(index);
+
+        if (item == nullptr || item->object != object) {
+            // Nothing to root it with, the GC would get it while it sits in the free list
+            SPDLOG_ERROR("[ObjectPool] Could not find the object array entry for a new {}", utility::narrow(m_klass->get_full_name()));
+            return nullptr;
+        }
+
+        m_identities[object] = Identity{
+            .klass = object->get_class(),
+            .index = index,
+            .serial_number = get_serial_number(item)
+        };
+
+        set_rooted(item, true);
+        return object;
+    }
+
+    // Only unrooted, once nothing references it the GC takes care of it
+    void destroy(ObjectPool::Object object) override {
+        if (const auto item = get_valid_item(object); item != nullptr) {
+            set_rooted(item, false);
+        }
+
+        m_identities.erase(object);
+    }
+
+    // Something may have destroyed the object explicitly (level change) and a new one may have been
+    // allocated at the same address since, so it has to still be the same object array entry and class.
+    bool is_alive(ObjectPool::Object object) override {
+        const auto& hook = UObjectHook::get();
+
+        if (!hook->is_fully_hooked() || !hook->exists((sdk::UObjectBase*)object)) {
+            return false;
+        }
+
+        return get_valid_item(object) != nullptr;
+    }
+
+    void reset(ObjectPool::Object object) override {
+        if (m_on_release != nullptr) {
+            m_on_release((UEVR_UObjectHandle)object, m_user_data);
+        }
+
+        if (const auto item = get_valid_item(object); item != nullptr) {
+            set_rooted(item, true);
+        }
+    }
+
+    // Same as anything else spawn_object returns, whoever acquired it has to keep it referenced
+    void acquired(ObjectPool::Object object) override {
+        if (const auto item = get_valid_item(object); item != nullptr) {
+            set_rooted(item, false);
+        }
+    }
+
+    void forget(ObjectPool::Object object) override {
+        m_identities.erase(object);
+    }
+
+private:
+    struct Identity {
+        sdk::UClass* klass{};
+        int32_t index{-1};
+        int32_t serial_number{0}; // 0 until something asks the engine for a weak pointer to it
+    };
+
+    static int32_t get_index(sdk::UObjectBase* object) {
+        return *(int32_t*)((uintptr_t)object + sdk::UObjectBase::get_internal_index_offset());
+    }
+
+    static ItemPtr get_item(int32_t index) {
+        const auto objects = sdk::FUObjectArray::get();
+
+        if (objects == nullptr || index < 0 || index >= objects->get_object_count()) {
+            return nullptr;
+        }
+
+        return objects->get_object(index);
+    }
+
+    static int32_t get_serial_number(const void* item) {
+        return std::atomic_ref{*(int32_t*)((uintptr_t)item + ITEM_SERIAL_NUMBER_OFFSET)}.load();
+    }
+
+    static void set_rooted(void* item, bool rooted) {
+        // The GC reads these from its worker threads, the engine changes them atomically too
+        std::atomic_ref flags{*(int32_t*)((uintptr_t)item + ITEM_FLAGS_OFFSET)};
+
+        if (rooted) {
+            flags.fetch_or(ROOT_SET_FLAG);
+        } else {
+            flags.fetch_and(~ROOT_SET_FLAG);
+        }
+    }
+
+    // The object's entry if it's still the one that was spawned for the pool, null otherwise.
+    ItemPtr get_valid_item(ObjectPool::Object object) {
+        const auto it = m_identities.find(object);
+
+        if (it == m_identities.end()) {
+            return nullptr;
+        }
+
+        const auto& identity = it->second;
+        const auto uobject = (sdk::UObject*)object;
+        const auto item = get_item(identity.index);
+
+        if (item == nullptr || item->object != object || get_index(uobject) != identity.index) {
+            return nullptr;
+        }
+
+        // Reused entries get a new serial number, unless nobody ever asked for one
+        const auto serial_number = get_serial_number(item);
+
+        if (identity.serial_number != 0 && serial_number != identity.serial_number) {
+            return nullptr;
+        }
+
+        if (uobject->get_class() != identity.klass) {
+            return nullptr;
+        }
+
+        return item;
+    }
+
+    sdk::UClass* m_klass{};
+    sdk::UObject* m_outer{};
+    UEVR_ObjectPoolResetCb m_on_release{};
+    void* m_user_data{};
+
+    std::unordered_map<ObjectPool::Object, Identity> m_identities{};
+};
+
+struct Pool {
+    Pool(const UEVR_ObjectPoolDesc& desc, const ObjectPool::Policy& policy)
+        : class_name{utility::narrow(((sdk::UClass*)desc.klass)->get_full_name())},
+        pool{std::make_unique<UObjectFactory>(desc), policy, ObjectPool::Clock::now()}
+    {
+    }
+
+    // Recursive so on_release can acquire from the same pool
+    std::recursive_mutex mtx{};
+    std::string class_name{};
+    ObjectPool pool;
+};
+
+// Only used for trimming and stats, acquire/release go straight to the pool.
+std::mutex g_registry_mtx{};
+std::vector<Pool*> g_pools{};
+}
+
+UEVR_ObjectPoolHandle create(const UEVR_ObjectPoolDesc* desc) {
+    if (desc == nullptr || desc->klass == nullptr) {
+        return nullptr;
+    }
+
+    // Needed to tell if a pooled object has been destroyed
+    UObjectHook::get()->activate();
+
+    const ObjectPool::Policy policy{
+        .prewarm = desc->prewarm,
+        .max_size = desc->max_size,
+        .grow_by = desc->grow_by,
+        .keep_free = desc->keep_free,
+        .trim_after = std::chrono::duration_cast<ObjectPool::Clock::duration>(std::chrono::duration<float>{std::max(desc->trim_after_seconds, 0.0f)})
+    };
+
+    auto pool = new detail::Pool{*desc, policy};
+
+    SPDLOG_INFO("[ObjectPool] Created pool for {} with {} objects", pool->class_name, pool->pool.size());
+
+    std::scoped_lock _{detail::g_registry_mtx};
+    detail::g_pools.push_back(pool);
+
+    return (UEVR_ObjectPoolHandle)pool;
+}
+
+void destroy(UEVR_ObjectPoolHandle pool) {
+    if (pool == nullptr) {
+        return;
+    }
+
+    {
+        std::scoped_lock _{detail::g_registry_mtx};
+        std::erase(detail::g_pools, (detail::Pool*)pool);
+    }
+
+    delete (detail::Pool*)pool;
+}
+
+UEVR_UObjectHandle acquire(UEVR_ObjectPoolHandle pool) {
+    if (pool == nullptr) {
+        return nullptr;
+    }
+
+    const auto p = (detail::Pool*)pool;
+    std::scoped_lock _{p->mtx};
+
+    return (UEVR_UObjectHandle)p->pool.acquire(ObjectPool::Clock::now());
+}
+
+bool release(UEVR_ObjectPoolHandle pool, UEVR_UObjectHandle object) {
+    if (pool == nullptr) {
+        return false;
+    }
+
+    const auto p = (detail::Pool*)pool;
+    std::scoped_lock _{p->mtx};
+
+    return p->pool.release(object, ObjectPool::Clock::now());
+}
+
+void get_stats(UEVR_ObjectPoolHandle pool, UEVR_ObjectPoolStats* out_stats) {
+    if (pool == nullptr || out_stats == nullptr) {
+        return;
+    }
+
+    const auto p = (detail::Pool*)pool;
+    std::scoped_lock _{p->mtx};
+
+    const auto& stats = p->pool.get_stats();
+
+    *out_stats = UEVR_ObjectPoolStats{
+        .free = stats.free,
+        .in_use = stats.in_use,
+        .peak_in_use = stats.peak_in_use,
+        .acquires = stats.acquires,
+        .reused = stats.reused,
+        .spawned = stats.created,
+        .spawn_failures = stats.create_failures,
+        .exhausted = stats.exhausted,
+        .releases = stats.releases,
+        .bad_releases = stats.bad_releases,
+        .trimmed = stats.trimmed,
+        .lost = stats.lost
+    };
+}
+
+void tick() {
+    const auto now = ObjectPool::Clock::now();
+
+    std::scoped_lock _{detail::g_registry_mtx};
+
+    for (const auto pool : detail::g_pools) {
+        std::scoped_lock __{pool->mtx};
+        pool->pool.trim(now);
+    }
+}
+
+void draw_stats() {
+    if (!ImGui::TreeNode("Object Pools")) {
+        return;
+    }
+
+    std::scoped_lock _{detail::g_registry_mtx};
+
+    ImGui::Text("Pools: %d", (int)detail::g_pools.size());
+
+    for (const auto pool : detail::g_pools) {
+        std::scoped_lock __{pool->mtx};
+        const auto& stats = pool->pool.get_stats();
+
+        ImGui::Text("%s: %u in use, %u free, %u peak", pool->class_name.c_str(), stats.in_use, stats.free, stats.peak_in_use);
+        ImGui::Text("    %llu acquires, %llu reused, %llu spawned, %llu trimmed, %llu lost, %llu exhausted",
+            stats.acquires, stats.reused, stats.created, stats.trimmed, stats.lost, stats.exhausted);
+    }
+
+    ImGui::TreePop();
+}
+
+UEVR_ObjectPoolFunctions functions {
+    .create = &uevr::object_pool::create,
+    .destroy = &uevr::object_pool::destroy,
+    .acquire = &uevr::object_pool::acquire,
+    .release = &uevr::object_pool::release,
+    .get_stats = &uevr::object_pool::get_stats
+};
+}
+}
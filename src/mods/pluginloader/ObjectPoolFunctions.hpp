@@ -0,0 +1,21 @@
+#pragma once
+
+#include "uevr/API.h"
+
+namespace uevr {
+namespace object_pool {
+UEVR_ObjectPoolHandle create(const UEVR_ObjectPoolDesc* desc);
+void destroy(UEVR_ObjectPoolHandle pool);
+UEVR_UObjectHandle acquire(UEVR_ObjectPoolHandle pool);
+bool release(UEVR_ObjectPoolHandle pool, UEVR_UObjectHandle object);
+void get_stats(UEVR_ObjectPoolHandle pool, UEVR_ObjectPoolStats* out_stats);
+
+// Trims every pool, called from PluginLoader::on_post_engine_tick
+void tick();
+
+// Drawn from PluginLoader::on_draw_ui
+void draw_stats();
+
+extern UEVR_ObjectPoolFunctions functions;
+}
+}
@@ -0,0 +1,146 @@
+#include <iterator>
+#include <utility>
+
+#include "PreparedCommand.hpp"
+
+namespace {
+bool is_space(wchar_t c) {
+    return c == L' ' || c == L'\t' || c == L'\r' || c == L'\n';
+}
+
+std::wstring_view trim(std::wstring_view str) {
+    while (!str.empty() && is_space(str.front())) {
+        str.remove_prefix(1);
+    }
+
+    while (!str.empty() && is_space(str.back())) {
+        str.remove_suffix(1);
+    }
+
+    return str;
+}
+}
+
+PreparedCommand::PreparedCommand(std::wstring_view line)
+    : m_line{trim(line)}
+{
+    auto tokens = tokenize(m_line);
+
+    if (tokens.empty()) {
+        return;
+    }
+
+    m_name = std::move(tokens.front());
+    m_args.assign(std::make_move_iterator(tokens.begin() + 1), std::make_move_iterator(tokens.end()));
+
+    // Variables take the rest of the line as is, like the console does
+    const auto line_view = std::wstring_view{m_line};
+    size_t name_end = 0;
+
+    while (name_end < line_view.size() && !is_space(line_view[name_end])) {
+        ++name_end;
+    }
+
+    auto value = trim(line_view.substr(name_end));
+
+    if (value.size() >= 2 && value.front() == L'"' && value.back() == L'"') {
+        value = value.substr(1, value.size() - 2);
+    }
+
+    m_value = value;
+}
+
+std::vector<std::wstring> PreparedCommand::tokenize(std::wstring_view line) {
+    std::vector<std::wstring> tokens{};
+    std::wstring token{};
+    bool in_token = false;
+    bool in_quotes = false;
+
+    for (const auto c : line) {
+        if (c == L'"') {
+            in_quotes = !in_quotes;
+            in_token = true; // "" is still an (empty) argument
+            continue;
+        }
+
+        if (is_space(c) && !in_quotes) {
+            if (in_token) {
+                tokens.push_back(std::move(token));
+                token.clear();
+                in_token = false;
+            }
+
+            continue;
+        }
+
+        token += c;
+        in_token = true;
+    }
+
+    if (in_token) {
+        tokens.push_back(std::move(token));
+    }
+
+    return tokens;
+}
+
+void PreparedCommand::resolve(Console& console) {
+    // Try again next time, the console manager might just not be there yet
+    if (!console.is_ready()) {
+        return;
+    }
+
+    ++m_stats.resolves;
+
+    const auto object = console.find(m_name);
+
+    if (object == nullptr) {
+        m_target = Target::EXEC;
+        return;
+    }
+
+    if (console.is_command(object)) {
+        m_target = Target::COMMAND;
+        m_object = object;
+        return;
+    }
+
+    // Without a value (or with "?") the console prints the variable instead of setting it, leave that to Exec
+    if (m_value.empty() || m_value == L"?") {
+        m_target = Target::EXEC;
+        return;
+    }
+
+    m_target = Target::VARIABLE;
+    m_object = object;
+}
+
+bool PreparedCommand::execute(Console& console) {
+    if (m_name.empty()) {
+        return false;
+    }
+
+    if (m_target == Target::UNRESOLVED) {
+        resolve(console);
+    }
+
+    switch (m_target) {
+    case Target::VARIABLE:
+        console.set_variable(m_object, m_value);
+        ++m_stats.direct;
+        return true;
+    case Target::COMMAND:
+        console.execute_command(m_object, m_args);
+        ++m_stats.direct;
+        return true;
+    default:
+        break;
+    }
+
+    if (!console.exec(m_line)) {
+        return false;
+    }
+
+    ++m_stats.exec;
+    return true;
+}
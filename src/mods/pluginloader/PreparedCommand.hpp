@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A console command line that's split up and looked up once, then run straight through the
+// console variable or command it resolved to instead of going through UEngine::Exec every time.
+// Lines that don't name a console object (stat, exec chain commands) still go through Exec.
+// Everything engine specific goes through Console, so this can be driven with a fake one.
+class PreparedCommand {
+public:
+    using Object = void*;
+
+    class Console {
+    public:
+        virtual ~Console() = default;
+
+        virtual bool is_ready() = 0; // false until the console manager exists, nothing is resolved before that
+        virtual Object find(std::wstring_view name) = 0; // null if no console object has this name
+        virtual bool is_command(Object object) = 0;
+        virtual void set_variable(Object variable, const std::wstring& value) = 0;
+        virtual void execute_command(Object command, const std::vector<std::wstring>& args) = 0;
+        virtual bool exec(const std::wstring& line) = 0; // false if there's nothing to run it on
+    };
+
+    enum class Target : uint8_t {
+        UNRESOLVED,
+        VARIABLE,
+        COMMAND,
+        EXEC,
+    };
+
+    struct Stats {
+        uint64_t direct{0}; // ran through the resolved variable or command
+        uint64_t exec{0}; // went through Console::exec
+        uint64_t resolves{0};
+    };
+
+    PreparedCommand(std::wstring_view line);
+
+    // Splits on whitespace, double quotes keep a token together and are dropped.
+    static std::vector<std::wstring> tokenize(std::wstring_view line);
+
+    // Resolves on first use. False if it couldn't be run at all.
+    bool execute(Console& console);
+
+    // Looks the name up again next time, for when the console object may have gone away.
+    void invalidate() {
+        m_target = Target::UNRESOLVED;
+        m_object = nullptr;
+    }
+
+    Target get_target() const {
+        return m_target;
+    }
+
+    const std::wstring& get_line() const {
+        return m_line;
+    }
+
+    const std::wstring& get_name() const {
+        return m_name;
+    }
+
+    const std::vector<std::wstring>& get_args() const {
+        return m_args;
+    }
+
+    const Stats& get_stats() const {
+        return m_stats;
+    }
+
+private:
+    void resolve(Console& console);
+
+    std::wstring m_line{};
+    std::wstring m_name{};
+    std::vector<std::wstring> m_args{};
+    std::wstring m_value{}; // everything after the name, what a variable gets set to
+
+    Target m_target{Target::UNRESOLVED};
+    Object m_object{nullptr};
+    Stats m_stats{};
+};
@@ -0,0 +1,118 @@
+#include <mutex>
+
+#include <sdk/ConsoleManager.hpp>
+#include <sdk/UEngine.hpp>
+
+#include "PreparedCommand.hpp"
+#include "PreparedCommandFunctions.hpp"
+
+namespace uevr {
+namespace prepared_command {
+namespace detail {
+class EngineConsole final : public PreparedCommand::Console {
+public:
+    bool is_ready() override {
+        return sdk::FConsoleManager::get() != nullptr;
+    }
+
+    PreparedCommand::Object find(std::wstring_view name) override {
+        const auto console_manager = sdk::FConsoleManager::get();
+
+        if (console_manager == nullptr) {
+            return nullptr;
+        }
+
+        return console_manager->find(std::wstring{name});
+    }
+
+    bool is_command(PreparedCommand::Object object) override {
+        return ((sdk::IConsoleObject*)object)->AsCommand() != nullptr;
+    }
+
+    void set_variable(PreparedCommand::Object variable, const std::wstring& value) override {
+        ((sdk::IConsoleVariable*)variable)->Set(value.c_str());
+    }
+
+    void execute_command(PreparedCommand::Object command, const std::vector<std::wstring>& args) override {
+        ((sdk::IConsoleObject*)command)->AsCommand()->Execute(args);
+    }
+
+    bool exec(const std::wstring& line) override {
+        const auto engine = sdk::UEngine::get();
+
+        if (engine == nullptr) {
+            return false;
+        }
+
+        engine->exec(line);
+        return true;
+    }
+};
+
+struct Prepared {
+    Prepared(const wchar_t* command)
+        : command{command}
+    {
+    }
+
+    std::mutex mtx{};
+    PreparedCommand command;
+    sdk::FConsoleManager* resolved_with{nullptr}; // looked up again if this changes
+};
+
+EngineConsole g_console{};
+}
+
+UEVR_PreparedCommandHandle create(const wchar_t* command) {
+    if (command == nullptr) {
+        return nullptr;
+    }
+
+    return (UEVR_PreparedCommandHandle)new detail::Prepared{command};
+}
+
+void destroy(UEVR_PreparedCommandHandle cmd) {
+    delete (detail::Prepared*)cmd;
+}
+
+bool execute(UEVR_PreparedCommandHandle cmd) {
+    if (cmd == nullptr) {
+        return false;
+    }
+
+    const auto p = (detail::Prepared*)cmd;
+    std::scoped_lock _{p->mtx};
+
+    if (const auto console_manager = sdk::FConsoleManager::get(); console_manager != p->resolved_with) {
+        p->command.invalidate();
+        p->resolved_with = console_manager;
+    }
+
+    return p->command.execute(detail::g_console);
+}
+
+void get_stats(UEVR_PreparedCommandHandle cmd, UEVR_PreparedCommandStats* out_stats) {
+    if (cmd == nullptr || out_stats == nullptr) {
+        return;
+    }
+
+    const auto p = (detail::Prepared*)cmd;
+    std::scoped_lock _{p->mtx};
+
+    const auto& stats = p->command.get_stats();
+
+    *out_stats = UEVR_PreparedCommandStats{
+        .direct = stats.direct,
+        .exec = stats.exec,
+        .resolves = stats.resolves
+    };
+}
+
+UEVR_PreparedCommandFunctions functions {
+    .create = &uevr::prepared_command::create,
+    .destroy = &uevr::prepared_command::destroy,
+    .execute = &uevr::prepared_command::execute,
+    .get_stats = &uevr::prepared_command::get_stats
+};
+}
+}
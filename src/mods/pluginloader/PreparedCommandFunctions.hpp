@@ -0,0 +1,14 @@
+#pragma once
+
+#include "uevr/API.h"
+
+namespace uevr {
+namespace prepared_command {
+UEVR_PreparedCommandHandle create(const wchar_t* command);
+void destroy(UEVR_PreparedCommandHandle cmd);
+bool execute(UEVR_PreparedCommandHandle cmd);
+void get_stats(UEVR_PreparedCommandHandle cmd, UEVR_PreparedCommandStats* out_stats);
+
+extern UEVR_PreparedCommandFunctions functions;
+}
+}
@@ -1,7 +1,9 @@
 #define NOMINMAX
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <nlohmann/json.hpp>
 
 #include <utility/Config.hpp>
@@ -12,6 +14,7 @@
 #include <sdk/ConsoleManager.hpp>
 #include <sdk/UGameplayStatics.hpp>
 
+#include "utility/JsonWriter.hpp"
 #include "Framework.hpp"
 
 #include "CVarManager.hpp"
@@ -188,55 +191,94 @@ void CVarManager::dump_commands() {
         return;
     }
 
-    nlohmann::json json;
+    // There can be thousands of these, so they get streamed to disk instead of building up a JSON DOM.
+    struct Entry {
+        std::string name{};
+        std::string description{};
+        std::optional<float> value{};
+        bool is_command{false};
+    };
+
+    std::vector<Entry> entries{};
 
     for (auto obj : console_manager->get_console_objects()) {
         if (obj.value == nullptr || obj.key == nullptr || IsBadReadPtr(obj.key, sizeof(wchar_t))) {
             continue;
         }
 
-        auto& entry = json[utility::narrow(obj.key)];
-        
-        entry["description"] = "";
-        //entry["address"] = (std::stringstream{} << std::hex << (uintptr_t)obj.value).str();
-        //entry["vtable"] = (std::stringstream{} << std::hex << *(uintptr_t*)obj.value).str();
-
-        bool is_command = false;
+        auto& entry = entries.emplace_back();
+        entry.name = utility::narrow(obj.key);
 
         try {
-            is_command = obj.value->AsCommand() != nullptr;
-            if (is_command) {
-                entry["command"] = true;
-            } else {
-                entry["value"] = ((sdk::IConsoleVariable*)obj.value)->GetFloat();
+            entry.is_command = obj.value->AsCommand() != nullptr;
+            if (!entry.is_command) {
+                entry.value = ((sdk::IConsoleVariable*)obj.value)->GetFloat();
             }
         } catch(...) {
-            SPDLOG_WARN("Failed to check if CVar is a command: {}", utility::narrow(obj.key));
+            SPDLOG_WARN("Failed to check if CVar is a command: {}", entry.name);
         }
 
         const auto help_string = obj.value->GetHelp();
 
         if (help_string != nullptr && !IsBadReadPtr(help_string, sizeof(wchar_t))) {
             try {
-                SPDLOG_INFO("Found CVar: {} {}", utility::narrow(obj.key), utility::narrow(help_string));
-                entry["description"] = utility::narrow(help_string);
+                SPDLOG_INFO("Found CVar: {} {}", entry.name, utility::narrow(help_string));
+                entry.description = utility::narrow(help_string);
             } catch(...) {
 
             }
         }
         
-        SPDLOG_INFO("Found CVar: {}", utility::narrow(obj.key));
+        SPDLOG_INFO("Found CVar: {}", entry.name);
     }
 
+    // Sorted by name like the old nlohmann::json object was, the last duplicate wins.
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.name < b.name;
+    });
+
     const auto persistent_dir = g_framework->get_persistent_dir();
 
     // Dump all CVars to a JSON file.
-    std::ofstream file(persistent_dir / "cvardump.json");
+    utility::JsonWriter writer{persistent_dir / "cvardump.json"};
+
+    if (!writer.is_open()) {
+        return;
+    }
+
+    // An empty nlohmann::json dumped as null, keep it that way
+    if (entries.empty()) {
+        writer.null();
+        writer.close();
+        return;
+    }
+
+    writer.begin_object();
+
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (auto next = std::next(it); next != entries.end() && next->name == it->name) {
+            continue;
+        }
+
+        writer.key(it->name);
+        writer.begin_object();
+
+        if (it->is_command) {
+            writer.field("command", true);
+        }
+
+        writer.field("description", it->description);
+
+        if (it->value) {
+            writer.field("value", *it->value);
+        }
+
+        writer.end_object();
+    }
 
-    if (file.is_open()) {
-        file << json.dump(4);
-        file.close();
+    writer.end_object();
 
+    if (writer.close()) {
         SPDLOG_INFO("Dumped CVars to {}", (persistent_dir / "cvardump.json").string());
     }
 }
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <optional>
+
+#include <sdk/Math.hpp>
+
+// A composition layer plus the inputs it was built from. Inputs is compared with ==,
+// the layer and everything derived from it only need rebuilding when update() says so.
+template <typename Layer, typename Inputs>
+struct CachedLayer {
+    Layer layer{};
+    std::optional<Inputs> inputs{};
+    Matrix4x4f transform{glm::identity<Matrix4x4f>()};
+    Matrix4x4f inverse_transform{glm::identity<Matrix4x4f>()}; // for the pointer intersection
+    float meters_w{0.0f};
+    float meters_h{0.0f};
+
+    // False if the inputs are the same as last time and the layer can be submitted as is.
+    bool update(const Inputs& new_inputs) {
+        if (inputs.has_value() && *inputs == new_inputs) {
+            return false;
+        }
+
+        inputs = new_inputs;
+        return true;
+    }
+};
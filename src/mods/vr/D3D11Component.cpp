@@ -31,83 +31,6 @@ namespace pixel_shader1 {
 //#define AFR_DEPTH_TEMP_DISABLED
 
 namespace vrmod {
-class DX11StateBackup {
-public:
-    DX11StateBackup(ID3D11DeviceContext* context) {
-        if (context == nullptr) {
-            throw std::runtime_error("DX11StateBackup: context is null");
-        }
-
-        m_context = context;
-
-        m_old.ScissorRectsCount = m_old.ViewportsCount = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
-        m_context->RSGetScissorRects(&m_old.ScissorRectsCount, m_old.ScissorRects);
-        m_context->RSGetViewports(&m_old.ViewportsCount, m_old.Viewports);
-        m_context->RSGetState(&m_old.RS);
-        m_context->OMGetBlendState(&m_old.BlendState, m_old.BlendFactor, &m_old.SampleMask);
-        m_context->OMGetDepthStencilState(&m_old.DepthStencilState, &m_old.StencilRef);
-        m_context->PSGetShaderResources(0, 1, &m_old.PSShaderResource);
-        m_context->PSGetSamplers(0, 1, &m_old.PSSampler);
-        m_old.PSInstancesCount = m_old.VSInstancesCount = m_old.GSInstancesCount = 256;
-        m_context->PSGetShader(&m_old.PS, m_old.PSInstances, &m_old.PSInstancesCount);
-        m_context->VSGetShader(&m_old.VS, m_old.VSInstances, &m_old.VSInstancesCount);
-        m_context->VSGetConstantBuffers(0, 1, &m_old.VSConstantBuffer);
-        m_context->GSGetShader(&m_old.GS, m_old.GSInstances, &m_old.GSInstancesCount);
-
-        m_context->IAGetPrimitiveTopology(&m_old.PrimitiveTopology);
-        m_context->IAGetIndexBuffer(&m_old.IndexBuffer, &m_old.IndexBufferFormat, &m_old.IndexBufferOffset);
-        m_context->IAGetVertexBuffers(0, 1, &m_old.VertexBuffer, &m_old.VertexBufferStride, &m_old.VertexBufferOffset);
-        m_context->IAGetInputLayout(&m_old.InputLayout);
-    }
-
-    virtual ~DX11StateBackup() {
-        m_context->RSSetScissorRects(m_old.ScissorRectsCount, m_old.ScissorRects);
-        m_context->RSSetViewports(m_old.ViewportsCount, m_old.Viewports);
-        m_context->RSSetState(m_old.RS); if (m_old.RS) m_old.RS->Release();
-        m_context->OMSetBlendState(m_old.BlendState, m_old.BlendFactor, m_old.SampleMask); if (m_old.BlendState) m_old.BlendState->Release();
-        m_context->OMSetDepthStencilState(m_old.DepthStencilState, m_old.StencilRef); if (m_old.DepthStencilState) m_old.DepthStencilState->Release();
-        m_context->PSSetShaderResources(0, 1, &m_old.PSShaderResource); if (m_old.PSShaderResource) m_old.PSShaderResource->Release();
-        m_context->PSSetSamplers(0, 1, &m_old.PSSampler); if (m_old.PSSampler) m_old.PSSampler->Release();
-        m_context->PSSetShader(m_old.PS, m_old.PSInstances, m_old.PSInstancesCount); if (m_old.PS) m_old.PS->Release();
-        for (UINT i = 0; i < m_old.PSInstancesCount; i++) if (m_old.PSInstances[i]) m_old.PSInstances[i]->Release();
-        m_context->VSSetShader(m_old.VS, m_old.VSInstances, m_old.VSInstancesCount); if (m_old.VS) m_old.VS->Release();
-        m_context->VSSetConstantBuffers(0, 1, &m_old.VSConstantBuffer); if (m_old.VSConstantBuffer) m_old.VSConstantBuffer->Release();
-        m_context->GSSetShader(m_old.GS, m_old.GSInstances, m_old.GSInstancesCount); if (m_old.GS) m_old.GS->Release();
-        for (UINT i = 0; i < m_old.VSInstancesCount; i++) if (m_old.VSInstances[i]) m_old.VSInstances[i]->Release();
-        m_context->IASetPrimitiveTopology(m_old.PrimitiveTopology);
-        m_context->IASetIndexBuffer(m_old.IndexBuffer, m_old.IndexBufferFormat, m_old.IndexBufferOffset); if (m_old.IndexBuffer) m_old.IndexBuffer->Release();
-        m_context->IASetVertexBuffers(0, 1, &m_old.VertexBuffer, &m_old.VertexBufferStride, &m_old.VertexBufferOffset); if (m_old.VertexBuffer) m_old.VertexBuffer->Release();
-        m_context->IASetInputLayout(m_old.InputLayout); if (m_old.InputLayout) m_old.InputLayout->Release();
-    }
-
-private:
-    Microsoft::WRL::ComPtr<ID3D11DeviceContext> m_context{};
-
-    struct BACKUP_DX11_STATE {
-        UINT                        ScissorRectsCount, ViewportsCount;
-        D3D11_RECT                  ScissorRects[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
-        D3D11_VIEWPORT              Viewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
-        ID3D11RasterizerState*      RS;
-        ID3D11BlendState*           BlendState;
-        FLOAT                       BlendFactor[4];
-        UINT                        SampleMask;
-        UINT                        StencilRef;
-        ID3D11DepthStencilState*    DepthStencilState;
-        ID3D11ShaderResourceView*   PSShaderResource;
-        ID3D11SamplerState*         PSSampler;
-        ID3D11PixelShader*          PS;
-        ID3D11VertexShader*         VS;
-        ID3D11GeometryShader*       GS;
-        UINT                        PSInstancesCount, VSInstancesCount, GSInstancesCount;
-        ID3D11ClassInstance         *PSInstances[256], *VSInstances[256], *GSInstances[256];   // 256 is max according to PSSetShader documentation
-        D3D11_PRIMITIVE_TOPOLOGY    PrimitiveTopology;
-        ID3D11Buffer*               IndexBuffer, *VertexBuffer, *VSConstantBuffer;
-        UINT                        IndexBufferOffset, VertexBufferStride, VertexBufferOffset;
-        DXGI_FORMAT                 IndexBufferFormat;
-        ID3D11InputLayout*          InputLayout;
-    } m_old{};
-};
-
 D3D11Component::TextureContext::TextureContext(ID3D11Resource* in_tex, std::optional<DXGI_FORMAT> rtv_format, std::optional<DXGI_FORMAT> srv_format) {
     set(in_tex, rtv_format, srv_format);
 }
@@ -229,6 +152,9 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
 
     device->GetImmediateContext(&context);
 
+    // Shared by everything drawn below, the game gets its state back once the frame is done
+    d3d11::StateBackup frame_state{context.Get()};
+
     // get swapchain
     auto swapchain = hook->get_swap_chain();
 
@@ -275,7 +201,7 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
     } else {
         // We need to use a shader to convert the real backbuffer
         // to a VR compatible format.
-        DX11StateBackup backup{context.Get()};
+        frame_state.forget_bindings();
 
         // this backbuffer is a copy of the real backbuffer
         // except it can be used as a shader resource
@@ -319,7 +245,7 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
         float clear_color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
         m_engine_tex_ref.clear_rtv(&clear_color[0]);
 
-        render_srv_to_rtv(m_backbuffer_batch.get(), m_extreme_compat_backbuffer_ctx, m_engine_tex_ref, m_backbuffer_size[0], m_backbuffer_size[1]);
+        render_srv_to_rtv(frame_state, m_backbuffer_batch.get(), m_extreme_compat_backbuffer_ctx, m_engine_tex_ref, m_backbuffer_size[0], m_backbuffer_size[1]);
 
         backbuffer = m_converted_backbuffer;
     }
@@ -380,7 +306,7 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
             return;
         }
 
-        DX11StateBackup backup{context.Get()};
+        frame_state.forget_bindings();
 
         float clear_color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
 
@@ -391,6 +317,7 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
 
         // Render left side to left screen tex
         render_srv_to_rtv(
+            frame_state,
             m_game_batch.get(),
             m_engine_tex_ref,
             m_2d_screen_tex[0],
@@ -399,6 +326,7 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
 
         if (m_engine_ui_ref.has_texture() && m_engine_ui_ref.has_srv()) {
             render_srv_to_rtv(
+                frame_state,
                 m_game_batch.get(),
                 m_engine_ui_ref,
                 m_2d_screen_tex[0]
@@ -408,6 +336,7 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
         if (!is_afr) {
             // Render right side to right screen tex
             render_srv_to_rtv(
+                frame_state,
                 m_game_batch.get(),
                 m_engine_tex_ref,
                 m_2d_screen_tex[1],
@@ -416,6 +345,7 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
 
             if (m_engine_ui_ref.has_texture() && m_engine_ui_ref.has_srv()) {
                 render_srv_to_rtv(
+                    frame_state,
                     m_game_batch.get(),
                     m_engine_ui_ref,
                     m_2d_screen_tex[1]
@@ -549,18 +479,18 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
             const auto submit_pose = vr->m_openvr->get_pose_for_submit();
 
             if (m_is_shader_setup) {
-                ID3D11RenderTargetView* views[] = { m_left_eye_rtv.Get() };
-                context->OMSetRenderTargets(1, views, nullptr);
+                frame_state.forget_bindings();
+                frame_state.set_render_target(m_left_eye_rtv.Get());
                 //context->ClearRenderTargetView(m_right_eye_rtv.Get(), clear_color);
-                invoke_shader(vr->m_frame_count, 0, m_backbuffer_size[0] / 2, m_backbuffer_size[1]);
+                invoke_shader(frame_state, vr->m_frame_count, 0, m_backbuffer_size[0] / 2, m_backbuffer_size[1]);
             }
 
             vr::VRTextureWithPose_t left_eye{
                 (void*)m_left_eye_tex.Get(), vr::TextureType_DirectX, vr::ColorSpace_Auto,
                 submit_pose
             };
-            const auto left_bounds = vr::VRTextureBounds_t{runtime->view_bounds[0][0], runtime->view_bounds[0][2],
-                                                           runtime->view_bounds[0][1], runtime->view_bounds[0][3]};
+            const auto left_view_bounds = runtime->get_submit_view_bounds(0);
+            const auto left_bounds = vr::VRTextureBounds_t{left_view_bounds[0], left_view_bounds[2], left_view_bounds[1], left_view_bounds[3]};
             const auto e = vr::VRCompositor()->Submit(vr::Eye_Left, &left_eye, &left_bounds, vr::EVRSubmitFlags::Submit_TextureWithPose);
 
             if (e != vr::VRCompositorError_None) {
@@ -641,7 +571,7 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
             }
 
             LOG_VERBOSE("Ending frame");
-            std::vector<XrCompositionLayerBaseHeader*> quad_layers{};
+            runtimes::OpenXR::QuadLayers quad_layers{};
 
             auto& openxr_overlay = vr->get_overlay_component().get_openxr();
 
@@ -701,18 +631,18 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
                 context->CopySubresourceRegion(m_left_eye_tex.Get(), 0, 0, 0, 0, backbuffer.Get(), 0, &src_box);
 
                 if (m_is_shader_setup) {
-                    ID3D11RenderTargetView* views[] = { m_left_eye_rtv.Get() };
-                    context->OMSetRenderTargets(1, views, nullptr);
+                    frame_state.forget_bindings();
+                    frame_state.set_render_target(m_left_eye_rtv.Get());
                     //context->ClearRenderTargetView(m_right_eye_rtv.Get(), clear_color);
-                    invoke_shader(vr->m_frame_count, 0, m_backbuffer_size[0] / 2, m_backbuffer_size[1]);
+                    invoke_shader(frame_state, vr->m_frame_count, 0, m_backbuffer_size[0] / 2, m_backbuffer_size[1]);
                 }
 
                 vr::VRTextureWithPose_t left_eye{
                     (void*)m_left_eye_tex.Get(), vr::TextureType_DirectX, vr::ColorSpace_Auto,
                     submit_pose
                 };
-                const auto left_bounds = vr::VRTextureBounds_t{runtime->view_bounds[0][0], runtime->view_bounds[0][2],
-                                                               runtime->view_bounds[0][1], runtime->view_bounds[0][3]};
+                const auto left_view_bounds = runtime->get_submit_view_bounds(0);
+                const auto left_bounds = vr::VRTextureBounds_t{left_view_bounds[0], left_view_bounds[2], left_view_bounds[1], left_view_bounds[3]};
                 e = vr::VRCompositor()->Submit(vr::Eye_Left, &left_eye, &left_bounds, vr::EVRSubmitFlags::Submit_TextureWithPose);
 
                 if (e != vr::VRCompositorError_None) {
@@ -752,9 +682,9 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
             context->CopySubresourceRegion(m_right_eye_tex.Get(), 0, 0, 0, 0, backbuffer.Get(), 0, &src_box);
 
             if (m_is_shader_setup) {
-                ID3D11RenderTargetView* views[] = { m_right_eye_rtv.Get() };
-                context->OMSetRenderTargets(1, views, nullptr);
-                invoke_shader(vr->m_frame_count, 1, m_backbuffer_size[0] / 2, m_backbuffer_size[1]);
+                frame_state.forget_bindings();
+                frame_state.set_render_target(m_right_eye_rtv.Get());
+                invoke_shader(frame_state, vr->m_frame_count, 1, m_backbuffer_size[0] / 2, m_backbuffer_size[1]);
                 //context->OMSetRenderTargets(1, &prev_rtv, prev_depth_rtv.Get());     
             }
 
@@ -762,8 +692,8 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
                 (void*)m_right_eye_tex.Get(), vr::TextureType_DirectX, vr::ColorSpace_Auto,
                 submit_pose
             };
-            const auto right_bounds = vr::VRTextureBounds_t{runtime->view_bounds[1][0], runtime->view_bounds[1][2],
-                                                            runtime->view_bounds[1][1], runtime->view_bounds[1][3]};
+            const auto right_view_bounds = runtime->get_submit_view_bounds(1);
+            const auto right_bounds = vr::VRTextureBounds_t{right_view_bounds[0], right_view_bounds[2], right_view_bounds[1], right_view_bounds[3]};
             e = vr::VRCompositor()->Submit(vr::Eye_Right, &right_eye, &right_bounds, vr::EVRSubmitFlags::Submit_TextureWithPose);
             runtime->frame_synced = false;
 
@@ -791,10 +721,9 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
 
     // Desktop fix
     if (is_right_eye_frame && should_draw_desktop) {
-        DX11StateBackup backup{context.Get()};
-        
-        ID3D11RenderTargetView* views[] = { m_backbuffer_rtv.Get() };
-        context->OMSetRenderTargets(1, views, nullptr);
+        frame_state.forget_bindings();
+        frame_state.capture(d3d11::StateBackup::SPRITE_BATCH);
+        frame_state.set_render_target(m_backbuffer_rtv.Get());
 
         m_backbuffer_batch->Begin();
 
@@ -803,14 +732,14 @@ vr::EVRCompositorError D3D11Component::on_frame(VR* vr) {
         viewport.Height = m_real_backbuffer_size[1];
         m_backbuffer_batch->SetViewport(viewport);
 
-        context->RSSetViewports(1, &viewport);
+        frame_state.set_viewport(viewport);
         
         D3D11_RECT scissor_rect{};
         scissor_rect.left = 0;
         scissor_rect.top = 0;
         scissor_rect.right = m_real_backbuffer_size[0];
         scissor_rect.bottom = m_real_backbuffer_size[1];
-        context->RSSetScissorRects(1, &scissor_rect);
+        frame_state.set_scissor_rect(scissor_rect);
 
         RECT dest_rect{};
         dest_rect.left = 0;
@@ -1024,16 +953,10 @@ void D3D11Component::copy_tex(ID3D11Resource* src, ID3D11Resource* dst) {
     context->CopyResource(dst, src);
 }
 
-void D3D11Component::render_srv_to_rtv(DirectX::DX11::SpriteBatch* batch, TextureContext& srv, TextureContext& rtv, float w, float h) {
-    auto& hook = g_framework->get_d3d11_hook();
-    auto device = hook->get_device();
-
-    ComPtr<ID3D11DeviceContext> context{};
-    device->GetImmediateContext(&context);
-
+void D3D11Component::render_srv_to_rtv(d3d11::StateBackup& state, DirectX::DX11::SpriteBatch* batch, TextureContext& srv, TextureContext& rtv, float w, float h) {
     // Finally do the rendering.
-    ID3D11RenderTargetView* views[] = { rtv };
-    context->OMSetRenderTargets(1, views, nullptr);
+    state.capture(d3d11::StateBackup::SPRITE_BATCH);
+    state.set_render_target(rtv);
 
     batch->Begin();
 
@@ -1042,14 +965,14 @@ void D3D11Component::render_srv_to_rtv(DirectX::DX11::SpriteBatch* batch, Textur
     viewport.Height = h;
     batch->SetViewport(viewport);
 
-    context->RSSetViewports(1, &viewport);
+    state.set_viewport(viewport);
     
     D3D11_RECT scissor_rect{};
     scissor_rect.left = 0;
     scissor_rect.top = 0;
     scissor_rect.right = w;
     scissor_rect.bottom = h;
-    context->RSSetScissorRects(1, &scissor_rect);
+    state.set_scissor_rect(scissor_rect);
 
     RECT dest_rect{};
     dest_rect.left = 0;
@@ -1061,7 +984,7 @@ void D3D11Component::render_srv_to_rtv(DirectX::DX11::SpriteBatch* batch, Textur
     batch->End();
 }
 
-void D3D11Component::render_srv_to_rtv(DirectX::DX11::SpriteBatch* batch, TextureContext& srv, TextureContext& rtv) {
+void D3D11Component::render_srv_to_rtv(d3d11::StateBackup& state, DirectX::DX11::SpriteBatch* batch, TextureContext& srv, TextureContext& rtv) {
     // get src and dest descs
     D3D11_TEXTURE2D_DESC src_desc{};
     D3D11_TEXTURE2D_DESC dest_desc{};
@@ -1069,15 +992,9 @@ void D3D11Component::render_srv_to_rtv(DirectX::DX11::SpriteBatch* batch, Textur
     ((ID3D11Texture2D*)srv.tex.Get())->GetDesc(&src_desc);
     ((ID3D11Texture2D*)rtv.tex.Get())->GetDesc(&dest_desc);
     
-    auto& hook = g_framework->get_d3d11_hook();
-    auto device = hook->get_device();
-
-    ComPtr<ID3D11DeviceContext> context{};
-    device->GetImmediateContext(&context);
-
     // Finally do the rendering.
-    ID3D11RenderTargetView* views[] = { rtv };
-    context->OMSetRenderTargets(1, views, nullptr);
+    state.capture(d3d11::StateBackup::SPRITE_BATCH);
+    state.set_render_target(rtv);
 
     batch->Begin();
 
@@ -1086,14 +1003,14 @@ void D3D11Component::render_srv_to_rtv(DirectX::DX11::SpriteBatch* batch, Textur
     viewport.Height = dest_desc.Height;
     batch->SetViewport(viewport);
 
-    context->RSSetViewports(1, &viewport);
+    state.set_viewport(viewport);
     
     D3D11_RECT scissor_rect{};
     scissor_rect.left = 0;
     scissor_rect.top = 0;
     scissor_rect.right = dest_desc.Width;
     scissor_rect.bottom = dest_desc.Height;
-    context->RSSetScissorRects(1, &scissor_rect);
+    state.set_scissor_rect(scissor_rect);
 
     RECT dest_rect{};
     dest_rect.left = 0;
@@ -1111,7 +1028,7 @@ void D3D11Component::render_srv_to_rtv(DirectX::DX11::SpriteBatch* batch, Textur
     batch->End();
 }
 
-void D3D11Component::render_srv_to_rtv(DirectX::DX11::SpriteBatch* batch, TextureContext& srv, TextureContext& rtv, const RECT& src_rect) {
+void D3D11Component::render_srv_to_rtv(d3d11::StateBackup& state, DirectX::DX11::SpriteBatch* batch, TextureContext& srv, TextureContext& rtv, const RECT& src_rect) {
     // get src and dest descs
     D3D11_TEXTURE2D_DESC src_desc{};
     D3D11_TEXTURE2D_DESC dest_desc{};
@@ -1119,15 +1036,9 @@ void D3D11Component::render_srv_to_rtv(DirectX::DX11::SpriteBatch* batch, Textur
     ((ID3D11Texture2D*)srv.tex.Get())->GetDesc(&src_desc);
     ((ID3D11Texture2D*)rtv.tex.Get())->GetDesc(&dest_desc);
     
-    auto& hook = g_framework->get_d3d11_hook();
-    auto device = hook->get_device();
-
-    ComPtr<ID3D11DeviceContext> context{};
-    device->GetImmediateContext(&context);
-
     // Finally do the rendering.
-    ID3D11RenderTargetView* views[] = { rtv };
-    context->OMSetRenderTargets(1, views, nullptr);
+    state.capture(d3d11::StateBackup::SPRITE_BATCH);
+    state.set_render_target(rtv);
 
     batch->Begin();
 
@@ -1136,14 +1047,14 @@ void D3D11Component::render_srv_to_rtv(DirectX::DX11::SpriteBatch* batch, Textur
     viewport.Height = dest_desc.Height;
     batch->SetViewport(viewport);
 
-    context->RSSetViewports(1, &viewport);
+    state.set_viewport(viewport);
     
     D3D11_RECT scissor_rect{};
     scissor_rect.left = 0;
     scissor_rect.top = 0;
     scissor_rect.right = dest_desc.Width;
     scissor_rect.bottom = dest_desc.Height;
-    context->RSSetScissorRects(1, &scissor_rect);
+    state.set_scissor_rect(scissor_rect);
 
     RECT dest_rect{};
     dest_rect.left = 0;
@@ -1472,7 +1383,7 @@ bool D3D11Component::setup_shader() {
     return true;
 }
 
-void D3D11Component::invoke_shader(uint32_t frame_count, uint32_t eye, uint32_t width, uint32_t height) {
+void D3D11Component::invoke_shader(d3d11::StateBackup& state, uint32_t frame_count, uint32_t eye, uint32_t width, uint32_t height) {
     if (m_constant_buffer == nullptr) {
         spdlog::error("[VR] Constant buffer is null. Cannot invoke shader.");
         return;
@@ -1492,49 +1403,8 @@ void D3D11Component::invoke_shader(uint32_t frame_count, uint32_t eye, uint32_t
 
     device->GetImmediateContext(&context);
 
-    // Backup DX state that will be modified to restore it afterwards (unfortunately this is very ugly looking and verbose. Close your eyes!)
-    struct BACKUP_DX11_STATE {
-        UINT                        ScissorRectsCount, ViewportsCount;
-        D3D11_RECT                  ScissorRects[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
-        D3D11_VIEWPORT              Viewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
-        ID3D11RasterizerState*      RS;
-        ID3D11BlendState*           BlendState;
-        FLOAT                       BlendFactor[4];
-        UINT                        SampleMask;
-        UINT                        StencilRef;
-        ID3D11DepthStencilState*    DepthStencilState;
-        ID3D11ShaderResourceView*   PSShaderResource;
-        ID3D11SamplerState*         PSSampler;
-        ID3D11PixelShader*          PS;
-        ID3D11VertexShader*         VS;
-        ID3D11GeometryShader*       GS;
-        UINT                        PSInstancesCount, VSInstancesCount, GSInstancesCount;
-        ID3D11ClassInstance         *PSInstances[256], *VSInstances[256], *GSInstances[256];   // 256 is max according to PSSetShader documentation
-        D3D11_PRIMITIVE_TOPOLOGY    PrimitiveTopology;
-        ID3D11Buffer*               IndexBuffer, *VertexBuffer, *VSConstantBuffer;
-        UINT                        IndexBufferOffset, VertexBufferStride, VertexBufferOffset;
-        DXGI_FORMAT                 IndexBufferFormat;
-        ID3D11InputLayout*          InputLayout;
-    };
-    BACKUP_DX11_STATE old = {};
-    old.ScissorRectsCount = old.ViewportsCount = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
-    context->RSGetScissorRects(&old.ScissorRectsCount, old.ScissorRects);
-    context->RSGetViewports(&old.ViewportsCount, old.Viewports);
-    context->RSGetState(&old.RS);
-    context->OMGetBlendState(&old.BlendState, old.BlendFactor, &old.SampleMask);
-    context->OMGetDepthStencilState(&old.DepthStencilState, &old.StencilRef);
-    context->PSGetShaderResources(0, 1, &old.PSShaderResource);
-    context->PSGetSamplers(0, 1, &old.PSSampler);
-    old.PSInstancesCount = old.VSInstancesCount = old.GSInstancesCount = 256;
-    context->PSGetShader(&old.PS, old.PSInstances, &old.PSInstancesCount);
-    context->VSGetShader(&old.VS, old.VSInstances, &old.VSInstancesCount);
-    context->VSGetConstantBuffers(0, 1, &old.VSConstantBuffer);
-    context->GSGetShader(&old.GS, old.GSInstances, &old.GSInstancesCount);
-
-    context->IAGetPrimitiveTopology(&old.PrimitiveTopology);
-    context->IAGetIndexBuffer(&old.IndexBuffer, &old.IndexBufferFormat, &old.IndexBufferOffset);
-    context->IAGetVertexBuffers(0, 1, &old.VertexBuffer, &old.VertexBufferStride, &old.VertexBufferOffset);
-    context->IAGetInputLayout(&old.InputLayout);
+    // Restored along with everything else once the frame is done
+    state.capture(d3d11::StateBackup::ALL);
 
     // Update the constant buffer.
     const auto glm_eye_transform_offset = vr->get_eye_transform(eye);
@@ -1649,24 +1519,8 @@ void D3D11Component::invoke_shader(uint32_t frame_count, uint32_t eye, uint32_t
     // Render the quad.
     context->DrawIndexed(6, 0, 0);
 
-    // Restore modified DX state
-    context->RSSetScissorRects(old.ScissorRectsCount, old.ScissorRects);
-    context->RSSetViewports(old.ViewportsCount, old.Viewports);
-    context->RSSetState(old.RS); if (old.RS) old.RS->Release();
-    context->OMSetBlendState(old.BlendState, old.BlendFactor, old.SampleMask); if (old.BlendState) old.BlendState->Release();
-    context->OMSetDepthStencilState(old.DepthStencilState, old.StencilRef); if (old.DepthStencilState) old.DepthStencilState->Release();
-    context->PSSetShaderResources(0, 1, &old.PSShaderResource); if (old.PSShaderResource) old.PSShaderResource->Release();
-    context->PSSetSamplers(0, 1, &old.PSSampler); if (old.PSSampler) old.PSSampler->Release();
-    context->PSSetShader(old.PS, old.PSInstances, old.PSInstancesCount); if (old.PS) old.PS->Release();
-    for (UINT i = 0; i < old.PSInstancesCount; i++) if (old.PSInstances[i]) old.PSInstances[i]->Release();
-    context->VSSetShader(old.VS, old.VSInstances, old.VSInstancesCount); if (old.VS) old.VS->Release();
-    context->VSSetConstantBuffers(0, 1, &old.VSConstantBuffer); if (old.VSConstantBuffer) old.VSConstantBuffer->Release();
-    context->GSSetShader(old.GS, old.GSInstances, old.GSInstancesCount); if (old.GS) old.GS->Release();
-    for (UINT i = 0; i < old.VSInstancesCount; i++) if (old.VSInstances[i]) old.VSInstances[i]->Release();
-    context->IASetPrimitiveTopology(old.PrimitiveTopology);
-    context->IASetIndexBuffer(old.IndexBuffer, old.IndexBufferFormat, old.IndexBufferOffset); if (old.IndexBuffer) old.IndexBuffer->Release();
-    context->IASetVertexBuffers(0, 1, &old.VertexBuffer, &old.VertexBufferStride, &old.VertexBufferOffset); if (old.VertexBuffer) old.VertexBuffer->Release();
-    context->IASetInputLayout(old.InputLayout); if (old.InputLayout) old.InputLayout->Release();
+    // Viewport and scissor were set behind its back
+    state.forget_bindings();
 }
 
 void D3D11Component::OpenXR::initialize(XrSessionCreateInfo& session_info) {
@@ -1775,7 +1629,7 @@ std::optional<std::string> D3D11Component::OpenXR::create_swapchains() {
             return "Failed to create swapchain.";
         }
 
-        vr->m_openxr->swapchains[i] = swapchain;
+        vr->m_openxr->set_swapchain(i, swapchain);
 
         uint32_t image_count{};
         auto result = xrEnumerateSwapchainImages(swapchain.handle, 0, &image_count, nullptr);
@@ -2029,7 +1883,7 @@ void D3D11Component::OpenXR::destroy_swapchains() {
     }
 
     this->contexts.clear();
-    VR::get()->m_openxr->swapchains.clear();
+    VR::get()->m_openxr->clear_swapchains();
 }
 
 void D3D11Component::OpenXR::copy(uint32_t swapchain_idx, ID3D11Texture2D* resource, D3D11_BOX* src_box) {
@@ -14,6 +14,8 @@
 #include <DirectXMath.h>
 #include <SpriteBatch.h>
 
+#include "d3d11/StateBackup.hpp"
+
 class VR;
 
 namespace vrmod {
@@ -44,17 +46,20 @@ private:
     struct TextureContext;
 
     void render_srv_to_rtv(
+        d3d11::StateBackup& state,
         DirectX::DX11::SpriteBatch* batch,
         TextureContext& srv,
         TextureContext& rtv,
         float w, float h);
 
     void render_srv_to_rtv(
+        d3d11::StateBackup& state,
         DirectX::DX11::SpriteBatch* batch,
         TextureContext& srv,
         TextureContext& rtv);
 
     void render_srv_to_rtv(
+        d3d11::StateBackup& state,
         DirectX::DX11::SpriteBatch* batch,
         TextureContext& srv,
         TextureContext& rtv,
@@ -213,6 +218,6 @@ private:
 
     bool setup();
     bool setup_shader();
-    void invoke_shader(uint32_t frame_count, uint32_t eye, uint32_t width, uint32_t height);
+    void invoke_shader(d3d11::StateBackup& state, uint32_t frame_count, uint32_t eye, uint32_t width, uint32_t height);
 };
 } // namespace vrmod
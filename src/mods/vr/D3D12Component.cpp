@@ -15,6 +15,19 @@
 
 //#define AFR_DEPTH_TEMP_DISABLED
 
+namespace {
+// The fence value is the one execute() just signaled for the copy into the texture
+OpenVRSubmitQueue::Eye make_async_eye(d3d12::TextureContext& ctx, ID3D12CommandQueue* command_queue, const vr::HmdMatrix34_t& pose, const std::array<float, 4>& view_bounds) {
+    return OpenVRSubmitQueue::Eye {
+        .texture = vr::D3D12TextureData_t{ ctx.texture.Get(), command_queue, 0 },
+        .pose = pose,
+        .bounds = vr::VRTextureBounds_t{view_bounds[0], view_bounds[2], view_bounds[1], view_bounds[3]},
+        .fence = ctx.commands.fence.Get(),
+        .fence_value = ctx.commands.fence_value
+    };
+}
+}
+
 constexpr auto ENGINE_SRC_DEPTH = D3D12_RESOURCE_STATE_DEPTH_READ | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
 constexpr auto ENGINE_SRC_COLOR = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
 
@@ -149,6 +162,7 @@ vr::EVRCompositorError D3D12Component::on_frame(VR* vr) {
             command_ctx.clear_rtv(m_game_tex, (float*)&clear_color, D3D12_RESOURCE_STATE_RENDER_TARGET);
             command_ctx.copy(real_backbuffer.Get(), m_backbuffer_copy.texture.Get(), D3D12_RESOURCE_STATE_PRESENT, D3D12_RESOURCE_STATE_RENDER_TARGET);
             //m_game_tex_commands[idx].copy(backbuffer.Get(), m_game_tex.texture.Get(), D3D12_RESOURCE_STATE_PRESENT, ENGINE_SRC_COLOR);
+            command_ctx.restore_states();
             d3d12::render_srv_to_rtv(
                 m_game_batch.get(),
                 command_ctx.cmd_list.Get(),
@@ -215,14 +229,21 @@ vr::EVRCompositorError D3D12Component::on_frame(VR* vr) {
     const auto is_2d_screen = vr->is_using_2d_screen();
 
     auto draw_2d_view = [&](d3d12::CommandContext& commands) {
+        commands.restore_states();
         draw_spectator_view(commands.cmd_list.Get(), is_right_eye_frame);
 
-        if (is_2d_screen && m_game_tex.texture.Get() != nullptr && m_game_tex.srv_heap != nullptr) {
-            // Clear previous frame
+        if (is_2d_screen && m_game_tex.texture.Get() != nullptr && m_game_tex.has_srv()) {
+            // Clear previous frame, both screens are transitioned with the first clear
+            for (auto& screen : m_2d_screen_tex) {
+                commands.transition(screen.texture.Get(), ENGINE_SRC_COLOR, D3D12_RESOURCE_STATE_RENDER_TARGET);
+            }
+
             for (auto& screen : m_2d_screen_tex) {
                 commands.clear_rtv(screen, clear_color, ENGINE_SRC_COLOR);
             }
 
+            commands.restore_states();
+
             // Render left side to left screen tex
             d3d12::render_srv_to_rtv(
                 m_game_batch.get(),
@@ -234,7 +255,7 @@ vr::EVRCompositorError D3D12Component::on_frame(VR* vr) {
                 ENGINE_SRC_COLOR
             );
 
-            if (m_game_ui_tex.texture.Get() != nullptr && m_game_ui_tex.srv_heap != nullptr) {
+            if (m_game_ui_tex.texture.Get() != nullptr && m_game_ui_tex.has_srv()) {
                 d3d12::render_srv_to_rtv(
                     m_game_batch.get(),
                     commands.cmd_list.Get(),
@@ -257,7 +278,7 @@ vr::EVRCompositorError D3D12Component::on_frame(VR* vr) {
                     ENGINE_SRC_COLOR
                 );
 
-                if (m_game_ui_tex.texture.Get() != nullptr && m_game_ui_tex.srv_heap != nullptr) {
+                if (m_game_ui_tex.texture.Get() != nullptr && m_game_ui_tex.has_srv()) {
                     d3d12::render_srv_to_rtv(
                         m_game_batch.get(),
                         commands.cmd_list.Get(),
@@ -388,23 +409,28 @@ vr::EVRCompositorError D3D12Component::on_frame(VR* vr) {
             auto openvr = vr->get_runtime<runtimes::OpenVR>();
             const auto submit_pose = openvr->get_pose_for_submit();
 
-            vr::D3D12TextureData_t left {
-                m_openvr.get_left().texture.Get(),
-                command_queue,
-                0
-            };
-            
-            vr::VRTextureWithPose_t left_eye{
-                (void*)&left, vr::TextureType_DirectX12, vr::ColorSpace_Auto,
-                submit_pose
-            };
-            const auto left_bounds = vr::VRTextureBounds_t{runtime->view_bounds[0][0], runtime->view_bounds[0][2],
-                                                           runtime->view_bounds[0][1], runtime->view_bounds[0][3]};
-            auto e = vr::VRCompositor()->Submit(vr::Eye_Left, &left_eye, &left_bounds, vr::EVRSubmitFlags::Submit_TextureWithPose);
+            if (vr->get_openvr_submit_queue()->is_enabled()) {
+                // Goes out together with the right eye
+                m_openvr.async_left = make_async_eye(m_openvr.get_left(), command_queue, submit_pose, runtime->get_submit_view_bounds(0));
+            } else {
+                vr::D3D12TextureData_t left {
+                    m_openvr.get_left().texture.Get(),
+                    command_queue,
+                    0
+                };
+                
+                vr::VRTextureWithPose_t left_eye{
+                    (void*)&left, vr::TextureType_DirectX12, vr::ColorSpace_Auto,
+                    submit_pose
+                };
+                const auto left_view_bounds = runtime->get_submit_view_bounds(0);
+                const auto left_bounds = vr::VRTextureBounds_t{left_view_bounds[0], left_view_bounds[2], left_view_bounds[1], left_view_bounds[3]};
+                auto e = vr::VRCompositor()->Submit(vr::Eye_Left, &left_eye, &left_bounds, vr::EVRSubmitFlags::Submit_TextureWithPose);
 
-            if (e != vr::VRCompositorError_None) {
-                spdlog::error("[VR] VRCompositor failed to submit left eye: {}", (int)e);
-                return e;
+                if (e != vr::VRCompositorError_None) {
+                    spdlog::error("[VR] VRCompositor failed to submit left eye: {}", (int)e);
+                    return e;
+                }
             }
         }
     } else {
@@ -480,7 +506,37 @@ vr::EVRCompositorError D3D12Component::on_frame(VR* vr) {
 
         // OpenVR texture
         // Copy the back buffer to the left and right eye textures.
-        if (runtime->is_openvr()) {
+        if (runtime->is_openvr() && vr->get_openvr_submit_queue()->is_enabled()) {
+            auto openvr = vr->get_runtime<runtimes::OpenVR>();
+            const auto submit_pose = openvr->get_pose_for_submit();
+
+            OpenVRSubmitQueue::Frame frame{};
+            frame.frame_count = (uint32_t)vr->m_frame_count;
+
+            if (!is_afr) {
+                m_openvr.copy_left(backbuffer.Get(), D3D12_RESOURCE_STATE_RENDER_TARGET);
+                frame.left = make_async_eye(m_openvr.get_left(), command_queue, submit_pose, runtime->get_submit_view_bounds(0));
+            } else {
+                frame.left = m_openvr.async_left;
+            }
+
+            if (!is_afr) {
+                m_openvr.copy_right(backbuffer.Get(), D3D12_RESOURCE_STATE_RENDER_TARGET);
+            } else {
+                m_openvr.copy_left_to_right(backbuffer.Get(), D3D12_RESOURCE_STATE_RENDER_TARGET);
+            }
+
+            frame.right = make_async_eye(m_openvr.get_right(), command_queue, submit_pose, runtime->get_submit_view_bounds(1));
+
+            // Can block for a bit if the compositor is behind, that's what keeps the textures from being reused too early
+            vr->get_openvr_submit_queue()->push(std::move(frame));
+            m_openvr.async_left.reset();
+
+            runtime->frame_synced = false;
+            vr->m_submitted = true;
+
+            ++m_openvr.texture_counter;
+        } else if (runtime->is_openvr()) {
             auto openvr = vr->get_runtime<runtimes::OpenVR>();
             const auto submit_pose = openvr->get_pose_for_submit();
 
@@ -497,8 +553,8 @@ vr::EVRCompositorError D3D12Component::on_frame(VR* vr) {
                     (void*)&left, vr::TextureType_DirectX12, vr::ColorSpace_Auto,
                     submit_pose
                 };
-                const auto left_bounds = vr::VRTextureBounds_t{runtime->view_bounds[0][0], runtime->view_bounds[0][2],
-                                                               runtime->view_bounds[0][1], runtime->view_bounds[0][3]};
+                const auto left_view_bounds = runtime->get_submit_view_bounds(0);
+                const auto left_bounds = vr::VRTextureBounds_t{left_view_bounds[0], left_view_bounds[2], left_view_bounds[1], left_view_bounds[3]};
                 auto e = vr::VRCompositor()->Submit(vr::Eye_Left, &left_eye, &left_bounds, vr::EVRSubmitFlags::Submit_TextureWithPose);
 
                 if (e != vr::VRCompositorError_None) {
@@ -523,8 +579,8 @@ vr::EVRCompositorError D3D12Component::on_frame(VR* vr) {
                 (void*)&right, vr::TextureType_DirectX12, vr::ColorSpace_Auto,
                 submit_pose
             };
-            const auto right_bounds = vr::VRTextureBounds_t{runtime->view_bounds[1][0], runtime->view_bounds[1][2],
-                                                            runtime->view_bounds[1][1], runtime->view_bounds[1][3]};
+            const auto right_view_bounds = runtime->get_submit_view_bounds(1);
+            const auto right_bounds = vr::VRTextureBounds_t{right_view_bounds[0], right_view_bounds[2], right_view_bounds[1], right_view_bounds[3]};
             auto e = vr::VRCompositor()->Submit(vr::Eye_Right, &right_eye, &right_bounds, vr::EVRSubmitFlags::Submit_TextureWithPose);
             runtime->frame_synced = false;
 
@@ -556,7 +612,7 @@ vr::EVRCompositorError D3D12Component::on_frame(VR* vr) {
                 vr->m_openxr->begin_frame();
             }
 
-            std::vector<XrCompositionLayerBaseHeader*> quad_layers{};
+            runtimes::OpenXR::QuadLayers quad_layers{};
 
             auto& openxr_overlay = vr->get_overlay_component().get_openxr();
 
@@ -659,11 +715,11 @@ void D3D12Component::draw_spectator_view(ID3D12GraphicsCommandList* command_list
         return;
     }
 
-    if (m_game_ui_tex.srv_heap == nullptr || m_game_ui_tex.srv_heap->Heap() == nullptr) {
+    if (m_game_ui_tex.get_srv_heap() == nullptr) {
         return;
     }
 
-    if (m_game_tex.texture == nullptr || m_game_tex.srv_heap == nullptr || m_game_tex.srv_heap->Heap() == nullptr) {
+    if (m_game_tex.texture == nullptr || m_game_tex.get_srv_heap() == nullptr) {
         return;
     }
 
@@ -698,7 +754,7 @@ void D3D12Component::draw_spectator_view(ID3D12GraphicsCommandList* command_list
         spdlog::info("[VR] Created backbuffer RTV (D3D12)");
     }
 
-    if (backbuffer_ctx.rtv_heap == nullptr || backbuffer_ctx.rtv_heap->Heap() == nullptr) {
+    if (!backbuffer_ctx.has_rtv()) {
         spdlog::error("[VR] Backbuffer RTV heap is null (D3D12)");
         return;
     }
@@ -794,7 +850,7 @@ void D3D12Component::draw_spectator_view(ID3D12GraphicsCommandList* command_list
     }
 
     // Set descriptor heaps
-    ID3D12DescriptorHeap* game_heaps[] = { m_game_tex.srv_heap->Heap() };
+    ID3D12DescriptorHeap* game_heaps[] = { m_game_tex.get_srv_heap() };
     command_list->SetDescriptorHeaps(1, game_heaps);
 
     batch->Draw(m_game_tex.get_srv_gpu(), 
@@ -807,7 +863,7 @@ void D3D12Component::draw_spectator_view(ID3D12GraphicsCommandList* command_list
     // UI
     //////
     // Set descriptor heaps
-    ID3D12DescriptorHeap* ui_heaps[] = { m_game_ui_tex.srv_heap->Heap() };
+    ID3D12DescriptorHeap* ui_heaps[] = { m_game_ui_tex.get_srv_heap() };
     command_list->SetDescriptorHeaps(1, ui_heaps);
 
     batch->Draw(m_game_ui_tex.get_srv_gpu(), 
@@ -863,7 +919,7 @@ void D3D12Component::clear_backbuffer() {
     }
 
     // oh well
-    if (backbuffer_ctx.rtv_heap == nullptr || backbuffer_ctx.rtv_heap->Heap() == nullptr) {
+    if (!backbuffer_ctx.has_rtv()) {
         return;
     }
 
@@ -895,6 +951,10 @@ void D3D12Component::on_reset(VR* vr) {
 
     auto runtime = vr->get_runtime();
 
+    // The worker may still be submitting the eye textures
+    vr->get_openvr_submit_queue()->stop();
+    m_openvr.async_left.reset();
+
     for (auto& ctx : m_openvr.left_eye_tex) {
         ctx.reset();
     }
@@ -922,6 +982,7 @@ void D3D12Component::on_reset(VR* vr) {
     m_openvr.ui_tex.reset();
     m_game_ui_tex.reset();
     m_game_tex.reset();
+    m_backbuffer_copy.reset(); // its descriptors would keep the shared heaps on the old device
     m_backbuffer_batch.reset();
     m_game_batch.reset();
     m_graphics_memory.reset();
@@ -1224,7 +1285,7 @@ std::optional<std::string> D3D12Component::OpenXR::create_swapchains() {
             return "Failed to create swapchain.";
         }
 
-        vr->m_openxr->swapchains[i] = swapchain;
+        vr->m_openxr->set_swapchain(i, swapchain);
 
         uint32_t image_count{};
         auto result = xrEnumerateSwapchainImages(swapchain.handle, 0, &image_count, nullptr);
@@ -1290,7 +1351,7 @@ std::optional<std::string> D3D12Component::OpenXR::create_swapchains() {
                 }
 
                 texture_ctx->texture.Reset();
-                texture_ctx->rtv_heap.reset();
+                texture_ctx->rtv.reset();
 
                 xrReleaseSwapchainImage(swapchain.handle, &release_info);
             }
@@ -1525,7 +1586,7 @@ void D3D12Component::OpenXR::destroy_swapchains() {
     }
 
     this->contexts.clear();
-    vr->m_openxr->swapchains.clear();
+    vr->m_openxr->clear_swapchains();
 }
 
 void D3D12Component::OpenXR::copy(
@@ -17,6 +17,7 @@
 
 #include "d3d12/CommandContext.hpp"
 #include "d3d12/TextureContext.hpp"
+#include "OpenVRSubmitQueue.hpp"
 
 class VR;
 
@@ -149,6 +150,9 @@ private:
         uint32_t texture_counter{0};
         D3D12Component* parent{};
 
+        // AFR left eye waiting for the right one when submitting through the OpenVRSubmitQueue
+        std::optional<OpenVRSubmitQueue::Eye> async_left{};
+
         friend class D3D12Component;
     } m_openvr;
 
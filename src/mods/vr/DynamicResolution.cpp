@@ -0,0 +1,107 @@
+#include <bit>
+
+#include <imgui.h>
+
+#include <utility/Config.hpp>
+
+#include "DynamicResolution.hpp"
+
+DynamicResolution::DynamicResolution() {
+    m_options = {
+        *m_enabled,
+        *m_min_scale,
+        *m_target_load
+    };
+}
+
+void DynamicResolution::on_config_save(utility::Config& cfg) {
+    for (IModValue& option : m_options) {
+        option.config_save(cfg);
+    }
+}
+
+void DynamicResolution::on_config_load(const utility::Config& cfg, bool set_defaults) {
+    for (IModValue& option : m_options) {
+        option.config_load(cfg, set_defaults);
+    }
+}
+
+void DynamicResolution::on_draw_ui() {
+    if (!ImGui::TreeNode("Dynamic Resolution")) {
+        return;
+    }
+
+    ImGui::TextWrapped("Lowers the resolution the game renders at when it can't keep up with the headset. Textures keep their full size.");
+
+    m_enabled->draw("Enabled");
+    m_min_scale->draw("Minimum Scale");
+    m_target_load->draw("Target Load");
+
+    ImGui::Text("Current Scale: %.3f", m_target_scale.load());
+
+    ImGui::TreePop();
+}
+
+void DynamicResolution::on_frame(const std::optional<Sample>& sample) {
+    if (!m_enabled->value()) {
+        m_controller.reset();
+        m_target_scale = 1.0f;
+        return;
+    }
+
+    if (sample) {
+        m_target_scale = m_controller.update(*sample, get_settings());
+    }
+}
+
+float DynamicResolution::latch_frame_scale(uint32_t frame) {
+    auto& slot = m_frame_scales[frame % FRAME_QUEUE_SIZE];
+    const auto packed = slot.load(std::memory_order_acquire);
+
+    if (unpack_frame(packed) == frame && unpack_scale(packed) > 0.0f) {
+        return unpack_scale(packed);
+    }
+
+    const auto scale = m_target_scale.load();
+    slot.store(pack(frame, scale), std::memory_order_release);
+    m_last_latched_scale = scale;
+
+    return scale;
+}
+
+float DynamicResolution::get_frame_scale(uint32_t frame) const {
+    const auto packed = m_frame_scales[frame % FRAME_QUEUE_SIZE].load(std::memory_order_acquire);
+
+    if (unpack_frame(packed) == frame && unpack_scale(packed) > 0.0f) {
+        return unpack_scale(packed);
+    }
+
+    // Frame counts out of sync with the engine, best guess is whatever was rendered last
+    return m_last_latched_scale.load();
+}
+
+void DynamicResolution::reset() {
+    m_controller.reset();
+    m_target_scale = 1.0f;
+    m_last_latched_scale = 1.0f;
+
+    for (auto& slot : m_frame_scales) {
+        slot = 0;
+    }
+}
+
+uint64_t DynamicResolution::pack(uint32_t frame, float scale) {
+    return ((uint64_t)frame << 32) | std::bit_cast<uint32_t>(scale);
+}
+
+float DynamicResolution::unpack_scale(uint64_t packed) {
+    return std::bit_cast<float>((uint32_t)(packed & 0xFFFFFFFF));
+}
+
+DynamicResolution::Controller::Settings DynamicResolution::get_settings() const {
+    return Controller::Settings {
+        .min_scale = m_min_scale->value(),
+        .max_scale = 1.0f,
+        .target_load = m_target_load->value()
+    };
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+#include "Mod.hpp"
+
+#include "DynamicResolutionController.hpp"
+
+// Shrinks the per-eye view rect the engine renders into when frames get too heavy, and grows it back
+// when there's headroom again. The render target and the swapchains always stay at their full size,
+// only the rect reported by FFakeStereoRenderingHook::adjust_view_rect changes, and the texture bounds
+// handed to the compositor get scaled by the same amount for the frame that was rendered with it.
+class DynamicResolution final : public ModComponent {
+public:
+    using Sample = DynamicResolutionController::Sample;
+    using Controller = DynamicResolutionController;
+
+    DynamicResolution();
+
+    void on_config_save(utility::Config& cfg) override;
+    void on_config_load(const utility::Config& cfg, bool set_defaults) override;
+    void on_draw_ui() override;
+
+    bool is_enabled() const {
+        return m_enabled->value();
+    }
+
+    // Present thread, once per submitted frame.
+    void on_frame(const std::optional<Sample>& sample);
+
+    // Game thread, from adjust_view_rect. The first call for a frame picks the scale and every
+    // later call for that frame (the other eye) gets the same one.
+    float latch_frame_scale(uint32_t frame);
+
+    // Present thread, the scale the given frame was rendered at.
+    float get_frame_scale(uint32_t frame) const;
+
+    void reset();
+
+private:
+    static constexpr size_t FRAME_QUEUE_SIZE = 4;
+
+    static uint64_t pack(uint32_t frame, float scale);
+    static float unpack_scale(uint64_t packed);
+    static uint32_t unpack_frame(uint64_t packed) {
+        return (uint32_t)(packed >> 32);
+    }
+
+    Controller::Settings get_settings() const;
+
+    const ModToggle::Ptr m_enabled{ ModToggle::create("VR_DynamicResolution", false) };
+    const ModSlider::Ptr m_min_scale{ ModSlider::create("VR_DynamicResolutionMinScale", 0.5f, 1.0f, 0.7f) };
+    const ModSlider::Ptr m_target_load{ ModSlider::create("VR_DynamicResolutionTargetLoad", 0.5f, 1.0f, 0.85f) };
+
+    Controller m_controller{}; // present thread only
+    std::atomic<float> m_target_scale{1.0f};
+    std::atomic<float> m_last_latched_scale{1.0f};
+
+    // frame << 32 | scale bits, written by the game thread, read at present
+    std::array<std::atomic<uint64_t>, FRAME_QUEUE_SIZE> m_frame_scales{};
+};
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <cmath>
+
+#include "DynamicResolutionController.hpp"
+
+namespace {
+// Weight of the newest sample in the smoothed load
+constexpr float LOAD_SMOOTHING = 0.2f;
+
+// Nothing changes while the load stays within this distance of the target
+constexpr float HYSTERESIS = 0.08f;
+
+// Going down has to be quick to avoid reprojection, going back up can take its time
+constexpr uint32_t FRAMES_TO_DECREASE = 3;
+constexpr uint32_t FRAMES_TO_INCREASE = 45;
+constexpr float MAX_DECREASE_STEP = 0.15f;
+constexpr float MAX_INCREASE_STEP = 0.05f;
+
+// A new scale takes a few frames to go through the pipeline and show up in the timings
+constexpr uint32_t COOLDOWN_FRAMES = 8;
+
+// Keeps tiny back and forth changes from reaching the engine
+constexpr float SCALE_QUANTUM = 1.0f / 64.0f;
+
+// A paced interval this much longer than the budget means the runtime had to skip a display refresh
+constexpr float MISSED_INTERVAL = 1.5f;
+}
+
+DynamicResolutionController::Sample DynamicResolutionController::from_paced_interval(float interval_ms, float waited_ms, float budget_ms) {
+    return Sample {
+        .frame_ms = interval_ms - std::clamp(waited_ms, 0.0f, interval_ms),
+        .budget_ms = budget_ms,
+        .missed = interval_ms > budget_ms * MISSED_INTERVAL
+    };
+}
+
+float DynamicResolutionController::update(const Sample& sample, const Settings& settings) {
+    const auto min_scale = std::clamp(settings.min_scale, 0.1f, 1.0f);
+    const auto max_scale = std::clamp(settings.max_scale, min_scale, 1.0f);
+
+    m_scale = std::clamp(m_scale, min_scale, max_scale);
+
+    if (!std::isfinite(sample.frame_ms) || !std::isfinite(sample.budget_ms) || sample.frame_ms < 0.0f || sample.budget_ms <= 0.0f) {
+        return m_scale;
+    }
+
+    const auto load = sample.frame_ms / sample.budget_ms;
+    m_load = m_has_load ? m_load + (load - m_load) * LOAD_SMOOTHING : load;
+    m_has_load = true;
+
+    if (m_cooldown > 0) {
+        --m_cooldown;
+        return m_scale;
+    }
+
+    const auto target = settings.target_load;
+
+    // A missed frame with the GPU nowhere near its budget is CPU bound, rendering fewer pixels won't help that
+    const auto over = m_load > target + HYSTERESIS || (sample.missed && m_load > target - HYSTERESIS);
+    const auto under = !sample.missed && m_load < target - HYSTERESIS;
+
+    m_frames_over = over ? m_frames_over + 1 : 0;
+    m_frames_under = under ? m_frames_under + 1 : 0;
+
+    float new_scale = m_scale;
+
+    // The cost goes with the pixel count, so with the square of the scale
+    if (m_frames_over >= FRAMES_TO_DECREASE) {
+        const auto effective_load = std::max(m_load, target + HYSTERESIS);
+        const auto wanted = m_scale * std::sqrt(target / effective_load);
+
+        new_scale = std::max(wanted, m_scale - MAX_DECREASE_STEP);
+        new_scale = std::floor(new_scale / SCALE_QUANTUM) * SCALE_QUANTUM;
+    } else if (m_frames_under >= FRAMES_TO_INCREASE) {
+        const auto wanted = m_scale * std::sqrt(target / std::max(m_load, 0.01f));
+
+        new_scale = std::min(wanted, m_scale + MAX_INCREASE_STEP);
+        new_scale = std::floor(new_scale / SCALE_QUANTUM) * SCALE_QUANTUM;
+    }
+
+    new_scale = std::clamp(new_scale, min_scale, max_scale);
+
+    if (new_scale != m_scale) {
+        // Assume the load follows the pixel count until real samples at the new scale come in,
+        // otherwise the stale average right after the change pushes it a second time.
+        m_load *= (new_scale * new_scale) / (m_scale * m_scale);
+        m_scale = new_scale;
+
+        m_frames_over = 0;
+        m_frames_under = 0;
+        m_cooldown = COOLDOWN_FRAMES;
+    }
+
+    return m_scale;
+}
+
+void DynamicResolutionController::reset() {
+    *this = DynamicResolutionController{};
+}
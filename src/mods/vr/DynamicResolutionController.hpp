@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+// The control loop behind DynamicResolution, with no dependencies on the mod, clocks or runtimes
+// so it behaves the same for the same samples and can be simulated.
+class DynamicResolutionController {
+public:
+    struct Sample {
+        float frame_ms{0.0f};  // GPU time on OpenVR, frame interval minus the time blocked in xrWaitFrame on OpenXR
+        float budget_ms{0.0f}; // display period
+        bool missed{false};    // the runtime had to reproject or drop this frame
+    };
+
+    struct Settings {
+        float min_scale{0.7f};
+        float max_scale{1.0f};
+        float target_load{0.85f}; // fraction of the budget to aim for
+    };
+
+    // For runtimes that pace the presents (xrWaitFrame) and don't report GPU timings. The interval alone
+    // is always about one display period no matter how heavy the frame was, so the time spent blocked waiting
+    // on the runtime is taken out of it, leaving what the game took (GPU included, through Present blocking).
+    static Sample from_paced_interval(float interval_ms, float waited_ms, float budget_ms);
+
+    // Returns the scale to render the next frames at.
+    float update(const Sample& sample, const Settings& settings);
+    void reset();
+
+    float get_scale() const {
+        return m_scale;
+    }
+
+    float get_load() const {
+        return m_load;
+    }
+
+private:
+    float m_scale{1.0f};
+    float m_load{0.0f}; // smoothed frame time / budget
+    bool m_has_load{false};
+
+    uint32_t m_frames_over{0};
+    uint32_t m_frames_under{0};
+    uint32_t m_cooldown{0};
+};
@@ -36,6 +36,7 @@
 #include <sdk/APlayerController.hpp>
 
 #include "Framework.hpp"
+#include "FlightRecorder.hpp"
 #include "Mods.hpp"
 
 #include <bdshemu.h>
@@ -127,6 +128,22 @@ void FFakeStereoRenderingHook::on_draw_ui() {
             m_tracking_system_hook->on_draw_ui();
         }
 
+        if (!!m_sceneview_data.constructor_hook && ImGui::TreeNode("Scene View Init Options Cache")) {
+            std::scoped_lock _{m_sceneview_data.mtx};
+
+            const auto stats = has_double_precision() ? m_sceneview_data.view_init_options_ue5.get_stats() : m_sceneview_data.view_init_options_ue4.get_stats();
+
+            ImGui::Text("Entries: %d / %d", (int)stats.size, (int)stats.capacity);
+            ImGui::Text("Hits: %llu", stats.hits);
+            ImGui::Text("Misses: %llu", stats.misses);
+            ImGui::Text("Evictions: %llu", stats.evictions);
+
+            const auto known_stats = m_sceneview_data.known_scene_states.get_stats();
+            ImGui::Text("Known Scene States: %d / %d (%llu evicted)", (int)known_stats.size, (int)known_stats.capacity, known_stats.evictions);
+
+            ImGui::TreePop();
+        }
+
         auto& data = m_viewport_rt_hook_data;
         std::scoped_lock _{data.retaddr_mutex};
 
@@ -329,8 +346,14 @@ void FFakeStereoRenderingHook::attempt_hook_game_engine_tick(uintptr_t return_ad
 
         hook->attempt_hooking();
 
+        auto& recorder = FlightRecorder::get();
+        recorder.end_frame();
+
         // Best place to run game thread jobs.
-        GameThreadWorker::get().execute();
+        {
+            FlightRecorder::Scope _{"engine", "GameThreadWorker::execute"};
+            GameThreadWorker::get().execute();
+        }
 
         if (hook->m_ignore_next_engine_tick) {
             hook->m_ignored_engine_delta = delta;
@@ -339,7 +362,11 @@ void FFakeStereoRenderingHook::attempt_hook_game_engine_tick(uintptr_t return_ad
         }
         
         g_framework->enable_engine_thread();
-        g_framework->run_imgui_frame(false);
+
+        {
+            FlightRecorder::Scope _{"engine", "Framework::run_imgui_frame"};
+            g_framework->run_imgui_frame(false);
+        }
 
         delta += hook->m_ignored_engine_delta;
         hook->m_ignored_engine_delta = 0.0f;
@@ -350,12 +377,17 @@ void FFakeStereoRenderingHook::attempt_hook_game_engine_tick(uintptr_t return_ad
 
         const auto& mods = g_framework->get_mods()->get_mods();
         for (auto& mod : mods) {
+            FlightRecorder::Scope _{"on_pre_engine_tick", mod->get_name()};
             mod->on_pre_engine_tick(engine, delta);
         }
 
-        const auto result = hook->m_tick_hook.call<void*>(engine, delta, idle);
+        const auto result = [&]() {
+            FlightRecorder::Scope _{"engine", "UGameEngine::Tick"};
+            return hook->m_tick_hook.call<void*>(engine, delta, idle);
+        }();
 
         for (auto& mod : mods) {
+            FlightRecorder::Scope _{"on_post_engine_tick", mod->get_name()};
             mod->on_post_engine_tick(engine, delta);
         }
 
@@ -2641,10 +2673,10 @@ sdk::FSceneView* FFakeStereoRenderingHook::sceneview_constructor(sdk::FSceneView
 
     if (has_valid_svsi) {
         if (is_ue5) {
-            auto& vio_entry = g_hook->m_sceneview_data.view_init_options_ue5[init_options_ue5->scene_view_state];
+            auto& vio_entry = g_hook->m_sceneview_data.view_init_options_ue5.get_or_insert(init_options_ue5->scene_view_state);
             memcpy(&vio_entry, init_options, sizeof(sdk::FSceneViewInitOptionsUE5));
         } else {
-            auto& vio_entry = g_hook->m_sceneview_data.view_init_options_ue4[init_options->scene_view_state];
+            auto& vio_entry = g_hook->m_sceneview_data.view_init_options_ue4.get_or_insert(init_options->scene_view_state);
             memcpy(&vio_entry, init_options, sizeof(sdk::FSceneViewInitOptionsUE4));
         }
     }
@@ -2653,6 +2685,13 @@ sdk::FSceneView* FFakeStereoRenderingHook::sceneview_constructor(sdk::FSceneView
     auto& last_frame_count = g_hook->m_sceneview_data.last_frame_count;
     auto& last_index = g_hook->m_sceneview_data.last_index;
 
+    // Scene states that haven't been constructed with in a while are most likely gone, their address could be reused by a new one.
+    if (last_frame_count != g_frame_count) {
+        known_scene_states.erase_if([](sdk::FSceneViewStateInterface*, uint32_t last_seen) {
+            return g_frame_count - last_seen > KNOWN_SCENE_STATE_MAX_AGE_FRAMES;
+        });
+    }
+
     if (last_frame_count != g_frame_count || last_index > 1) {
         last_index = 0;
     }
@@ -2742,11 +2781,15 @@ sdk::FSceneView* FFakeStereoRenderingHook::sceneview_constructor(sdk::FSceneView
 
     bool new_scene_state_inserted_this_frame = false;
 
-    if (init_options_scene_state != nullptr && !g_hook->m_sceneview_data.known_scene_states.contains(init_options_scene_state)) {
-        SPDLOG_INFO("Inserting new scene state {:x}", (uintptr_t)init_options_scene_state);
-        known_scene_states.insert(init_options_scene_state);
-        new_scene_state_inserted_this_frame = true;
-    } else if (init_options_scene_state == nullptr) {
+    if (init_options_scene_state != nullptr) {
+        if (auto last_seen = known_scene_states.find(init_options_scene_state); last_seen != nullptr) {
+            *last_seen = g_frame_count;
+        } else {
+            SPDLOG_INFO("Inserting new scene state {:x}", (uintptr_t)init_options_scene_state);
+            known_scene_states.get_or_insert(init_options_scene_state) = g_frame_count;
+            new_scene_state_inserted_this_frame = true;
+        }
+    } else {
         SPDLOG_ERROR_ONCE("Scene state passed to FSceneView constructor is null");
 
         if ((int32_t)init_options_stereo_pass < 0) {
@@ -2754,16 +2797,21 @@ sdk::FSceneView* FFakeStereoRenderingHook::sceneview_constructor(sdk::FSceneView
         }
     }
 
-    if (init_options_scene_state != nullptr && !new_scene_state_inserted_this_frame && vr->is_ghosting_fix_enabled() && !known_scene_states.empty() && vr->is_using_afr() && true_index == 1) {
+    if (init_options_scene_state != nullptr && !new_scene_state_inserted_this_frame && vr->is_ghosting_fix_enabled() && vr->is_using_afr() && true_index == 1) {
         init_options_stereo_pass = 1;
 
-        // Set the scene state to the one that isn't the current one
-        for (auto scene_state : known_scene_states) {
-            if (scene_state != init_options_scene_state) {
-                SPDLOG_INFO_ONCE("Setting scene state to {:x}", (uintptr_t)scene_state);
-                init_options_scene_state = scene_state;
-                break;
+        // Set the scene state to the most recently seen one that isn't the current one
+        sdk::FSceneViewStateInterface* other_scene_state{nullptr};
+
+        known_scene_states.for_each([&](sdk::FSceneViewStateInterface* scene_state, uint32_t) {
+            if (other_scene_state == nullptr && scene_state != init_options_scene_state) {
+                other_scene_state = scene_state;
             }
+        });
+
+        if (other_scene_state != nullptr) {
+            SPDLOG_INFO_ONCE("Setting scene state to {:x}", (uintptr_t)other_scene_state);
+            init_options_scene_state = other_scene_state;
         }
     }
 
@@ -2895,8 +2943,8 @@ void FFakeStereoRenderingHook::begin_render_viewfamily(ISceneViewExtension* exte
 
             auto& cached_init_options = g_hook->m_sceneview_data.view_init_options_ue4;
 
-            if (auto it = cached_init_options.find(init_options_a->scene_view_state); it != cached_init_options.end()) {
-                const auto& vio_entry = it->second;
+            if (const auto cached = cached_init_options.find(init_options_a->scene_view_state); cached != nullptr) {
+                const auto& vio_entry = *cached;
                 //memcpy(init_options_b, &vio_entry, sizeof(sdk::FSceneViewInitOptionsUE4));
                 init_options_b->view_origin = vio_entry.view_origin;
                 init_options_b->view_rotation_matrix = vio_entry.view_rotation_matrix;
@@ -4055,6 +4103,14 @@ void FFakeStereoRenderingHook::adjust_view_rect(FFakeStereoRendering* stereo, in
 
     const auto true_index = index_starts_from_one ? ((index + 1) % 2) : (index % 2);
     *x += *w * true_index;
+
+    // Only the rect inside each eye's half shrinks, the render target itself is left alone so nothing gets reallocated
+    const auto scale = VR::get()->get_dynamic_resolution()->latch_frame_scale(VR::get()->get_runtime()->internal_frame_count);
+
+    if (scale < 1.0f) {
+        *w = std::max<uint32_t>((uint32_t)(*w * scale), 1);
+        *h = std::max<uint32_t>((uint32_t)(*h * scale), 1);
+    }
 }
 
 __forceinline void FFakeStereoRenderingHook::calculate_stereo_view_offset(
@@ -4660,7 +4716,7 @@ uint32_t FFakeStereoRenderingHook::get_desired_number_of_views_hook(FFakeStereoR
         // We need to know about the second scene state to fix ghosting, so set the view count to 2
         // after we know about it, we can continue returning 1.
         if (is_stereo_enabled && vr->is_ghosting_fix_enabled() && vr->is_using_afr() &&
-            g_hook->m_sceneview_data.known_scene_states.size() < 2 && g_hook->m_fixed_localplayer_view_count &&
+            g_hook->m_sceneview_data.known_scene_states.get_stats().size < 2 && g_hook->m_fixed_localplayer_view_count &&
             !!g_hook->m_sceneview_data.constructor_hook && g_hook->m_has_view_extensions_installed)
         {
             // Only works correctly if view extensions are installed, so we can reset the view count to 1 without crashing
@@ -5104,6 +5160,8 @@ void FFakeStereoRenderingHook::post_init_properties(uintptr_t localplayer) {
     }
 
     g_hook->m_sceneview_data.known_scene_states.clear();
+    g_hook->m_sceneview_data.view_init_options_ue4.bump_generation();
+    g_hook->m_sceneview_data.view_init_options_ue5.bump_generation();
     g_hook->m_fixed_localplayer_view_count = true;
 }
 
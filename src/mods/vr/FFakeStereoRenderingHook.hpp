@@ -12,6 +12,8 @@
 #include <sdk/threading/ThreadWorker.hpp>
 #include <sdk/RHICommandList.hpp>
 
+#include "utility/LruCache.hpp"
+
 #include "IXRTrackingSystemHook.hpp"
 
 #include "Mod.hpp"
@@ -359,18 +361,28 @@ private:
 
     std::unique_ptr<ThreadWorker<FRHICommandListImmediate*>> m_slate_thread_worker{std::make_unique<ThreadWorker<FRHICommandListImmediate*>>()};
 
+    // Scene states seen in the constructor, with the frame they were last seen on. Only the player's views
+    // need to be in there, bounded and aged out so transient views don't pile up and stale pointers don't stick around.
+    static constexpr size_t KNOWN_SCENE_STATES_SIZE = 8;
+    static constexpr uint32_t KNOWN_SCENE_STATE_MAX_AGE_FRAMES = 300;
+
+    // For keeping track of what the states were before our modifications.
+    // Bounded because the engine creates a new scene state for every transient view (scene captures, reflections...)
+    // and we never find out when they get destroyed. Only the player's views are actually looked up again.
+    static constexpr size_t VIEW_INIT_OPTIONS_CACHE_SIZE = 16;
+
     struct {
         std::recursive_mutex mtx{};
         safetyhook::InlineHook constructor_hook{};
-        std::unordered_set<sdk::FSceneViewStateInterface*> known_scene_states;
         bool inside_post_init_properties{false};
 
+        utility::LruCache<sdk::FSceneViewStateInterface*, uint32_t, KNOWN_SCENE_STATES_SIZE> known_scene_states{};
+
         uint32_t last_frame_count{};
         uint32_t last_index{};
 
-        // For keeping track of what the states were before our modifications.
-        std::unordered_map<sdk::FSceneViewStateInterface*, sdk::FSceneViewInitOptionsUE4> view_init_options_ue4{};
-        std::unordered_map<sdk::FSceneViewStateInterface*, sdk::FSceneViewInitOptionsUE5> view_init_options_ue5{};
+        utility::LruCache<sdk::FSceneViewStateInterface*, sdk::FSceneViewInitOptionsUE4, VIEW_INIT_OPTIONS_CACHE_SIZE> view_init_options_ue4{};
+        utility::LruCache<sdk::FSceneViewStateInterface*, sdk::FSceneViewInitOptionsUE5, VIEW_INIT_OPTIONS_CACHE_SIZE> view_init_options_ue5{};
     } m_sceneview_data;
 
     safetyhook::InlineHook m_localplayer_get_viewpoint_hook{};
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cmath>
+
+#include "HapticCoalescer.hpp"
+
+namespace {
+// Anything this far in the future is most likely garbage from a plugin, not worth holding on to.
+constexpr auto MAX_SCHEDULE_AHEAD = std::chrono::seconds(10);
+}
+
+HapticCoalescer::HapticCoalescer() {
+    m_devices.reserve(4);
+    m_scheduled.reserve(16);
+}
+
+void HapticCoalescer::request(const Settings& settings, float seconds_from_now, float duration, float frequency, float amplitude, uint64_t source,
+                              Clock::time_point now, Submissions& out)
+{
+    if (!std::isfinite(seconds_from_now) || !std::isfinite(duration) || duration < 0.0f) {
+        return;
+    }
+
+    const auto delay = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(std::max(seconds_from_now, 0.0f)));
+
+    if (delay > MAX_SCHEDULE_AHEAD) {
+        return;
+    }
+
+    Pulse pulse{};
+    pulse.start = now + delay;
+    pulse.end = pulse.start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(duration));
+    pulse.frequency = frequency;
+    pulse.amplitude = amplitude;
+    pulse.source = source;
+
+    ++m_stats.requested;
+
+    if (pulse.start > now) {
+        ++m_stats.scheduled;
+        m_scheduled.push_back(pulse);
+        return;
+    }
+
+    enqueue(settings, pulse, now, out);
+}
+
+void HapticCoalescer::update(const Settings& settings, Clock::time_point now, Submissions& out) {
+    // Move any scheduled pulses that became due over to their devices
+    for (auto it = m_scheduled.begin(); it != m_scheduled.end();) {
+        if (it->start > now) {
+            ++it;
+            continue;
+        }
+
+        const auto pulse = *it;
+        it = m_scheduled.erase(it);
+
+        if (pulse.end > now || is_stop(pulse)) {
+            enqueue(settings, pulse, now, out);
+        } else {
+            ++m_stats.dropped;
+        }
+    }
+
+    for (auto& device : m_devices) {
+        flush(settings, device, now, out);
+    }
+}
+
+void HapticCoalescer::reset() {
+    m_devices.clear();
+    m_scheduled.clear();
+}
+
+bool HapticCoalescer::is_same_vibration(const Pulse& a, const Pulse& b) {
+    constexpr float EPSILON = 0.001f;
+
+    return std::abs(a.amplitude - b.amplitude) <= EPSILON && std::abs(a.frequency - b.frequency) <= EPSILON;
+}
+
+bool HapticCoalescer::is_stop(const Pulse& pulse) {
+    return pulse.amplitude <= 0.0f || pulse.end <= pulse.start;
+}
+
+bool HapticCoalescer::is_covered_by(const Pulse& pulse, const Pulse& active) {
+    // A different (even weaker) vibration replaces whatever is playing, same as a new XInputSetState would
+    return pulse.end <= active.end && is_same_vibration(pulse, active);
+}
+
+void HapticCoalescer::merge(Pulse& into, const Pulse& pulse) {
+    // The stronger pulse decides what it feels like
+    if (pulse.amplitude > into.amplitude) {
+        into.amplitude = pulse.amplitude;
+        into.frequency = pulse.frequency;
+    }
+
+    into.start = std::min(into.start, pulse.start);
+    into.end = std::max(into.end, pulse.end);
+}
+
+HapticCoalescer::Device& HapticCoalescer::get_device(uint64_t source) {
+    for (auto& device : m_devices) {
+        if (device.source == source) {
+            return device;
+        }
+    }
+
+    auto& device = m_devices.emplace_back();
+    device.source = source;
+
+    return device;
+}
+
+void HapticCoalescer::enqueue(const Settings& settings, const Pulse& pulse, Clock::time_point now, Submissions& out) {
+    auto& device = get_device(pulse.source);
+
+    if (is_stop(pulse)) {
+        stop(device, now, out);
+        return;
+    }
+
+    if (device.pending) {
+        ++m_stats.merged;
+        merge(*device.pending, pulse);
+    } else {
+        device.pending = pulse;
+    }
+
+    flush(settings, device, now, out);
+}
+
+void HapticCoalescer::stop(Device& device, Clock::time_point now, Submissions& out) {
+    // Anything still waiting on the rate limit was asked for before the stop
+    if (device.pending) {
+        ++m_stats.dropped;
+        device.pending.reset();
+    }
+
+    // Only skipped when nothing we sent can still be playing, games that call
+    // XInputSetState(0) every frame would otherwise send a stop every frame.
+    // Never held back by the rate limit.
+    if (!device.active || device.active->end <= now) {
+        device.active.reset();
+        return;
+    }
+
+    out.push_back({0.0f, 0.0f, 0.0f, 0.0f, device.source});
+
+    ++m_stats.submitted;
+    device.active.reset();
+    device.last_submit = now;
+}
+
+void HapticCoalescer::flush(const Settings& settings, Device& device, Clock::time_point now, Submissions& out) {
+    if (!device.pending) {
+        return;
+    }
+
+    auto& pending = *device.pending;
+
+    if (pending.end <= now) {
+        ++m_stats.dropped;
+        device.pending.reset();
+        return;
+    }
+
+    if (device.active && device.active->end > now) {
+        const auto& active = *device.active;
+
+        // Whatever is still playing already covers this one, or it's the same vibration
+        // and has enough time left on it that it's not worth extending yet.
+        if (is_covered_by(pending, active) || (is_same_vibration(pending, active) && active.end - now > settings.refresh_margin)) {
+            ++m_stats.dropped;
+            device.pending.reset();
+            return;
+        }
+    }
+
+    if (now - device.last_submit < settings.min_interval) {
+        return; // picked up by update() later
+    }
+
+    const auto duration = std::chrono::duration<float>(pending.end - now).count();
+    out.push_back({0.0f, duration, pending.frequency, pending.amplitude, device.source});
+
+    ++m_stats.submitted;
+    pending.start = now;
+    device.active = pending;
+    device.last_submit = now;
+    device.pending.reset();
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// The merging and rate limiting behind HapticScheduler, with no dependencies on the mod or the runtimes
+// so recorded haptic traces can be replayed through it. Time is always passed in, and whatever should go
+// to the runtime is handed back instead of being sent, so the caller can send it without holding a lock.
+class HapticCoalescer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        Clock::duration min_interval{};
+        Clock::duration refresh_margin{};
+    };
+
+    struct Submission {
+        float seconds_from_now{0.0f};
+        float duration{0.0f};
+        float frequency{0.0f};
+        float amplitude{0.0f};
+        uint64_t source{0};
+    };
+
+    using Submissions = std::vector<Submission>;
+
+    struct Stats {
+        uint64_t requested{0};
+        uint64_t submitted{0};
+        uint64_t merged{0};
+        uint64_t dropped{0};
+        uint64_t scheduled{0};
+    };
+
+    HapticCoalescer();
+
+    void request(const Settings& settings, float seconds_from_now, float duration, float frequency, float amplitude, uint64_t source,
+                 Clock::time_point now, Submissions& out);
+
+    // Counts a request that skipped the coalescing and went straight to the runtime.
+    void request_passthrough() {
+        ++m_stats.requested;
+        ++m_stats.submitted;
+    }
+
+    // Anything that was held back by the rate limit or has become due.
+    void update(const Settings& settings, Clock::time_point now, Submissions& out);
+
+    void reset();
+
+    const Stats& get_stats() const {
+        return m_stats;
+    }
+
+private:
+    struct Pulse {
+        Clock::time_point start{};
+        Clock::time_point end{};
+        float frequency{0.0f};
+        float amplitude{0.0f};
+        uint64_t source{0};
+    };
+
+    struct Device {
+        uint64_t source{0};
+        std::optional<Pulse> active{};  // last pulse sent to the runtime
+        std::optional<Pulse> pending{}; // merged pulses waiting on the rate limit
+        Clock::time_point last_submit{};
+    };
+
+    static bool is_stop(const Pulse& pulse);
+    static bool is_same_vibration(const Pulse& a, const Pulse& b);
+    static bool is_covered_by(const Pulse& pulse, const Pulse& active);
+    static void merge(Pulse& into, const Pulse& pulse);
+
+    Device& get_device(uint64_t source);
+    void enqueue(const Settings& settings, const Pulse& pulse, Clock::time_point now, Submissions& out);
+    void stop(Device& device, Clock::time_point now, Submissions& out);
+    void flush(const Settings& settings, Device& device, Clock::time_point now, Submissions& out);
+
+    std::vector<Device> m_devices{};
+    std::vector<Pulse> m_scheduled{};
+    Stats m_stats{};
+};
@@ -0,0 +1,100 @@
+#include <imgui.h>
+
+#include <utility/Config.hpp>
+
+#include "HapticScheduler.hpp"
+
+HapticScheduler::HapticScheduler(SubmitFn submit)
+    : m_submit{std::move(submit)}
+{
+    m_options = {
+        *m_enabled,
+        *m_min_interval_ms,
+        *m_refresh_margin_ms
+    };
+}
+
+void HapticScheduler::on_config_save(utility::Config& cfg) {
+    for (IModValue& option : m_options) {
+        option.config_save(cfg);
+    }
+}
+
+void HapticScheduler::on_config_load(const utility::Config& cfg, bool set_defaults) {
+    for (IModValue& option : m_options) {
+        option.config_load(cfg, set_defaults);
+    }
+}
+
+void HapticScheduler::on_draw_ui() {
+    if (!ImGui::TreeNode("Haptics")) {
+        return;
+    }
+
+    m_enabled->draw("Coalesce Haptics");
+    m_min_interval_ms->draw("Min Interval (ms)");
+    m_refresh_margin_ms->draw("Refresh Margin (ms)");
+
+    const auto stats = get_stats();
+    ImGui::Text("Requested: %llu, Submitted: %llu", stats.requested, stats.submitted);
+    ImGui::Text("Merged: %llu, Dropped: %llu, Scheduled: %llu", stats.merged, stats.dropped, stats.scheduled);
+
+    ImGui::TreePop();
+}
+
+void HapticScheduler::request(float seconds_from_now, float duration, float frequency, float amplitude, uint64_t source) {
+    if (!m_enabled->value()) {
+        // Straight through, the runtime handles the delay itself (OpenXR just ignores it)
+        {
+            std::scoped_lock _{m_mtx};
+            m_coalescer.request_passthrough();
+        }
+
+        m_submit(seconds_from_now, duration, frequency, amplitude, source);
+        return;
+    }
+
+    const auto settings = get_settings();
+    HapticCoalescer::Submissions submissions{};
+
+    {
+        std::scoped_lock _{m_mtx};
+        m_coalescer.request(settings, seconds_from_now, duration, frequency, amplitude, source, HapticCoalescer::Clock::now(), submissions);
+    }
+
+    submit(submissions);
+}
+
+void HapticScheduler::update() {
+    const auto settings = get_settings();
+    HapticCoalescer::Submissions submissions{};
+
+    {
+        std::scoped_lock _{m_mtx};
+        m_coalescer.update(settings, HapticCoalescer::Clock::now(), submissions);
+    }
+
+    submit(submissions);
+}
+
+void HapticScheduler::reset() {
+    std::scoped_lock _{m_mtx};
+    m_coalescer.reset();
+}
+
+HapticCoalescer::Settings HapticScheduler::get_settings() const {
+    const auto to_duration = [](float ms) {
+        return std::chrono::duration_cast<HapticCoalescer::Clock::duration>(std::chrono::duration<float, std::milli>(ms));
+    };
+
+    return HapticCoalescer::Settings{
+        .min_interval = to_duration(m_min_interval_ms->value()),
+        .refresh_margin = to_duration(m_refresh_margin_ms->value())
+    };
+}
+
+void HapticScheduler::submit(const HapticCoalescer::Submissions& submissions) {
+    for (const auto& s : submissions) {
+        m_submit(s.seconds_from_now, s.duration, s.frequency, s.amplitude, s.source);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "Mod.hpp"
+
+#include "HapticCoalescer.hpp"
+
+// Sits between everything that wants to rumble (XInput forwarding, D-Pad gestures, plugins, Lua) and the runtime.
+// Games that call XInputSetState every frame would otherwise send a haptic action to the runtime every frame,
+// so overlapping pulses on the same device get merged, repeats of a vibration that's still playing get dropped,
+// and submissions per device are rate limited. A new vibration replaces the one playing and stops always go through.
+// Pulses scheduled in the future are held until they're due. The actual logic is in HapticCoalescer.
+// The runtime is only ever called with the lock released, it can block (OpenVR) and plugins can call back in.
+class HapticScheduler final : public ModComponent {
+public:
+    // Source is a vr::VRInputValueHandle_t (or a VRRuntime::Hand on OpenXR)
+    using SubmitFn = std::function<void(float seconds_from_now, float duration, float frequency, float amplitude, uint64_t source)>;
+
+    using Stats = HapticCoalescer::Stats;
+
+    HapticScheduler(SubmitFn submit);
+
+    void on_config_save(utility::Config& cfg) override;
+    void on_config_load(const utility::Config& cfg, bool set_defaults) override;
+    void on_draw_ui() override;
+
+    void request(float seconds_from_now, float duration, float frequency, float amplitude, uint64_t source);
+
+    // Sends anything that was held back by the rate limit or has become due. Called once per frame.
+    void update();
+
+    // Forgets everything, e.g. when the runtime gets reinitialized.
+    void reset();
+
+    Stats get_stats() const {
+        std::scoped_lock _{m_mtx};
+        return m_coalescer.get_stats();
+    }
+
+private:
+    HapticCoalescer::Settings get_settings() const;
+    void submit(const HapticCoalescer::Submissions& submissions);
+
+    const ModToggle::Ptr m_enabled{ ModToggle::create("Haptics_Coalescing", true) };
+    const ModSlider::Ptr m_min_interval_ms{ ModSlider::create("Haptics_MinIntervalMs", 0.0f, 100.0f, 10.0f) };
+    const ModSlider::Ptr m_refresh_margin_ms{ ModSlider::create("Haptics_RefreshMarginMs", 0.0f, 200.0f, 50.0f) };
+
+    SubmitFn m_submit{};
+
+    mutable std::mutex m_mtx{};
+    HapticCoalescer m_coalescer{};
+};
@@ -0,0 +1,71 @@
+#include "InputSnapshot.hpp"
+
+std::shared_ptr<const InputSnapshot> InputSnapshot::build(const Queries& queries, std::span<const vr::VRActionHandle_t> actions,
+                                                          vr::VRInputValueHandle_t left_joystick, vr::VRInputValueHandle_t right_joystick)
+{
+    auto snapshot = std::make_shared<InputSnapshot>();
+    snapshot->left_joystick = left_joystick;
+    snapshot->right_joystick = right_joystick;
+    snapshot->actions.reserve(actions.size());
+
+    for (const auto action : actions) {
+        if (action == vr::k_ulInvalidActionHandle) {
+            continue;
+        }
+
+        snapshot->actions.push_back({
+            .action = action,
+            .left = queries.query_action_active(action, left_joystick),
+            .right = queries.query_action_active(action, right_joystick)
+        });
+    }
+
+    std::sort(snapshot->actions.begin(), snapshot->actions.end(), [](const auto& a, const auto& b) {
+        return a.action < b.action;
+    });
+
+    snapshot->left_axis = queries.query_joystick_axis(left_joystick);
+    snapshot->right_axis = queries.query_joystick_axis(right_joystick);
+
+    return snapshot;
+}
+
+bool InputSnapshot::is_action_active(const InputSnapshot* snapshot, const Queries& queries, vr::VRActionHandle_t action, vr::VRInputValueHandle_t source) {
+    if (action == vr::k_ulInvalidActionHandle) {
+        return false;
+    }
+
+    if (snapshot != nullptr) {
+        if (const auto active = snapshot->is_action_active(action, source); active.has_value()) {
+            return *active;
+        }
+    }
+
+    return queries.query_action_active(action, source);
+}
+
+bool InputSnapshot::is_action_active_any_joystick(const InputSnapshot* snapshot, const Queries& queries, vr::VRActionHandle_t action,
+                                                  vr::VRInputValueHandle_t left_joystick, vr::VRInputValueHandle_t right_joystick)
+{
+    if (action == vr::k_ulInvalidActionHandle) {
+        return false;
+    }
+
+    if (snapshot != nullptr) {
+        if (const auto state = snapshot->find(action); state != nullptr) {
+            return state->left || state->right;
+        }
+    }
+
+    return is_action_active(snapshot, queries, action, left_joystick) || is_action_active(snapshot, queries, action, right_joystick);
+}
+
+Vector2f InputSnapshot::get_joystick_axis(const InputSnapshot* snapshot, const Queries& queries, vr::VRInputValueHandle_t source) {
+    if (snapshot != nullptr) {
+        if (const auto axis = snapshot->get_joystick_axis(source); axis.has_value()) {
+            return *axis;
+        }
+    }
+
+    return queries.query_joystick_axis(source);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <openvr.h>
+#include <sdk/Math.hpp>
+
+// Every bound action and both sticks, resolved once per input update in VR::update_action_states.
+// XInput emulation, plugins and Lua all read from this instead of going back to the runtime
+// every time the game polls (which can be several times a frame per user index).
+struct InputSnapshot {
+    // The live runtime queries the snapshot is built from, and what anything it doesn't cover falls through to.
+    class Queries {
+    public:
+        virtual ~Queries() = default;
+
+        virtual bool query_action_active(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source) const = 0;
+        virtual Vector2f query_joystick_axis(vr::VRInputValueHandle_t source) const = 0;
+    };
+
+    struct ActionState {
+        vr::VRActionHandle_t action{vr::k_ulInvalidActionHandle};
+        bool left{false};
+        bool right{false};
+    };
+
+    // Queries each action for both hands and both stick axes, invalid action handles are skipped.
+    static std::shared_ptr<const InputSnapshot> build(const Queries& queries, std::span<const vr::VRActionHandle_t> actions,
+                                                      vr::VRInputValueHandle_t left_joystick, vr::VRInputValueHandle_t right_joystick);
+
+    // From the snapshot if it has the answer, otherwise straight from the runtime. The snapshot can be null.
+    static bool is_action_active(const InputSnapshot* snapshot, const Queries& queries, vr::VRActionHandle_t action, vr::VRInputValueHandle_t source);
+    static bool is_action_active_any_joystick(const InputSnapshot* snapshot, const Queries& queries, vr::VRActionHandle_t action,
+                                              vr::VRInputValueHandle_t left_joystick, vr::VRInputValueHandle_t right_joystick);
+    static Vector2f get_joystick_axis(const InputSnapshot* snapshot, const Queries& queries, vr::VRInputValueHandle_t source);
+
+    std::vector<ActionState> actions{}; // sorted by action handle
+    vr::VRInputValueHandle_t left_joystick{};
+    vr::VRInputValueHandle_t right_joystick{};
+    Vector2f left_axis{};
+    Vector2f right_axis{};
+
+    const ActionState* find(vr::VRActionHandle_t action) const {
+        const auto it = std::lower_bound(actions.begin(), actions.end(), action, [](const ActionState& state, vr::VRActionHandle_t a) {
+            return state.action < a;
+        });
+
+        if (it == actions.end() || it->action != action) {
+            return nullptr;
+        }
+
+        return &*it;
+    }
+
+    // nullopt if the action/source isn't part of the snapshot
+    std::optional<bool> is_action_active(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source) const {
+        const auto state = find(action);
+
+        if (state == nullptr) {
+            return std::nullopt;
+        }
+
+        if (source == left_joystick) {
+            return state->left;
+        }
+
+        if (source == right_joystick) {
+            return state->right;
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<Vector2f> get_joystick_axis(vr::VRInputValueHandle_t source) const {
+        if (source == left_joystick) {
+            return left_axis;
+        }
+
+        if (source == right_joystick) {
+            return right_axis;
+        }
+
+        return std::nullopt;
+    }
+};
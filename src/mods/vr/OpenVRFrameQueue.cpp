@@ -0,0 +1,186 @@
+#include <algorithm>
+
+#include <spdlog/spdlog.h>
+
+#include "OpenVRFrameQueue.hpp"
+
+namespace {
+float elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+OpenVRFrameQueue::OpenVRFrameQueue(std::unique_ptr<Compositor> compositor)
+    : m_compositor{std::move(compositor)}
+{
+}
+
+OpenVRFrameQueue::~OpenVRFrameQueue() {
+    stop();
+}
+
+void OpenVRFrameQueue::push(Frame&& frame, const Settings& settings) {
+    std::unique_lock lock{m_mtx};
+
+    if (m_worker == nullptr) {
+        start_locked();
+    }
+
+    const auto depth = std::clamp<size_t>(settings.depth, 1, MAX_DEPTH);
+    const auto outstanding = [&]() { return m_count + (m_in_flight ? 1 : 0); };
+
+    // A zero timeout never waits, the frame just replaces the oldest pending one below
+    if (outstanding() >= depth && settings.stall_timeout.count() > 0) {
+        const auto start = std::chrono::steady_clock::now();
+
+        ++m_stats.stalls;
+        m_space_cv.wait_for(lock, settings.stall_timeout, [&]() { return outstanding() < depth; });
+        m_stats.stall_ms += elapsed_ms(start);
+    }
+
+    // Still full, the compositor is further behind than we're willing to wait for.
+    // Replace the oldest frame it hasn't picked up yet, that one would only go out late anyway.
+    // The one in flight can't be dropped, so with nothing pending this goes one over the depth,
+    // which MAX_DEPTH leaves room for.
+    if (outstanding() >= depth && m_count > 0) {
+        m_head = (m_head + 1) % m_frames.size();
+        --m_count;
+        ++m_stats.dropped;
+    }
+
+    m_frames[(m_head + m_count) % m_frames.size()] = std::move(frame);
+    ++m_count;
+    ++m_stats.pushed;
+    m_stats.max_depth = std::max(m_stats.max_depth, outstanding());
+
+    lock.unlock();
+    m_cv.notify_one();
+}
+
+std::optional<OpenVRFrameQueue::Poses> OpenVRFrameQueue::get_poses(uint64_t last_version) const {
+    std::scoped_lock _{m_mtx};
+
+    if (!m_has_poses || m_poses.version <= last_version) {
+        return std::nullopt;
+    }
+
+    return m_poses;
+}
+
+void OpenVRFrameQueue::stop() {
+    std::unique_ptr<std::jthread> worker{};
+
+    {
+        std::scoped_lock _{m_mtx};
+        worker = std::move(m_worker);
+    }
+
+    if (worker == nullptr) {
+        return;
+    }
+
+    spdlog::info("[OpenVRSubmitQueue] Stopping worker");
+
+    // Whatever is still queued gets submitted before the worker exits
+    worker->request_stop();
+    worker->join();
+
+    std::scoped_lock _{m_mtx};
+    m_head = 0;
+    m_count = 0;
+    m_in_flight = false;
+    m_has_poses = false;
+    m_space_cv.notify_all();
+}
+
+void OpenVRFrameQueue::start_locked() {
+    spdlog::info("[OpenVRSubmitQueue] Starting worker");
+
+    m_head = 0;
+    m_count = 0;
+    m_in_flight = false;
+    m_has_poses = false;
+    m_worker = std::make_unique<std::jthread>([this](std::stop_token stop) {
+        worker_proc(stop);
+    });
+}
+
+void OpenVRFrameQueue::worker_proc(std::stop_token stop) {
+    // Poses are written here and swapped into m_poses under the lock
+    auto poses = std::make_unique<Poses>();
+
+    while (true) {
+        Frame frame{};
+
+        {
+            std::unique_lock lock{m_mtx};
+            m_cv.wait(lock, stop, [&]() { return m_count > 0; });
+
+            if (m_count == 0) {
+                break; // stopped and drained
+            }
+
+            frame = std::move(m_frames[m_head]);
+            m_head = (m_head + 1) % m_frames.size();
+            --m_count;
+            m_in_flight = true;
+        }
+
+        submit_frame(frame);
+        m_compositor->post_present_handoff();
+
+        const auto wait_start = std::chrono::steady_clock::now();
+        poses->result = m_compositor->wait_get_poses(poses->render, poses->game);
+        const auto wait_ms = elapsed_ms(wait_start);
+
+        {
+            std::scoped_lock _{m_mtx};
+            m_in_flight = false;
+            m_stats.last_wait_get_poses_ms = wait_ms;
+
+            if (poses->result == vr::VRCompositorError_None) {
+                poses->version = m_poses.version + 1;
+                std::swap(m_poses, *poses);
+                m_has_poses = true;
+            }
+        }
+
+        m_space_cv.notify_all();
+    }
+}
+
+void OpenVRFrameQueue::submit_frame(const Frame& frame) {
+    uint64_t failed{0};
+    uint64_t fence_timeouts{0};
+
+    const auto submit_eye = [&](vr::EVREye eye_index, const Eye& eye) {
+        // Submitting anyway is fine, SteamVR reads the texture on the same queue the copy went through
+        if (!m_compositor->wait_for_copy(eye)) {
+            ++fence_timeouts;
+        }
+
+        // The texture data has to be the copy that lives in the frame, the handle gets read during Submit
+        vr::VRTextureWithPose_t texture{
+            (void*)&eye.texture, vr::TextureType_DirectX12, vr::ColorSpace_Auto,
+            eye.pose
+        };
+
+        const auto e = m_compositor->submit(eye_index, &texture, &eye.bounds, vr::EVRSubmitFlags::Submit_TextureWithPose);
+
+        if (e != vr::VRCompositorError_None) {
+            spdlog::error("[OpenVRSubmitQueue] Failed to submit {} eye of frame {}: {}", eye_index == vr::Eye_Left ? "left" : "right", frame.frame_count, (int)e);
+            ++failed;
+        }
+    };
+
+    if (frame.left) {
+        submit_eye(vr::Eye_Left, *frame.left);
+    }
+
+    submit_eye(vr::Eye_Right, frame.right);
+
+    std::scoped_lock _{m_mtx};
+    ++m_stats.submitted;
+    m_stats.failed += failed;
+    m_stats.fence_timeouts += fence_timeouts;
+}
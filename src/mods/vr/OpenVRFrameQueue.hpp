@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+
+#include <openvr.h>
+
+struct ID3D12Fence;
+
+// The queue and worker behind OpenVRSubmitQueue, with no dependencies on the mod, D3D12 or the runtime
+// so it can be driven by a fake compositor. The present thread pushes frames into a bounded ring, the worker
+// waits on each eye's copy, submits both eyes, hands off and blocks in WaitGetPoses. The poses it gets back
+// are published as a snapshot.
+class OpenVRFrameQueue {
+public:
+    static constexpr size_t MAX_DEPTH = 2; // the D3D12 eye textures are triple buffered, one is always being written
+
+    struct Eye {
+        vr::D3D12TextureData_t texture{};
+        vr::HmdMatrix34_t pose{};
+        vr::VRTextureBounds_t bounds{};
+
+        // Signaled once the copy into the texture is done. Can be null if there's nothing to wait for.
+        ID3D12Fence* fence{nullptr};
+        uint64_t fence_value{0};
+    };
+
+    // Everything the worker waits on or says to the compositor goes through this, so it can be swapped out for a fake one.
+    // Only ever called from the worker thread.
+    class Compositor {
+    public:
+        virtual ~Compositor() = default;
+
+        virtual bool wait_for_copy(const Eye& eye) = 0; // false if the copy didn't finish in time
+        virtual vr::EVRCompositorError submit(vr::EVREye eye, const vr::Texture_t* texture, const vr::VRTextureBounds_t* bounds, vr::EVRSubmitFlags flags) = 0;
+        virtual void post_present_handoff() = 0;
+        virtual vr::EVRCompositorError wait_get_poses(std::span<vr::TrackedDevicePose_t> render_poses, std::span<vr::TrackedDevicePose_t> game_poses) = 0;
+    };
+
+    struct Frame {
+        std::optional<Eye> left{}; // missing on AFR frames, the left eye went out with the previous one
+        Eye right{};
+        uint32_t frame_count{0};
+    };
+
+    struct Poses {
+        std::array<vr::TrackedDevicePose_t, vr::k_unMaxTrackedDeviceCount> render{};
+        std::array<vr::TrackedDevicePose_t, vr::k_unMaxTrackedDeviceCount> game{};
+        vr::EVRCompositorError result{vr::VRCompositorError_None};
+        uint64_t version{0};
+    };
+
+    struct Settings {
+        size_t depth{1};
+        std::chrono::milliseconds stall_timeout{33};
+    };
+
+    struct Stats {
+        uint64_t pushed{0};
+        uint64_t submitted{0};
+        uint64_t dropped{0};       // pushed but replaced by a newer frame before the worker got to it
+        uint64_t stalls{0};        // pushes that had to wait for room in the queue
+        uint64_t failed{0};        // Submit returned an error
+        uint64_t fence_timeouts{0};
+        size_t max_depth{0};       // most frames pending or being submitted right after a push
+        float stall_ms{0.0f};      // total time the present thread spent waiting
+        float last_wait_get_poses_ms{0.0f};
+    };
+
+    OpenVRFrameQueue(std::unique_ptr<Compositor> compositor);
+    ~OpenVRFrameQueue();
+
+    OpenVRFrameQueue(const OpenVRFrameQueue&) = delete;
+    OpenVRFrameQueue& operator=(const OpenVRFrameQueue&) = delete;
+
+    bool is_running() const {
+        std::scoped_lock _{m_mtx};
+        return m_worker != nullptr;
+    }
+
+    // Present thread. Starts the worker on first use, waits for room in the queue if it's full
+    // (up to the stall timeout, after that the oldest pending frame gets dropped).
+    void push(Frame&& frame, const Settings& settings);
+
+    // Newer than last_version, if the worker got new poses since then.
+    std::optional<Poses> get_poses(uint64_t last_version) const;
+
+    // Submits everything still queued and joins the worker.
+    void stop();
+
+    Stats get_stats() const {
+        std::scoped_lock _{m_mtx};
+        return m_stats;
+    }
+
+private:
+    void start_locked();
+    void worker_proc(std::stop_token stop);
+    void submit_frame(const Frame& frame);
+
+    std::unique_ptr<Compositor> m_compositor{};
+
+    mutable std::mutex m_mtx{};
+    std::condition_variable_any m_cv{};   // worker waits for frames, wakes up on stop too
+    std::condition_variable m_space_cv{}; // present thread waits for room
+
+    // Ring of pending frames plus the one the worker is submitting
+    std::array<Frame, MAX_DEPTH> m_frames{};
+    size_t m_head{0};
+    size_t m_count{0};
+    bool m_in_flight{false};
+
+    std::unique_ptr<std::jthread> m_worker{};
+
+    Poses m_poses{};
+    bool m_has_poses{false}; // anything from before the last stop is stale
+    Stats m_stats{};
+};
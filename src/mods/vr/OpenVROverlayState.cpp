@@ -0,0 +1,107 @@
+#include "OpenVROverlayState.hpp"
+
+namespace vrmod {
+void OpenVROverlayState::show() {
+    if (m_visible == true) {
+        return;
+    }
+
+    m_overlay->ShowOverlay(m_handle);
+    m_visible = true;
+}
+
+void OpenVROverlayState::hide() {
+    if (m_visible == false) {
+        return;
+    }
+
+    m_overlay->HideOverlay(m_handle);
+    m_visible = false;
+}
+
+void OpenVROverlayState::set_flag(vr::VROverlayFlags flag, bool enabled) {
+    const auto bit = (uint32_t)flag;
+
+    if ((m_known_flags & bit) != 0 && ((m_flags & bit) != 0) == enabled) {
+        return;
+    }
+
+    m_overlay->SetOverlayFlag(m_handle, flag, enabled);
+
+    m_known_flags |= bit;
+    m_flags = enabled ? (m_flags | bit) : (m_flags & ~bit);
+}
+
+void OpenVROverlayState::set_width_in_meters(float width) {
+    if (m_width == width) {
+        return;
+    }
+
+    m_overlay->SetOverlayWidthInMeters(m_handle, width);
+    m_width = width;
+}
+
+void OpenVROverlayState::set_texture_bounds(const vr::VRTextureBounds_t& bounds) {
+    if (m_bounds.has_value() && 
+        m_bounds->uMin == bounds.uMin && m_bounds->uMax == bounds.uMax && 
+        m_bounds->vMin == bounds.vMin && m_bounds->vMax == bounds.vMax) 
+    {
+        return;
+    }
+
+    m_overlay->SetOverlayTextureBounds(m_handle, &bounds);
+    m_bounds = bounds;
+}
+
+void OpenVROverlayState::set_transform_absolute(const Matrix3x4f& transform) {
+    if (m_transform == transform) {
+        return;
+    }
+
+    m_overlay->SetOverlayTransformAbsolute(m_handle, vr::TrackingUniverseStanding, (vr::HmdMatrix34_t*)&transform);
+    m_transform = transform;
+}
+
+void OpenVROverlayState::set_mouse_scale(const vr::HmdVector2_t& scale) {
+    if (m_mouse_scale.has_value() && m_mouse_scale->v[0] == scale.v[0] && m_mouse_scale->v[1] == scale.v[1]) {
+        return;
+    }
+
+    m_overlay->SetOverlayMouseScale(m_handle, &scale);
+    m_mouse_scale = scale;
+}
+
+void OpenVROverlayState::set_intersection_rect(const vr::IntersectionMaskRectangle_t& rect) {
+    if (m_intersection_rect.has_value() && 
+        m_intersection_rect->m_flTopLeftX == rect.m_flTopLeftX && m_intersection_rect->m_flTopLeftY == rect.m_flTopLeftY && 
+        m_intersection_rect->m_flWidth == rect.m_flWidth && m_intersection_rect->m_flHeight == rect.m_flHeight) 
+    {
+        return;
+    }
+
+    vr::VROverlayIntersectionMaskPrimitive_t intersection_mask{};
+    intersection_mask.m_nPrimitiveType = vr::EVROverlayIntersectionMaskPrimitiveType::OverlayIntersectionPrimitiveType_Rectangle;
+    intersection_mask.m_Primitive.m_Rectangle = rect;
+
+    m_overlay->SetOverlayIntersectionMask(m_handle, &intersection_mask, 1);
+    m_intersection_rect = rect;
+}
+
+void OpenVROverlayState::set_texture(const vr::Texture_t& texture, const void* resource, bool is_live) {
+    if (!is_live && m_texture == resource) {
+        return;
+    }
+
+    m_overlay->SetOverlayTexture(m_handle, &texture);
+    m_texture = resource;
+}
+
+void OpenVROverlayState::clear_texture() {
+    if (m_texture == nullptr) {
+        return;
+    }
+
+    m_overlay->ClearOverlayTexture(m_handle);
+    m_texture = nullptr;
+}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include <openvr.h>
+#include <sdk/Math.hpp>
+
+namespace vrmod {
+// Last state we sent to the compositor for an overlay. Every IVROverlay call is an IPC round trip,
+// so only things that actually changed since the last frame get sent.
+class OpenVROverlayState {
+public:
+    // Forgets everything that was sent, the next frame sends it all again.
+    void reset(vr::IVROverlay* overlay, vr::VROverlayHandle_t handle) {
+        *this = {};
+        m_overlay = overlay;
+        m_handle = handle;
+    }
+
+    void reset(vr::VROverlayHandle_t handle) {
+        reset(m_overlay, handle);
+    }
+
+    void show();
+    void hide();
+    void set_flag(vr::VROverlayFlags flag, bool enabled);
+    void set_width_in_meters(float width);
+    void set_texture_bounds(const vr::VRTextureBounds_t& bounds);
+    void set_transform_absolute(const Matrix3x4f& transform);
+    void set_mouse_scale(const vr::HmdVector2_t& scale);
+    void set_intersection_rect(const vr::IntersectionMaskRectangle_t& rect);
+
+    // Render targets we draw into every frame are always submitted,
+    // anything else (e.g. the blank texture) only when it changes.
+    void set_texture(const vr::Texture_t& texture, const void* resource, bool is_live);
+    void clear_texture();
+
+private:
+    vr::IVROverlay* m_overlay{nullptr};
+    vr::VROverlayHandle_t m_handle{vr::k_ulOverlayHandleInvalid};
+    std::optional<bool> m_visible{};
+    std::optional<float> m_width{};
+    std::optional<vr::VRTextureBounds_t> m_bounds{};
+    std::optional<Matrix3x4f> m_transform{};
+    std::optional<vr::HmdVector2_t> m_mouse_scale{};
+    std::optional<vr::IntersectionMaskRectangle_t> m_intersection_rect{};
+    std::optional<const void*> m_texture{}; // nullptr once cleared
+    uint32_t m_known_flags{0};
+    uint32_t m_flags{0};
+};
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+
+#include <d3d12.h>
+#include <imgui.h>
+
+#include <utility/Config.hpp>
+
+#include "OpenVRSubmitQueue.hpp"
+
+namespace {
+// The copies are tiny, if the fence takes this long something else is holding up the queue.
+constexpr DWORD FENCE_TIMEOUT_MS = 500;
+
+// Checks for the compositor every time, the runtime can be shut down before the worker is stopped on exit.
+class VRCompositorWrapper final : public OpenVRSubmitQueue::Compositor {
+public:
+    ~VRCompositorWrapper() override {
+        if (m_fence_event != nullptr) {
+            CloseHandle(m_fence_event);
+        }
+    }
+
+    bool wait_for_copy(const OpenVRSubmitQueue::Eye& eye) override {
+        if (eye.fence == nullptr || eye.fence->GetCompletedValue() >= eye.fence_value) {
+            return true;
+        }
+
+        if (m_fence_event == nullptr) {
+            m_fence_event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        }
+
+        if (m_fence_event == nullptr || FAILED(eye.fence->SetEventOnCompletion(eye.fence_value, m_fence_event))) {
+            return false;
+        }
+
+        return WaitForSingleObject(m_fence_event, FENCE_TIMEOUT_MS) == WAIT_OBJECT_0;
+    }
+
+    vr::EVRCompositorError submit(vr::EVREye eye, const vr::Texture_t* texture, const vr::VRTextureBounds_t* bounds, vr::EVRSubmitFlags flags) override {
+        const auto compositor = vr::VRCompositor();
+        return compositor != nullptr ? compositor->Submit(eye, texture, bounds, flags) : vr::VRCompositorError_RequestFailed;
+    }
+
+    void post_present_handoff() override {
+        if (const auto compositor = vr::VRCompositor(); compositor != nullptr) {
+            compositor->PostPresentHandoff();
+        }
+    }
+
+    vr::EVRCompositorError wait_get_poses(std::span<vr::TrackedDevicePose_t> render_poses, std::span<vr::TrackedDevicePose_t> game_poses) override {
+        const auto compositor = vr::VRCompositor();
+
+        if (compositor == nullptr) {
+            return vr::VRCompositorError_RequestFailed;
+        }
+
+        compositor->SetTrackingSpace(vr::TrackingUniverseStanding);
+        return compositor->WaitGetPoses(render_poses.data(), (uint32_t)render_poses.size(), game_poses.data(), (uint32_t)game_poses.size());
+    }
+
+private:
+    HANDLE m_fence_event{nullptr}; // worker only
+};
+}
+
+OpenVRSubmitQueue::OpenVRSubmitQueue()
+    : OpenVRSubmitQueue{std::make_unique<VRCompositorWrapper>()}
+{
+}
+
+OpenVRSubmitQueue::OpenVRSubmitQueue(std::unique_ptr<Compositor> compositor)
+    : m_queue{std::move(compositor)}
+{
+    m_options = {
+        *m_enabled,
+        *m_depth,
+        *m_stall_timeout_ms
+    };
+}
+
+OpenVRSubmitQueue::~OpenVRSubmitQueue() {
+    stop();
+}
+
+void OpenVRSubmitQueue::on_config_save(utility::Config& cfg) {
+    for (IModValue& option : m_options) {
+        option.config_save(cfg);
+    }
+}
+
+void OpenVRSubmitQueue::on_config_load(const utility::Config& cfg, bool set_defaults) {
+    for (IModValue& option : m_options) {
+        option.config_load(cfg, set_defaults);
+    }
+}
+
+void OpenVRSubmitQueue::on_draw_ui() {
+    if (!ImGui::TreeNode("Async Submit")) {
+        return;
+    }
+
+    ImGui::TextWrapped("Submits frames to SteamVR from a separate thread so the game doesn't wait on the compositor. D3D12 only.");
+
+    m_enabled->draw("Enabled");
+    m_depth->draw("Queue Depth");
+    m_stall_timeout_ms->draw("Stall Timeout (ms)");
+
+    const auto stats = get_stats();
+    ImGui::Text("Running: %s", is_running() ? "Yes" : "No");
+    ImGui::Text("Pushed: %llu, Submitted: %llu, Dropped: %llu", stats.pushed, stats.submitted, stats.dropped);
+    ImGui::Text("Stalls: %llu (%.1f ms total), Max Depth: %zu", stats.stalls, stats.stall_ms, stats.max_depth);
+    ImGui::Text("Failed: %llu, Fence Timeouts: %llu", stats.failed, stats.fence_timeouts);
+    ImGui::Text("WaitGetPoses: %.2f ms", stats.last_wait_get_poses_ms);
+
+    ImGui::TreePop();
+}
+
+void OpenVRSubmitQueue::push(Frame&& frame) {
+    m_queue.push(std::move(frame), OpenVRFrameQueue::Settings {
+        .depth = (size_t)std::clamp<int32_t>(m_depth->value(), 1, (int32_t)MAX_DEPTH),
+        .stall_timeout = std::chrono::milliseconds{std::max<int32_t>(m_stall_timeout_ms->value(), 0)}
+    });
+}
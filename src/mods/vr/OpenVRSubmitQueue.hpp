@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "Mod.hpp"
+
+#include "OpenVRFrameQueue.hpp"
+
+// Moves Submit, PostPresentHandoff and WaitGetPoses off the present thread. The present thread copies the eyes
+// like it always did, then hands the frame to a worker through a bounded queue (OpenVRFrameQueue). The worker waits
+// on the fences of those copies, submits both eyes, hands off and blocks in WaitGetPoses so the game doesn't have to.
+// The poses it gets back are published as a snapshot the runtime picks up in synchronize_frame.
+//
+// Only used with D3D12, where Submit goes through the game's command queue which is free threaded.
+// The D3D11 path has SteamVR use the immediate context, so that stays on the present thread.
+class OpenVRSubmitQueue final : public ModComponent {
+public:
+    static constexpr size_t MAX_DEPTH = OpenVRFrameQueue::MAX_DEPTH;
+
+    using Compositor = OpenVRFrameQueue::Compositor;
+    using Eye = OpenVRFrameQueue::Eye;
+    using Frame = OpenVRFrameQueue::Frame;
+    using Poses = OpenVRFrameQueue::Poses;
+    using Stats = OpenVRFrameQueue::Stats;
+
+    OpenVRSubmitQueue();
+    OpenVRSubmitQueue(std::unique_ptr<Compositor> compositor);
+    virtual ~OpenVRSubmitQueue();
+
+    void on_config_save(utility::Config& cfg) override;
+    void on_config_load(const utility::Config& cfg, bool set_defaults) override;
+    void on_draw_ui() override;
+
+    bool is_enabled() const {
+        return m_enabled->value();
+    }
+
+    bool is_running() const {
+        return m_queue.is_running();
+    }
+
+    // Present thread. Starts the worker on first use, waits for room in the queue if it's full
+    // (up to the stall timeout, after that the oldest pending frame gets dropped).
+    void push(Frame&& frame);
+
+    // Newer than last_version, if the worker got new poses since then.
+    std::optional<Poses> get_poses(uint64_t last_version) const {
+        return m_queue.get_poses(last_version);
+    }
+
+    // Submits everything still queued and joins the worker, must happen before the eye textures go away
+    // and before the runtime is shut down.
+    void stop() {
+        m_queue.stop();
+    }
+
+    Stats get_stats() const {
+        return m_queue.get_stats();
+    }
+
+private:
+    const ModToggle::Ptr m_enabled{ ModToggle::create("OpenVR_AsyncSubmit", false) };
+    const ModSliderInt32::Ptr m_depth{ ModSliderInt32::create("OpenVR_AsyncSubmitQueueDepth", 1, (int32_t)MAX_DEPTH, 1) };
+    const ModSliderInt32::Ptr m_stall_timeout_ms{ ModSliderInt32::create("OpenVR_AsyncSubmitStallTimeoutMs", 0, 100, 33) };
+
+    OpenVRFrameQueue m_queue;
+};
@@ -10,6 +10,8 @@
 namespace vrmod {
 void OverlayComponent::on_reset() {
     m_overlay_data = {};
+    m_overlay_state.reset(m_overlay_handle);
+    m_slate_overlay_state.reset(m_slate_overlay_handle);
 }
 
 std::optional<std::string> OverlayComponent::on_initialize_openvr() {
@@ -67,6 +69,10 @@ std::optional<std::string> OverlayComponent::on_initialize_openvr() {
         }
     }
 
+    // Nothing is known about the new overlays yet, so the first frame sends everything.
+    m_overlay_state.reset(vr::VROverlay(), m_overlay_handle);
+    m_slate_overlay_state.reset(vr::VROverlay(), m_slate_overlay_handle);
+
     return std::nullopt;
 }
 
@@ -321,7 +327,7 @@ void OverlayComponent::update_slate_openvr() {
     }
 
     if (!vr->is_gui_enabled()) {
-        vr::VROverlay()->ClearOverlayTexture(m_slate_overlay_handle);
+        m_slate_overlay_state.clear_texture();
         return;
     }
 
@@ -335,10 +341,7 @@ void OverlayComponent::update_slate_openvr() {
     bounds.vMin = 0.0f;
     bounds.vMax = 1.0f;
 
-    vr::VROverlay()->SetOverlayTextureBounds(m_slate_overlay_handle, &bounds);
-
-    vr::TrackedDevicePose_t pose{};
-    vr::VRSystem()->GetDeviceToAbsoluteTrackingPose(vr::TrackingUniverseStanding, 0.0f, &pose, 1);
+    m_slate_overlay_state.set_texture_bounds(bounds);
 
     auto rotation_offset = glm::inverse(vr->get_rotation_offset());
 
@@ -353,7 +356,9 @@ void OverlayComponent::update_slate_openvr() {
     //auto glm_matrix = glm::rowMajor4(Matrix4x4f{*(Matrix3x4f*)&pose.mDeviceToAbsoluteTracking});
     auto glm_matrix = Matrix4x4f{rotation_offset};
     if (m_ui_follows_view->value()) {
-        const auto mat = glm::rowMajor4(Matrix4x4f{*(Matrix3x4f*)&pose.mDeviceToAbsoluteTracking});
+        // Same standing space pose the rest of the frame uses, no need to ask the compositor again
+        const auto pose = vr->get_raw_transform(vr::k_unTrackedDeviceIndex_Hmd);
+        const auto mat = glm::rowMajor4(Matrix4x4f{*(Matrix3x4f*)&pose});
         glm_matrix = glm::extractMatrixRotation(mat);
         glm_matrix[3] += mat[3];
     } else {
@@ -366,13 +371,13 @@ void OverlayComponent::update_slate_openvr() {
     glm_matrix[3].w = 1.0f;
     
     const auto steamvr_matrix = Matrix3x4f{glm::rowMajor4(glm_matrix)};
-    vr::VROverlay()->SetOverlayTransformAbsolute(m_slate_overlay_handle, vr::TrackingUniverseStanding, (vr::HmdMatrix34_t*)&steamvr_matrix);
+    m_slate_overlay_state.set_transform_absolute(steamvr_matrix);
 
     const auto is_d3d12 = g_framework->get_renderer_type() == Framework::RendererType::D3D12;
     const auto size = is_d3d12 ? g_framework->get_d3d12_rt_size() : g_framework->get_d3d11_rt_size();
     const auto aspect = size.x / size.y;
     const auto width_meters = m_slate_size->value() * aspect;
-    vr::VROverlay()->SetOverlayWidthInMeters(m_slate_overlay_handle, width_meters);
+    m_slate_overlay_state.set_width_in_meters(width_meters);
 
     if (is_d3d11) {
         if (vr->m_d3d11.get_ui_tex().Get() == nullptr) {
@@ -380,7 +385,7 @@ void OverlayComponent::update_slate_openvr() {
         }
 
         vr::Texture_t ui_tex{(void*)vr->m_d3d11.get_ui_tex().Get(), vr::TextureType_DirectX, vr::ColorSpace_Auto};
-        vr::VROverlay()->SetOverlayTexture(m_slate_overlay_handle, &ui_tex);   
+        m_slate_overlay_state.set_texture(ui_tex, vr->m_d3d11.get_ui_tex().Get(), true);
     } else {
         if (vr->m_d3d12.get_openvr_ui_tex().texture.Get() == nullptr) {
             return;
@@ -393,7 +398,7 @@ void OverlayComponent::update_slate_openvr() {
         };
 
         vr::Texture_t ui_tex{(void*)&overlay_tex, vr::TextureType_DirectX12, vr::ColorSpace_Auto};
-        vr::VROverlay()->SetOverlayTexture(m_slate_overlay_handle, &ui_tex);   
+        m_slate_overlay_state.set_texture(ui_tex, overlay_tex.m_pResource, true);
     }
 }
 
@@ -434,21 +439,18 @@ bool OverlayComponent::update_wrist_overlay_openvr() {
         bounds.vMin = last_window_pos.y / render_target_height;
         bounds.vMax = (last_window_pos.y + last_window_size.y) / render_target_height;
 
-        vr::VROverlay()->SetOverlayTextureBounds(m_overlay_handle, &bounds);
+        m_overlay_state.set_texture_bounds(bounds);
 
         // necessary, fixes all sorts of issues with ray intersection
-        const auto mouse_scale = vr::HmdVector2_t{(float)render_target_width, (float)render_target_height};
-        vr::VROverlay()->SetOverlayMouseScale(m_overlay_handle, &mouse_scale);
-
-        vr::VROverlayIntersectionMaskPrimitive_t intersection_mask{};
+        m_overlay_state.set_mouse_scale(vr::HmdVector2_t{(float)render_target_width, (float)render_target_height});
 
-        intersection_mask.m_nPrimitiveType = vr::EVROverlayIntersectionMaskPrimitiveType::OverlayIntersectionPrimitiveType_Rectangle;
-        intersection_mask.m_Primitive.m_Rectangle.m_flTopLeftX = last_window_pos.x;
-        intersection_mask.m_Primitive.m_Rectangle.m_flTopLeftY = last_window_pos.y;
-        intersection_mask.m_Primitive.m_Rectangle.m_flWidth = last_window_size.x;
-        intersection_mask.m_Primitive.m_Rectangle.m_flHeight = last_window_size.y;
+        vr::IntersectionMaskRectangle_t intersection_rect{};
+        intersection_rect.m_flTopLeftX = last_window_pos.x;
+        intersection_rect.m_flTopLeftY = last_window_pos.y;
+        intersection_rect.m_flWidth = last_window_size.x;
+        intersection_rect.m_flHeight = last_window_size.y;
 
-        vr::VROverlay()->SetOverlayIntersectionMask(m_overlay_handle, &intersection_mask, 1);
+        m_overlay_state.set_intersection_rect(intersection_rect);
 
         // and now set the last known values
         m_overlay_data.last_x = last_window_pos.x;
@@ -478,7 +480,7 @@ bool OverlayComponent::update_wrist_overlay_openvr() {
 
             const auto steamvr_transform = Matrix3x4f{ glm::rowMajor4(left_controller_world_transform) };
             
-            vr::VROverlay()->SetOverlayTransformAbsolute(m_overlay_handle, vr::ETrackingUniverseOrigin::TrackingUniverseStanding, (vr::HmdMatrix34_t*)&steamvr_transform);
+            m_overlay_state.set_transform_absolute(steamvr_transform);
         }
 
         bool any_intersected = false;
@@ -581,7 +583,7 @@ bool OverlayComponent::update_wrist_overlay_openvr() {
         // set overlay flag
         if (any_intersected) {
             should_show_overlay = true;
-            vr::VROverlay()->SetOverlayFlag(m_overlay_handle, vr::VROverlayFlags::VROverlayFlags_MakeOverlaysInteractiveIfVisible, true);
+            m_overlay_state.set_flag(vr::VROverlayFlags::VROverlayFlags_MakeOverlaysInteractiveIfVisible, true);
 
             g_framework->set_draw_ui(true);
 
@@ -595,7 +597,7 @@ bool OverlayComponent::update_wrist_overlay_openvr() {
             m_just_closed_ui = false;
         } else {
             should_show_overlay = false;
-            vr::VROverlay()->SetOverlayFlag(m_overlay_handle, vr::VROverlayFlags::VROverlayFlags_MakeOverlaysInteractiveIfVisible, false);
+            m_overlay_state.set_flag(vr::VROverlayFlags::VROverlayFlags_MakeOverlaysInteractiveIfVisible, false);
 
             if (!m_closed_ui) {
                 g_framework->set_draw_ui(false);
@@ -625,13 +627,13 @@ void OverlayComponent::update_overlay_openvr() {
     bool should_show_overlay = update_wrist_overlay_openvr();
 
     if (m_framework_wrist_ui->value()) {
-        vr::VROverlay()->ShowOverlay(m_overlay_handle); // always show overlay idk look at it later
+        m_overlay_state.show(); // always show overlay idk look at it later
 
         if (should_show_overlay) {
             // finally set the texture
             if (is_d3d11) {
                 vr::Texture_t imgui_tex{(void*)g_framework->get_rendertarget_d3d11().Get(), vr::TextureType_DirectX, vr::ColorSpace_Auto};
-                vr::VROverlay()->SetOverlayTexture(m_overlay_handle, &imgui_tex);   
+                m_overlay_state.set_texture(imgui_tex, imgui_tex.handle, true);
             } else {
                 auto& hook = g_framework->get_d3d12_hook();
 
@@ -642,13 +644,13 @@ void OverlayComponent::update_overlay_openvr() {
                 };
                 
                 vr::Texture_t imgui_tex{(void*)&texture_data, vr::TextureType_DirectX12, vr::ColorSpace_Auto};
-                vr::VROverlay()->SetOverlayTexture(m_overlay_handle, &imgui_tex);
+                m_overlay_state.set_texture(imgui_tex, texture_data.m_pResource, true);
             }
         } else {
             if (is_d3d11) {
                 // draw a blank texture (don't just call HideOverlay, we'll no longer be able to use intersection tests)
                 vr::Texture_t imgui_tex{(void*)g_framework->get_blank_rendertarget_d3d11().Get(), vr::TextureType_DirectX, vr::ColorSpace_Auto};
-                vr::VROverlay()->SetOverlayTexture(m_overlay_handle, &imgui_tex);
+                m_overlay_state.set_texture(imgui_tex, imgui_tex.handle, false);
             } else {
                 auto& hook = g_framework->get_d3d12_hook();
 
@@ -659,7 +661,7 @@ void OverlayComponent::update_overlay_openvr() {
                 };
                 
                 vr::Texture_t imgui_tex{(void*)&texture_data, vr::TextureType_DirectX12, vr::ColorSpace_Auto};
-                vr::VROverlay()->SetOverlayTexture(m_overlay_handle, &imgui_tex);
+                m_overlay_state.set_texture(imgui_tex, texture_data.m_pResource, false);
             }
         }
 
@@ -668,7 +670,7 @@ void OverlayComponent::update_overlay_openvr() {
 
     // Draw the UI as a plane in front of the user instead
     if (!m_framework_wrist_ui->value() && g_framework->is_drawing_anything()) {
-        vr::VROverlay()->ShowOverlay(m_overlay_handle);
+        m_overlay_state.show();
 
         // Show the entire texture
         // TODO: do the sizing / scaling calculations below need to take into account non-standard VRTextureBounds_t
@@ -679,12 +681,8 @@ void OverlayComponent::update_overlay_openvr() {
         bounds.vMin = 0.0f;
         bounds.vMax = 1.0f;
 
-        vr::VROverlay()->SetOverlayTextureBounds(m_overlay_handle, &bounds);
-
-        vr::TrackedDevicePose_t pose{};
-        vr::VRSystem()->GetDeviceToAbsoluteTrackingPose(vr::TrackingUniverseStanding, 0.0f, &pose, 1);
+        m_overlay_state.set_texture_bounds(bounds);
 
-        //auto glm_matrix = glm::rowMajor4(Matrix4x4f{*(Matrix3x4f*)&pose.mDeviceToAbsoluteTracking});
         auto rotation_offset = glm::inverse(vr->get_rotation_offset());
 
         // If we're not drawing the UI, this means we want to draw the cursor all the time
@@ -716,7 +714,7 @@ void OverlayComponent::update_overlay_openvr() {
 
         glm_matrix[3].w = 1.0f;
         const auto steamvr_matrix = Matrix3x4f{glm::rowMajor4(glm_matrix)};
-        vr::VROverlay()->SetOverlayTransformAbsolute(m_overlay_handle, vr::TrackingUniverseStanding, (vr::HmdMatrix34_t*)&steamvr_matrix);
+        m_overlay_state.set_transform_absolute(steamvr_matrix);
 
         const auto is_d3d12 = g_framework->get_renderer_type() == Framework::RendererType::D3D12;
         const auto size = is_d3d12 ? g_framework->get_d3d12_rt_size() : g_framework->get_d3d11_rt_size();
@@ -729,11 +727,11 @@ void OverlayComponent::update_overlay_openvr() {
         const auto width_meters = adjusted_size_meters * aspect;
         const auto height_meters = adjusted_size_meters;
 
-        vr::VROverlay()->SetOverlayWidthInMeters(m_overlay_handle, width_meters);
+        m_overlay_state.set_width_in_meters(width_meters);
 
         if (is_d3d11) {
             vr::Texture_t imgui_tex{(void*)g_framework->get_rendertarget_d3d11().Get(), vr::TextureType_DirectX, vr::ColorSpace_Auto};
-            vr::VROverlay()->SetOverlayTexture(m_overlay_handle, &imgui_tex);   
+            m_overlay_state.set_texture(imgui_tex, imgui_tex.handle, true);
         } else {
             auto& hook = g_framework->get_d3d12_hook();
 
@@ -744,7 +742,7 @@ void OverlayComponent::update_overlay_openvr() {
             };
             
             vr::Texture_t imgui_tex{(void*)&texture_data, vr::TextureType_DirectX12, vr::ColorSpace_Auto};
-            vr::VROverlay()->SetOverlayTexture(m_overlay_handle, &imgui_tex);
+            m_overlay_state.set_texture(imgui_tex, texture_data.m_pResource, true);
         }
 
         // Check if the controller pointer intersects with the quad, and we can use this to emulate the mouse
@@ -800,9 +798,59 @@ void OverlayComponent::update_overlay_openvr() {
             m_intersect_state.intersecting = false;
         }
     } else {
-        vr::VROverlay()->ClearOverlayTexture(m_overlay_handle);
-        vr::VROverlay()->HideOverlay(m_overlay_handle);
+        m_overlay_state.clear_texture();
+        m_overlay_state.hide();
+    }
+}
+
+OverlayComponent::OpenXR::LayerInputs OverlayComponent::OpenXR::get_layer_inputs(
+    runtimes::OpenXR::SwapchainIndex swapchain,
+    XrEyeVisibility eye,
+    bool follows_view,
+    bool adjust_pitch) const
+{
+    auto& vr = VR::get();
+    const auto& layer_swapchain = vr->m_openxr->swapchains[(uint32_t)swapchain];
+
+    LayerInputs inputs{};
+    inputs.swapchain = layer_swapchain.handle;
+    inputs.width = layer_swapchain.width;
+    inputs.height = layer_swapchain.height;
+    inputs.eye = eye;
+    inputs.follows_view = follows_view;
+
+    if (follows_view) {
+        inputs.space = vr->m_openxr->view_space;
+        return inputs;
     }
+
+    inputs.space = vr->m_openxr->stage_space;
+    inputs.rotation_offset = vr->get_rotation_offset();
+    inputs.standing_origin = vr->get_standing_origin();
+
+    if (adjust_pitch) {
+        inputs.pre_flat_pitch = utility::math::pitch_only(vr->get_pre_flattened_rotation());
+    }
+
+    return inputs;
+}
+
+glm::mat4 OverlayComponent::OpenXR::get_base_transform(const LayerInputs& inputs) {
+    if (inputs.follows_view) {
+        return glm::identity<glm::mat4>();
+    }
+
+    auto rotation_offset = glm::inverse(inputs.rotation_offset);
+
+    if (inputs.pre_flat_pitch.has_value()) {
+        // Add the inverse of the pitch rotation to the rotation offset
+        rotation_offset = glm::normalize(glm::inverse(*inputs.pre_flat_pitch * inputs.rotation_offset));
+    }
+
+    glm::mat4 glm_matrix = Matrix4x4f{rotation_offset};
+    glm_matrix[3] += inputs.standing_origin;
+
+    return glm_matrix;
 }
 
 std::optional<std::reference_wrapper<XrCompositionLayerQuad>> OverlayComponent::OpenXR::generate_slate_quad(
@@ -822,50 +870,47 @@ std::optional<std::reference_wrapper<XrCompositionLayerQuad>> OverlayComponent::
 
     const auto is_left_eye = eye == XR_EYE_VISIBILITY_BOTH || eye == XR_EYE_VISIBILITY_LEFT;
 
-    auto& layer = is_left_eye ? this->m_slate_layer : this->m_slate_layer_right;
-
-    layer.type = XR_TYPE_COMPOSITION_LAYER_QUAD;
-    const auto& ui_swapchain = vr->m_openxr->swapchains[(uint32_t)swapchain];
-    layer.subImage.swapchain = ui_swapchain.handle;
-    layer.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
-    layer.subImage.imageRect.offset.x = 0;
-    layer.subImage.imageRect.offset.y = 0;
-    layer.subImage.imageRect.extent.width = ui_swapchain.width;
-    layer.subImage.imageRect.extent.height = ui_swapchain.height;
-    layer.eyeVisibility = eye;
-
-    auto glm_matrix = glm::identity<glm::mat4>();
-
-    if (vr->m_overlay_component.m_ui_follows_view->value()) {
-        layer.space = vr->m_openxr->view_space;
-    } else {
-        auto rotation_offset = glm::inverse(vr->get_rotation_offset());
-
-        if (vr->is_decoupled_pitch_enabled() && vr->is_decoupled_pitch_ui_adjust_enabled()) {
-            const auto pre_flat_rotation = vr->get_pre_flattened_rotation();
-            const auto pre_flat_pitch = utility::math::pitch_only(pre_flat_rotation);
+    auto& cached = is_left_eye ? this->m_slate_layer : this->m_slate_layer_right;
+    auto& layer = cached.layer;
+
+    auto inputs = get_layer_inputs(swapchain, eye, m_parent->m_ui_follows_view->value(),
+        vr->is_decoupled_pitch_enabled() && vr->is_decoupled_pitch_ui_adjust_enabled());
+    inputs.size = m_parent->m_slate_size->value();
+    inputs.distance = m_parent->m_slate_distance->value();
+    inputs.x_offset = m_parent->m_slate_x_offset->value();
+    inputs.y_offset = m_parent->m_slate_y_offset->value();
+
+    if (cached.update(inputs)) {
+        layer.type = XR_TYPE_COMPOSITION_LAYER_QUAD;
+        layer.subImage.swapchain = inputs.swapchain;
+        layer.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
+        layer.subImage.imageRect.offset.x = 0;
+        layer.subImage.imageRect.offset.y = 0;
+        layer.subImage.imageRect.extent.width = inputs.width;
+        layer.subImage.imageRect.extent.height = inputs.height;
+        layer.eyeVisibility = eye;
+        layer.space = inputs.space;
+
+        cached.meters_w = (float)inputs.width / (float)inputs.height * inputs.size;
+        cached.meters_h = inputs.size;
+        layer.size = {cached.meters_w, cached.meters_h};
+
+        auto glm_matrix = get_base_transform(inputs);
+        glm_matrix[3] -= glm_matrix[2] * inputs.distance;
+        glm_matrix[3] += inputs.x_offset * glm_matrix[0];
+        glm_matrix[3] += inputs.y_offset * glm_matrix[1];
+        glm_matrix[3].w = 1.0f;
 
-            // Add the inverse of the pitch rotation to the rotation offset
-            rotation_offset = glm::normalize(glm::inverse(pre_flat_pitch * vr->get_rotation_offset()));
-        }
+        layer.pose.orientation = runtimes::OpenXR::to_openxr(glm::quat_cast(glm_matrix));
+        layer.pose.position = runtimes::OpenXR::to_openxr(glm_matrix[3]);
 
-        glm_matrix = Matrix4x4f{rotation_offset};   
-        glm_matrix[3] += vr->get_standing_origin();
-        layer.space = vr->m_openxr->stage_space;
+        cached.transform = glm_matrix;
+        cached.inverse_transform = glm::inverse(glm_matrix);
     }
 
-    const auto size_meters = m_parent->m_slate_size->value();
-    const auto meters_w = (float)ui_swapchain.width / (float)ui_swapchain.height * size_meters;
-    const auto meters_h = size_meters;
-    layer.size = {meters_w, meters_h};
-
-    glm_matrix[3] -= glm_matrix[2] * m_parent->m_slate_distance->value();
-    glm_matrix[3] += m_parent->m_slate_x_offset->value() * glm_matrix[0];
-    glm_matrix[3] += m_parent->m_slate_y_offset->value() * glm_matrix[1];
-    glm_matrix[3].w = 1.0f;
-
-    layer.pose.orientation = runtimes::OpenXR::to_openxr(glm::quat_cast(glm_matrix));
-    layer.pose.position = runtimes::OpenXR::to_openxr(glm_matrix[3]);
+    const auto& glm_matrix = cached.transform;
+    const auto meters_w = cached.meters_w;
+    const auto meters_h = cached.meters_h;
 
     // Check if the controller pointer intersects with the quad, and we can use this to emulate the mouse
     if (vr->is_using_controllers()) {
@@ -884,7 +929,7 @@ std::optional<std::reference_wrapper<XrCompositionLayerQuad>> OverlayComponent::
         if (glm::intersectRayPlane<glm::vec3>(start, fwd, plane_pos, glm::normalize(glm::vec3{glm_matrix[2]}), intersection_distance)) {
             const auto intersection_point = start + (fwd * intersection_distance);
 
-            const auto local_point = glm::inverse(glm_matrix) * glm::vec4{intersection_point, 1.0f};
+            const auto local_point = cached.inverse_transform * glm::vec4{intersection_point, 1.0f};
 
             const auto w_half = meters_w / 2.0f;
             const auto h_half = meters_h / 2.0f;
@@ -929,59 +974,56 @@ std::optional<std::reference_wrapper<XrCompositionLayerCylinderKHR>> OverlayComp
 
     const auto is_left_eye = eye == XR_EYE_VISIBILITY_BOTH || eye == XR_EYE_VISIBILITY_LEFT;
 
-    auto& layer = is_left_eye ? this->m_slate_layer_cylinder : this->m_slate_layer_cylinder_right;
+    auto& cached = is_left_eye ? this->m_slate_layer_cylinder : this->m_slate_layer_cylinder_right;
+    auto& layer = cached.layer;
+
+    auto inputs = get_layer_inputs(swapchain, eye, m_parent->m_ui_follows_view->value(),
+        vr->is_decoupled_pitch_enabled() && vr->is_decoupled_pitch_ui_adjust_enabled());
+    inputs.size = m_parent->m_slate_size->value();
+    inputs.distance = m_parent->m_slate_distance->value();
+    inputs.x_offset = m_parent->m_slate_x_offset->value();
+    inputs.y_offset = m_parent->m_slate_y_offset->value();
+    inputs.cylinder_angle = m_parent->m_slate_cylinder_angle->value();
+
+    if (!cached.update(inputs)) {
+        return layer;
+    }
 
     layer.type = XR_TYPE_COMPOSITION_LAYER_CYLINDER_KHR;
-    const auto& ui_swapchain = vr->m_openxr->swapchains[(uint32_t)swapchain];
-    layer.subImage.swapchain = ui_swapchain.handle;
+    layer.subImage.swapchain = inputs.swapchain;
     layer.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
     layer.subImage.imageRect.offset.x = 0;
     layer.subImage.imageRect.offset.y = 0;
-    layer.subImage.imageRect.extent.width = ui_swapchain.width;
-    layer.subImage.imageRect.extent.height = ui_swapchain.height;
+    layer.subImage.imageRect.extent.width = inputs.width;
+    layer.subImage.imageRect.extent.height = inputs.height;
     layer.eyeVisibility = eye;
-    
-    auto glm_matrix = glm::identity<glm::mat4>();
-
-    if (vr->m_overlay_component.m_ui_follows_view->value()) {
-        layer.space = vr->m_openxr->view_space;
-    } else {
-        auto rotation_offset = glm::inverse(vr->get_rotation_offset());
-
-        if (vr->is_decoupled_pitch_enabled() && vr->is_decoupled_pitch_ui_adjust_enabled()) {
-            const auto pre_flat_rotation = vr->get_pre_flattened_rotation();
-            const auto pre_flat_pitch = utility::math::pitch_only(pre_flat_rotation);
+    layer.space = inputs.space;
 
-            // Add the inverse of the pitch rotation to the rotation offset
-            rotation_offset = glm::normalize(glm::inverse(pre_flat_pitch * vr->get_rotation_offset()));
-        }
-
-        glm_matrix = Matrix4x4f{rotation_offset};   
-        glm_matrix[3] += vr->get_standing_origin();
-        layer.space = vr->m_openxr->stage_space;
-    }
-
-    const auto size_meters = m_parent->m_slate_size->value();
-    const auto meters_w = (float)ui_swapchain.width / (float)ui_swapchain.height * size_meters;
-    const auto meters_h = size_meters;
+    const auto meters_w = (float)inputs.width / (float)inputs.height * inputs.size;
+    const auto meters_h = inputs.size;
 
     // OpenXR Docs:
     // radius is the non-negative radius of the cylinder. Values of zero or floating point positive infinity are treated as an infinite cylinder.
     // centralAngle is the angle of the visible section of the cylinder, based at 0 radians, in the range of [0, 2π). It grows symmetrically around the 0 radian angle.
     // aspectRatio is the ratio of the visible cylinder section width / height. The height of the cylinder is given by: (cylinder radius × cylinder angle) / aspectRatio.
-    layer.centralAngle = glm::max<float>(1.0f, glm::radians(m_parent->m_slate_cylinder_angle->value()));
+    layer.centralAngle = glm::max<float>(1.0f, glm::radians(inputs.cylinder_angle));
     layer.aspectRatio = (meters_w / meters_h);
     layer.radius = (meters_h / layer.centralAngle) * layer.aspectRatio;
 
-    glm_matrix[3] -= glm_matrix[2] * m_parent->m_slate_distance->value();
+    auto glm_matrix = get_base_transform(inputs);
+    glm_matrix[3] -= glm_matrix[2] * inputs.distance;
     glm_matrix[3] += glm_matrix[2] * layer.radius;
-    glm_matrix[3] += m_parent->m_slate_x_offset->value() * glm_matrix[0];
-    glm_matrix[3] += m_parent->m_slate_y_offset->value() * glm_matrix[1];
+    glm_matrix[3] += inputs.x_offset * glm_matrix[0];
+    glm_matrix[3] += inputs.y_offset * glm_matrix[1];
     glm_matrix[3].w = 1.0f;
 
     layer.pose.orientation = runtimes::OpenXR::to_openxr(glm::quat_cast(glm_matrix));
     layer.pose.position = runtimes::OpenXR::to_openxr(glm_matrix[3]);
 
+    cached.transform = glm_matrix;
+    cached.meters_w = meters_w;
+    cached.meters_h = meters_h;
+
     return layer;
 }
 
@@ -1023,65 +1065,65 @@ std::optional<std::reference_wrapper<XrCompositionLayerQuad>> OverlayComponent::
 
     auto& vr = VR::get();
 
-    auto& layer = this->m_framework_ui_layer;
+    auto& cached = this->m_framework_ui_layer;
+    auto& layer = cached.layer;
 
-    layer.type = XR_TYPE_COMPOSITION_LAYER_QUAD;
-    const auto& ui_swapchain = vr->m_openxr->swapchains[(uint32_t)runtimes::OpenXR::SwapchainIndex::FRAMEWORK_UI];
-    layer.subImage.swapchain = ui_swapchain.handle;
-    layer.subImage.imageRect.offset.x = 0;
-    layer.subImage.imageRect.offset.y = 0;
-    layer.subImage.imageRect.extent.width = ui_swapchain.width;
-    layer.subImage.imageRect.extent.height = ui_swapchain.height;
-    layer.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
-    layer.eyeVisibility = XrEyeVisibility::XR_EYE_VISIBILITY_BOTH;
+    const auto drawing_ui = g_framework->is_drawing_ui();
 
-    auto glm_matrix = glm::identity<glm::mat4>();
+    // If we're not drawing the UI, this means we want to draw the cursor all the time
+    // So we need to rotate the UI's pitch as well
+    auto inputs = get_layer_inputs(runtimes::OpenXR::SwapchainIndex::FRAMEWORK_UI, XR_EYE_VISIBILITY_BOTH, m_parent->m_framework_ui_follows_view->value(),
+        !drawing_ui && vr->is_decoupled_pitch_enabled() && vr->is_decoupled_pitch_ui_adjust_enabled());
+    inputs.drawing_framework_ui = drawing_ui;
 
-    if (vr->m_overlay_component.m_framework_ui_follows_view->value()) {
-        layer.space = vr->m_openxr->view_space;
+    if (drawing_ui) {
+        inputs.size = m_parent->m_framework_size->value();
+        inputs.distance = m_parent->m_framework_distance->value();
     } else {
-        auto rotation_offset = glm::inverse(vr->get_rotation_offset());
+        inputs.size = m_parent->m_slate_size->value();
+        inputs.distance = m_parent->m_slate_distance->value() - 0.01f;
+        inputs.x_offset = m_parent->m_slate_x_offset->value();
+        inputs.y_offset = m_parent->m_slate_y_offset->value();
+    }
 
-        // If we're not drawing the UI, this means we want to draw the cursor all the time
-        // So we need to rotate the UI's pitch as well
-        if (!g_framework->is_drawing_ui() && vr->is_decoupled_pitch_enabled() && vr->is_decoupled_pitch_ui_adjust_enabled()) {
-            const auto pre_flat_rotation = vr->get_pre_flattened_rotation();
-            const auto pre_flat_pitch = utility::math::pitch_only(pre_flat_rotation);
+    if (cached.update(inputs)) {
+        layer.type = XR_TYPE_COMPOSITION_LAYER_QUAD;
+        layer.subImage.swapchain = inputs.swapchain;
+        layer.subImage.imageRect.offset.x = 0;
+        layer.subImage.imageRect.offset.y = 0;
+        layer.subImage.imageRect.extent.width = inputs.width;
+        layer.subImage.imageRect.extent.height = inputs.height;
+        layer.layerFlags = XR_COMPOSITION_LAYER_BLEND_TEXTURE_SOURCE_ALPHA_BIT;
+        layer.eyeVisibility = XrEyeVisibility::XR_EYE_VISIBILITY_BOTH;
+        layer.space = inputs.space;
 
-            // Add the inverse of the pitch rotation to the rotation offset
-            rotation_offset = glm::normalize(glm::inverse(pre_flat_pitch * vr->get_rotation_offset()));
-        }
+        const float scale_factor = drawing_ui ? ((float)inputs.width / 1920.0f) : 1.0f;
 
-        glm_matrix = Matrix4x4f{rotation_offset};
-        glm_matrix[3] += vr->get_standing_origin();
-        layer.space = vr->m_openxr->stage_space;
-    }
+        // Adjust size_meters based on scaling factor.
+        const float adjusted_size_meters = inputs.size * scale_factor;
 
-    const auto size_meters = g_framework->is_drawing_ui() ? m_parent->m_framework_size->value() : m_parent->m_slate_size->value();
-    const float scale_factor =  g_framework->is_drawing_ui() ? ((float)ui_swapchain.width / 1920.0f) : 1.0f;
+        // Compute the new dimensions in meters.
+        cached.meters_w = (float)inputs.width / (float)inputs.height * adjusted_size_meters;
+        cached.meters_h = adjusted_size_meters;
 
-    // Adjust size_meters based on scaling factor.
-    const float adjusted_size_meters = size_meters * scale_factor;
+        layer.size = {cached.meters_w, cached.meters_h};
 
-    // Compute the new dimensions in meters.
-    const auto meters_w = (float)ui_swapchain.width / (float)ui_swapchain.height * adjusted_size_meters;
-    const auto meters_h = adjusted_size_meters;
-
-    layer.size = {meters_w, meters_h};
+        auto glm_matrix = get_base_transform(inputs);
+        glm_matrix[3] -= glm_matrix[2] * inputs.distance;
+        glm_matrix[3] += inputs.x_offset * glm_matrix[0];
+        glm_matrix[3] += inputs.y_offset * glm_matrix[1];
+        glm_matrix[3].w = 1.0f;
 
-    if (g_framework->is_drawing_ui()) {
-        glm_matrix[3] -= glm_matrix[2] * m_parent->m_framework_distance->value();
-    } else {
-        glm_matrix[3] -= glm_matrix[2] * (m_parent->m_slate_distance->value() - 0.01f);
+        layer.pose.orientation = runtimes::OpenXR::to_openxr(glm::quat_cast(glm_matrix));
+        layer.pose.position = runtimes::OpenXR::to_openxr(glm_matrix[3]);
 
-        glm_matrix[3] += m_parent->m_slate_x_offset->value() * glm_matrix[0];
-        glm_matrix[3] += m_parent->m_slate_y_offset->value() * glm_matrix[1];
+        cached.transform = glm_matrix;
+        cached.inverse_transform = glm::inverse(glm_matrix);
     }
 
-    glm_matrix[3].w = 1.0f;
-
-    layer.pose.orientation = runtimes::OpenXR::to_openxr(glm::quat_cast(glm_matrix));
-    layer.pose.position = runtimes::OpenXR::to_openxr(glm_matrix[3]);
+    const auto& glm_matrix = cached.transform;
+    const auto meters_w = cached.meters_w;
+    const auto meters_h = cached.meters_h;
 
     // Check if the controller pointer intersects with the quad, and we can use this to emulate the mouse
     if (vr->is_using_controllers()) {
@@ -1100,7 +1142,7 @@ std::optional<std::reference_wrapper<XrCompositionLayerQuad>> OverlayComponent::
         if (glm::intersectRayPlane<glm::vec3>(start, fwd, plane_pos, glm::normalize(glm::vec3{glm_matrix[2]}), intersection_distance)) {
             const auto intersection_point = start + (fwd * intersection_distance);
 
-            const auto local_point = glm::inverse(glm_matrix) * glm::vec4{intersection_point, 1.0f};
+            const auto local_point = cached.inverse_transform * glm::vec4{intersection_point, 1.0f};
 
             const auto w_half = meters_w / 2.0f;
             const auto h_half = meters_h / 2.0f;
@@ -5,6 +5,8 @@
 #include <cstdint>
 
 #include "Mod.hpp"
+#include "CachedLayer.hpp"
+#include "OpenVROverlayState.hpp"
 
 #include "imgui.h"
 
@@ -72,6 +74,9 @@ private:
     vr::VROverlayHandle_t m_thumbnail_handle{};
     vr::VROverlayHandle_t m_slate_overlay_handle{};
 
+    OpenVROverlayState m_overlay_state{};
+    OpenVROverlayState m_slate_overlay_state{};
+
     bool m_closed_ui{false};
     bool m_just_closed_ui{false};
     bool m_just_opened_ui{false};
@@ -154,11 +159,35 @@ private:
         std::optional<std::reference_wrapper<XrCompositionLayerQuad>> generate_framework_ui_quad();
         
     private:
-        XrCompositionLayerQuad m_slate_layer{};
-        XrCompositionLayerQuad m_slate_layer_right{};
-        XrCompositionLayerCylinderKHR m_slate_layer_cylinder{};
-        XrCompositionLayerCylinderKHR m_slate_layer_cylinder_right{};
-        XrCompositionLayerQuad m_framework_ui_layer{};
+        // Everything a layer's placement depends on, the layer is only rebuilt when one of these changes.
+        struct LayerInputs {
+            XrSwapchain swapchain{XR_NULL_HANDLE};
+            int32_t width{0};
+            int32_t height{0};
+            XrEyeVisibility eye{XR_EYE_VISIBILITY_BOTH};
+            XrSpace space{XR_NULL_HANDLE};
+            bool follows_view{false};
+            glm::quat rotation_offset{glm::identity<glm::quat>()}; // identity when following the view
+            std::optional<glm::quat> pre_flat_pitch{}; // only with decoupled pitch UI adjustment
+            Vector4f standing_origin{};
+            float size{0.0f};
+            float distance{0.0f};
+            float x_offset{0.0f};
+            float y_offset{0.0f};
+            float cylinder_angle{0.0f};
+            bool drawing_framework_ui{false};
+
+            bool operator==(const LayerInputs&) const = default;
+        };
+
+        LayerInputs get_layer_inputs(runtimes::OpenXR::SwapchainIndex swapchain, XrEyeVisibility eye, bool follows_view, bool adjust_pitch) const;
+        static glm::mat4 get_base_transform(const LayerInputs& inputs);
+
+        CachedLayer<XrCompositionLayerQuad, LayerInputs> m_slate_layer{};
+        CachedLayer<XrCompositionLayerQuad, LayerInputs> m_slate_layer_right{};
+        CachedLayer<XrCompositionLayerCylinderKHR, LayerInputs> m_slate_layer_cylinder{};
+        CachedLayer<XrCompositionLayerCylinderKHR, LayerInputs> m_slate_layer_cylinder_right{};
+        CachedLayer<XrCompositionLayerQuad, LayerInputs> m_framework_ui_layer{};
         OverlayComponent* m_parent{ nullptr };
         
         friend class OverlayComponent;
@@ -0,0 +1,83 @@
+#include <algorithm>
+
+#include "PoseExtrapolator.hpp"
+
+namespace {
+float angle_between(const Matrix4x4f& a, const Matrix4x4f& b) {
+    const auto qa = glm::normalize(glm::quat{glm::extractMatrixRotation(a)});
+    const auto qb = glm::normalize(glm::quat{glm::extractMatrixRotation(b)});
+    const auto d = glm::clamp(glm::abs(glm::dot(qa, qb)), 0.0f, 1.0f);
+
+    return glm::degrees(2.0f * glm::acos(d));
+}
+
+float distance_mm(const Matrix4x4f& a, const Matrix4x4f& b) {
+    return glm::length(Vector3f{a[3] - b[3]}) * 1000.0f;
+}
+}
+
+float PoseExtrapolator::get_lead_seconds(const Settings& settings, int64_t display_time_ns, int64_t now_ns) {
+    if (display_time_ns == 0) {
+        return 0.0f;
+    }
+
+    const auto past_display = now_ns - display_time_ns;
+
+    if (past_display > MAX_SAMPLE_AGE_NS) {
+        return 0.0f;
+    }
+
+    const auto ms = (float)((double)past_display / 1'000'000.0) + settings.extra_lead_ms;
+
+    if (ms <= 0.0f) {
+        return 0.0f;
+    }
+
+    return std::min<float>(ms, settings.max_prediction_ms) / 1000.0f;
+}
+
+Matrix4x4f PoseExtrapolator::extrapolate(const Matrix4x4f& transform, const Vector3f& velocity, const Vector3f& angular_velocity, float seconds) {
+    auto result = transform;
+
+    if (seconds <= 0.0f) {
+        return result;
+    }
+
+    const auto angular_speed = glm::length(angular_velocity);
+
+    if (angular_speed > 0.0001f) {
+        const auto delta = glm::angleAxis(angular_speed * seconds, angular_velocity / angular_speed);
+        result = glm::mat4_cast(delta) * glm::extractMatrixRotation(transform);
+    }
+
+    result[3] = transform[3] + Vector4f{velocity * seconds, 0.0f};
+
+    return result;
+}
+
+Matrix4x4f PoseExtrapolator::predict(const Settings& settings, const Sample& sample, int64_t now_ns) {
+    const auto seconds = get_lead_seconds(settings, sample.display_time_ns, now_ns);
+
+    return extrapolate(sample.transform, sample.velocity * settings.velocity_scale, sample.angular_velocity * settings.angular_velocity_scale, seconds);
+}
+
+std::optional<PoseExtrapolator::Error> PoseExtrapolator::measure(const Settings& settings, const Sample& prev, const Sample& current) {
+    if (!prev.valid || !current.valid || prev.display_time_ns == 0) {
+        return std::nullopt;
+    }
+
+    const auto dt = current.display_time_ns - prev.display_time_ns;
+
+    if (dt <= 0 || dt > MAX_SAMPLE_AGE_NS) {
+        return std::nullopt;
+    }
+
+    const auto predicted = predict(settings, prev, current.display_time_ns);
+
+    return Error {
+        .predicted_mm = distance_mm(predicted, current.transform),
+        .unpredicted_mm = distance_mm(prev.transform, current.transform),
+        .predicted_deg = angle_between(predicted, current.transform),
+        .unpredicted_deg = angle_between(prev.transform, current.transform)
+    };
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include <sdk/Math.hpp>
+
+// The math behind PosePredictor, with no dependencies on the mod or the runtimes
+// so recorded pose streams can be replayed through it.
+// Poses from the runtime are already predicted to the display time they were sampled for,
+// so they're only ever extrapolated past that point, never from when they were sampled.
+class PoseExtrapolator {
+public:
+    struct Settings {
+        float velocity_scale{1.0f};
+        float angular_velocity_scale{1.0f};
+        float extra_lead_ms{0.0f};
+        float max_prediction_ms{40.0f};
+    };
+
+    struct Sample {
+        Matrix4x4f transform{glm::identity<Matrix4x4f>()};
+        Vector3f velocity{};
+        Vector3f angular_velocity{}; // tracking space, same as the transform
+        int64_t display_time_ns{0}; // steady_clock, what the runtime predicted the pose for
+        bool valid{false};
+    };
+
+    struct Error {
+        float predicted_mm{0.0f};
+        float unpredicted_mm{0.0f};
+        float predicted_deg{0.0f};
+        float unpredicted_deg{0.0f};
+    };
+
+    // Anything whose display time is longer ago than this is stale (paused game, loading screen),
+    // extrapolating it would just fling the pose away.
+    static constexpr int64_t MAX_SAMPLE_AGE_NS = 250'000'000;
+
+    // How far past the display time "now" is, plus the extra lead. 0 if the display time hasn't been reached.
+    static float get_lead_seconds(const Settings& settings, int64_t display_time_ns, int64_t now_ns);
+
+    static Matrix4x4f extrapolate(const Matrix4x4f& transform, const Vector3f& velocity, const Vector3f& angular_velocity, float seconds);
+
+    static Matrix4x4f predict(const Settings& settings, const Sample& sample, int64_t now_ns);
+
+    // Predicts prev forward to current's display time and compares that, and prev as is, against what the runtime reported.
+    // Nothing if either sample is invalid or they're too far apart to say anything.
+    static std::optional<Error> measure(const Settings& settings, const Sample& prev, const Sample& current);
+};
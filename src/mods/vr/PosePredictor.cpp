@@ -0,0 +1,147 @@
+#include <algorithm>
+
+#include <imgui.h>
+
+#include <utility/Config.hpp>
+
+#include "PosePredictor.hpp"
+
+namespace {
+// Smoothing factor for the displayed error averages
+constexpr float ERROR_SMOOTHING = 0.05f;
+}
+
+PosePredictor::Settings PosePredictor::create_settings(std::string_view prefix, bool enabled) {
+    const auto name = [prefix](std::string_view suffix) {
+        return std::string{prefix} + "_" + std::string{suffix};
+    };
+
+    return Settings {
+        .enabled = ModToggle::create(name("Enabled"), enabled),
+        .velocity_scale = ModSlider::create(name("VelocityScale"), 0.0f, 2.0f, 1.0f),
+        .angular_velocity_scale = ModSlider::create(name("AngularVelocityScale"), 0.0f, 2.0f, 1.0f),
+        .extra_lead_ms = ModSlider::create(name("ExtraLeadMs"), 0.0f, 50.0f, 0.0f),
+        .max_prediction_ms = ModSlider::create(name("MaxPredictionMs"), 0.0f, 100.0f, 40.0f)
+    };
+}
+
+PosePredictor::PosePredictor() {
+    for (auto& settings : m_settings) {
+        if (settings.enabled == nullptr) {
+            continue;
+        }
+
+        m_options.push_back(*settings.enabled);
+        m_options.push_back(*settings.velocity_scale);
+        m_options.push_back(*settings.angular_velocity_scale);
+        m_options.push_back(*settings.extra_lead_ms);
+        m_options.push_back(*settings.max_prediction_ms);
+    }
+}
+
+void PosePredictor::on_config_save(utility::Config& cfg) {
+    for (IModValue& option : m_options) {
+        option.config_save(cfg);
+    }
+}
+
+void PosePredictor::on_config_load(const utility::Config& cfg, bool set_defaults) {
+    for (IModValue& option : m_options) {
+        option.config_load(cfg, set_defaults);
+    }
+}
+
+PoseExtrapolator::Settings PosePredictor::get_extrapolator_settings(Device device) const {
+    const auto& settings = m_settings[device];
+
+    return PoseExtrapolator::Settings {
+        .velocity_scale = settings.velocity_scale->value(),
+        .angular_velocity_scale = settings.angular_velocity_scale->value(),
+        .extra_lead_ms = settings.extra_lead_ms->value(),
+        .max_prediction_ms = settings.max_prediction_ms->value()
+    };
+}
+
+Matrix4x4f PosePredictor::predict(Device device, const Matrix4x4f& transform, const Vector3f& velocity, const Vector3f& angular_velocity) const {
+    if (!is_enabled(device)) {
+        return transform;
+    }
+
+    const auto sample = Sample {
+        .transform = transform,
+        .velocity = velocity,
+        .angular_velocity = angular_velocity,
+        .display_time_ns = m_display_time_ns.load(std::memory_order_acquire),
+        .valid = true
+    };
+
+    return PoseExtrapolator::predict(get_extrapolator_settings(device), sample, now_ns());
+}
+
+void PosePredictor::on_poses_updated(const std::array<Sample, Device::COUNT>& samples, int64_t display_time_ns) {
+    // Replay what each device's previous sample would have predicted for the new sample's display time
+    // and compare it against what the runtime actually gave us.
+    for (size_t i = 0; i < Device::COUNT; ++i) {
+        auto& stats = m_error_stats[i];
+
+        if (m_settings[i].enabled == nullptr) {
+            continue;
+        }
+
+        auto sample = samples[i];
+        sample.display_time_ns = display_time_ns;
+
+        const auto error = PoseExtrapolator::measure(get_extrapolator_settings((Device)i), stats.last_sample, sample);
+
+        if (error) {
+            stats.average.predicted_mm = glm::mix(stats.average.predicted_mm, error->predicted_mm, ERROR_SMOOTHING);
+            stats.average.unpredicted_mm = glm::mix(stats.average.unpredicted_mm, error->unpredicted_mm, ERROR_SMOOTHING);
+            stats.average.predicted_deg = glm::mix(stats.average.predicted_deg, error->predicted_deg, ERROR_SMOOTHING);
+            stats.average.unpredicted_deg = glm::mix(stats.average.unpredicted_deg, error->unpredicted_deg, ERROR_SMOOTHING);
+        }
+
+        stats.last_sample = sample;
+    }
+
+    m_display_time_ns.store(display_time_ns, std::memory_order_release);
+}
+
+void PosePredictor::on_draw_ui() {
+    if (!ImGui::TreeNode("Pose Prediction")) {
+        return;
+    }
+
+    ImGui::TextWrapped("Extrapolates controller poses past the display time the runtime predicted them for when they get read late, "
+                       "using the velocities reported by the runtime. "
+                       "The error shown is how far the previous frame's prediction was from the pose the runtime reported next.");
+
+    constexpr std::array<const char*, Device::COUNT> names{ "HMD", "Left Controller", "Right Controller" };
+
+    for (size_t i = 0; i < Device::COUNT; ++i) {
+        if (m_settings[i].enabled == nullptr) {
+            continue;
+        }
+
+        ImGui::PushID((int)i);
+
+        if (ImGui::TreeNode(names[i])) {
+            auto& settings = m_settings[i];
+            const auto& stats = m_error_stats[i];
+
+            settings.enabled->draw("Enabled");
+            settings.velocity_scale->draw("Velocity Scale");
+            settings.angular_velocity_scale->draw("Angular Velocity Scale");
+            settings.extra_lead_ms->draw("Extra Lead (ms)");
+            settings.max_prediction_ms->draw("Max Prediction (ms)");
+
+            ImGui::Text("Position Error: %.2f mm (%.2f mm without prediction)", stats.average.predicted_mm, stats.average.unpredicted_mm);
+            ImGui::Text("Rotation Error: %.2f deg (%.2f deg without prediction)", stats.average.predicted_deg, stats.average.unpredicted_deg);
+
+            ImGui::TreePop();
+        }
+
+        ImGui::PopID();
+    }
+
+    ImGui::TreePop();
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+#include <sdk/Math.hpp>
+
+#include "Mod.hpp"
+
+#include "PoseExtrapolator.hpp"
+
+// The poses the game sees are sampled once per game frame in VR::update_hmd_state,
+// so anything reading them later (attachments, the render thread) gets a pose meant for a display time that has already passed.
+// This extrapolates the controllers past that display time with the runtime's linear/angular velocity.
+// The HMD is never predicted, the views that get rendered come from the runtime's own prediction and get_transform has to match them.
+class PosePredictor final : public ModComponent {
+public:
+    enum Device : uint8_t {
+        HMD,
+        LEFT_CONTROLLER,
+        RIGHT_CONTROLLER,
+        COUNT
+    };
+
+    using Sample = PoseExtrapolator::Sample;
+
+    PosePredictor();
+
+    void on_config_save(utility::Config& cfg) override;
+    void on_config_load(const utility::Config& cfg, bool set_defaults) override;
+    void on_draw_ui() override;
+
+    // Called on the game thread right after the runtime has updated its poses, with the (steady_clock) time they were predicted for.
+    // The samples are also used to measure how far off the previous prediction was.
+    void on_poses_updated(const std::array<Sample, Device::COUNT>& samples, int64_t display_time_ns);
+
+    bool is_enabled(Device device) const {
+        return device != Device::HMD && device < Device::COUNT && m_settings[device].enabled->value();
+    }
+
+    // Extrapolates from the last samples' display time to "now", called whenever a pose is read.
+    Matrix4x4f predict(Device device, const Matrix4x4f& transform, const Vector3f& velocity, const Vector3f& angular_velocity) const;
+
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+private:
+    PoseExtrapolator::Settings get_extrapolator_settings(Device device) const;
+
+    struct Settings {
+        ModToggle::Ptr enabled;
+        ModSlider::Ptr velocity_scale;
+        ModSlider::Ptr angular_velocity_scale;
+        ModSlider::Ptr extra_lead_ms;
+        ModSlider::Ptr max_prediction_ms;
+    };
+
+    static Settings create_settings(std::string_view prefix, bool enabled);
+
+    // No settings for the HMD, it's never predicted.
+    std::array<Settings, Device::COUNT> m_settings{
+        Settings{},
+        create_settings("PosePrediction_LeftController", false),
+        create_settings("PosePrediction_RightController", false)
+    };
+
+    std::atomic<int64_t> m_display_time_ns{0};
+
+    // Game thread only. Compares what the last samples predicted against what the runtime reported next.
+    struct ErrorStats {
+        Sample last_sample{};
+        PoseExtrapolator::Error average{};
+    };
+
+    std::array<ErrorStats, Device::COUNT> m_error_stats{};
+};
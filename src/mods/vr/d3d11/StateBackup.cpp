@@ -0,0 +1,216 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "StateBackup.hpp"
+
+namespace d3d11 {
+StateBackup::StateBackup(ID3D11DeviceContext* context) {
+    if (context == nullptr) {
+        throw std::runtime_error("StateBackup: context is null");
+    }
+
+    m_context = context;
+}
+
+StateBackup::~StateBackup() {
+    restore();
+}
+
+void StateBackup::capture(uint32_t groups) {
+    groups &= ~m_captured;
+
+    if (groups == 0) {
+        return;
+    }
+
+    m_captured |= groups;
+
+    auto& old = m_old;
+
+    if (groups & VIEWPORTS) {
+        old.scissor_rect_count = old.viewport_count = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
+        m_context->RSGetScissorRects(&old.scissor_rect_count, old.scissor_rects);
+        m_context->RSGetViewports(&old.viewport_count, old.viewports);
+    }
+
+    if (groups & RASTERIZER) {
+        m_context->RSGetState(old.rasterizer.ReleaseAndGetAddressOf());
+    }
+
+    if (groups & BLEND) {
+        m_context->OMGetBlendState(old.blend.ReleaseAndGetAddressOf(), old.blend_factor, &old.sample_mask);
+    }
+
+    if (groups & DEPTH_STENCIL) {
+        m_context->OMGetDepthStencilState(old.depth_stencil.ReleaseAndGetAddressOf(), &old.stencil_ref);
+    }
+
+    if (groups & RENDER_TARGETS) {
+        ID3D11RenderTargetView* rtvs[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT]{};
+        m_context->OMGetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, rtvs, old.dsv.ReleaseAndGetAddressOf());
+
+        for (auto i = 0; i < D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i) {
+            old.rtvs[i].Attach(rtvs[i]);
+        }
+    }
+
+    if (groups & PIXEL_SHADER) {
+        old.ps.instance_count = (UINT)old.ps.instances.size();
+        m_context->PSGetShader(old.ps.shader.ReleaseAndGetAddressOf(), old.ps.instances.data(), &old.ps.instance_count);
+        m_context->PSGetShaderResources(0, 1, old.ps_srv.ReleaseAndGetAddressOf());
+        m_context->PSGetSamplers(0, 1, old.ps_sampler.ReleaseAndGetAddressOf());
+        m_context->PSGetConstantBuffers(0, 1, old.ps_constant_buffer.ReleaseAndGetAddressOf());
+    }
+
+    if (groups & VERTEX_SHADER) {
+        old.vs.instance_count = (UINT)old.vs.instances.size();
+        m_context->VSGetShader(old.vs.shader.ReleaseAndGetAddressOf(), old.vs.instances.data(), &old.vs.instance_count);
+        m_context->VSGetConstantBuffers(0, 1, old.vs_constant_buffer.ReleaseAndGetAddressOf());
+    }
+
+    if (groups & OTHER_SHADERS) {
+        old.gs.instance_count = old.hs.instance_count = old.ds.instance_count = old.cs.instance_count = (UINT)old.gs.instances.size();
+        m_context->GSGetShader(old.gs.shader.ReleaseAndGetAddressOf(), old.gs.instances.data(), &old.gs.instance_count);
+        m_context->HSGetShader(old.hs.shader.ReleaseAndGetAddressOf(), old.hs.instances.data(), &old.hs.instance_count);
+        m_context->DSGetShader(old.ds.shader.ReleaseAndGetAddressOf(), old.ds.instances.data(), &old.ds.instance_count);
+        m_context->CSGetShader(old.cs.shader.ReleaseAndGetAddressOf(), old.cs.instances.data(), &old.cs.instance_count);
+    }
+
+    if (groups & INPUT_ASSEMBLER) {
+        m_context->IAGetPrimitiveTopology(&old.topology);
+        m_context->IAGetInputLayout(old.input_layout.ReleaseAndGetAddressOf());
+        m_context->IAGetIndexBuffer(old.index_buffer.ReleaseAndGetAddressOf(), &old.index_buffer_format, &old.index_buffer_offset);
+        m_context->IAGetVertexBuffers(0, 1, old.vertex_buffer.ReleaseAndGetAddressOf(), &old.vertex_buffer_stride, &old.vertex_buffer_offset);
+    }
+}
+
+void StateBackup::restore() {
+    const auto groups = m_captured;
+
+    m_captured = 0;
+    forget_bindings();
+
+    if (groups == 0) {
+        return;
+    }
+
+    auto& old = m_old;
+
+    if (groups & VIEWPORTS) {
+        m_context->RSSetScissorRects(old.scissor_rect_count, old.scissor_rects);
+        m_context->RSSetViewports(old.viewport_count, old.viewports);
+    }
+
+    if (groups & RASTERIZER) {
+        m_context->RSSetState(old.rasterizer.Get());
+        old.rasterizer.Reset();
+    }
+
+    if (groups & BLEND) {
+        m_context->OMSetBlendState(old.blend.Get(), old.blend_factor, old.sample_mask);
+        old.blend.Reset();
+    }
+
+    if (groups & DEPTH_STENCIL) {
+        m_context->OMSetDepthStencilState(old.depth_stencil.Get(), old.stencil_ref);
+        old.depth_stencil.Reset();
+    }
+
+    if (groups & RENDER_TARGETS) {
+        ID3D11RenderTargetView* rtvs[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT]{};
+
+        for (auto i = 0; i < D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i) {
+            rtvs[i] = old.rtvs[i].Get();
+        }
+
+        m_context->OMSetRenderTargets(D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT, rtvs, old.dsv.Get());
+
+        for (auto& rtv : old.rtvs) {
+            rtv.Reset();
+        }
+
+        old.dsv.Reset();
+    }
+
+    if (groups & PIXEL_SHADER) {
+        m_context->PSSetShader(old.ps.shader.Get(), old.ps.instances.data(), old.ps.instance_count);
+        m_context->PSSetShaderResources(0, 1, old.ps_srv.GetAddressOf());
+        m_context->PSSetSamplers(0, 1, old.ps_sampler.GetAddressOf());
+        m_context->PSSetConstantBuffers(0, 1, old.ps_constant_buffer.GetAddressOf());
+        old.ps.release_instances();
+        old.ps.shader.Reset();
+        old.ps_srv.Reset();
+        old.ps_sampler.Reset();
+        old.ps_constant_buffer.Reset();
+    }
+
+    if (groups & VERTEX_SHADER) {
+        m_context->VSSetShader(old.vs.shader.Get(), old.vs.instances.data(), old.vs.instance_count);
+        m_context->VSSetConstantBuffers(0, 1, old.vs_constant_buffer.GetAddressOf());
+        old.vs.release_instances();
+        old.vs.shader.Reset();
+        old.vs_constant_buffer.Reset();
+    }
+
+    if (groups & OTHER_SHADERS) {
+        m_context->GSSetShader(old.gs.shader.Get(), old.gs.instances.data(), old.gs.instance_count);
+        m_context->HSSetShader(old.hs.shader.Get(), old.hs.instances.data(), old.hs.instance_count);
+        m_context->DSSetShader(old.ds.shader.Get(), old.ds.instances.data(), old.ds.instance_count);
+        m_context->CSSetShader(old.cs.shader.Get(), old.cs.instances.data(), old.cs.instance_count);
+        old.gs.release_instances();
+        old.hs.release_instances();
+        old.ds.release_instances();
+        old.cs.release_instances();
+        old.gs.shader.Reset();
+        old.hs.shader.Reset();
+        old.ds.shader.Reset();
+        old.cs.shader.Reset();
+    }
+
+    if (groups & INPUT_ASSEMBLER) {
+        m_context->IASetPrimitiveTopology(old.topology);
+        m_context->IASetInputLayout(old.input_layout.Get());
+        m_context->IASetIndexBuffer(old.index_buffer.Get(), old.index_buffer_format, old.index_buffer_offset);
+        m_context->IASetVertexBuffers(0, 1, old.vertex_buffer.GetAddressOf(), &old.vertex_buffer_stride, &old.vertex_buffer_offset);
+        old.input_layout.Reset();
+        old.index_buffer.Reset();
+        old.vertex_buffer.Reset();
+    }
+}
+
+void StateBackup::set_render_target(ID3D11RenderTargetView* rtv) {
+    capture(RENDER_TARGETS);
+
+    if (m_bound.rtv == rtv && rtv != nullptr) {
+        return;
+    }
+
+    ID3D11RenderTargetView* views[] = { rtv };
+    m_context->OMSetRenderTargets(1, views, nullptr);
+    m_bound.rtv = rtv;
+}
+
+void StateBackup::set_viewport(const D3D11_VIEWPORT& viewport) {
+    capture(VIEWPORTS);
+
+    if (m_bound.has_viewport && std::memcmp(&m_bound.viewport, &viewport, sizeof(viewport)) == 0) {
+        return;
+    }
+
+    m_context->RSSetViewports(1, &viewport);
+    m_bound.viewport = viewport;
+    m_bound.has_viewport = true;
+}
+
+void StateBackup::set_scissor_rect(const D3D11_RECT& rect) {
+    capture(VIEWPORTS);
+
+    if (m_bound.has_scissor_rect && std::memcmp(&m_bound.scissor_rect, &rect, sizeof(rect)) == 0) {
+        return;
+    }
+
+    m_context->RSSetScissorRects(1, &rect);
+    m_bound.scissor_rect = rect;
+    m_bound.has_scissor_rect = true;
+}
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <d3d11.h>
+#include <wrl.h>
+
+namespace d3d11 {
+// Saves whatever immediate context state the framework is about to change and puts it back when it goes away.
+// State is captured in groups, each one only the first time something asks for it, so every draw in a frame
+// can share one backup and the game only gets its state back once, with only the parts that were touched.
+class StateBackup {
+public:
+    enum Group : uint32_t {
+        VIEWPORTS = 1 << 0, // and scissor rects
+        RASTERIZER = 1 << 1,
+        BLEND = 1 << 2,
+        DEPTH_STENCIL = 1 << 3,
+        RENDER_TARGETS = 1 << 4,
+        PIXEL_SHADER = 1 << 5, // shader, first SRV, sampler and constant buffer
+        VERTEX_SHADER = 1 << 6, // shader and first constant buffer
+        OTHER_SHADERS = 1 << 7, // geometry, hull, domain and compute shaders
+        INPUT_ASSEMBLER = 1 << 8, // topology, layout, index and first vertex buffer
+
+        // Everything DirectXTK's SpriteBatch sets, plus the render target and viewport it's drawn with
+        SPRITE_BATCH = VIEWPORTS | RASTERIZER | BLEND | DEPTH_STENCIL | RENDER_TARGETS | PIXEL_SHADER | VERTEX_SHADER | INPUT_ASSEMBLER,
+        ALL = SPRITE_BATCH | OTHER_SHADERS
+    };
+
+    StateBackup(ID3D11DeviceContext* context);
+    virtual ~StateBackup();
+
+    StateBackup(const StateBackup&) = delete;
+    StateBackup& operator=(const StateBackup&) = delete;
+
+    // Groups that were already captured are left alone, they hold the game's state and not ours.
+    void capture(uint32_t groups);
+
+    // Puts back everything captured so far, after that it's as if nothing had been captured.
+    void restore();
+
+    // These skip the call if it's the same thing the framework bound last,
+    // and capture their group the first time.
+    void set_render_target(ID3D11RenderTargetView* rtv);
+    void set_viewport(const D3D11_VIEWPORT& viewport);
+    void set_scissor_rect(const D3D11_RECT& rect);
+
+    // For when something else might have used the context since the last set_* call,
+    // SteamVR's Submit for one, or anything setting these directly.
+    void forget_bindings() {
+        m_bound = {};
+    }
+
+private:
+    template <typename T> using ComPtr = Microsoft::WRL::ComPtr<T>;
+
+    template <typename T>
+    struct Shader {
+        ComPtr<T> shader{};
+        UINT instance_count{0};
+        std::array<ID3D11ClassInstance*, 256> instances{}; // 256 is max according to PSSetShader documentation
+
+        void release_instances() {
+            for (UINT i = 0; i < instance_count; ++i) {
+                if (instances[i] != nullptr) {
+                    instances[i]->Release();
+                }
+            }
+
+            instance_count = 0;
+        }
+    };
+
+    ComPtr<ID3D11DeviceContext> m_context{};
+    uint32_t m_captured{0};
+
+    struct {
+        UINT scissor_rect_count{0};
+        UINT viewport_count{0};
+        D3D11_RECT scissor_rects[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE]{};
+        D3D11_VIEWPORT viewports[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE]{};
+
+        ComPtr<ID3D11RasterizerState> rasterizer{};
+
+        ComPtr<ID3D11BlendState> blend{};
+        FLOAT blend_factor[4]{};
+        UINT sample_mask{0};
+
+        ComPtr<ID3D11DepthStencilState> depth_stencil{};
+        UINT stencil_ref{0};
+
+        ComPtr<ID3D11RenderTargetView> rtvs[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT]{};
+        ComPtr<ID3D11DepthStencilView> dsv{};
+
+        Shader<ID3D11PixelShader> ps{};
+        ComPtr<ID3D11ShaderResourceView> ps_srv{};
+        ComPtr<ID3D11SamplerState> ps_sampler{};
+        ComPtr<ID3D11Buffer> ps_constant_buffer{};
+
+        Shader<ID3D11VertexShader> vs{};
+        ComPtr<ID3D11Buffer> vs_constant_buffer{};
+
+        Shader<ID3D11GeometryShader> gs{};
+        Shader<ID3D11HullShader> hs{};
+        Shader<ID3D11DomainShader> ds{};
+        Shader<ID3D11ComputeShader> cs{};
+
+        D3D11_PRIMITIVE_TOPOLOGY topology{};
+        ComPtr<ID3D11InputLayout> input_layout{};
+        ComPtr<ID3D11Buffer> index_buffer{};
+        DXGI_FORMAT index_buffer_format{};
+        UINT index_buffer_offset{0};
+        ComPtr<ID3D11Buffer> vertex_buffer{};
+        UINT vertex_buffer_stride{0};
+        UINT vertex_buffer_offset{0};
+    } m_old{};
+
+    // What the framework itself bound last, not refcounted, only compared against
+    struct {
+        ID3D11RenderTargetView* rtv{nullptr};
+        bool has_viewport{false};
+        D3D11_VIEWPORT viewport{};
+        bool has_scissor_rect{false};
+        D3D11_RECT scissor_rect{};
+    } m_bound{};
+};
+}
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <array>
+
 #include <spdlog/spdlog.h>
 #include <utility/String.hpp>
 
@@ -7,6 +10,43 @@
 #include "CommandContext.hpp"
 
 namespace d3d12 {
+namespace {
+// Turns the tracker's batches into ResourceBarrier calls on the command list.
+class BarrierRecorder final : public ResourceStateTracker::CommandList {
+public:
+    BarrierRecorder(ID3D12GraphicsCommandList* cmd_list)
+        : m_cmd_list{cmd_list}
+    {
+    }
+
+    void resource_barrier(std::span<const ResourceStateTracker::Transition> transitions) override {
+        // Never more than a couple of resources in flight per CommandContext,
+        // anything past this just takes more than one call.
+        std::array<D3D12_RESOURCE_BARRIER, 16> barriers{};
+
+        while (!transitions.empty()) {
+            const auto count = std::min(transitions.size(), barriers.size());
+
+            for (size_t i = 0; i < count; ++i) {
+                auto& barrier = barriers[i];
+                barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                barrier.Transition.pResource = transitions[i].resource;
+                barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+                barrier.Transition.StateBefore = (D3D12_RESOURCE_STATES)transitions[i].before;
+                barrier.Transition.StateAfter = (D3D12_RESOURCE_STATES)transitions[i].after;
+            }
+
+            m_cmd_list->ResourceBarrier((UINT)count, barriers.data());
+            transitions = transitions.subspan(count);
+        }
+    }
+
+private:
+    ID3D12GraphicsCommandList* m_cmd_list{nullptr};
+};
+}
+
 bool CommandContext::setup(const wchar_t* name) {
     std::scoped_lock _{this->mtx};
 
@@ -53,6 +93,7 @@ void CommandContext::reset() {
     this->cmd_allocator.Reset();
     this->cmd_list.Reset();
     this->fence.Reset();
+    this->states.reset();
     this->fence_value = 0;
     CloseHandle(this->fence_event);
     this->fence_event = 0;
@@ -73,6 +114,7 @@ void CommandContext::wait(uint32_t ms) {
         if (FAILED(this->cmd_list->Reset(this->cmd_allocator.Get(), nullptr))) {
             spdlog::error("[VR] Failed to reset command list for {}", utility::narrow(this->internal_name));
         }
+        this->states.reset();
         this->has_commands = false;
     }
 }
@@ -85,44 +127,14 @@ void CommandContext::copy(ID3D12Resource* src, ID3D12Resource* dst, D3D12_RESOUR
         return;
     }
 
-    // Switch src into copy source.
-    D3D12_RESOURCE_BARRIER src_barrier{};
-
-    src_barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    src_barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    src_barrier.Transition.pResource = src;
-    src_barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    src_barrier.Transition.StateBefore = src_state;
-    src_barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
-
-    // Switch dst into copy destination.
-    D3D12_RESOURCE_BARRIER dst_barrier{};
-    dst_barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    dst_barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    dst_barrier.Transition.pResource = dst;
-    dst_barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    dst_barrier.Transition.StateBefore = dst_state;
-    dst_barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
-
-    {
-        D3D12_RESOURCE_BARRIER barriers[2]{src_barrier, dst_barrier};
-        this->cmd_list->ResourceBarrier(2, barriers);
-    }
+    this->states.transition(src, src_state, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    this->states.transition(dst, dst_state, D3D12_RESOURCE_STATE_COPY_DEST);
+    BarrierRecorder recorder{this->cmd_list.Get()};
+    this->states.flush(recorder);
 
     // Copy the resource.
     this->cmd_list->CopyResource(dst, src);
 
-    // Switch back to present.
-    src_barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_SOURCE;
-    src_barrier.Transition.StateAfter = src_state;
-    dst_barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-    dst_barrier.Transition.StateAfter = dst_state;
-
-    {
-        D3D12_RESOURCE_BARRIER barriers[2]{src_barrier, dst_barrier};
-        this->cmd_list->ResourceBarrier(2, barriers);
-    }
-
     this->has_commands = true;
 }
 
@@ -134,29 +146,10 @@ void CommandContext::copy_region(ID3D12Resource* src, ID3D12Resource* dst, D3D12
         return;
     }
 
-    // Switch src into copy source.
-    D3D12_RESOURCE_BARRIER src_barrier{};
-
-    src_barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    src_barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    src_barrier.Transition.pResource = src;
-    src_barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    src_barrier.Transition.StateBefore = src_state;
-    src_barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
-
-    // Switch dst into copy destination.
-    D3D12_RESOURCE_BARRIER dst_barrier{};
-    dst_barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    dst_barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    dst_barrier.Transition.pResource = dst;
-    dst_barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    dst_barrier.Transition.StateBefore = dst_state;
-    dst_barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
-
-    {
-        D3D12_RESOURCE_BARRIER barriers[2]{src_barrier, dst_barrier};
-        this->cmd_list->ResourceBarrier(2, barriers);
-    }
+    this->states.transition(src, src_state, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    this->states.transition(dst, dst_state, D3D12_RESOURCE_STATE_COPY_DEST);
+    BarrierRecorder recorder{this->cmd_list.Get()};
+    this->states.flush(recorder);
 
     // Copy the resource.
     D3D12_TEXTURE_COPY_LOCATION src_loc{};
@@ -171,17 +164,6 @@ void CommandContext::copy_region(ID3D12Resource* src, ID3D12Resource* dst, D3D12
 
     this->cmd_list->CopyTextureRegion(&dst_loc, 0, 0, 0, &src_loc, src_box);
 
-    // Switch back to present.
-    src_barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_SOURCE;
-    src_barrier.Transition.StateAfter = src_state;
-    dst_barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-    dst_barrier.Transition.StateAfter = dst_state;
-
-    {
-        D3D12_RESOURCE_BARRIER barriers[2]{src_barrier, dst_barrier};
-        this->cmd_list->ResourceBarrier(2, barriers);
-    }
-
     this->has_commands = true;
 }
 
@@ -193,48 +175,45 @@ void CommandContext::clear_rtv(ID3D12Resource* dst, D3D12_CPU_DESCRIPTOR_HANDLE
         return;
     }
 
-    // Switch dst into copy destination.
-    D3D12_RESOURCE_BARRIER dst_barrier{};
-    dst_barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    dst_barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    dst_barrier.Transition.pResource = dst;
-    dst_barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    dst_barrier.Transition.StateBefore = dst_state;
-    dst_barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-
-    // No need to switch if we're already in the right state.
-    if (dst_state != dst_barrier.Transition.StateAfter) {
-        D3D12_RESOURCE_BARRIER barriers[1]{dst_barrier};
-        this->cmd_list->ResourceBarrier(1, barriers);
-    }
+    // No barrier if it's already a render target.
+    this->states.transition(dst, dst_state, D3D12_RESOURCE_STATE_RENDER_TARGET);
+    BarrierRecorder recorder{this->cmd_list.Get()};
+    this->states.flush(recorder);
 
     // Clear the resource.
     this->cmd_list->ClearRenderTargetView(rtv, color, 0, nullptr);
 
-    // Switch back to present.
-    dst_barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
-    dst_barrier.Transition.StateAfter = dst_state;
-
-    if (dst_state != dst_barrier.Transition.StateBefore) {
-        D3D12_RESOURCE_BARRIER barriers[1]{dst_barrier};
-        this->cmd_list->ResourceBarrier(1, barriers);
-    }
-
     this->has_commands = true;
 }
 
 void CommandContext::clear_rtv(d3d12::TextureContext& tex, const float* color, D3D12_RESOURCE_STATES dst_state) {
-    if (tex.texture == nullptr || tex.rtv_heap == nullptr) {
+    if (tex.texture == nullptr || !tex.has_rtv()) {
         return;
     }
 
     this->clear_rtv(tex.texture.Get(), tex.get_rtv(), color, dst_state);
 }
 
+void CommandContext::transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES assumed_state, D3D12_RESOURCE_STATES state) {
+    std::scoped_lock _{this->mtx};
+
+    // Recorded along with whatever barriers the next command needs.
+    this->states.transition(resource, assumed_state, state);
+}
+
+void CommandContext::restore_states() {
+    std::scoped_lock _{this->mtx};
+
+    BarrierRecorder recorder{this->cmd_list.Get()};
+    this->states.restore(recorder);
+}
+
 void CommandContext::execute() {
     std::scoped_lock _{this->mtx};
     
     if (this->has_commands) {
+        this->restore_states();
+
         if (FAILED(this->cmd_list->Close())) {
             spdlog::error("[VR] Failed to close command list. ({})", utility::narrow(this->internal_name));
             return;
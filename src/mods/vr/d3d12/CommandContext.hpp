@@ -4,6 +4,7 @@
 #include <d3d12.h>
 
 #include "ComPtr.hpp"
+#include "ResourceStateTracker.hpp"
 
 namespace d3d12 {
 struct TextureContext;
@@ -24,11 +25,17 @@ struct CommandContext {
     void clear_rtv(ID3D12Resource* dst, D3D12_CPU_DESCRIPTOR_HANDLE rtv, const float* color, 
         D3D12_RESOURCE_STATES dst_state = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
     void clear_rtv(TextureContext& tex, const float* color, D3D12_RESOURCE_STATES dst_state = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+    // copy/copy_region/clear_rtv leave their resources in whatever state they needed,
+    // everything gets put back in one go on execute, or here if cmd_list is about to be used directly.
+    void transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES assumed_state, D3D12_RESOURCE_STATES state);
+    void restore_states();
     void execute();
 
     ComPtr<ID3D12CommandAllocator> cmd_allocator{};
     ComPtr<ID3D12GraphicsCommandList> cmd_list{};
     ComPtr<ID3D12Fence> fence{};
+    ResourceStateTracker states{};
     UINT64 fence_value{};
     HANDLE fence_event{};
 
@@ -0,0 +1,126 @@
+#include <algorithm>
+
+#include "DescriptorAllocator.hpp"
+
+namespace d3d12 {
+DescriptorAllocator::DescriptorAllocator(std::unique_ptr<Backend> backend, uint32_t page_size)
+    : m_backend{std::move(backend)},
+    m_page_size{std::max<uint32_t>(page_size, 1)}
+{
+}
+
+DescriptorAllocator::~DescriptorAllocator() {
+    // Whoever still holds a handle is holding a dangling descriptor now
+    if (!m_slots.empty()) {
+        m_backend->destroy_pages();
+    }
+}
+
+std::optional<DescriptorAllocator::Handle> DescriptorAllocator::allocate() {
+    uint32_t index{};
+
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+        ++m_stats.reused;
+    } else {
+        const auto page = (uint32_t)(m_slots.size() / m_page_size);
+
+        if (!m_backend->create_page(page, m_page_size)) {
+            ++m_stats.page_failures;
+            return std::nullopt;
+        }
+
+        index = (uint32_t)m_slots.size();
+        m_slots.resize(m_slots.size() + m_page_size, Slot{.generation = m_next_generation});
+
+        // Handed out lowest first
+        for (auto i = (uint32_t)m_slots.size() - 1; i > index; --i) {
+            m_free.push_back(i);
+        }
+
+        m_stats.pages = page + 1;
+        m_stats.capacity = (uint32_t)m_slots.size();
+    }
+
+    auto& slot = m_slots[index];
+    slot.used = true;
+
+    ++m_stats.allocations;
+    ++m_stats.live;
+
+    return Handle{index, slot.generation};
+}
+
+bool DescriptorAllocator::free(Handle handle, uint64_t reusable_after) {
+    if (!is_valid(handle)) {
+        ++m_stats.stale_frees;
+        return false;
+    }
+
+    auto& slot = m_slots[handle.index];
+    slot.used = false;
+
+    // 0 is reserved for handles that were never allocated
+    if (++slot.generation == 0) {
+        slot.generation = 1;
+    }
+
+    if (reusable_after > 0) {
+        m_deferred.push_back(DeferredFree{handle.index, reusable_after});
+        m_stats.deferred = (uint32_t)m_deferred.size();
+    } else {
+        m_free.push_back(handle.index);
+    }
+
+    ++m_stats.frees;
+    --m_stats.live;
+
+    return true;
+}
+
+void DescriptorAllocator::reclaim(uint64_t completed) {
+    while (!m_deferred.empty() && m_deferred.front().reusable_after <= completed) {
+        m_free.push_back(m_deferred.front().index);
+        m_deferred.pop_front();
+    }
+
+    m_stats.deferred = (uint32_t)m_deferred.size();
+}
+
+bool DescriptorAllocator::is_valid(Handle handle) const {
+    if (handle.generation == 0 || handle.index >= m_slots.size()) {
+        return false;
+    }
+
+    const auto& slot = m_slots[handle.index];
+    return slot.used && slot.generation == handle.generation;
+}
+
+bool DescriptorAllocator::release_pages() {
+    if (!is_empty()) {
+        return false;
+    }
+
+    if (m_slots.empty()) {
+        return true;
+    }
+
+    m_backend->destroy_pages();
+
+    // Generations carry on so handles from before this stay stale
+    // even if the slots come back with the next page.
+    const auto max_generation = std::max_element(m_slots.begin(), m_slots.end(), [](const auto& a, const auto& b) {
+        return a.generation < b.generation;
+    })->generation;
+
+    m_slots.clear();
+    m_free.clear();
+    m_next_generation = max_generation + 1 != 0 ? max_generation + 1 : 1;
+
+    m_stats.pages = 0;
+    m_stats.capacity = 0;
+
+    return true;
+}
+}
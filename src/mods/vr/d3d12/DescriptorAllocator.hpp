@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace d3d12 {
+// Slot bookkeeping for descriptor heaps that are shared between many textures.
+// Grows a page at a time instead of reallocating, so descriptors that were handed out never move.
+// Knows nothing about D3D12, the pages themselves come from Backend (see SharedDescriptorHeap).
+// Frees can be held back until the GPU is past a fence value, descriptors in shader visible heaps
+// are read when the command list executes, not when it's recorded.
+// Not thread safe.
+class DescriptorAllocator {
+public:
+    struct Handle {
+        uint32_t index{0};
+        uint32_t generation{0}; // never 0 for a handle that came from allocate()
+
+        bool operator==(const Handle&) const = default;
+    };
+
+    class Backend {
+    public:
+        virtual ~Backend() = default;
+
+        virtual bool create_page(uint32_t page, uint32_t size) = 0;
+        virtual void destroy_pages() = 0; // only when nothing is allocated anymore
+    };
+
+    struct Stats {
+        uint32_t live{0};
+        uint32_t deferred{0}; // freed, waiting on a fence before they can be reused
+        uint32_t capacity{0};
+        uint32_t pages{0};
+
+        uint64_t allocations{0};
+        uint64_t reused{0}; // allocations served from the free list
+        uint64_t frees{0};
+        uint64_t stale_frees{0}; // freed twice, or from before release_pages
+        uint64_t page_failures{0};
+    };
+
+    DescriptorAllocator(std::unique_ptr<Backend> backend, uint32_t page_size);
+    ~DescriptorAllocator();
+
+    DescriptorAllocator(const DescriptorAllocator&) = delete;
+    DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+
+    // Empty if a new page was needed and the backend couldn't make one.
+    std::optional<Handle> allocate();
+
+    // False if the handle is stale, nothing happens in that case.
+    // The handle is invalid right away, but the slot only gets reused once reclaim() sees reusable_after completed.
+    bool free(Handle handle, uint64_t reusable_after = 0);
+
+    // Makes everything freed with a fence value up to and including completed reusable.
+    void reclaim(uint64_t completed);
+
+    bool is_valid(Handle handle) const;
+
+    // Drops every page, fails if anything is still allocated or waiting on a fence.
+    bool release_pages();
+
+    bool is_empty() const {
+        return m_stats.live == 0 && m_deferred.empty();
+    }
+
+    uint32_t get_page(Handle handle) const {
+        return handle.index / m_page_size;
+    }
+
+    uint32_t get_offset(Handle handle) const {
+        return handle.index % m_page_size;
+    }
+
+    const Stats& get_stats() const {
+        return m_stats;
+    }
+
+private:
+    struct Slot {
+        uint32_t generation{1};
+        bool used{false};
+    };
+
+    std::unique_ptr<Backend> m_backend{};
+    uint32_t m_page_size{};
+
+    std::vector<Slot> m_slots{};
+    struct DeferredFree {
+        uint32_t index{};
+        uint64_t reusable_after{};
+    };
+
+    std::vector<uint32_t> m_free{}; // most recently freed at the back
+    std::deque<DeferredFree> m_deferred{}; // in the order they were freed, fence values only go up
+    uint32_t m_next_generation{1}; // for slots of new pages
+    Stats m_stats{};
+};
+}
@@ -13,7 +13,7 @@ void render_srv_to_rtv(
         return;
     }
 
-    if (src.srv_heap == nullptr || dst.rtv_heap == nullptr) {
+    if (!src.has_srv() || !dst.has_rtv()) {
         return;
     }
 
@@ -59,7 +59,7 @@ void render_srv_to_rtv(
     RECT dest_rect{ 0, 0, (LONG)dst_desc.Width, (LONG)dst_desc.Height };
 
     // Set descriptor heaps
-    ID3D12DescriptorHeap* game_heaps[] = { src.srv_heap->Heap() };
+    ID3D12DescriptorHeap* game_heaps[] = { src.get_srv_heap() };
     command_list->SetDescriptorHeaps(1, game_heaps);
 
     batch->Draw(src.get_srv_gpu(), 
@@ -90,7 +90,7 @@ void render_srv_to_rtv(
         return;
     }
 
-    if (src.srv_heap == nullptr || dst.rtv_heap == nullptr) {
+    if (!src.has_srv() || !dst.has_rtv()) {
         return;
     }
 
@@ -136,7 +136,7 @@ void render_srv_to_rtv(
     RECT dest_rect{ 0, 0, (LONG)dst_desc.Width, (LONG)dst_desc.Height };
 
     // Set descriptor heaps
-    ID3D12DescriptorHeap* game_heaps[] = { src.srv_heap->Heap() };
+    ID3D12DescriptorHeap* game_heaps[] = { src.get_srv_heap() };
     command_list->SetDescriptorHeaps(1, game_heaps);
 
     if (src_rect) {
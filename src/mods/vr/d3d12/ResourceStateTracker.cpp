@@ -0,0 +1,66 @@
+#include <algorithm>
+
+#include "ResourceStateTracker.hpp"
+
+namespace d3d12 {
+void ResourceStateTracker::transition(ID3D12Resource* resource, State assumed_state, State state) {
+    if (resource == nullptr) {
+        return;
+    }
+
+    ++m_stats.requested;
+
+    auto it = std::find_if(m_resources.begin(), m_resources.end(), [&](const auto& tracked) {
+        return tracked.resource == resource;
+    });
+
+    if (it == m_resources.end()) {
+        m_resources.push_back(TrackedResource{
+            .resource = resource,
+            .initial = assumed_state,
+            .recorded = assumed_state,
+            .current = state
+        });
+
+        return;
+    }
+
+    it->current = state;
+}
+
+void ResourceStateTracker::flush(CommandList& cmd_list) {
+    m_transitions.clear();
+
+    for (auto& tracked : m_resources) {
+        if (tracked.recorded == tracked.current) {
+            continue;
+        }
+
+        m_transitions.push_back(Transition{
+            .resource = tracked.resource,
+            .before = tracked.recorded,
+            .after = tracked.current
+        });
+
+        tracked.recorded = tracked.current;
+    }
+
+    if (m_transitions.empty()) {
+        return;
+    }
+
+    m_stats.emitted += m_transitions.size();
+    ++m_stats.batches;
+
+    cmd_list.resource_barrier(m_transitions);
+}
+
+void ResourceStateTracker::restore(CommandList& cmd_list) {
+    for (auto& tracked : m_resources) {
+        tracked.current = tracked.initial;
+    }
+
+    flush(cmd_list);
+    m_resources.clear();
+}
+}
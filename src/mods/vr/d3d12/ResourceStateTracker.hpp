@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct ID3D12Resource;
+
+namespace d3d12 {
+// Keeps track of which state each resource is in at the current point of a command list,
+// so back to back copies and clears don't bounce a resource out of and back into its state every time.
+// Transitions are only queued, flush/restore hand them to the command list as a single batch.
+// Doesn't know about D3D12 beyond the resource pointer, CommandContext turns the batches into ResourceBarrier calls.
+class ResourceStateTracker {
+public:
+    using State = uint32_t; // D3D12_RESOURCE_STATES
+
+    struct Transition {
+        ID3D12Resource* resource{nullptr};
+        State before{};
+        State after{};
+    };
+
+    // Where the barriers end up, one call per batch.
+    class CommandList {
+    public:
+        virtual ~CommandList() = default;
+        virtual void resource_barrier(std::span<const Transition> transitions) = 0;
+    };
+
+    struct Stats {
+        uint64_t requested{0}; // transitions asked for
+        uint64_t emitted{0}; // barriers that actually ended up in the command list
+        uint64_t batches{0}; // ResourceBarrier calls
+    };
+
+    // assumed_state is what the resource is in if it hasn't been seen yet in this command list,
+    // it's also where restore() puts it back to. Ignored for resources that are already tracked.
+    void transition(ID3D12Resource* resource, State assumed_state, State state);
+
+    // Records barriers for every resource whose state changed since the last flush.
+    // Transitions that cancel out are dropped, and several for the same resource become one.
+    // Nothing is recorded if there's nothing to do.
+    void flush(CommandList& cmd_list);
+
+    // Like flush, but puts everything back into the state it was in when first seen
+    // and forgets about it. Needed before recording anything that doesn't go through the tracker.
+    void restore(CommandList& cmd_list);
+
+    // The command list got reset, nothing recorded so far matters anymore.
+    void reset() {
+        m_resources.clear();
+        m_transitions.clear();
+    }
+
+    bool empty() const {
+        return m_resources.empty();
+    }
+
+    const Stats& get_stats() const {
+        return m_stats;
+    }
+
+private:
+    struct TrackedResource {
+        ID3D12Resource* resource{nullptr};
+        State initial{};
+        State recorded{}; // as of the last barrier in the command list
+        State current{}; // what the next command needs
+    };
+
+    // Rarely more than a handful per command list, a linear search is fine
+    std::vector<TrackedResource> m_resources{};
+    std::vector<Transition> m_transitions{};
+    Stats m_stats{};
+};
+}
@@ -0,0 +1,215 @@
+#include <spdlog/spdlog.h>
+
+#include "Framework.hpp"
+
+#include "SharedDescriptorHeap.hpp"
+
+namespace d3d12 {
+class SharedDescriptorHeap::HeapBackend final : public DescriptorAllocator::Backend {
+public:
+    HeapBackend(D3D12_DESCRIPTOR_HEAP_TYPE type, DeviceHeap& heap)
+        : m_type{type},
+        m_heap{heap}
+    {
+    }
+
+    bool create_page(uint32_t page, uint32_t size) override {
+        const auto flags = m_type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV ?
+            D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+
+        try {
+            auto heap = std::make_unique<DirectX::DescriptorHeap>(m_heap.device, m_type, flags, size);
+
+            if (heap->Heap() == nullptr) {
+                return false;
+            }
+
+            m_heap.pages.push_back(std::move(heap));
+        } catch(...) {
+            spdlog::error("[D3D12] Failed to create descriptor heap page {} (type {})", page, (int)m_type);
+            return false;
+        }
+
+        spdlog::info("[D3D12] Created descriptor heap page {} (type {})", page, (int)m_type);
+        return true;
+    }
+
+    void destroy_pages() override {
+        m_heap.pages.clear();
+    }
+
+private:
+    D3D12_DESCRIPTOR_HEAP_TYPE m_type{};
+    DeviceHeap& m_heap;
+};
+
+SharedDescriptorHeap::DeviceHeap::DeviceHeap(SharedDescriptorHeap& owner, ID3D12Device* device)
+    : device{device},
+    allocator{std::make_unique<HeapBackend>(owner.m_type, *this), PAGE_SIZE}
+{
+    // Everything that reads these descriptors goes through the hook's command queue
+    const auto& hook = g_framework->get_d3d12_hook();
+
+    if (owner.m_type != D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV || hook == nullptr || hook->get_device() != device || hook->get_command_queue() == nullptr) {
+        return;
+    }
+
+    if (FAILED(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)))) {
+        spdlog::error("[D3D12] Failed to create descriptor heap fence, freed descriptors get reused right away");
+        return;
+    }
+
+    queue = hook->get_command_queue();
+}
+
+SharedDescriptorHeap& SharedDescriptorHeap::get(D3D12_DESCRIPTOR_HEAP_TYPE type) {
+    // Leaked on purpose, texture contexts can outlive static destruction
+    static auto rtv = new SharedDescriptorHeap{D3D12_DESCRIPTOR_HEAP_TYPE_RTV};
+    static auto srv = new SharedDescriptorHeap{D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV};
+    static auto dsv = new SharedDescriptorHeap{D3D12_DESCRIPTOR_HEAP_TYPE_DSV};
+    static auto sampler = new SharedDescriptorHeap{D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER};
+
+    switch (type) {
+    case D3D12_DESCRIPTOR_HEAP_TYPE_RTV:
+        return *rtv;
+    case D3D12_DESCRIPTOR_HEAP_TYPE_DSV:
+        return *dsv;
+    case D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER:
+        return *sampler;
+    default:
+        return *srv;
+    }
+}
+
+SharedDescriptorHeap::SharedDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE type)
+    : m_type{type}
+{
+}
+
+SharedDescriptorHeap::Descriptor SharedDescriptorHeap::allocate(ID3D12Device* device) {
+    if (device == nullptr) {
+        return {};
+    }
+
+    std::scoped_lock _{m_mtx};
+
+    release_drained_heaps();
+
+    if (m_heaps.empty() || m_heaps.back()->device != device) {
+        // Whatever is left on the old device's pages drains on its own
+        if (!m_heaps.empty()) {
+            spdlog::info("[D3D12] Descriptor heap (type {}) switching devices, {} descriptors left on the previous one", 
+                (int)m_type, m_heaps.back()->allocator.get_stats().live);
+        }
+
+        m_heaps.push_back(std::make_unique<DeviceHeap>(*this, device));
+    }
+
+    auto& heap = *m_heaps.back();
+    reclaim(heap);
+
+    const auto handle = heap.allocator.allocate();
+
+    if (!handle) {
+        return {};
+    }
+
+    return Descriptor{this, &heap, *handle};
+}
+
+void SharedDescriptorHeap::free(DeviceHeap* heap, DescriptorAllocator::Handle handle) {
+    std::scoped_lock _{m_mtx};
+
+    uint64_t reusable_after{0};
+
+    // Anything already submitted could still read the old descriptor
+    if (heap->fence != nullptr && heap->allocator.is_valid(handle) && SUCCEEDED(heap->queue->Signal(heap->fence.Get(), heap->fence_value + 1))) {
+        reusable_after = ++heap->fence_value;
+    }
+
+    if (!heap->allocator.free(handle, reusable_after)) {
+        spdlog::error("[D3D12] Stale descriptor freed (type {}, index {})", (int)m_type, handle.index);
+    }
+
+    if (heap != m_heaps.back().get()) {
+        release_drained_heaps();
+    }
+}
+
+DirectX::DescriptorHeap* SharedDescriptorHeap::get_page(DeviceHeap* heap, DescriptorAllocator::Handle handle) {
+    std::scoped_lock _{m_mtx};
+
+    if (!heap->allocator.is_valid(handle)) {
+        return nullptr;
+    }
+
+    return heap->pages[heap->allocator.get_page(handle)].get();
+}
+
+void SharedDescriptorHeap::reclaim(DeviceHeap& heap) {
+    if (heap.fence != nullptr && heap.allocator.get_stats().deferred > 0) {
+        // UINT64_MAX once the device is gone, which lets everything through
+        heap.allocator.reclaim(heap.fence->GetCompletedValue());
+    }
+}
+
+void SharedDescriptorHeap::release_drained_heaps() {
+    if (m_heaps.size() <= 1) {
+        return;
+    }
+
+    // Never the current device's
+    for (auto it = m_heaps.begin(); it != m_heaps.end() - 1;) {
+        auto& heap = **it;
+        reclaim(heap);
+
+        if (!heap.allocator.release_pages()) {
+            ++it;
+            continue;
+        }
+
+        spdlog::info("[D3D12] Released descriptor heap (type {}) of a previous device", (int)m_type);
+        it = m_heaps.erase(it);
+    }
+}
+
+void SharedDescriptorHeap::Descriptor::reset() {
+    if (m_owner != nullptr) {
+        m_owner->free(m_heap, m_handle);
+    }
+
+    m_owner = nullptr;
+    m_heap = nullptr;
+    m_handle = {};
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE SharedDescriptorHeap::Descriptor::get_cpu() const {
+    const auto page = m_owner != nullptr ? m_owner->get_page(m_heap, m_handle) : nullptr;
+
+    if (page == nullptr) {
+        return {};
+    }
+
+    return page->GetCpuHandle(m_heap->allocator.get_offset(m_handle));
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE SharedDescriptorHeap::Descriptor::get_gpu() const {
+    const auto page = m_owner != nullptr ? m_owner->get_page(m_heap, m_handle) : nullptr;
+
+    if (page == nullptr || m_owner->m_type != D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV) {
+        return {};
+    }
+
+    return page->GetGpuHandle(m_heap->allocator.get_offset(m_handle));
+}
+
+ID3D12DescriptorHeap* SharedDescriptorHeap::Descriptor::get_heap() const {
+    const auto page = m_owner != nullptr ? m_owner->get_page(m_heap, m_handle) : nullptr;
+
+    if (page == nullptr) {
+        return nullptr;
+    }
+
+    return page->Heap();
+}
+}
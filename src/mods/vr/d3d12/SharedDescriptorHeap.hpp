@@ -0,0 +1,116 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <d3d12.h>
+
+#include <../../directxtk12-src/Inc/DescriptorHeap.h>
+
+#include "ComPtr.hpp"
+#include "DescriptorAllocator.hpp"
+
+namespace d3d12 {
+// One per descriptor heap type, shared by every TextureContext instead of each of them owning a heap per view.
+// Heaps are allocated in pages of PAGE_SIZE and never resized, a descriptor stays where it is until it's freed.
+// CBV/SRV/UAV pages are shader visible, so whoever binds a descriptor should bind its page with get_heap().
+// Freed CBV/SRV/UAV slots are only reused once the command queue is past everything submitted before the free.
+class SharedDescriptorHeap {
+public:
+    static constexpr uint32_t PAGE_SIZE = 64;
+
+private:
+    struct DeviceHeap;
+
+public:
+    // Frees itself when it goes away.
+    class Descriptor {
+    public:
+        Descriptor() = default;
+        Descriptor(SharedDescriptorHeap* owner, DeviceHeap* heap, DescriptorAllocator::Handle handle)
+            : m_owner{owner},
+            m_heap{heap},
+            m_handle{handle}
+        {
+        }
+
+        Descriptor(const Descriptor&) = delete;
+        Descriptor& operator=(const Descriptor&) = delete;
+
+        Descriptor(Descriptor&& other) noexcept {
+            *this = std::move(other);
+        }
+
+        Descriptor& operator=(Descriptor&& other) noexcept {
+            if (this != &other) {
+                reset();
+                m_owner = std::exchange(other.m_owner, nullptr);
+                m_heap = std::exchange(other.m_heap, nullptr);
+                m_handle = std::exchange(other.m_handle, {});
+            }
+
+            return *this;
+        }
+
+        ~Descriptor() {
+            reset();
+        }
+
+        void reset();
+
+        explicit operator bool() const {
+            return m_owner != nullptr;
+        }
+
+        D3D12_CPU_DESCRIPTOR_HANDLE get_cpu() const;
+        D3D12_GPU_DESCRIPTOR_HANDLE get_gpu() const; // only for shader visible heaps
+        ID3D12DescriptorHeap* get_heap() const;
+
+    private:
+        SharedDescriptorHeap* m_owner{nullptr};
+        DeviceHeap* m_heap{nullptr};
+        DescriptorAllocator::Handle m_handle{};
+    };
+
+    static SharedDescriptorHeap& get(D3D12_DESCRIPTOR_HEAP_TYPE type);
+
+    // Empty if it couldn't grow. Descriptors from a previous device keep working until they're freed,
+    // the new device gets its own pages in the meantime.
+    Descriptor allocate(ID3D12Device* device);
+
+    // For the current device.
+    DescriptorAllocator::Stats get_stats() {
+        std::scoped_lock _{m_mtx};
+        return m_heaps.empty() ? DescriptorAllocator::Stats{} : m_heaps.back()->allocator.get_stats();
+    }
+
+private:
+    class HeapBackend;
+
+    // Pages and bookkeeping for one device. Heaps of devices that have been replaced
+    // stay around until their last descriptor is freed and the GPU is done with them.
+    struct DeviceHeap {
+        DeviceHeap(SharedDescriptorHeap& owner, ID3D12Device* device);
+
+        ID3D12Device* device{nullptr};
+        ComPtr<ID3D12CommandQueue> queue{}; // what the descriptors get used on, null if unknown
+        ComPtr<ID3D12Fence> fence{}; // only for shader visible heaps
+        uint64_t fence_value{0};
+        std::vector<std::unique_ptr<DirectX::DescriptorHeap>> pages{};
+        DescriptorAllocator allocator;
+    };
+
+    SharedDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE type);
+
+    void free(DeviceHeap* heap, DescriptorAllocator::Handle handle);
+    DirectX::DescriptorHeap* get_page(DeviceHeap* heap, DescriptorAllocator::Handle handle);
+    void reclaim(DeviceHeap& heap);
+    void release_drained_heaps();
+
+    std::mutex m_mtx{};
+    D3D12_DESCRIPTOR_HEAP_TYPE m_type{};
+    std::vector<std::unique_ptr<DeviceHeap>> m_heaps{}; // current device at the back
+};
+}
@@ -26,20 +26,11 @@ bool TextureContext::setup(ID3D12Device* device, ID3D12Resource* rsrc, std::opti
 bool TextureContext::create_rtv(ID3D12Device* device, std::optional<DXGI_FORMAT> format) {
     spdlog::info("Creating RTV for texture context");
 
-    rtv_heap.reset();
-
-    // create descriptor heap
-    try {
-        rtv_heap = std::make_unique<DirectX::DescriptorHeap>(device,
-            D3D12_DESCRIPTOR_HEAP_TYPE_RTV,
-            D3D12_DESCRIPTOR_HEAP_FLAG_NONE,
-            1);
-    } catch(...) {
-        spdlog::error("Failed to create RTV descriptor heap");
-        return false;
-    }
+    rtv.reset();
+    rtv = SharedDescriptorHeap::get(D3D12_DESCRIPTOR_HEAP_TYPE_RTV).allocate(device);
 
-    if (rtv_heap->Heap() == nullptr) {
+    if (!rtv) {
+        spdlog::error("Failed to allocate RTV descriptor");
         return false;
     }
 
@@ -60,20 +51,11 @@ bool TextureContext::create_rtv(ID3D12Device* device, std::optional<DXGI_FORMAT>
 bool TextureContext::create_srv(ID3D12Device* device, std::optional<DXGI_FORMAT> format) {
     spdlog::info("Creating SRV for texture context");
 
-    srv_heap.reset();
-
-    // create descriptor heap
-    try {
-        srv_heap = std::make_unique<DirectX::DescriptorHeap>(device,
-            D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
-            D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE,
-            1);
-    } catch(...) {
-        spdlog::error("Failed to create SRV descriptor heap");
-        return false;
-    }
+    srv.reset();
+    srv = SharedDescriptorHeap::get(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV).allocate(device);
 
-    if (srv_heap->Heap() == nullptr) {
+    if (!srv) {
+        spdlog::error("Failed to allocate SRV descriptor");
         return false;
     }
 
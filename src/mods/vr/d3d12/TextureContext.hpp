@@ -2,37 +2,49 @@
 
 #include <optional>
 
-#include <../../directxtk12-src/Inc/DescriptorHeap.h>
-
 #include "CommandContext.hpp"
+#include "SharedDescriptorHeap.hpp"
 
 namespace d3d12 {
 struct TextureContext {
     CommandContext commands{};
     ComPtr<ID3D12Resource> texture{};
-    std::unique_ptr<DirectX::DescriptorHeap> rtv_heap{};
-    std::unique_ptr<DirectX::DescriptorHeap> srv_heap{};
+    SharedDescriptorHeap::Descriptor rtv{};
+    SharedDescriptorHeap::Descriptor srv{};
 
     bool setup(ID3D12Device* device, ID3D12Resource* rsrc, std::optional<DXGI_FORMAT> rtv_format, std::optional<DXGI_FORMAT> srv_format, const wchar_t* name = L"TextureContext object");
     bool create_rtv(ID3D12Device* device, std::optional<DXGI_FORMAT> format = std::nullopt);
     bool create_srv(ID3D12Device* device, std::optional<DXGI_FORMAT> format = std::nullopt);
 
+    bool has_rtv() const {
+        return (bool)rtv;
+    }
+
+    bool has_srv() const {
+        return (bool)srv;
+    }
+
     D3D12_CPU_DESCRIPTOR_HANDLE get_rtv() const {
-        return rtv_heap->GetCpuHandle(0);
+        return rtv.get_cpu();
     }
 
     D3D12_GPU_DESCRIPTOR_HANDLE get_srv_gpu() const {
-        return srv_heap->GetGpuHandle(0);
+        return srv.get_gpu();
     }
 
     D3D12_CPU_DESCRIPTOR_HANDLE get_srv_cpu() const {
-        return srv_heap->GetCpuHandle(0);
+        return srv.get_cpu();
+    }
+
+    // The shared page get_srv_gpu() lives in, this is what needs to be bound with SetDescriptorHeaps.
+    ID3D12DescriptorHeap* get_srv_heap() const {
+        return srv.get_heap();
     }
 
     void reset() {
         commands.reset();
-        rtv_heap.reset();
-        srv_heap.reset();
+        rtv.reset();
+        srv.reset();
         texture.Reset();
     }
 
@@ -12,6 +12,29 @@ VRRuntime::Error OpenVR::synchronize_frame(std::optional<uint32_t> frame_count)
         return VRRuntime::Error::SUCCESS;
     }
 
+    // The submit thread is the one waiting on the compositor, just pick up whatever it got last
+    const auto& submit_queue = VR::get()->get_openvr_submit_queue();
+
+    if (submit_queue->is_running()) {
+        const auto poses = submit_queue->get_poses(this->async_pose_version);
+
+        if (!poses) {
+            return VRRuntime::Error::SUCCESS;
+        }
+
+        std::unique_lock _{ this->pose_mtx };
+        this->real_render_poses = poses->render;
+        this->real_game_poses = poses->game;
+        this->async_pose_version = poses->version;
+
+        this->got_first_valid_poses = true;
+        this->got_first_sync = true;
+        this->frame_synced = true;
+        this->should_update_eye_matrices = true;
+
+        return VRRuntime::Error::SUCCESS;
+    }
+
     std::unique_lock _{ this->pose_mtx };
     vr::VRCompositor()->SetTrackingSpace(vr::TrackingUniverseStanding);
     auto ret = vr::VRCompositor()->WaitGetPoses(this->real_render_poses.data(), vr::k_unMaxTrackedDeviceCount, this->real_game_poses.data(), vr::k_unMaxTrackedDeviceCount);
@@ -135,6 +158,31 @@ VRRuntime::Error OpenVR::update_render_target_size() {
     return VRRuntime::Error::SUCCESS;
 }
 
+int64_t OpenVR::get_display_lead_ns() const {
+    if (this->hmd == nullptr) {
+        return 0;
+    }
+
+    float since_vsync{};
+    uint64_t frame_counter{};
+
+    if (!this->hmd->GetTimeSinceLastVsync(&since_vsync, &frame_counter)) {
+        return 0;
+    }
+
+    const auto hz = this->hmd->GetFloatTrackedDeviceProperty(vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_DisplayFrequency_Float);
+
+    if (hz <= 0.0f) {
+        return 0;
+    }
+
+    // WaitGetPoses predicts for when the next frame's photons hit, counted from the last vsync.
+    const auto vsync_to_photons = this->hmd->GetFloatTrackedDeviceProperty(vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_SecondsFromVsyncToPhotons_Float);
+    const auto seconds = (1.0f / hz) - since_vsync + vsync_to_photons;
+
+    return (int64_t)(std::max<float>(seconds, 0.0f) * 1'000'000'000.0f);
+}
+
 uint32_t OpenVR::get_width() const {
     return this->w * eye_width_adjustment;
 }
@@ -30,6 +30,7 @@ struct OpenVR final : public VRRuntime {
     VRRuntime::Error synchronize_frame(std::optional<uint32_t> frame_count = std::nullopt) override;
     VRRuntime::Error update_poses(bool from_view_extensions = false, uint32_t frame_count = 0) override;
     VRRuntime::Error update_render_target_size() override;
+    int64_t get_display_lead_ns() const override;
 
     uint32_t get_width() const override;
     uint32_t get_height() const override;
@@ -76,6 +77,8 @@ struct OpenVR final : public VRRuntime {
 
     std::chrono::system_clock::time_point last_hmd_active_time{};
 
+    uint64_t async_pose_version{0}; // last snapshot taken from the OpenVRSubmitQueue
+
     std::array<vr::HmdMatrix34_t, 3> pose_queue{};
 
     vr::VRActionHandle_t pose_action{vr::k_ulInvalidActionHandle};
@@ -138,7 +138,10 @@ VRRuntime::Error OpenXR::synchronize_frame(std::optional<uint32_t> frame_count)
 
     XrFrameWaitInfo frame_wait_info{XR_TYPE_FRAME_WAIT_INFO};
     XrFrameState local_frame_state{XR_TYPE_FRAME_STATE};
+
+    const auto wait_start = std::chrono::steady_clock::now();
     auto result = xrWaitFrame(this->session, &frame_wait_info, &local_frame_state);
+    this->frame_wait_blocked_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wait_start).count();
 
     this->end_profile("xrWaitFrame");
 
@@ -155,6 +158,8 @@ VRRuntime::Error OpenXR::synchronize_frame(std::optional<uint32_t> frame_count)
         }
 
         this->frame_state = local_frame_state;
+        this->frame_wait_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        this->frame_display_period_ns = local_frame_state.predictedDisplayPeriod;
 
         // Initialize all the existing frame states if they aren't already so we don't get some random error when calling xrEndFrame
         for (auto& pipeline_state : this->pipeline_states) {
@@ -356,6 +361,22 @@ VRRuntime::Error OpenXR::update_poses(bool from_view_extensions, uint32_t frame_
     return VRRuntime::Error::SUCCESS;
 }
 
+int64_t OpenXR::get_display_lead_ns() const {
+    const auto wait_time = this->frame_wait_time_ns.load();
+
+    if (wait_time == 0) {
+        return 0;
+    }
+
+    // XrTime can't be compared against the steady clock without XR_KHR_win32_convert_performance_counter_time,
+    // so this goes off of xrWaitFrame returning about a display period before the frame it predicted for is shown.
+    const auto period = this->frame_display_period_ns.load();
+    const auto display_time = wait_time + (int64_t)((double)period * (1.0 + this->prediction_scale));
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    return std::max<int64_t>(display_time - now, 0);
+}
+
 VRRuntime::Error OpenXR::update_render_target_size() {
     uint32_t view_count{};
     auto result = xrEnumerateViewConfigurationViews(this->instance, this->system, this->view_config, 0, &view_count, nullptr); 
@@ -689,13 +710,15 @@ void OpenXR::destroy() {
     this->frame_began = false;
 }
 
-OpenXR::PipelineState OpenXR::get_submit_state() {
+const OpenXR::PipelineState& OpenXR::get_submit_state() {
     std::scoped_lock __{ this->sync_assignment_mtx };
 
     if (this->has_render_frame_count) {
         last_submit_state = this->pipeline_states[this->internal_render_frame_count % QUEUE_SIZE];
     } else {
-        last_submit_state.stage_views = get_current_stage_view();
+        // Copy-assigning into the existing vector reuses its storage, get_current_stage_view would hand us a fresh copy every frame.
+        const auto& pipelined_stage_views = this->pipeline_states[this->internal_frame_count % QUEUE_SIZE].stage_views;
+        last_submit_state.stage_views = pipelined_stage_views.empty() ? this->stage_views : pipelined_stage_views;
         last_submit_state.view_space_location = this->view_space_location;
         last_submit_state.frame_state = this->frame_state;
         last_submit_state.frame_count = this->internal_frame_count;
@@ -1699,7 +1722,7 @@ XrResult OpenXR::begin_frame() {
     return result;
 }
 
-XrResult OpenXR::end_frame(const std::vector<XrCompositionLayerBaseHeader*>& quad_layers, bool has_depth) {
+XrResult OpenXR::end_frame(const QuadLayers& quad_layers, bool has_depth) {
     std::scoped_lock _{sync_mtx};
 
     if (!this->ready() || !this->got_first_poses || !this->frame_synced) {
@@ -1711,35 +1734,37 @@ XrResult OpenXR::end_frame(const std::vector<XrCompositionLayerBaseHeader*>& qua
         return XR_ERROR_CALL_ORDER_INVALID;
     }
 
+    if (quad_layers.dropped() > 0 && !this->warned_quad_overflow) {
+        spdlog::warn("[VR] More than {} quad layers in one frame, {} were not submitted", QuadLayers::CAPACITY, quad_layers.dropped());
+        this->warned_quad_overflow = true;
+    }
+
     const auto is_afr = VR::get()->is_using_afr();
 
+    std::array<Swapchain*, 2> eye_swapchains{};
+    std::array<Swapchain*, 2> depth_swapchains{};
+
     if (is_afr) {
-        if (!this->swapchains.contains((uint32_t)OpenXR::SwapchainIndex::AFR_LEFT_EYE) || !this->swapchains.contains((uint32_t)OpenXR::SwapchainIndex::AFR_RIGHT_EYE)) {
+        eye_swapchains = {this->get_swapchain(SwapchainIndex::AFR_LEFT_EYE), this->get_swapchain(SwapchainIndex::AFR_RIGHT_EYE)};
+        depth_swapchains = {this->get_swapchain(SwapchainIndex::AFR_DEPTH_LEFT_EYE), this->get_swapchain(SwapchainIndex::AFR_DEPTH_RIGHT_EYE)};
+
+        if (eye_swapchains[0] == nullptr || eye_swapchains[1] == nullptr) {
             spdlog::error("[VR] AFR swapchains not created");
             return XR_ERROR_VALIDATION_FAILURE;
         }
-
-        /*if (has_depth && (!this->swapchains.contains((uint32_t)OpenXR::SwapchainIndex::AFR_DEPTH_LEFT_EYE) || !this->swapchains.contains((uint32_t)OpenXR::SwapchainIndex::AFR_DEPTH_RIGHT_EYE))) {
-            spdlog::error("[VR] AFR depth swapchains not created");
-            return XR_ERROR_VALIDATION_FAILURE;
-        }*/
-
-        has_depth = has_depth && this->swapchains.contains((uint32_t)OpenXR::SwapchainIndex::AFR_DEPTH_LEFT_EYE) && this->swapchains.contains((uint32_t)OpenXR::SwapchainIndex::AFR_DEPTH_RIGHT_EYE);
     } else {
-        if (!this->swapchains.contains((uint32_t)OpenXR::SwapchainIndex::DOUBLE_WIDE)) {
+        eye_swapchains.fill(this->get_swapchain(SwapchainIndex::DOUBLE_WIDE));
+        depth_swapchains.fill(this->get_swapchain(SwapchainIndex::DEPTH));
+
+        if (eye_swapchains[0] == nullptr) {
             spdlog::error("[VR] Double wide swapchain not created");
             return XR_ERROR_VALIDATION_FAILURE;
         }
-
-        /*if (has_depth && !this->swapchains.contains((uint32_t)OpenXR::SwapchainIndex::DEPTH)) {
-            spdlog::error("[VR] Double wide depth swapchain not created");
-            return XR_ERROR_VALIDATION_FAILURE;
-        }*/
-
-        has_depth = has_depth && this->swapchains.contains((uint32_t)OpenXR::SwapchainIndex::DEPTH);
     }
 
-    const auto submit_state = this->get_submit_state();
+    has_depth = has_depth && depth_swapchains[0] != nullptr && depth_swapchains[1] != nullptr;
+
+    const auto& submit_state = this->get_submit_state();
     const auto& pipelined_stage_views = submit_state.stage_views;
     const auto& pipelined_frame_state = submit_state.frame_state;
 
@@ -1747,24 +1772,21 @@ XrResult OpenXR::end_frame(const std::vector<XrCompositionLayerBaseHeader*>& qua
         spdlog::warn("[VR] No stage views to submit");
     }
 
-    this->projection_layer_cache.clear();
-
-    std::vector<XrCompositionLayerBaseHeader*> layers{};
-    std::vector<XrCompositionLayerProjectionView> projection_layer_views{};
-    std::vector<XrCompositionLayerDepthInfoKHR> depth_layers{};
+    auto& storage = this->submit_storage;
+    auto& layers = storage.layers;
+    uint32_t layer_count = 0;
 
     // Dummy projection layers for Virtual Desktop. If we don't do this, timewarp does not work correctly on VD.
     // the reasoning from ggodin (VD dev) is that VD composites all layers using the top layer's pose (apparently)
     // I am actually not sure why this fixes the issue, but it does. and even makes the SteamVR overlay work completely fine.
+    const auto vd_swapchain = this->get_swapchain(SwapchainIndex::DUMMY_VIRTUAL_DESKTOP);
     const auto should_push_dummy = this->push_dummy_projection == true && 
                                    !pipelined_stage_views.empty() && 
-                                   this->ever_submitted == true;
-
-    XrCompositionLayerProjection dummy_projection_layer{XR_TYPE_COMPOSITION_LAYER_PROJECTION};
-    std::array<XrCompositionLayerProjectionView, 2> dummy_projection_layer_views{};
+                                   this->ever_submitted == true &&
+                                   vd_swapchain != nullptr;
 
     if (should_push_dummy) {
-        const auto& vd_swapchain = this->swapchains[(uint32_t)OpenXR::SwapchainIndex::DUMMY_VIRTUAL_DESKTOP];
+        auto& dummy_projection_layer_views = storage.dummy_projection_views;
 
         for (auto i = 0; i < std::min<size_t>(dummy_projection_layer_views.size(), pipelined_stage_views.size()); ++i) {
             auto& view = dummy_projection_layer_views[i];
@@ -1772,12 +1794,13 @@ XrResult OpenXR::end_frame(const std::vector<XrCompositionLayerBaseHeader*>& qua
             view.pose = pipelined_stage_views[i].pose;
             view.fov = pipelined_stage_views[i].fov;
 
-            view.subImage.swapchain = vd_swapchain.handle;
-            view.subImage.imageRect.offset = {(vd_swapchain.width / 2) * i, 0};
-            view.subImage.imageRect.extent = {(vd_swapchain.width / 2), vd_swapchain.height};
+            view.subImage.swapchain = vd_swapchain->handle;
+            view.subImage.imageRect.offset = {(vd_swapchain->width / 2) * i, 0};
+            view.subImage.imageRect.extent = {(vd_swapchain->width / 2), vd_swapchain->height};
             view.subImage.imageArrayIndex = 0;
         }
 
+        auto& dummy_projection_layer = storage.dummy_projection_layer;
         dummy_projection_layer.type = XR_TYPE_COMPOSITION_LAYER_PROJECTION;
         dummy_projection_layer.viewCount = 2;
         dummy_projection_layer.views = dummy_projection_layer_views.data();
@@ -1788,59 +1811,43 @@ XrResult OpenXR::end_frame(const std::vector<XrCompositionLayerBaseHeader*>& qua
     // we CANT push the layers every time, it cause some layer error
     // in xrEndFrame, so we must only do it when shouldRender is true
     if (pipelined_frame_state.shouldRender == XR_TRUE && !pipelined_stage_views.empty()) {
-        projection_layer_views.resize(pipelined_stage_views.size(), {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW});
-        depth_layers.resize(projection_layer_views.size(), {XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR});
+        auto& projection_layer_views = storage.projection_views;
+        auto& depth_layers = storage.depth_infos;
 
-        for (auto i = 0; i < projection_layer_views.size(); ++i) {            
-            Swapchain* swapchain = nullptr;
+        // Stereo only, the eye swapchains only cover two views anyways.
+        const auto view_count = std::min<size_t>(pipelined_stage_views.size(), eye_swapchains.size());
 
-            if (is_afr) {
-                if (i == 0) {
-                    swapchain = &this->swapchains[(uint32_t)OpenXR::SwapchainIndex::AFR_LEFT_EYE];
-                } else {
-                    swapchain = &this->swapchains[(uint32_t)OpenXR::SwapchainIndex::AFR_RIGHT_EYE];
-                }
-            } else {
-                swapchain = &this->swapchains[(uint32_t)OpenXR::SwapchainIndex::DOUBLE_WIDE];
-            }
+        for (auto i = 0; i < view_count; ++i) {            
+            Swapchain* swapchain = eye_swapchains[i];
 
-            projection_layer_views[i].type = XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW;
+            projection_layer_views[i] = {XR_TYPE_COMPOSITION_LAYER_PROJECTION_VIEW};
             projection_layer_views[i].pose = pipelined_stage_views[i].pose;
             projection_layer_views[i].fov = pipelined_stage_views[i].fov;
             projection_layer_views[i].subImage.swapchain = swapchain->handle;
 
             int32_t offset_x = 0, offset_y = 0, extent_x = 0, extent_y = 0;
+            const auto bounds = get_submit_view_bounds(i);
             // if we're working with a double-wide texture, use half the view bounds adjustment (as they apply to a single eye)
             int texture_area_width = is_afr ? swapchain->width : swapchain->width / 2;
             if (is_afr || i == 0) {
-                offset_x = view_bounds[i][0] * texture_area_width;
-                extent_x = view_bounds[i][1] * texture_area_width - offset_x;
+                offset_x = bounds[0] * texture_area_width;
+                extent_x = bounds[1] * texture_area_width - offset_x;
             } else {
                 // right eye double-wide
-                offset_x = texture_area_width + view_bounds[i][0] * texture_area_width;
-                extent_x = view_bounds[i][1] * texture_area_width - (offset_x - texture_area_width);
+                offset_x = texture_area_width + bounds[0] * texture_area_width;
+                extent_x = bounds[1] * texture_area_width - (offset_x - texture_area_width);
             }
-            offset_y = view_bounds[i][2] * swapchain->height;
-            extent_y = view_bounds[i][3] * swapchain->height - offset_y;
+            offset_y = bounds[2] * swapchain->height;
+            extent_y = bounds[3] * swapchain->height - offset_y;
             
             // SPDLOG_INFO("image calc for eye {} {}, {}, {}, {}", i, offset_x, extent_x, offset_y, extent_y);
             projection_layer_views[i].subImage.imageRect.offset = {offset_x, offset_y};
             projection_layer_views[i].subImage.imageRect.extent = {extent_x, extent_y};
 
             if (has_depth) {
-                Swapchain* depth_swapchain = nullptr;
+                Swapchain* depth_swapchain = depth_swapchains[i];
 
-                if (is_afr) {
-                    if (i == 0) {
-                        depth_swapchain = &this->swapchains[(uint32_t)OpenXR::SwapchainIndex::AFR_DEPTH_LEFT_EYE];
-                    } else {
-                        depth_swapchain = &this->swapchains[(uint32_t)OpenXR::SwapchainIndex::AFR_DEPTH_RIGHT_EYE];
-                    }
-                } else {
-                    depth_swapchain = &this->swapchains[(uint32_t)OpenXR::SwapchainIndex::DEPTH];
-                }
-
-                depth_layers[i].type = XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR;
+                depth_layers[i] = {XR_TYPE_COMPOSITION_LAYER_DEPTH_INFO_KHR};
                 depth_layers[i].next = nullptr;
                 depth_layers[i].subImage.swapchain = depth_swapchain->handle;
 
@@ -1862,30 +1869,33 @@ XrResult OpenXR::end_frame(const std::vector<XrCompositionLayerBaseHeader*>& qua
             }
         }
 
-        auto& layer = this->projection_layer_cache.emplace_back();
+        auto& layer = storage.projection_layer;
         layer.type = XR_TYPE_COMPOSITION_LAYER_PROJECTION;
+        layer.next = nullptr;
         layer.space = this->stage_space;
-        layer.viewCount = (uint32_t)projection_layer_views.size();
+        layer.viewCount = (uint32_t)view_count;
         layer.views = projection_layer_views.data();
         layer.layerFlags = 0;
 
         if (should_push_dummy) {
-            layers.push_back((XrCompositionLayerBaseHeader*)&dummy_projection_layer);
+            layers[layer_count++] = (XrCompositionLayerBaseHeader*)&storage.dummy_projection_layer;
         }
 
-        for (auto& l : this->projection_layer_cache) {
-            layers.push_back((XrCompositionLayerBaseHeader*)&l);
-        }
+        layers[layer_count++] = (XrCompositionLayerBaseHeader*)&layer;
 
         for (auto& l : quad_layers) {   
-            layers.push_back(l);
+            if (layer_count >= layers.size()) {
+                break;
+            }
+
+            layers[layer_count++] = l;
         }
     }
 
     XrFrameEndInfo frame_end_info{XR_TYPE_FRAME_END_INFO};
     frame_end_info.displayTime = pipelined_frame_state.predictedDisplayTime != 0 ? pipelined_frame_state.predictedDisplayTime : this->frame_state.predictedDisplayTime;
     frame_end_info.environmentBlendMode = this->blend_mode;
-    frame_end_info.layerCount = (uint32_t)layers.size();
+    frame_end_info.layerCount = layer_count;
     frame_end_info.layers = layers.data();
 
     //spdlog::info("[VR] display time diff: {}", pipelined_frame_state.predictedDisplayTime - this->frame_state.predictedDisplayTime);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <unordered_set>
 #include <deque>
 
@@ -18,6 +20,7 @@
 #include <sdk/Math.hpp>
 
 #include "Mod.hpp"
+#include "utility/FixedVector.hpp"
 
 #include "VRRuntime.hpp"
 
@@ -37,6 +40,9 @@ struct OpenXR final : public VRRuntime {
         int32_t height;
     };
 
+    // Fixed capacity so the renderers can build their quad layer list every frame without allocating.
+    using QuadLayers = utility::FixedVector<XrCompositionLayerBaseHeader*, 8>;
+
     VRRuntime::Type type() const override { 
         return VRRuntime::Type::OPENXR;
     }
@@ -57,6 +63,8 @@ struct OpenXR final : public VRRuntime {
         return this->enabled_extensions.contains(XR_KHR_COMPOSITION_LAYER_CYLINDER_EXTENSION_NAME);
     }
 
+    int64_t get_display_lead_ns() const override;
+
     void on_system_properties_acquired(const XrSystemProperties& props);
 
     void on_config_load(const utility::Config& cfg, bool set_defaults) override;
@@ -136,7 +144,8 @@ public:
     std::optional<std::string> initialize_actions(const std::string& json_string);
 
     XrResult begin_frame();
-    XrResult end_frame(const std::vector<XrCompositionLayerBaseHeader*>& quad_layers, bool has_depth = false);
+    // Layers that didn't fit in quad_layers are logged the first time it happens.
+    XrResult end_frame(const QuadLayers& quad_layers, bool has_depth = false);
 
     void begin_profile() {
         if (!this->profile_calls) {
@@ -200,12 +209,18 @@ public:
     XrViewState stage_view_state{XR_TYPE_VIEW_STATE};
     XrFrameState frame_state{XR_TYPE_FRAME_STATE};
 
+    // steady_clock time xrWaitFrame last returned and its display period, for get_display_lead_ns.
+    std::atomic<int64_t> frame_wait_time_ns{0};
+    std::atomic<int64_t> frame_display_period_ns{0};
+
+    // Running total of the time spent blocked in xrWaitFrame, for telling the game's own frame time apart from the pacing.
+    std::atomic<int64_t> frame_wait_blocked_ns{0};
+
     XrSessionState session_state{XR_SESSION_STATE_UNKNOWN};
 
     XrSpaceLocation view_space_location{XR_TYPE_SPACE_LOCATION};
 
     std::unordered_set<std::string> enabled_extensions{};
-    std::vector<XrCompositionLayerProjection> projection_layer_cache{};
 
     std::vector<XrViewConfigurationView> view_configs{};
     std::unordered_map<uint32_t, Swapchain> swapchains{}; // SwapchainIndex -> Swapchain
@@ -297,12 +312,13 @@ public:
     }
 
     PipelineState last_submit_state{};
-    PipelineState get_submit_state();
+    const PipelineState& get_submit_state();
     
     const ModSlider::Ptr resolution_scale{ ModSlider::create("OpenXR_ResolutionScale", 0.1f, 3.0f, 1.0f) };
     const ModToggle::Ptr ignore_vd_checks{ ModToggle::create("OpenXR_IgnoreVirtualDesktopChecks", false) };
     bool push_dummy_projection{ false };
     bool ever_submitted{false};
+    bool warned_quad_overflow{false};
     
     Mod::ValueList options{
         *resolution_scale,
@@ -343,6 +359,41 @@ public:
         EXTRA_COUNT = EXTRA_END - EXTRA_START,
     };
 
+    // Called by the D3D components when they create/destroy their swapchains.
+    // Keeps the slots end_frame reads in sync with the swapchains map.
+    void set_swapchain(uint32_t index, const Swapchain& swapchain) {
+        auto& result = this->swapchains[index];
+        result = swapchain;
+
+        if (index < this->swapchain_slots.size()) {
+            this->swapchain_slots[index] = &result;
+        }
+    }
+
+    void clear_swapchains() {
+        this->swapchain_slots.fill(nullptr);
+        this->swapchains.clear();
+    }
+
+    Swapchain* get_swapchain(SwapchainIndex index) const {
+        return this->swapchain_slots[(uint32_t)index];
+    }
+
+    // Resolved once at creation, unordered_map nodes don't move so these stay valid until clear_swapchains.
+    std::array<Swapchain*, (size_t)SwapchainIndex::END> swapchain_slots{};
+
+    // Everything end_frame hands to xrEndFrame. Kept around between frames so submission doesn't allocate.
+    struct SubmitStorage {
+        XrCompositionLayerProjection projection_layer{XR_TYPE_COMPOSITION_LAYER_PROJECTION};
+        std::array<XrCompositionLayerProjectionView, 2> projection_views{};
+        std::array<XrCompositionLayerDepthInfoKHR, 2> depth_infos{};
+
+        XrCompositionLayerProjection dummy_projection_layer{XR_TYPE_COMPOSITION_LAYER_PROJECTION};
+        std::array<XrCompositionLayerProjectionView, 2> dummy_projection_views{};
+
+        std::array<XrCompositionLayerBaseHeader*, 2 + QuadLayers::CAPACITY> layers{};
+    } submit_storage{};
+
     struct Action {
         std::vector<XrAction> action_collection{};
     };
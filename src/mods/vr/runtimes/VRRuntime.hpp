@@ -79,6 +79,11 @@ struct VRRuntime {
         return Error::SUCCESS;
     }
 
+    // How far ahead of now the poses from the last update_poses were predicted for, 0 if the runtime doesn't say.
+    virtual int64_t get_display_lead_ns() const {
+        return 0;
+    }
+
     virtual Error consume_events(std::function<void(void*)> callback) {
         return Error::SUCCESS;
     }
@@ -198,6 +203,19 @@ struct VRRuntime {
     // used to crop the rendered eye textures to account for projection adjustments
     float view_bounds[2][4] = {0, 1, 0, 1, 0, 1, 0, 1};
 
+    // share of each eye's area the frame being submitted was rendered into, below 1 with dynamic resolution
+    float submit_view_scale{1.0f};
+
+    // view_bounds of the given eye, scaled to the area that was actually rendered this frame
+    std::array<float, 4> get_submit_view_bounds(size_t eye) const {
+        return {
+            view_bounds[eye][0] * submit_view_scale,
+            view_bounds[eye][1] * submit_view_scale,
+            view_bounds[eye][2] * submit_view_scale,
+            view_bounds[eye][3] * submit_view_scale
+        };
+    }
+
     float last_eye_matrix_nearz = 0.01f;
     bool should_update_eye_matrices{true};
     bool should_recalculate_eye_projections{false};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+namespace utility {
+// Fixed-capacity list for things that get rebuilt every frame and must not allocate while doing it.
+// Anything pushed past the capacity is dropped and counted, whoever consumes the list decides how loudly to complain.
+template <typename T, size_t Capacity>
+class FixedVector {
+public:
+    static constexpr size_t CAPACITY = Capacity;
+
+    // False if it's full, the value is dropped.
+    bool push_back(const T& value) {
+        if (m_size >= Capacity) {
+            ++m_dropped;
+            return false;
+        }
+
+        m_data[m_size++] = value;
+        return true;
+    }
+
+    void clear() {
+        m_size = 0;
+        m_dropped = 0;
+    }
+
+    std::span<const T> span() const {
+        return {m_data.data(), m_size};
+    }
+
+    const T* begin() const {
+        return m_data.data();
+    }
+
+    const T* end() const {
+        return m_data.data() + m_size;
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    // How many push_back calls didn't fit since the last clear.
+    size_t dropped() const {
+        return m_dropped;
+    }
+
+private:
+    std::array<T, Capacity> m_data{};
+    size_t m_size{0};
+    size_t m_dropped{0};
+};
+}
@@ -0,0 +1,394 @@
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <optional>
+
+#include "JsonWriter.hpp"
+
+namespace utility {
+namespace {
+constexpr size_t FILE_BUFFER_SIZE = 64 * 1024;
+
+struct Decimal {
+    std::array<char, 24> digits{};
+    int count{0};
+    int exponent{0}; // of the first digit
+};
+
+// Splits to_chars' scientific output ("d[.ddd]e(+|-)XX") back into digits and an exponent.
+Decimal to_decimal(double d, std::optional<int> precision = std::nullopt) {
+    std::array<char, 40> buf{};
+    const auto result = precision ?
+        std::to_chars(buf.data(), buf.data() + buf.size(), d, std::chars_format::scientific, *precision) :
+        std::to_chars(buf.data(), buf.data() + buf.size(), d, std::chars_format::scientific);
+    const std::string_view str{buf.data(), (size_t)(result.ptr - buf.data())};
+
+    Decimal out{};
+    const auto e = str.find('e');
+
+    for (const auto c : str.substr(0, e)) {
+        if (c != '.') {
+            out.digits[out.count++] = c;
+        }
+    }
+
+    std::from_chars(str.data() + e + (str[e + 1] == '+' ? 2 : 1), str.data() + str.size(), out.exponent);
+    return out;
+}
+
+double from_decimal(const Decimal& dec) {
+    std::array<char, 40> buf{};
+    auto p = std::copy_n(dec.digits.data(), dec.count, buf.data());
+    *p++ = 'e';
+    p = std::to_chars(p, buf.data() + buf.size(), dec.exponent - (dec.count - 1)).ptr;
+
+    double d{};
+    std::from_chars(buf.data(), p, d);
+    return d;
+}
+
+// Shortest digits that read back as d, picked the way nlohmann's grisu2 picks them. to_chars rounds
+// halfway cases to even, grisu2 always takes the candidate further from zero. A halfway case is when
+// one more digit is exact and that digit is a 5, which is common for floats that got widened.
+Decimal shortest_decimal(double d) {
+    const auto dec = to_decimal(d);
+
+    // Halfway and rounded down means one more digit is a 5 with the same digits in front of it,
+    const auto longer = to_decimal(d, dec.count);
+
+    if (longer.digits[dec.count] != '5' || longer.exponent != dec.exponent ||
+        !std::equal(dec.digits.begin(), dec.digits.begin() + dec.count, longer.digits.begin()))
+    {
+        return dec;
+    }
+
+    // and nothing after it. Every double has a finite decimal expansion, at most 767 digits long.
+    std::array<char, 800> exact{};
+    const auto exact_end = std::to_chars(exact.data(), exact.data() + exact.size(), d, std::chars_format::scientific, 766).ptr;
+    const std::string_view exact_digits{exact.data(), (size_t)(std::find(exact.data(), exact_end, 'e') - exact.data())};
+
+    // "d.ddd", the digits past the 5 start after the point and the first count + 1 digits
+    if (exact_digits.find_first_not_of('0', dec.count + 2) != std::string_view::npos) {
+        return dec;
+    }
+
+    auto up = dec;
+    auto i = up.count - 1;
+
+    for (; i >= 0 && up.digits[i] == '9'; --i) {
+        up.digits[i] = '0';
+    }
+
+    if (i >= 0) {
+        ++up.digits[i];
+    } else {
+        // 999 -> 1000, the zeros aren't part of the shortest form
+        up.digits[0] = '1';
+        up.count = 1;
+        ++up.exponent;
+    }
+
+    while (up.count > 1 && up.digits[up.count - 1] == '0') {
+        --up.count;
+    }
+
+    return from_decimal(up) == d ? up : dec;
+}
+
+// Same layout nlohmann's serializer uses: plain notation for decimal exponents in (-4, 15]
+// with a ".0" on whole numbers, otherwise d.ddde+XX.
+std::string_view format_double(std::array<char, 64>& out, double d) {
+    auto p = out.data();
+
+    if (std::signbit(d)) {
+        *p++ = '-';
+        d = -d;
+    }
+
+    if (d == 0.0) {
+        *p++ = '0';
+        *p++ = '.';
+        *p++ = '0';
+        return {out.data(), (size_t)(p - out.data())};
+    }
+
+    const auto dec = shortest_decimal(d);
+    const auto& digits = dec.digits;
+    const auto k = dec.count;
+    const auto exponent = dec.exponent;
+
+    constexpr int MIN_EXP = -4;
+    constexpr int MAX_EXP = 15;
+    const auto n = exponent + 1; // where the decimal point goes, relative to the first digit
+
+    const auto put = [&](std::string_view s) {
+        p = std::copy(s.begin(), s.end(), p);
+    };
+
+    if (k <= n && n <= MAX_EXP) {
+        // 1234e7 -> 12340000000.0
+        put({digits.data(), (size_t)k});
+        p = std::fill_n(p, n - k, '0');
+        put(".0");
+    } else if (0 < n && n <= MAX_EXP) {
+        // 1234e-2 -> 12.34
+        put({digits.data(), (size_t)n});
+        *p++ = '.';
+        put({digits.data() + n, (size_t)(k - n)});
+    } else if (MIN_EXP < n && n <= 0) {
+        // 1234e-6 -> 0.001234
+        put("0.");
+        p = std::fill_n(p, -n, '0');
+        put({digits.data(), (size_t)k});
+    } else {
+        // 1234e30 -> 1.234e+33
+        *p++ = digits[0];
+
+        if (k > 1) {
+            *p++ = '.';
+            put({digits.data() + 1, (size_t)(k - 1)});
+        }
+
+        *p++ = 'e';
+        *p++ = exponent < 0 ? '-' : '+';
+
+        const auto abs_exponent = exponent < 0 ? -exponent : exponent;
+
+        if (abs_exponent < 10) {
+            *p++ = '0';
+        }
+
+        p = std::to_chars(p, out.data() + out.size(), abs_exponent).ptr;
+    }
+
+    return {out.data(), (size_t)(p - out.data())};
+}
+}
+
+JsonWriter::JsonWriter(const std::filesystem::path& path, int indent)
+    : m_buffer(FILE_BUFFER_SIZE),
+    m_indent{indent}
+{
+    // Text mode like the std::ofstream this replaced, so line endings stay the same.
+    // MSVC's filebuf ignores setbuf until a file is open, so the buffer goes in afterwards.
+    m_file.open(path, std::ios::out | std::ios::trunc);
+    m_file.rdbuf()->pubsetbuf(m_buffer.data(), (std::streamsize)m_buffer.size());
+
+    m_scopes.reserve(16);
+}
+
+JsonWriter::~JsonWriter() {
+    close();
+}
+
+bool JsonWriter::close() {
+    if (!m_file.is_open()) {
+        return false;
+    }
+
+    m_file.flush();
+    const auto ok = m_file.good();
+    m_file.close();
+
+    return ok;
+}
+
+void JsonWriter::write_indent(size_t depth) {
+    static constexpr std::string_view spaces{"                                "};
+
+    for (auto remaining = depth * m_indent; remaining > 0;) {
+        const auto count = std::min<size_t>(remaining, spaces.size());
+        write_raw(spaces.substr(0, count));
+        remaining -= count;
+    }
+}
+
+void JsonWriter::begin_value() {
+    // Object members already did this in key()
+    if (m_after_key) {
+        m_after_key = false;
+        return;
+    }
+
+    if (m_scopes.empty()) {
+        return;
+    }
+
+    auto& scope = m_scopes.back();
+    write_raw(scope.empty ? "\n" : ",\n");
+    scope.empty = false;
+
+    write_indent(m_scopes.size());
+}
+
+void JsonWriter::begin_scope(char c) {
+    begin_value();
+    m_file.put(c);
+    m_scopes.push_back({});
+}
+
+void JsonWriter::end_scope(char c) {
+    const auto scope = m_scopes.back();
+    m_scopes.pop_back();
+
+    if (!scope.empty) {
+        m_file.put('\n');
+        write_indent(m_scopes.size());
+    }
+
+    m_file.put(c);
+}
+
+void JsonWriter::begin_object() {
+    begin_scope('{');
+}
+
+void JsonWriter::end_object() {
+    end_scope('}');
+}
+
+void JsonWriter::begin_array() {
+    begin_scope('[');
+}
+
+void JsonWriter::end_array() {
+    end_scope(']');
+}
+
+void JsonWriter::key(std::string_view name) {
+    begin_value();
+    write_string(name);
+    write_raw(": ");
+
+    m_after_key = true;
+}
+
+void JsonWriter::value(std::string_view str) {
+    begin_value();
+    write_string(str);
+}
+
+void JsonWriter::value(bool b) {
+    begin_value();
+    write_raw(b ? "true" : "false");
+}
+
+void JsonWriter::value(int64_t i) {
+    begin_value();
+
+    std::array<char, 32> buf{};
+    const auto result = std::to_chars(buf.data(), buf.data() + buf.size(), i);
+    write_raw(std::string_view{buf.data(), (size_t)(result.ptr - buf.data())});
+}
+
+void JsonWriter::value(uint64_t u) {
+    begin_value();
+
+    std::array<char, 32> buf{};
+    const auto result = std::to_chars(buf.data(), buf.data() + buf.size(), u);
+    write_raw(std::string_view{buf.data(), (size_t)(result.ptr - buf.data())});
+}
+
+void JsonWriter::value(double d) {
+    begin_value();
+
+    if (!std::isfinite(d)) {
+        write_raw("null");
+        return;
+    }
+
+    std::array<char, 64> buf{};
+    write_raw(format_double(buf, d));
+}
+
+void JsonWriter::null() {
+    begin_value();
+    write_raw("null");
+}
+
+void JsonWriter::value(const nlohmann::json& j) {
+    switch (j.type()) {
+    case nlohmann::json::value_t::object:
+        begin_object();
+
+        for (const auto& [k, v] : j.items()) {
+            key(k);
+            value(v);
+        }
+
+        end_object();
+        break;
+    case nlohmann::json::value_t::array:
+        begin_array();
+
+        for (const auto& v : j) {
+            value(v);
+        }
+
+        end_array();
+        break;
+    case nlohmann::json::value_t::string:
+        value(std::string_view{j.get_ref<const std::string&>()});
+        break;
+    case nlohmann::json::value_t::boolean:
+        value(j.get<bool>());
+        break;
+    case nlohmann::json::value_t::number_integer:
+        value(j.get<int64_t>());
+        break;
+    case nlohmann::json::value_t::number_unsigned:
+        value(j.get<uint64_t>());
+        break;
+    case nlohmann::json::value_t::number_float:
+        value(j.get<double>());
+        break;
+    default:
+        null();
+        break;
+    }
+}
+
+void JsonWriter::write_string(std::string_view str) {
+    m_file.put('"');
+
+    auto start = str.begin();
+
+    const auto flush = [&](std::string_view::const_iterator it) {
+        if (it != start) {
+            write_raw(std::string_view{start, it});
+        }
+    };
+
+    for (auto it = str.begin(); it != str.end(); ++it) {
+        const auto c = (uint8_t)*it;
+        std::string_view escaped{};
+        std::array<char, 8> unicode{};
+
+        switch (c) {
+        case '\b': escaped = "\\b"; break;
+        case '\t': escaped = "\\t"; break;
+        case '\n': escaped = "\\n"; break;
+        case '\f': escaped = "\\f"; break;
+        case '\r': escaped = "\\r"; break;
+        case '"': escaped = "\\\""; break;
+        case '\\': escaped = "\\\\"; break;
+        default:
+            if (c < 0x20) {
+                static constexpr char hex[] = "0123456789abcdef";
+                unicode = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                escaped = std::string_view{unicode.data(), 6};
+            }
+            break;
+        }
+
+        if (!escaped.empty()) {
+            flush(it);
+            write_raw(escaped);
+            start = it + 1;
+        }
+    }
+
+    flush(str.end());
+    m_file.put('"');
+}
+}
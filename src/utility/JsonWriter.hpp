@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace utility {
+// Streams JSON straight into a buffered file instead of building a nlohmann::json DOM first.
+// The output is byte-identical to nlohmann::json::dump(indent), as long as object keys
+// are written in sorted order (nlohmann stores objects in a std::map). The one exception is
+// the rare double where nlohmann's grisu2 doesn't find the shortest digits, to_chars does,
+// so the text is shorter but still reads back as the exact same value.
+class JsonWriter {
+public:
+    JsonWriter(const std::filesystem::path& path, int indent = 4);
+    virtual ~JsonWriter();
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    bool is_open() const {
+        return m_file.is_open();
+    }
+
+    void begin_object();
+    void end_object();
+    void begin_array();
+    void end_array();
+
+    void key(std::string_view name);
+
+    void value(std::string_view str);
+    void value(const char* str) { value(std::string_view{str}); }
+    void value(const std::string& str) { value(std::string_view{str}); } // otherwise ambiguous with the json overload
+    void value(bool b);
+    void value(int64_t i);
+    void value(uint64_t u);
+    void value(int32_t i) { value((int64_t)i); }
+    void value(uint32_t u) { value((uint64_t)u); }
+    void value(double d);
+    void value(float f) { value((double)f); } // nlohmann stores floats as doubles too
+    void null();
+
+    // For small subtrees that are easier to build as a DOM (e.g. utility::math::to_json).
+    void value(const nlohmann::json& j);
+
+    template <typename T>
+    void field(std::string_view name, T&& v) {
+        key(name);
+        value(std::forward<T>(v));
+    }
+
+    // Flushes and closes the file, returns false if anything failed to write.
+    bool close();
+
+private:
+    void begin_value();
+    void begin_scope(char c);
+    void end_scope(char c);
+    void write_indent(size_t depth);
+    void write_string(std::string_view str);
+    void write_raw(std::string_view str) {
+        m_file.write(str.data(), (std::streamsize)str.size());
+    }
+
+    struct Scope {
+        bool empty{true};
+    };
+
+    std::ofstream m_file{};
+    std::vector<char> m_buffer{};
+    std::vector<Scope> m_scopes{};
+    int m_indent{4};
+    bool m_after_key{false};
+};
+}
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace utility {
+// Fixed-capacity cache that evicts the least recently used entry when full.
+// Storage is allocated once up front, so memory stays flat no matter how many keys pass through it.
+// Meant for small capacities (lookups are a linear scan over the keys).
+//
+// Entries are tagged with the generation they were inserted in. bump_generation() invalidates
+// everything at once, which is how callers deal with keys (usually pointers) that may get reused
+// by the engine for something unrelated.
+template <typename Key, typename Value, size_t Capacity>
+class LruCache {
+public:
+    static_assert(Capacity > 0 && Capacity < std::numeric_limits<uint32_t>::max(), "Invalid capacity");
+
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t evictions{0};
+        size_t size{0};
+        size_t capacity{Capacity};
+    };
+
+    LruCache() {
+        clear();
+    }
+
+    // Returns nullptr on a miss. A hit makes the entry the most recently used one.
+    Value* find(const Key& key) {
+        const auto index = find_index(key);
+
+        if (index == INVALID) {
+            ++m_stats.misses;
+            return nullptr;
+        }
+
+        ++m_stats.hits;
+        touch(index);
+
+        return &m_entries[index].value;
+    }
+
+    // Returns the entry for the key, creating it (and evicting the LRU entry if full) if needed.
+    Value& get_or_insert(const Key& key) {
+        if (const auto index = find_index(key); index != INVALID) {
+            touch(index);
+            return m_entries[index].value;
+        }
+
+        uint32_t index = INVALID;
+
+        if (m_size < Capacity) {
+            index = (uint32_t)m_size++;
+        } else {
+            // Reuse entries from an older generation first, they're dead anyways.
+            for (auto i = m_tail; i != INVALID; i = m_entries[i].prev) {
+                if (m_entries[i].generation != m_generation) {
+                    index = i;
+                    break;
+                }
+            }
+
+            if (index == INVALID) {
+                index = m_tail;
+                ++m_stats.evictions;
+            }
+
+            unlink(index);
+        }
+
+        auto& entry = m_entries[index];
+        entry.key = key;
+        entry.generation = m_generation;
+        entry.value = Value{};
+
+        push_front(index);
+
+        return entry.value;
+    }
+
+    // Visits the live entries from most to least recently used, without touching them.
+    template <typename Fn>
+    void for_each(Fn&& fn) {
+        for (auto i = m_head; i != INVALID; i = m_entries[i].next) {
+            auto& entry = m_entries[i];
+
+            if (entry.generation == m_generation) {
+                fn(entry.key, entry.value);
+            }
+        }
+    }
+
+    // Drops the live entries the predicate returns true for, their slots get reused first. Returns how many were dropped.
+    template <typename Fn>
+    size_t erase_if(Fn&& pred) {
+        size_t erased = 0;
+
+        for (size_t i = 0; i < m_size; ++i) {
+            auto& entry = m_entries[i];
+
+            if (entry.generation == m_generation && pred(entry.key, entry.value)) {
+                entry.generation = m_generation - 1;
+                ++erased;
+            }
+        }
+
+        return erased;
+    }
+
+    void bump_generation() {
+        ++m_generation;
+    }
+
+    void clear() {
+        m_size = 0;
+        m_head = INVALID;
+        m_tail = INVALID;
+        ++m_generation;
+    }
+
+    Stats get_stats() const {
+        auto stats = m_stats;
+        stats.size = 0;
+
+        for (size_t i = 0; i < m_size; ++i) {
+            if (m_entries[i].generation == m_generation) {
+                ++stats.size;
+            }
+        }
+
+        return stats;
+    }
+
+private:
+    static constexpr uint32_t INVALID = std::numeric_limits<uint32_t>::max();
+
+    struct Entry {
+        Key key{};
+        uint64_t generation{0};
+        uint32_t prev{INVALID};
+        uint32_t next{INVALID};
+        Value value{};
+    };
+
+    uint32_t find_index(const Key& key) const {
+        for (uint32_t i = 0; i < m_size; ++i) {
+            const auto& entry = m_entries[i];
+
+            if (entry.key == key && entry.generation == m_generation) {
+                return i;
+            }
+        }
+
+        return INVALID;
+    }
+
+    void unlink(uint32_t index) {
+        auto& entry = m_entries[index];
+
+        if (entry.prev != INVALID) {
+            m_entries[entry.prev].next = entry.next;
+        } else {
+            m_head = entry.next;
+        }
+
+        if (entry.next != INVALID) {
+            m_entries[entry.next].prev = entry.prev;
+        } else {
+            m_tail = entry.prev;
+        }
+
+        entry.prev = INVALID;
+        entry.next = INVALID;
+    }
+
+    void push_front(uint32_t index) {
+        auto& entry = m_entries[index];
+        entry.prev = INVALID;
+        entry.next = m_head;
+
+        if (m_head != INVALID) {
+            m_entries[m_head].prev = index;
+        }
+
+        m_head = index;
+
+        if (m_tail == INVALID) {
+            m_tail = index;
+        }
+    }
+
+    void touch(uint32_t index) {
+        if (m_head == index) {
+            return;
+        }
+
+        unlink(index);
+        push_front(index);
+    }
+
+    std::array<Entry, Capacity> m_entries{};
+    size_t m_size{0};
+    uint32_t m_head{INVALID};
+    uint32_t m_tail{INVALID};
+    uint64_t m_generation{0};
+
+    Stats m_stats{};
+};
+}
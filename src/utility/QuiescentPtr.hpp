@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utility {
+// Pointer that can be read without taking a lock, meant for state that gets read on hot paths
+// (hooked functions, window procedures) but only rarely replaced.
+//
+// Readers hold a ReadGuard for as long as they use the object. Writers swap in a new object with publish(),
+// the old one is retired and only freed once there are no readers left (a quiescent state), so a reader never
+// sees a freed object. Writers are serialized with each other, readers never wait on anything.
+//
+// Retired objects are freed by whichever comes first: a write that finds no readers, or the last reader
+// leaving. The reader only tries the write lock and skips it if a writer holds it, so a retired object can
+// outlive its last reader until the next write or the next time the reader count drops to zero.
+template <typename T>
+class QuiescentPtr {
+public:
+    class ReadGuard {
+    public:
+        ReadGuard(const QuiescentPtr& owner)
+            : m_owner{&owner}
+        {
+            // seq_cst on both so a writer that sees no readers after its exchange
+            // can't race with a reader that's about to load the old pointer.
+            m_owner->m_readers.fetch_add(1, std::memory_order_seq_cst);
+            m_ptr = m_owner->m_ptr.load(std::memory_order_seq_cst);
+        }
+
+        ~ReadGuard() {
+            release();
+        }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        // Drops the guard early. The object must not be touched afterwards.
+        void release() {
+            if (m_owner != nullptr) {
+                // seq_cst, paired with reclaim_locked: either the writer sees this reader gone,
+                // or this reader sees what the writer retired.
+                if (m_owner->m_readers.fetch_sub(1, std::memory_order_seq_cst) == 1 && m_owner->m_has_retired.load(std::memory_order_seq_cst)) {
+                    m_owner->try_reclaim();
+                }
+
+                m_owner = nullptr;
+                m_ptr = nullptr;
+            }
+        }
+
+        const T* get() const {
+            return m_ptr;
+        }
+
+        const T* operator->() const {
+            return m_ptr;
+        }
+
+        const T& operator*() const {
+            return *m_ptr;
+        }
+
+        explicit operator bool() const {
+            return m_ptr != nullptr;
+        }
+
+    private:
+        const QuiescentPtr* m_owner{nullptr};
+        const T* m_ptr{nullptr};
+    };
+
+    QuiescentPtr() = default;
+    QuiescentPtr(const QuiescentPtr&) = delete;
+    QuiescentPtr& operator=(const QuiescentPtr&) = delete;
+
+    ~QuiescentPtr() {
+        publish(nullptr);
+
+        // Leaking is better than pulling the object out from under a reader that's stuck somewhere.
+        if (!wait_for_readers(std::chrono::seconds(1))) {
+            std::scoped_lock _{m_write_mtx};
+
+            for (auto& retired : m_retired) {
+                retired.release();
+            }
+        }
+    }
+
+    ReadGuard read() const {
+        return ReadGuard{*this};
+    }
+
+    // Swaps in the new object, returns the version number it was published as.
+    uint64_t publish(std::unique_ptr<T> value) {
+        std::scoped_lock _{m_write_mtx};
+
+        auto old = m_ptr.exchange(value.release(), std::memory_order_seq_cst);
+
+        if (old != nullptr) {
+            m_retired.emplace_back(old);
+        }
+
+        const auto version = m_version.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+        reclaim_locked();
+        return version;
+    }
+
+    // publish() split in two for writers that can't touch the heap or take locks at that point
+    // (e.g. with every other thread frozen, one of them might be holding the heap lock).
+    // exchange() only swaps the pointer, the old object has to be handed to retire() afterwards.
+    // Callers have to serialize this with publish() themselves.
+    std::unique_ptr<const T> exchange(std::unique_ptr<T> value) {
+        auto old = m_ptr.exchange(value.release(), std::memory_order_seq_cst);
+        m_version.fetch_add(1, std::memory_order_acq_rel);
+
+        return std::unique_ptr<const T>{old};
+    }
+
+    void retire(std::unique_ptr<const T> old) {
+        std::scoped_lock _{m_write_mtx};
+
+        if (old != nullptr) {
+            m_retired.push_back(std::move(old));
+        }
+
+        reclaim_locked();
+    }
+
+    // Frees retired objects if nobody is reading right now. Also done on every write and by the last reader out.
+    void reclaim() {
+        std::scoped_lock _{m_write_mtx};
+        reclaim_locked();
+    }
+
+    // For writers that must know no reader is still using an old object (e.g. before unloading code it points into).
+    // Returns false if readers were still around when the timeout expired.
+    bool wait_for_readers(std::chrono::milliseconds timeout) const {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        while (m_readers.load(std::memory_order_seq_cst) != 0) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+
+            std::this_thread::yield();
+        }
+
+        return true;
+    }
+
+    uint64_t get_version() const {
+        return m_version.load(std::memory_order_acquire);
+    }
+
+    size_t get_retired_count() const {
+        std::scoped_lock _{m_write_mtx};
+        return m_retired.size();
+    }
+
+private:
+    // Readers never wait on a writer, if one is busy it'll reclaim on its own.
+    void try_reclaim() const {
+        std::unique_lock lock{m_write_mtx, std::try_to_lock};
+
+        if (lock.owns_lock()) {
+            reclaim_locked();
+        }
+    }
+
+    void reclaim_locked() const {
+        m_has_retired.store(!m_retired.empty(), std::memory_order_seq_cst);
+
+        if (m_retired.empty()) {
+            return;
+        }
+
+        if (m_readers.load(std::memory_order_seq_cst) != 0) {
+            return;
+        }
+
+        m_retired.clear();
+        m_has_retired.store(false, std::memory_order_seq_cst);
+    }
+
+    std::atomic<const T*> m_ptr{nullptr};
+    mutable std::atomic<uint32_t> m_readers{0};
+    std::atomic<uint64_t> m_version{0};
+
+    mutable std::mutex m_write_mtx{};
+
+    // Mutable so the last ReadGuard out can free them.
+    mutable std::vector<std::unique_ptr<const T>> m_retired{};
+    mutable std::atomic<bool> m_has_retired{false};
+};
+}
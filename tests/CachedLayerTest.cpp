@@ -0,0 +1,98 @@
+#include <cstdint>
+#include <cstring>
+
+#include <mods/vr/CachedLayer.hpp>
+
+#include "Test.hpp"
+
+namespace {
+// Shaped like an XrCompositionLayerQuad and the LayerInputs it's built from, without the runtime.
+struct FakeLayer {
+    uint64_t swapchain{0};
+    float width{0.0f};
+    float height{0.0f};
+    float position[3]{};
+};
+
+struct FakeInputs {
+    uint64_t swapchain{0};
+    int32_t width{0};
+    int32_t height{0};
+    float size{0.0f};
+    float distance{0.0f};
+    bool drawing_framework_ui{false};
+
+    bool operator==(const FakeInputs&) const = default;
+};
+
+// What the OpenXR layer generators do: only rebuild when update() says the inputs changed.
+struct Generator {
+    CachedLayer<FakeLayer, FakeInputs> cached{};
+    uint32_t builds{0};
+
+    const FakeLayer& generate(const FakeInputs& inputs) {
+        if (cached.update(inputs)) {
+            ++builds;
+
+            cached.meters_w = (float)inputs.width / (float)inputs.height * inputs.size;
+            cached.meters_h = inputs.size;
+            cached.layer.swapchain = inputs.swapchain;
+            cached.layer.width = cached.meters_w;
+            cached.layer.height = cached.meters_h;
+            cached.layer.position[2] = -inputs.distance;
+        }
+
+        return cached.layer;
+    }
+};
+
+const FakeInputs SLATE{.swapchain = 1, .width = 1920, .height = 1080, .size = 2.0f, .distance = 1.5f};
+}
+
+TEST(cached_layer_same_inputs_same_layer) {
+    Generator generator{};
+
+    const auto first = generator.generate(SLATE);
+    CHECK(generator.builds == 1);
+
+    const auto allocations = test::get_allocations();
+
+    for (auto i = 0; i < 100; ++i) {
+        const auto& layer = generator.generate(SLATE);
+        CHECK(std::memcmp(&layer, &first, sizeof(first)) == 0);
+    }
+
+    CHECK(generator.builds == 1);
+    CHECK(test::get_allocations() == allocations);
+}
+
+TEST(cached_layer_rebuilds_on_any_change) {
+    Generator generator{};
+    generator.generate(SLATE);
+
+    auto moved = SLATE;
+    moved.distance = 2.0f;
+    CHECK(generator.generate(moved).position[2] == -2.0f);
+    CHECK(generator.builds == 2);
+
+    auto ui = moved;
+    ui.drawing_framework_ui = true;
+    generator.generate(ui);
+    CHECK(generator.builds == 3);
+
+    // Going back is a change too, the cache only remembers the last inputs
+    CHECK(generator.generate(SLATE).position[2] == -1.5f);
+    CHECK(generator.builds == 4);
+
+    generator.generate(SLATE);
+    CHECK(generator.builds == 4);
+}
+
+TEST(cached_layer_first_update_always_builds) {
+    CachedLayer<FakeLayer, FakeInputs> cached{};
+
+    // Even for inputs equal to a default constructed set
+    CHECK(cached.update(FakeInputs{}));
+    CHECK(!cached.update(FakeInputs{}));
+    CHECK(cached.inputs.has_value());
+}
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <mods/vr/d3d12/DescriptorAllocator.hpp>
+
+#include "Test.hpp"
+
+using d3d12::DescriptorAllocator;
+
+namespace {
+// Pages are just counted, optionally refusing to make more than max_pages.
+struct FakePages {
+    uint32_t created{0};
+    uint32_t destroyed{0};
+    uint32_t max_pages{~0u};
+
+    uint32_t alive() const {
+        return created - destroyed;
+    }
+};
+
+class FakeBackend final : public DescriptorAllocator::Backend {
+public:
+    FakeBackend(FakePages& pages)
+        : m_pages{pages}
+    {
+    }
+
+    bool create_page(uint32_t page, uint32_t) override {
+        if (m_pages.alive() >= m_pages.max_pages || page != m_pages.alive()) {
+            return false;
+        }
+
+        ++m_pages.created;
+        return true;
+    }
+
+    void destroy_pages() override {
+        m_pages.destroyed = m_pages.created;
+    }
+
+private:
+    FakePages& m_pages;
+};
+
+constexpr uint32_t PAGE_SIZE = 4;
+}
+
+TEST(descriptor_allocator_grows_a_page_at_a_time) {
+    FakePages pages{};
+    DescriptorAllocator allocator{std::make_unique<FakeBackend>(pages), PAGE_SIZE};
+
+    std::vector<DescriptorAllocator::Handle> handles{};
+
+    for (uint32_t i = 0; i < PAGE_SIZE * 2 + 1; ++i) {
+        const auto handle = allocator.allocate();
+        CHECK(handle.has_value());
+        CHECK(handle->index == i); // lowest first, nothing moves
+        handles.push_back(*handle);
+    }
+
+    CHECK(pages.created == 3);
+    CHECK(allocator.get_stats().capacity == PAGE_SIZE * 3);
+    CHECK(allocator.get_page(handles[5]) == 1);
+    CHECK(allocator.get_offset(handles[5]) == 1);
+
+    pages.max_pages = 3;
+
+    for (uint32_t i = 0; i < PAGE_SIZE - 1; ++i) {
+        CHECK(allocator.allocate().has_value());
+    }
+
+    CHECK(!allocator.allocate().has_value());
+    CHECK(allocator.get_stats().page_failures == 1);
+}
+
+TEST(descriptor_allocator_stale_handles) {
+    FakePages pages{};
+    DescriptorAllocator allocator{std::make_unique<FakeBackend>(pages), PAGE_SIZE};
+
+    const auto a = *allocator.allocate();
+    CHECK(allocator.free(a));
+    CHECK(!allocator.is_valid(a));
+    CHECK(!allocator.free(a));
+
+    // Same slot, new generation
+    const auto b = *allocator.allocate();
+    CHECK(b.index == a.index);
+    CHECK(b.generation != a.generation);
+    CHECK(!allocator.free(a));
+    CHECK(allocator.is_valid(b));
+
+    CHECK(!allocator.is_valid(DescriptorAllocator::Handle{}));
+    CHECK(allocator.get_stats().stale_frees == 2);
+}
+
+TEST(descriptor_allocator_deferred_reuse) {
+    FakePages pages{};
+    DescriptorAllocator allocator{std::make_unique<FakeBackend>(pages), PAGE_SIZE};
+
+    std::vector<DescriptorAllocator::Handle> handles{};
+
+    for (uint32_t i = 0; i < PAGE_SIZE; ++i) {
+        handles.push_back(*allocator.allocate());
+    }
+
+    // Freed while the GPU may still read them, fence values 1 and 2
+    CHECK(allocator.free(handles[0], 1));
+    CHECK(allocator.free(handles[1], 2));
+    CHECK(!allocator.is_valid(handles[0]));
+    CHECK(allocator.get_stats().deferred == 2);
+    CHECK(allocator.get_stats().live == PAGE_SIZE - 2);
+
+    // Nothing has completed, the next allocation needs a new page instead of reusing them
+    allocator.reclaim(0);
+    CHECK(allocator.allocate()->index == PAGE_SIZE);
+
+    allocator.reclaim(1);
+    CHECK(allocator.get_stats().deferred == 1);
+    CHECK(allocator.allocate()->index == handles[0].index); // the GPU is past it now
+
+    // Pages can't go while something is allocated or waiting on the GPU
+    CHECK(!allocator.release_pages());
+}
+
+TEST(descriptor_allocator_release_waits_for_fences) {
+    FakePages pages{};
+    DescriptorAllocator allocator{std::make_unique<FakeBackend>(pages), PAGE_SIZE};
+
+    const auto a = *allocator.allocate();
+    const auto b = *allocator.allocate();
+
+    CHECK(!allocator.release_pages());
+    CHECK(allocator.free(a));
+    CHECK(allocator.free(b, 7));
+    CHECK(!allocator.is_empty());
+    CHECK(!allocator.release_pages());
+
+    allocator.reclaim(6);
+    CHECK(!allocator.release_pages());
+
+    allocator.reclaim(7);
+    CHECK(allocator.is_empty());
+    CHECK(allocator.release_pages());
+    CHECK(pages.alive() == 0);
+    CHECK(allocator.get_stats().capacity == 0);
+
+    // Handles from before the release never become valid again
+    const auto c = *allocator.allocate();
+    CHECK(c.index == a.index);
+    CHECK(!allocator.is_valid(a));
+    CHECK(allocator.is_valid(c));
+}
+
+TEST(descriptor_allocator_stress) {
+    FakePages pages{};
+    DescriptorAllocator allocator{std::make_unique<FakeBackend>(pages), PAGE_SIZE};
+
+    struct Freed {
+        DescriptorAllocator::Handle handle{};
+        uint64_t reusable_after{};
+    };
+
+    std::vector<DescriptorAllocator::Handle> live{};
+    std::vector<Freed> in_flight{}; // freed, GPU not past the fence yet
+    uint64_t fence{0};
+    uint64_t completed{0};
+    uint32_t seed{1};
+    uint32_t max_live{0};
+
+    const auto next = [&]() {
+        seed = seed * 1664525 + 1013904223;
+        return seed >> 8;
+    };
+
+    for (uint32_t frame = 0; frame < 20'000; ++frame) {
+        // The GPU runs a couple of frames behind
+        if (fence > 2) {
+            completed = std::max(completed, fence - 2);
+        }
+
+        allocator.reclaim(completed);
+        std::erase_if(in_flight, [&](const Freed& f) { return f.reusable_after <= completed; });
+
+        for (auto i = next() % 4; i > 0; --i) {
+            const auto handle = allocator.allocate();
+            CHECK(handle.has_value());
+
+            // Never a slot that's still in use or that the GPU could still be reading
+            for (const auto& other : live) {
+                CHECK(other.index != handle->index);
+            }
+
+            for (const auto& other : in_flight) {
+                CHECK(other.handle.index != handle->index);
+            }
+
+            live.push_back(*handle);
+        }
+
+        for (auto i = next() % 4; i > 0 && !live.empty(); --i) {
+            const auto victim = next() % live.size();
+            const auto handle = live[victim];
+            live.erase(live.begin() + victim);
+
+            // Now and then a free that doesn't have to wait (e.g. no command queue yet)
+            const auto reusable_after = next() % 8 == 0 ? 0 : fence + 1;
+
+            CHECK(allocator.free(handle, reusable_after));
+            CHECK(!allocator.free(handle, reusable_after));
+
+            if (reusable_after > 0) {
+                in_flight.push_back(Freed{handle, reusable_after});
+            }
+        }
+
+        ++fence;
+        max_live = std::max<uint32_t>(max_live, (uint32_t)live.size());
+
+        const auto& stats = allocator.get_stats();
+        CHECK(stats.live == live.size());
+        CHECK(stats.deferred == in_flight.size());
+
+        for (const auto& handle : live) {
+            CHECK(allocator.is_valid(handle));
+        }
+    }
+
+    // Capacity only has to cover what's live plus a few frames of deferred frees
+    CHECK(allocator.get_stats().capacity <= (max_live + 4 * 3) + PAGE_SIZE * 2);
+
+    for (const auto& handle : live) {
+        CHECK(allocator.free(handle, fence));
+    }
+
+    CHECK(!allocator.release_pages());
+    allocator.reclaim(fence);
+    CHECK(allocator.release_pages());
+    CHECK(pages.alive() == 0);
+}
@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <mods/vr/DynamicResolutionController.hpp>
+
+#include "Test.hpp"
+
+namespace {
+constexpr float BUDGET_MS = 1000.0f / 90.0f;
+
+const DynamicResolutionController::Settings SETTINGS{.min_scale = 0.5f, .max_scale = 1.0f, .target_load = 0.85f};
+
+// A GPU whose frame cost goes with the pixel count, plus a bit of deterministic jitter.
+struct FakeGpu {
+    float full_res_ms{0.0f};
+    uint32_t seed{1};
+
+    float render(float scale) {
+        seed = seed * 1664525u + 1013904223u;
+        const auto jitter = ((float)(seed >> 8) / (float)(1u << 24) - 0.5f) * 0.04f; // +-2%
+
+        return full_res_ms * scale * scale * (1.0f + jitter);
+    }
+};
+
+// xrWaitFrame: the frame is shown on the next vsync after the work is done, the rest of the interval is spent waiting.
+struct PacedFrame {
+    float interval_ms{0.0f};
+    float waited_ms{0.0f};
+};
+
+PacedFrame pace(float work_ms, float period_ms) {
+    const auto periods = std::max(std::ceil(work_ms / period_ms), 1.0f);
+    const auto interval_ms = periods * period_ms;
+
+    return PacedFrame{interval_ms, interval_ms - work_ms};
+}
+
+struct Run {
+    std::vector<float> scales{};
+    uint32_t missed{0};
+
+    float final_scale() const {
+        return scales.back();
+    }
+
+    // Scale changes over the last frames, a settled controller shouldn't be making any
+    uint32_t changes_in_last(size_t frames) const {
+        uint32_t changes{0};
+
+        for (auto i = scales.size() - frames + 1; i < scales.size(); ++i) {
+            changes += scales[i] != scales[i - 1] ? 1 : 0;
+        }
+
+        return changes;
+    }
+};
+
+// OpenVR style, the compositor reports GPU time directly.
+Run simulate_gpu_timed(DynamicResolutionController& controller, FakeGpu& gpu, uint32_t frames) {
+    Run run{};
+
+    for (uint32_t frame = 0; frame < frames; ++frame) {
+        const auto gpu_ms = gpu.render(controller.get_scale());
+        const auto missed = gpu_ms > BUDGET_MS;
+
+        run.missed += missed ? 1 : 0;
+        run.scales.push_back(controller.update({gpu_ms, BUDGET_MS, missed}, SETTINGS));
+    }
+
+    return run;
+}
+
+// OpenXR style, only the present interval and the time spent in xrWaitFrame are known.
+Run simulate_paced(DynamicResolutionController& controller, FakeGpu& gpu, uint32_t frames) {
+    Run run{};
+
+    for (uint32_t frame = 0; frame < frames; ++frame) {
+        const auto paced = pace(gpu.render(controller.get_scale()), BUDGET_MS);
+        const auto sample = DynamicResolutionController::from_paced_interval(paced.interval_ms, paced.waited_ms, BUDGET_MS);
+
+        run.missed += sample.missed ? 1 : 0;
+        run.scales.push_back(controller.update(sample, SETTINGS));
+    }
+
+    return run;
+}
+}
+
+TEST(dynamic_resolution_settles_where_the_load_meets_the_target) {
+    DynamicResolutionController controller{};
+    FakeGpu gpu{.full_res_ms = 14.0f};
+
+    const auto run = simulate_gpu_timed(controller, gpu, 600);
+
+    // sqrt(0.85 * 11.1 / 14) is about 0.82
+    std::printf("  settled at %.3f, load %.3f\n", run.final_scale(), controller.get_load());
+    CHECK(run.final_scale() > 0.72f && run.final_scale() < 0.9f);
+    CHECK(std::abs(controller.get_load() - SETTINGS.target_load) < 0.08f);
+    CHECK(run.changes_in_last(300) == 0);
+
+    // Getting there only takes a few steps down, and drops the frames only while it does
+    CHECK(run.missed < 30);
+}
+
+TEST(dynamic_resolution_stays_at_full_res_with_headroom) {
+    DynamicResolutionController controller{};
+    FakeGpu gpu{.full_res_ms = 6.0f};
+
+    const auto run = simulate_gpu_timed(controller, gpu, 600);
+
+    CHECK(run.final_scale() == 1.0f);
+    CHECK(run.changes_in_last(600) == 0);
+}
+
+TEST(dynamic_resolution_recovers_after_a_heavy_scene) {
+    DynamicResolutionController controller{};
+    FakeGpu gpu{.full_res_ms = 20.0f};
+
+    const auto heavy = simulate_gpu_timed(controller, gpu, 300);
+    CHECK(heavy.final_scale() < 0.75f);
+
+    gpu.full_res_ms = 6.0f;
+    const auto light = simulate_gpu_timed(controller, gpu, 1200);
+
+    CHECK(light.final_scale() == 1.0f);
+
+    // Going back up is slow and in small steps
+    for (size_t i = 1; i < light.scales.size(); ++i) {
+        CHECK(light.scales[i] - light.scales[i - 1] <= 0.05f + 0.001f);
+    }
+}
+
+TEST(dynamic_resolution_ignores_cpu_bound_missed_frames) {
+    DynamicResolutionController controller{};
+
+    // Dropping frames while the GPU sits at half its budget, fewer pixels won't help
+    for (auto frame = 0; frame < 300; ++frame) {
+        controller.update({BUDGET_MS * 0.5f, BUDGET_MS, frame % 2 == 0}, SETTINGS);
+    }
+
+    CHECK(controller.get_scale() == 1.0f);
+
+    // Garbage doesn't move it either
+    controller.update({-1.0f, BUDGET_MS, true}, SETTINGS);
+    controller.update({NAN, BUDGET_MS, true}, SETTINGS);
+    controller.update({5.0f, 0.0f, true}, SETTINGS);
+    CHECK(controller.get_scale() == 1.0f);
+}
+
+TEST(dynamic_resolution_paced_interval_is_not_a_load) {
+    // A light game under xrWaitFrame presents exactly once per period
+    FakeGpu light{.full_res_ms = 6.0f};
+
+    {
+        DynamicResolutionController controller{};
+        const auto run = simulate_paced(controller, light, 600);
+
+        CHECK(run.final_scale() == 1.0f);
+        CHECK(run.missed == 0);
+    }
+
+    // Feeding the interval itself reads as a load of 1.0 and walks all the way down to the minimum
+    {
+        DynamicResolutionController controller{};
+
+        for (auto frame = 0; frame < 600; ++frame) {
+            const auto paced = pace(light.render(controller.get_scale()), BUDGET_MS);
+            controller.update({paced.interval_ms, BUDGET_MS, false}, SETTINGS);
+        }
+
+        CHECK(controller.get_scale() == SETTINGS.min_scale);
+    }
+
+    // A heavy one still gets brought down, and settles the same as with GPU timings
+    {
+        DynamicResolutionController controller{};
+        FakeGpu heavy{.full_res_ms = 14.0f};
+
+        const auto run = simulate_paced(controller, heavy, 600);
+
+        std::printf("  paced settled at %.3f\n", run.final_scale());
+        CHECK(run.final_scale() > 0.72f && run.final_scale() < 0.9f);
+        CHECK(run.changes_in_last(300) == 0);
+    }
+}
+
+TEST(dynamic_resolution_paced_sample) {
+    const auto on_time = DynamicResolutionController::from_paced_interval(11.1f, 5.1f, 11.1f);
+    CHECK_NEAR(on_time.frame_ms, 6.0f, 0.001f);
+    CHECK(!on_time.missed);
+
+    const auto missed = DynamicResolutionController::from_paced_interval(22.2f, 1.0f, 11.1f);
+    CHECK_NEAR(missed.frame_ms, 21.2f, 0.001f);
+    CHECK(missed.missed);
+
+    // Waits counted in a different interval than the present they paced can't make it negative
+    CHECK(DynamicResolutionController::from_paced_interval(11.1f, 30.0f, 11.1f).frame_ms == 0.0f);
+    CHECK(DynamicResolutionController::from_paced_interval(11.1f, -3.0f, 11.1f).frame_ms == 11.1f);
+}
@@ -0,0 +1,125 @@
+#include <cstdint>
+#include <vector>
+
+#include <utility/FixedVector.hpp>
+
+#include "Test.hpp"
+
+using utility::FixedVector;
+
+namespace {
+// Stand-ins for XrCompositionLayerBaseHeader and xrEndFrame, end_frame itself needs a live session.
+struct FakeLayerHeader {
+    uint32_t type{0};
+};
+
+struct FakeFrameEndInfo {
+    uint32_t layer_count{0};
+    const FakeLayerHeader* const* layers{nullptr};
+};
+
+// What the runtime gets handed, checked without holding on to anything that allocates.
+struct FakeRuntime {
+    uint32_t frames{0};
+    uint32_t last_layer_count{0};
+    uint32_t last_first_type{0};
+
+    static void end_frame(void* self, const FakeFrameEndInfo& info) {
+        auto& runtime = *(FakeRuntime*)self;
+        ++runtime.frames;
+        runtime.last_layer_count = info.layer_count;
+        runtime.last_first_type = info.layer_count > 0 ? info.layers[0]->type : 0;
+    }
+};
+
+// The function table the frame is submitted through, like the OpenXR loader's dispatch table.
+struct FakeTable {
+    void (*end_frame)(void*, const FakeFrameEndInfo&){&FakeRuntime::end_frame};
+};
+
+using QuadLayers = FixedVector<FakeLayerHeader*, 8>;
+}
+
+TEST(fixed_vector_drops_and_counts_overflow) {
+    FixedVector<int, 3> list{};
+
+    CHECK(list.empty());
+    CHECK(list.push_back(1));
+    CHECK(list.push_back(2));
+    CHECK(list.push_back(3));
+    CHECK(!list.push_back(4));
+    CHECK(!list.push_back(5));
+
+    CHECK(list.size() == 3);
+    CHECK(list.dropped() == 2);
+    CHECK(list.span().back() == 3);
+
+    int sum = 0;
+
+    for (const auto value : list) {
+        sum += value;
+    }
+
+    CHECK(sum == 6);
+
+    list.clear();
+    CHECK(list.empty());
+    CHECK(list.dropped() == 0);
+}
+
+TEST(fixed_vector_frame_submission_does_not_allocate) {
+    FakeRuntime runtime{};
+    FakeTable table{};
+
+    // Slate for each eye, framework UI and a couple of plugin overlays
+    std::vector<FakeLayerHeader> quads(5);
+
+    for (uint32_t i = 0; i < quads.size(); ++i) {
+        quads[i].type = i + 1;
+    }
+
+    FakeLayerHeader projection{100};
+    std::vector<FakeLayerHeader*> layers(1 + QuadLayers::CAPACITY); // persistent, like SubmitStorage::layers
+
+    const auto allocations = test::get_allocations();
+
+    for (auto frame = 0; frame < 1000; ++frame) {
+        QuadLayers quad_layers{};
+
+        // Not every layer is there every frame
+        for (size_t i = 0; i < quads.size(); ++i) {
+            if ((frame + i) % 3 != 0) {
+                quad_layers.push_back(&quads[i]);
+            }
+        }
+
+        uint32_t count = 0;
+        layers[count++] = &projection;
+
+        for (const auto layer : quad_layers) {
+            layers[count++] = layer;
+        }
+
+        table.end_frame(&runtime, FakeFrameEndInfo{count, layers.data()});
+        CHECK(runtime.last_layer_count == 1 + quad_layers.size());
+    }
+
+    CHECK(test::get_allocations() == allocations);
+    CHECK(runtime.frames == 1000);
+    CHECK(runtime.last_first_type == 100);
+}
+
+TEST(fixed_vector_full_frame_keeps_the_first_layers) {
+    std::vector<FakeLayerHeader> quads(QuadLayers::CAPACITY + 2);
+    QuadLayers quad_layers{};
+
+    for (auto& quad : quads) {
+        quad_layers.push_back(&quad);
+    }
+
+    // The ones that made it are submitted as is, the rest are only counted so end_frame can warn about them
+    CHECK(quad_layers.size() == QuadLayers::CAPACITY);
+    CHECK(quad_layers.dropped() == 2);
+    CHECK(quad_layers.span().front() == &quads.front());
+    CHECK(quad_layers.span().back() == &quads[QuadLayers::CAPACITY - 1]);
+}
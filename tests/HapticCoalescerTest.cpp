@@ -0,0 +1,199 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+#include <mods/vr/HapticCoalescer.hpp>
+
+#include "Test.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+using Clock = HapticCoalescer::Clock;
+
+constexpr uint64_t LEFT = 1;
+constexpr uint64_t RIGHT = 2;
+
+const HapticCoalescer::Settings SETTINGS{.min_interval = 10ms, .refresh_margin = 50ms};
+
+// One XInputSetState worth of rumble, split per hand like VR::on_xinput_set_state does it.
+struct TraceEntry {
+    float left{0.0f};
+    float right{0.0f};
+    float duration{0.1f};
+};
+
+// A game calling XInputSetState every frame at 60 fps for 10 seconds: engine idle rumble, an explosion,
+// a stretch of XInputSetState(0) every frame, then gunfire that starts and stops every few frames.
+std::vector<TraceEntry> make_trace() {
+    std::vector<TraceEntry> trace{};
+
+    for (auto frame = 0; frame < 600; ++frame) {
+        if (frame < 120) {
+            trace.push_back({0.2f, 0.0f});
+        } else if (frame < 180) {
+            trace.push_back({1.0f, 1.0f, 0.5f});
+        } else if (frame < 300) {
+            trace.push_back({0.0f, 0.0f});
+        } else {
+            const auto firing = (frame / 6) % 2 == 0;
+            trace.push_back(firing ? TraceEntry{0.8f, 0.5f, 0.05f} : TraceEntry{0.0f, 0.0f});
+        }
+    }
+
+    return trace;
+}
+
+// What the runtime ends up doing with what it's sent.
+struct FakeRuntime {
+    struct Device {
+        Clock::time_point playing_until{};
+        uint32_t submissions{0};
+        uint32_t stops{0};
+        std::vector<Clock::time_point> vibration_times{};
+    };
+
+    std::map<uint64_t, Device> devices{};
+    uint32_t submissions{0};
+
+    void submit(const HapticCoalescer::Submissions& out, Clock::time_point now) {
+        for (const auto& s : out) {
+            auto& device = devices[s.source];
+            ++device.submissions;
+            ++submissions;
+
+            if (s.amplitude <= 0.0f || s.duration <= 0.0f) {
+                ++device.stops;
+                device.playing_until = now;
+            } else {
+                device.playing_until = now + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(s.duration));
+                device.vibration_times.push_back(now);
+            }
+        }
+    }
+
+    bool is_playing(uint64_t source, Clock::time_point now) const {
+        const auto it = devices.find(source);
+        return it != devices.end() && it->second.playing_until > now;
+    }
+};
+
+struct Replay {
+    uint32_t requests{0};
+    uint32_t frames_that_differ{0};
+    FakeRuntime runtime{};
+    HapticCoalescer::Stats stats{};
+};
+
+Replay replay(const std::vector<TraceEntry>& trace) {
+    Replay result{};
+    HapticCoalescer coalescer{};
+    FakeRuntime uncoalesced{};
+    HapticCoalescer::Submissions out{};
+
+    auto now = Clock::time_point{} + 1h;
+
+    for (const auto& entry : trace) {
+        for (const auto& [source, amplitude] : {std::pair{LEFT, entry.left}, std::pair{RIGHT, entry.right}}) {
+            const auto duration = amplitude > 0.0f ? entry.duration : 0.0f;
+
+            out.clear();
+            coalescer.request(SETTINGS, 0.0f, duration, 160.0f, amplitude, source, now, out);
+            result.runtime.submit(out, now);
+
+            uncoalesced.submit({{0.0f, duration, 160.0f, amplitude, source}}, now);
+            ++result.requests;
+        }
+
+        out.clear();
+        coalescer.update(SETTINGS, now, out);
+        result.runtime.submit(out, now);
+
+        // Whatever the player feels has to be the same as if every call had gone through
+        for (const auto source : {LEFT, RIGHT}) {
+            if (result.runtime.is_playing(source, now) != uncoalesced.is_playing(source, now)) {
+                ++result.frames_that_differ;
+            }
+        }
+
+        now += 16667us;
+    }
+
+    result.stats = coalescer.get_stats();
+    return result;
+}
+}
+
+TEST(haptic_coalescer_trace_replay) {
+    const auto result = replay(make_trace());
+
+    CHECK(result.requests == 1200);
+    CHECK(result.frames_that_differ == 0);
+
+    // Every request would have been a runtime call. The idle rumble and the explosion collapse into a
+    // refresh every so often, the short gunfire pulses have to be extended every frame while firing.
+    std::printf("  %u requests, %u submitted\n", result.requests, result.runtime.submissions);
+    CHECK(result.runtime.submissions * 3 < result.requests);
+    CHECK(result.stats.submitted == result.runtime.submissions);
+    CHECK(result.stats.requested == result.requests);
+
+    // Each gunfire burst ends with a stop that has to reach the runtime, the idle stretch of
+    // XInputSetState(0) after the explosion only needs one
+    CHECK(result.runtime.devices.at(LEFT).stops == 1 + 25);
+    CHECK(result.runtime.devices.at(RIGHT).stops == 1 + 25);
+}
+
+TEST(haptic_coalescer_rate_limits_each_device) {
+    HapticCoalescer coalescer{};
+    FakeRuntime runtime{};
+    HapticCoalescer::Submissions out{};
+
+    auto now = Clock::time_point{} + 1h;
+
+    // A plugin hammering different vibrations every millisecond
+    for (auto i = 0; i < 200; ++i) {
+        out.clear();
+        coalescer.request(SETTINGS, 0.0f, 0.2f, 100.0f + (float)(i % 7), 0.1f + (float)(i % 5) * 0.1f, LEFT, now, out);
+        coalescer.update(SETTINGS, now, out);
+        runtime.submit(out, now);
+        now += 1ms;
+    }
+
+    const auto& times = runtime.devices.at(LEFT).vibration_times;
+    CHECK(times.size() <= 20 + 1);
+
+    for (size_t i = 1; i < times.size(); ++i) {
+        CHECK(times[i] - times[i - 1] >= SETTINGS.min_interval);
+    }
+
+    // A stop is never held back
+    out.clear();
+    coalescer.request(SETTINGS, 0.0f, 0.0f, 0.0f, 0.0f, LEFT, now, out);
+    CHECK(out.size() == 1);
+    CHECK(out[0].amplitude == 0.0f);
+}
+
+TEST(haptic_coalescer_holds_scheduled_pulses_until_due) {
+    HapticCoalescer coalescer{};
+    HapticCoalescer::Submissions out{};
+
+    const auto now = Clock::time_point{} + 1h;
+
+    coalescer.request(SETTINGS, 0.1f, 0.2f, 160.0f, 1.0f, RIGHT, now, out);
+    coalescer.update(SETTINGS, now + 50ms, out);
+    CHECK(out.empty());
+
+    coalescer.update(SETTINGS, now + 100ms, out);
+    CHECK(out.size() == 1);
+    CHECK(out[0].source == RIGHT);
+    CHECK_NEAR(out[0].duration, 0.2f, 0.001f);
+
+    // Too far ahead, or nonsense, is ignored
+    out.clear();
+    coalescer.request(SETTINGS, 60.0f, 0.2f, 160.0f, 1.0f, RIGHT, now, out);
+    coalescer.request(SETTINGS, 0.0f, -1.0f, 160.0f, 1.0f, RIGHT, now, out);
+    CHECK(out.empty());
+    CHECK(coalescer.get_stats().requested == 1);
+}
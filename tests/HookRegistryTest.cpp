@@ -0,0 +1,172 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <hooks/HookRegistry.hpp>
+
+#include "Test.hpp"
+
+namespace {
+// A made up module: a few function prologues followed by a vtable.
+class FakeCode final : public HookRegistry::Memory {
+public:
+    static constexpr size_t PRESENT = 0x00;
+    static constexpr size_t XINPUT_GET_STATE = 0x10;
+    static constexpr size_t XINPUT_SET_STATE = 0x20;
+    static constexpr size_t VTABLE = 0x40;
+
+    FakeCode() {
+        bytes.resize(0x100, 0xCC);
+
+        // mov [rsp+8], rbx; push rdi; sub rsp, 0x20
+        const std::array<uint8_t, 10> prologue{0x48, 0x89, 0x5C, 0x24, 0x08, 0x57, 0x48, 0x83, 0xEC, 0x20};
+
+        for (const auto offset : {PRESENT, XINPUT_GET_STATE, XINPUT_SET_STATE}) {
+            std::memcpy(&bytes[offset], prologue.data(), prologue.size());
+        }
+
+        for (size_t i = 0; i < 8; ++i) {
+            const uint64_t fn = 0x7FF600001000ull + i * 0x100;
+            std::memcpy(&bytes[VTABLE + i * sizeof(fn)], &fn, sizeof(fn));
+        }
+    }
+
+    uintptr_t at(size_t offset) const {
+        return (uintptr_t)bytes.data() + offset;
+    }
+
+    // What an inline hook writes over a prologue.
+    void write_jmp(size_t offset, int32_t displacement) {
+        bytes[offset] = 0xE9;
+        std::memcpy(&bytes[offset + 1], &displacement, sizeof(displacement));
+    }
+
+    void write_pointer(size_t offset, uint64_t value) {
+        std::memcpy(&bytes[offset], &value, sizeof(value));
+    }
+
+    bool read(uintptr_t address, uint8_t* out, size_t size) const override {
+        ++reads;
+
+        if (unmapped || address < at(0) || address + size > at(bytes.size())) {
+            return false;
+        }
+
+        std::memcpy(out, (const void*)address, size);
+        return true;
+    }
+
+    std::vector<uint8_t> bytes{};
+    bool unmapped{false};
+    mutable uint32_t reads{0};
+};
+}
+
+TEST(hook_registry_detects_an_overwritten_inline_hook) {
+    FakeCode code{};
+    HookRegistry registry{code};
+
+    code.write_jmp(FakeCode::XINPUT_GET_STATE, 0x1000);
+    code.write_jmp(FakeCode::XINPUT_SET_STATE, 0x2000);
+
+    const auto get_state = registry.add("XInputGetState", code.at(FakeCode::XINPUT_GET_STATE), 5);
+    const auto set_state = registry.add("XInputSetState", code.at(FakeCode::XINPUT_SET_STATE), 5);
+    CHECK(get_state != HookRegistry::INVALID_ID && set_state != HookRegistry::INVALID_ID);
+
+    CHECK(registry.validate() == 0);
+    CHECK(registry.validate() == 0);
+
+    // Something else hooks the same function after us
+    code.write_jmp(FakeCode::XINPUT_SET_STATE, 0x3000);
+
+    CHECK(registry.validate() == 1);
+    CHECK(registry.get_state(set_state) == HookRegistry::State::BROKEN);
+    CHECK(registry.get_state(get_state) == HookRegistry::State::ACTIVE);
+
+    // Only reported once, even if it changes again
+    code.write_jmp(FakeCode::XINPUT_SET_STATE, 0x4000);
+    CHECK(registry.validate() == 0);
+
+    // Broken records can still be removed by their owner
+    registry.remove(set_state);
+    CHECK(!registry.get_state(set_state).has_value());
+}
+
+TEST(hook_registry_only_watches_its_own_vtable_slot) {
+    FakeCode code{};
+    HookRegistry registry{code};
+
+    // Present is slot 2 in this vtable
+    const auto slot = FakeCode::VTABLE + 2 * sizeof(uint64_t);
+    code.write_pointer(slot, 0x7FFA00002000ull);
+
+    const auto present = registry.add("Present", code.at(slot), sizeof(uint64_t));
+
+    code.write_pointer(FakeCode::VTABLE + 3 * sizeof(uint64_t), 0x1234);
+    code.write_pointer(FakeCode::VTABLE + 1 * sizeof(uint64_t), 0x5678);
+    CHECK(registry.validate() == 0);
+
+    // An overlay chaining onto Present
+    code.write_pointer(slot, 0x7FFB00003000ull);
+    CHECK(registry.validate() == 1);
+    CHECK(registry.get_state(present) == HookRegistry::State::BROKEN);
+}
+
+TEST(hook_registry_treats_unreadable_code_as_broken) {
+    FakeCode code{};
+    HookRegistry registry{code};
+
+    // Out of range, empty, or bigger than a snapshot holds
+    CHECK(registry.add("Nowhere", code.at(code.bytes.size()), 5) == HookRegistry::INVALID_ID);
+    CHECK(registry.add("Nothing", code.at(FakeCode::PRESENT), 0) == HookRegistry::INVALID_ID);
+    CHECK(registry.add("Everything", code.at(FakeCode::PRESENT), HookRegistry::MAX_SNAPSHOT_SIZE + 1) == HookRegistry::INVALID_ID);
+
+    const auto present = registry.add("Present", code.at(FakeCode::PRESENT), 5);
+    CHECK(registry.get_state(present) == HookRegistry::State::ACTIVE);
+
+    // The module got unloaded
+    code.unmapped = true;
+    CHECK(registry.validate() == 1);
+    CHECK(registry.get_state(present) == HookRegistry::State::BROKEN);
+}
+
+TEST(hook_registry_stale_ids_never_match_a_new_record) {
+    FakeCode code{};
+    HookRegistry registry{code};
+
+    const auto first = registry.add("Present", code.at(FakeCode::PRESENT), 5);
+    registry.remove(first);
+
+    // Rehooked into the same slot
+    const auto second = registry.add("Present", code.at(FakeCode::PRESENT), 5);
+    CHECK(second != first);
+    CHECK(!registry.get_state(first).has_value());
+
+    // The old owner removing its id again can't take the new hook with it
+    registry.remove(first);
+    registry.remove(HookRegistry::INVALID_ID);
+    CHECK(registry.get_state(second) == HookRegistry::State::ACTIVE);
+}
+
+TEST(hook_registry_runs_out_of_slots) {
+    FakeCode code{};
+    HookRegistry registry{code};
+
+    std::vector<HookRegistry::Id> ids{};
+
+    for (size_t i = 0; i < HookRegistry::MAX_HOOKS; ++i) {
+        ids.push_back(registry.add("Hook", code.at(i), 1));
+    }
+
+    CHECK(ids.back() != HookRegistry::INVALID_ID);
+    CHECK(registry.add("One too many", code.at(0), 1) == HookRegistry::INVALID_ID);
+
+    // Validation reads every hook once and nothing else
+    code.reads = 0;
+    CHECK(registry.validate() == 0);
+    CHECK(code.reads == HookRegistry::MAX_HOOKS);
+
+    registry.remove(ids.front());
+    CHECK(registry.add("Fits again", code.at(0), 1) != HookRegistry::INVALID_ID);
+}
@@ -0,0 +1,134 @@
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <mods/vr/InputSnapshot.hpp>
+
+#include "Test.hpp"
+
+namespace {
+constexpr vr::VRInputValueHandle_t LEFT = 1;
+constexpr vr::VRInputValueHandle_t RIGHT = 2;
+
+// A runtime with a few held buttons that counts every query that would have gone to OpenVR/OpenXR.
+class FakeRuntime final : public InputSnapshot::Queries {
+public:
+    std::map<std::pair<vr::VRActionHandle_t, vr::VRInputValueHandle_t>, bool> held{};
+    Vector2f left_axis{};
+    Vector2f right_axis{};
+    mutable uint32_t action_queries{0};
+    mutable uint32_t axis_queries{0};
+
+    bool query_action_active(vr::VRActionHandle_t action, vr::VRInputValueHandle_t source) const override {
+        ++action_queries;
+
+        const auto it = held.find({action, source});
+        return it != held.end() && it->second;
+    }
+
+    Vector2f query_joystick_axis(vr::VRInputValueHandle_t source) const override {
+        ++axis_queries;
+        return source == LEFT ? left_axis : source == RIGHT ? right_axis : Vector2f{};
+    }
+};
+
+// Trigger, grip, A, B, system, joystick click, and one that didn't get bound
+const std::vector<vr::VRActionHandle_t> ACTIONS{10, 11, 12, 13, 14, 15, vr::k_ulInvalidActionHandle};
+
+// Roughly what VR::on_xinput_get_state reads for one XInputGetState call.
+uint32_t poll_xinput(const InputSnapshot* snapshot, const FakeRuntime& runtime) {
+    uint32_t buttons{0};
+
+    for (const auto action : ACTIONS) {
+        buttons += InputSnapshot::is_action_active(snapshot, runtime, action, LEFT) ? 1 : 0;
+        buttons += InputSnapshot::is_action_active(snapshot, runtime, action, RIGHT) ? 1 : 0;
+        buttons += InputSnapshot::is_action_active_any_joystick(snapshot, runtime, action, LEFT, RIGHT) ? 1 : 0;
+    }
+
+    buttons += InputSnapshot::get_joystick_axis(snapshot, runtime, LEFT).x > 0.5f ? 1 : 0;
+    buttons += InputSnapshot::get_joystick_axis(snapshot, runtime, RIGHT).y > 0.5f ? 1 : 0;
+
+    return buttons;
+}
+
+// Runtime queries over a number of input updates, with the game polling XInput polls_per_update times in between.
+uint32_t count_queries(uint32_t updates, uint32_t polls_per_update) {
+    FakeRuntime runtime{};
+    runtime.held[{10, LEFT}] = true;
+    runtime.held[{13, RIGHT}] = true;
+    runtime.left_axis = {0.75f, 0.0f};
+
+    for (uint32_t update = 0; update < updates; ++update) {
+        const auto snapshot = InputSnapshot::build(runtime, ACTIONS, LEFT, RIGHT);
+
+        for (uint32_t poll = 0; poll < polls_per_update; ++poll) {
+            // Left trigger, right B (plus any joystick for both), left stick
+            CHECK(poll_xinput(snapshot.get(), runtime) == 5);
+        }
+    }
+
+    return runtime.action_queries + runtime.axis_queries;
+}
+}
+
+TEST(input_snapshot_queries_do_not_scale_with_xinput_polls) {
+    constexpr uint32_t UPDATES = 100;
+
+    // Both hands for every bound action, and both sticks, once per update
+    constexpr uint32_t PER_UPDATE = 6 * 2 + 2;
+
+    CHECK(count_queries(UPDATES, 1) == UPDATES * PER_UPDATE);
+    CHECK(count_queries(UPDATES, 4) == UPDATES * PER_UPDATE);
+    CHECK(count_queries(UPDATES, 16) == UPDATES * PER_UPDATE);
+
+    // The game not polling at all doesn't change it either
+    CHECK(count_queries(UPDATES, 0) == UPDATES * PER_UPDATE);
+}
+
+TEST(input_snapshot_falls_through_for_what_it_does_not_cover) {
+    FakeRuntime runtime{};
+    runtime.held[{10, LEFT}] = true;
+    runtime.held[{99, LEFT}] = true;
+    runtime.held[{10, 7}] = true;
+
+    const auto snapshot = InputSnapshot::build(runtime, ACTIONS, LEFT, RIGHT);
+    runtime.action_queries = 0;
+    runtime.axis_queries = 0;
+
+    CHECK(InputSnapshot::is_action_active(snapshot.get(), runtime, 10, LEFT));
+    CHECK(runtime.action_queries == 0);
+
+    // An action that isn't bound, or a source that isn't either hand, goes to the runtime
+    CHECK(InputSnapshot::is_action_active(snapshot.get(), runtime, 99, LEFT));
+    CHECK(InputSnapshot::is_action_active(snapshot.get(), runtime, 10, 7));
+    CHECK(runtime.action_queries == 2);
+
+    CHECK(InputSnapshot::get_joystick_axis(snapshot.get(), runtime, 7) == Vector2f{});
+    CHECK(runtime.axis_queries == 1);
+
+    // The invalid handle never does
+    CHECK(!InputSnapshot::is_action_active(snapshot.get(), runtime, vr::k_ulInvalidActionHandle, LEFT));
+    CHECK(!InputSnapshot::is_action_active_any_joystick(snapshot.get(), runtime, vr::k_ulInvalidActionHandle, LEFT, RIGHT));
+    CHECK(runtime.action_queries == 2);
+
+    // No snapshot yet (or the runtime is reinitializing), everything is live
+    CHECK(InputSnapshot::is_action_active_any_joystick(nullptr, runtime, 10, LEFT, RIGHT));
+    CHECK(runtime.action_queries == 3);
+}
+
+TEST(input_snapshot_is_sorted_for_lookup) {
+    FakeRuntime runtime{};
+    runtime.held[{3, RIGHT}] = true;
+
+    const std::vector<vr::VRActionHandle_t> unordered{5, 3, 9, 1};
+    const auto snapshot = InputSnapshot::build(runtime, unordered, LEFT, RIGHT);
+
+    CHECK(snapshot->actions.size() == 4);
+
+    for (size_t i = 1; i < snapshot->actions.size(); ++i) {
+        CHECK(snapshot->actions[i - 1].action < snapshot->actions[i].action);
+    }
+
+    CHECK(snapshot->find(3) != nullptr && snapshot->find(3)->right && !snapshot->find(3)->left);
+    CHECK(snapshot->find(4) == nullptr);
+}
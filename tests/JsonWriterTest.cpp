@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <utility/JsonWriter.hpp>
+
+#include "Test.hpp"
+
+using utility::JsonWriter;
+
+namespace {
+std::filesystem::path temp_file(std::string_view name) {
+    return std::filesystem::temp_directory_path() / (std::string{"uevr_"} + std::string{name} + ".json");
+}
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream file{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+// What the saves looked like before JsonWriter, same text mode ofstream.
+std::string dump_the_old_way(const nlohmann::json& j) {
+    const auto path = temp_file("expected");
+
+    {
+        std::ofstream file{path};
+        file << j.dump(4);
+    }
+
+    auto result = read_file(path);
+    std::filesystem::remove(path);
+    return result;
+}
+
+// Shaped like cvardump.json, the biggest thing that goes through JsonWriter.
+struct CVar {
+    std::string name{};
+    std::string description{};
+    float value{};
+    bool is_command{false};
+};
+
+std::vector<CVar> make_cvars(size_t count) {
+    std::mt19937 rng{1234};
+    std::uniform_real_distribution<float> values{-10000.0f, 10000.0f};
+    std::vector<CVar> cvars{};
+
+    for (size_t i = 0; i < count; ++i) {
+        auto& cvar = cvars.emplace_back();
+        cvar.name = "r.Test" + std::to_string(i);
+        cvar.description = "Some help text for\t\"" + cvar.name + "\"\nwith a couple of lines\x01";
+        cvar.is_command = i % 5 == 0;
+        cvar.value = i % 3 == 0 ? (float)i : values(rng);
+    }
+
+    // JsonWriter gets keys in sorted order, nlohmann sorts them itself.
+    std::sort(cvars.begin(), cvars.end(), [](const CVar& a, const CVar& b) { return a.name < b.name; });
+    return cvars;
+}
+
+nlohmann::json cvars_to_dom(const std::vector<CVar>& cvars) {
+    nlohmann::json j{};
+
+    for (const auto& cvar : cvars) {
+        auto& entry = j[cvar.name];
+        entry["description"] = cvar.description;
+
+        if (cvar.is_command) {
+            entry["command"] = true;
+        } else {
+            entry["value"] = cvar.value;
+        }
+    }
+
+    return j;
+}
+
+void write_cvars(JsonWriter& writer, const std::vector<CVar>& cvars) {
+    writer.begin_object();
+
+    for (const auto& cvar : cvars) {
+        writer.key(cvar.name);
+        writer.begin_object();
+
+        if (cvar.is_command) {
+            writer.field("command", true);
+        }
+
+        writer.field("description", cvar.description);
+
+        if (!cvar.is_command) {
+            writer.field("value", cvar.value);
+        }
+
+        writer.end_object();
+    }
+
+    writer.end_object();
+}
+
+template <typename Fn>
+std::string write_with(std::string_view name, Fn&& fn) {
+    const auto path = temp_file(name);
+
+    {
+        JsonWriter writer{path};
+        CHECK(writer.is_open());
+        fn(writer);
+        CHECK(writer.close());
+    }
+
+    auto result = read_file(path);
+    std::filesystem::remove(path);
+    return result;
+}
+}
+
+TEST(json_writer_numbers_match_nlohmann) {
+    std::vector<double> values{
+        0.0, -0.0, 1.0, -1.0, 0.1, 0.5, 1.5, 100.0, 1e15, 1e16, 1.5e16, 123456789012345.0,
+        1e-4, 1e-5, 0.00012345, 0.000012345, 1e21, 1e100, 1e-100, 5e-324, 2.2250738585072014e-308,
+        std::numeric_limits<double>::max(), std::numeric_limits<double>::min(),
+        3.14159265358979, 1.0 / 3.0, 2.0 / 3.0, 9007199254740993.0, 0.30000000000000004,
+    };
+
+    // Mostly floats that got widened, that's what the saves are full of
+    std::mt19937 rng{42};
+    std::uniform_real_distribution<float> floats{-1000.0f, 1000.0f};
+    std::uniform_int_distribution<uint32_t> bits{};
+
+    for (auto i = 0; i < 50000; ++i) {
+        values.push_back(floats(rng));
+
+        const auto raw = bits(rng);
+        float f{};
+        std::memcpy(&f, &raw, sizeof(f));
+
+        if (std::isfinite(f) && std::abs(f) >= 1e-6f && std::abs(f) <= 1e6f) {
+            values.push_back(f);
+        }
+    }
+
+    size_t mismatches{0};
+
+    for (const auto d : values) {
+        const auto expected = nlohmann::json(d).dump();
+        const auto actual = write_with("number", [&](JsonWriter& writer) { writer.value(d); });
+
+        if (actual != expected) {
+            ++mismatches;
+
+            // grisu2 now and then misses the shortest form, the text still reads back the same
+            CHECK(nlohmann::json::parse(actual).get<double>() == d);
+            CHECK(actual.size() < expected.size());
+        }
+    }
+
+    CHECK(mismatches * 10000 < values.size());
+
+    // nlohmann writes these as null too
+    CHECK(write_with("nan", [](JsonWriter& writer) { writer.value(std::numeric_limits<double>::quiet_NaN()); }) == "null");
+    CHECK(write_with("inf", [](JsonWriter& writer) { writer.value(-std::numeric_limits<double>::infinity()); }) == "null");
+}
+
+TEST(json_writer_doubles_read_back_the_same) {
+    std::mt19937_64 rng{42};
+    std::uniform_int_distribution<uint64_t> bits{};
+
+    for (auto i = 0; i < 50000; ++i) {
+        const auto raw = bits(rng);
+        double d{};
+        std::memcpy(&d, &raw, sizeof(d));
+
+        if (!std::isfinite(d)) {
+            continue;
+        }
+
+        const auto actual = write_with("double", [&](JsonWriter& writer) { writer.value(d); });
+        const auto expected = nlohmann::json(d).dump();
+
+        CHECK(nlohmann::json::parse(actual).get<double>() == d);
+        CHECK((actual.find('e') == std::string::npos) == (expected.find('e') == std::string::npos));
+    }
+}
+
+TEST(json_writer_is_byte_identical_to_dump) {
+    const nlohmann::json j{
+        {"array", {1, -2, 3.5, "four", nullptr, true, false}},
+        {"empty_array", nlohmann::json::array()},
+        {"empty_object", nlohmann::json::object()},
+        {"nested", {{"a", {{"b", {{"c", 1u}}}}}, {"d", {nlohmann::json::array(), nlohmann::json::object()}}}},
+        {"numbers", {{"int", INT64_MIN}, {"uint", UINT64_MAX}, {"float", 0.1f}}},
+        {"strings", {"", "plain", "quote\" backslash\\ slash/", "\b\f\n\r\t", "\x01\x1f\x7f", "utf-8 \xc3\xa9\xe2\x82\xac"}},
+    };
+
+    // Once through the DOM overload, once by hand like UObjectHook does it
+    CHECK(write_with("dom", [&](JsonWriter& writer) { writer.value(j); }) == dump_the_old_way(j));
+
+    const auto cvars = make_cvars(200);
+    CHECK(write_with("cvars", [&](JsonWriter& writer) { write_cvars(writer, cvars); }) == dump_the_old_way(cvars_to_dom(cvars)));
+
+    // A dump with nothing in it used to be a null document, not an empty object
+    CHECK(write_with("empty", [](JsonWriter& writer) { writer.null(); }) == dump_the_old_way(nlohmann::json{}));
+}
+
+TEST(json_writer_benchmark_cvar_dump) {
+    const auto cvars = make_cvars(5000);
+    const auto path = temp_file("bench");
+
+    constexpr auto RUNS = 5;
+    using Clock = std::chrono::steady_clock;
+
+    auto dom_time = Clock::duration::zero();
+    auto streamed_time = Clock::duration::zero();
+    size_t dom_allocations{0};
+    size_t streamed_allocations{0};
+
+    for (auto run = 0; run < RUNS; ++run) {
+        auto start = Clock::now();
+        auto allocations = test::get_allocations();
+
+        {
+            std::ofstream file{path};
+            file << cvars_to_dom(cvars).dump(4);
+        }
+
+        dom_time += Clock::now() - start;
+        dom_allocations += test::get_allocations() - allocations;
+
+        start = Clock::now();
+        allocations = test::get_allocations();
+
+        {
+            JsonWriter writer{path};
+            write_cvars(writer, cvars);
+        }
+
+        streamed_time += Clock::now() - start;
+        streamed_allocations += test::get_allocations() - allocations;
+    }
+
+    std::filesystem::remove(path);
+
+    const auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count() / RUNS; };
+    std::printf("  %zu cvars: dump(4) %.2f ms, %zu allocations; JsonWriter %.2f ms, %zu allocations\n",
+        cvars.size(), ms(dom_time), dom_allocations / RUNS, ms(streamed_time), streamed_allocations / RUNS);
+
+    // Timings are only printed, they're too noisy to fail on. The allocations aren't.
+    CHECK(streamed_allocations * 100 < dom_allocations);
+}
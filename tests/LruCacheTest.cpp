@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+#include <utility/LruCache.hpp>
+
+#include "Test.hpp"
+
+namespace {
+// Stands in for FSceneViewStateInterface*, only ever compared
+using ViewState = const void*;
+
+ViewState make_view_state(uintptr_t id) {
+    return (ViewState)(0x10000 + id * 0x40);
+}
+}
+
+TEST(lru_cache_evicts_least_recently_used) {
+    utility::LruCache<int, int, 3> cache{};
+
+    cache.get_or_insert(1) = 10;
+    cache.get_or_insert(2) = 20;
+    cache.get_or_insert(3) = 30;
+
+    CHECK(cache.find(1) != nullptr); // 1 is now the most recently used
+    cache.get_or_insert(4) = 40;     // evicts 2
+
+    CHECK(cache.find(2) == nullptr);
+    CHECK(cache.find(1) != nullptr && *cache.find(1) == 10);
+    CHECK(cache.find(3) != nullptr && *cache.find(3) == 30);
+    CHECK(cache.find(4) != nullptr && *cache.find(4) == 40);
+
+    const auto stats = cache.get_stats();
+    CHECK(stats.size == 3);
+    CHECK(stats.evictions == 1);
+    CHECK(stats.misses == 1);
+}
+
+TEST(lru_cache_generation_invalidates_everything) {
+    utility::LruCache<int, int, 4> cache{};
+
+    cache.get_or_insert(1) = 1;
+    cache.get_or_insert(2) = 2;
+    cache.bump_generation();
+
+    CHECK(cache.find(1) == nullptr);
+    CHECK(cache.find(2) == nullptr);
+    CHECK(cache.get_stats().size == 0);
+
+    // A pointer from the old generation coming back is a fresh entry
+    CHECK(cache.get_or_insert(1) == 0);
+}
+
+TEST(lru_cache_for_each_and_erase_if) {
+    utility::LruCache<int, uint32_t, 4> cache{};
+
+    cache.get_or_insert(1) = 100;
+    cache.get_or_insert(2) = 200;
+    cache.get_or_insert(3) = 300;
+    cache.find(1);
+
+    int order[4]{};
+    int count = 0;
+
+    cache.for_each([&](int key, uint32_t) {
+        order[count++] = key;
+    });
+
+    CHECK(count == 3);
+    CHECK(order[0] == 1 && order[1] == 3 && order[2] == 2);
+
+    CHECK(cache.erase_if([](int, uint32_t value) { return value < 250; }) == 2);
+    CHECK(cache.find(1) == nullptr);
+    CHECK(cache.find(2) == nullptr);
+    CHECK(cache.find(3) != nullptr);
+
+    // Erased slots get reused before anything live is evicted
+    cache.get_or_insert(4);
+    cache.get_or_insert(5);
+    cache.get_or_insert(6);
+
+    CHECK(cache.find(3) != nullptr);
+    CHECK(cache.get_stats().size == 4);
+    CHECK(cache.get_stats().evictions == 0);
+}
+
+// Millions of transient views (scene captures, reflections) going through the cache while the
+// player's two views keep getting looked up, the way sceneview_constructor drives it.
+TEST(lru_cache_stress_millions_of_views) {
+    constexpr size_t CAPACITY = 16;
+    constexpr size_t VIEWS = 4'000'000;
+    constexpr size_t VIEWS_PER_FRAME = 8;
+
+    auto cache = std::make_unique<utility::LruCache<ViewState, uint32_t, CAPACITY>>();
+
+    const auto left = make_view_state(0);
+    const auto right = make_view_state(1);
+    cache->get_or_insert(left) = 0;
+    cache->get_or_insert(right) = 0;
+
+    const auto allocations_before = test::get_allocations();
+    size_t max_size = 0;
+    bool players_kept = true;
+
+    for (size_t i = 0; i < VIEWS; ++i) {
+        const auto frame = (uint32_t)(i / VIEWS_PER_FRAME);
+
+        cache->get_or_insert(make_view_state(2 + i)) = frame;
+
+        if (i % VIEWS_PER_FRAME == 0) {
+            for (const auto player : {left, right}) {
+                if (auto last_seen = cache->find(player); last_seen != nullptr) {
+                    *last_seen = frame;
+                } else {
+                    players_kept = false;
+                    cache->get_or_insert(player) = frame;
+                }
+            }
+        }
+
+        if ((i & 0xFFFF) == 0) {
+            max_size = std::max(max_size, cache->get_stats().size);
+        }
+    }
+
+    const auto stats = cache->get_stats();
+
+    CHECK(players_kept);
+    CHECK(max_size <= CAPACITY);
+    CHECK(stats.size == CAPACITY);
+    CHECK(stats.evictions == VIEWS - (CAPACITY - 2));
+    CHECK(stats.hits == (VIEWS / VIEWS_PER_FRAME) * 2);
+    CHECK(stats.misses == 0);
+
+    // Flat memory, nothing allocated no matter how many keys went through it
+    CHECK(test::get_allocations() == allocations_before);
+
+    // Old pointers the engine might hand out again don't match after a level change
+    cache->bump_generation();
+    CHECK(cache->find(left) == nullptr);
+}
@@ -0,0 +1,58 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "Test.hpp"
+
+namespace {
+std::atomic<size_t> g_allocations{0};
+}
+
+size_t test::get_allocations() {
+    return g_allocations.load();
+}
+
+void* operator new(size_t size) {
+    ++g_allocations;
+
+    if (auto p = std::malloc(size == 0 ? 1 : size); p != nullptr) {
+        return p;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+// Runs everything, or only the tests whose names contain the first argument.
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int ran = 0;
+
+    for (const auto& test_case : test::get_cases()) {
+        if (filter != nullptr && test_case.name.find(filter) == std::string_view::npos) {
+            continue;
+        }
+
+        const auto failures_before = test::get_failures();
+
+        std::printf("%.*s\n", (int)test_case.name.size(), test_case.name.data());
+        test_case.fn();
+        ++ran;
+
+        if (test::get_failures() != failures_before) {
+            std::printf("  FAILED\n");
+        }
+    }
+
+    std::printf("%d tests, %d failed checks\n", ran, test::get_failures());
+
+    return test::get_failures() == 0 ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+#include <memory>
+#include <unordered_map>
+
+#include <mods/pluginloader/ObjectPool.hpp>
+
+#include "Test.hpp"
+
+namespace {
+struct FakeObject {
+    bool alive{true};
+    bool rooted{false};
+    bool destroyed{false};
+    bool forgotten{false};
+};
+
+using FakeObjects = std::unordered_map<ObjectPool::Object, FakeObject>;
+
+// Hands out fake objects and tracks which ones the pool is responsible for keeping alive (rooted),
+// the way UObjectFactory roots free objects and unroots acquired ones.
+// The objects live outside the factory so they can still be checked after the pool is gone.
+class FakeFactory final : public ObjectPool::Factory {
+public:
+    FakeFactory(FakeObjects& objects)
+        : m_objects{objects}
+    {
+    }
+
+    ObjectPool::Object create() override {
+        const auto object = (ObjectPool::Object)(uintptr_t)(++m_next * 16);
+        m_objects[object].rooted = true;
+        return object;
+    }
+
+    void destroy(ObjectPool::Object object) override {
+        auto& state = m_objects[object];
+        state.rooted = false;
+        state.destroyed = true;
+    }
+
+    bool is_alive(ObjectPool::Object object) override {
+        return m_objects[object].alive;
+    }
+
+    void reset(ObjectPool::Object object) override {
+        m_objects[object].rooted = true;
+    }
+
+    void acquired(ObjectPool::Object object) override {
+        m_objects[object].rooted = false;
+    }
+
+    void forget(ObjectPool::Object object) override {
+        m_objects[object].forgotten = true;
+    }
+
+private:
+    FakeObjects& m_objects;
+    uintptr_t m_next{0};
+};
+
+struct Fixture {
+    Fixture(const ObjectPool::Policy& policy)
+        : pool{std::make_unique<FakeFactory>(objects), policy, now}
+    {
+    }
+
+    ObjectPool::Clock::time_point now{};
+    FakeObjects objects{};
+    ObjectPool pool;
+};
+}
+
+TEST(object_pool_free_objects_stay_rooted) {
+    Fixture f{ObjectPool::Policy{.prewarm = 4}};
+
+    CHECK(f.objects.size() == 4);
+
+    for (const auto& [object, state] : f.objects) {
+        CHECK(state.rooted);
+    }
+
+    const auto object = f.pool.acquire(f.now);
+    CHECK(object != nullptr);
+    CHECK(!f.objects[object].rooted);
+
+    CHECK(f.pool.release(object, f.now));
+    CHECK(f.objects[object].rooted);
+
+    // Reused, rooted only while it's free again
+    CHECK(f.pool.acquire(f.now) == object);
+    CHECK(!f.objects[object].rooted);
+    CHECK(f.pool.get_stats().reused == 2);
+}
+
+TEST(object_pool_grown_objects_are_handed_over) {
+    Fixture f{ObjectPool::Policy{.grow_by = 3}};
+
+    const auto object = f.pool.acquire(f.now);
+
+    CHECK(object != nullptr);
+    CHECK(f.objects.size() == 3);
+    CHECK(!f.objects[object].rooted);
+    CHECK(f.pool.get_stats().free == 2);
+}
+
+TEST(object_pool_dead_objects_are_forgotten) {
+    Fixture f{ObjectPool::Policy{.prewarm = 2}};
+
+    for (auto& [object, state] : f.objects) {
+        state.alive = false;
+    }
+
+    // Both free ones are dead, a new one gets made
+    const auto object = f.pool.acquire(f.now);
+
+    CHECK(object != nullptr);
+    CHECK(f.pool.get_stats().lost == 2);
+
+    size_t forgotten{0};
+
+    for (const auto& [o, state] : f.objects) {
+        forgotten += state.forgotten ? 1 : 0;
+        CHECK(!state.destroyed); // never touched again
+    }
+
+    CHECK(forgotten == 2);
+
+    f.objects[object].alive = false;
+    CHECK(!f.pool.release(object, f.now));
+    CHECK(f.objects[object].forgotten);
+    CHECK(!f.objects[object].rooted);
+}
+
+TEST(object_pool_trim_unroots) {
+    Fixture f{ObjectPool::Policy{.prewarm = 4, .keep_free = 1, .trim_after = std::chrono::seconds(1)}};
+
+    f.pool.trim(f.now + std::chrono::seconds(2));
+
+    CHECK(f.pool.get_stats().trimmed == 3);
+    CHECK(f.pool.get_stats().free == 1);
+
+    size_t rooted{0};
+
+    for (const auto& [object, state] : f.objects) {
+        rooted += state.rooted ? 1 : 0;
+        CHECK(state.rooted != state.destroyed);
+    }
+
+    CHECK(rooted == 1);
+}
+
+TEST(object_pool_destruction_unroots_free_objects_only) {
+    FakeObjects objects{};
+    ObjectPool::Object in_use{};
+
+    {
+        ObjectPool pool{std::make_unique<FakeFactory>(objects), ObjectPool::Policy{.prewarm = 3}, ObjectPool::Clock::time_point{}};
+        in_use = pool.acquire(ObjectPool::Clock::time_point{});
+    }
+
+    CHECK(objects.size() == 3);
+
+    for (const auto& [object, state] : objects) {
+        CHECK(!state.rooted);
+        CHECK(state.destroyed == (object != in_use)); // the in use one belongs to the caller
+    }
+}
@@ -0,0 +1,317 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <mods/vr/OpenVRFrameQueue.hpp>
+
+#include "Test.hpp"
+
+using namespace std::chrono_literals;
+
+namespace {
+// A compositor whose WaitGetPoses blocks until the test lets a vsync through, like SteamVR does when it's behind.
+class FakeCompositor final : public OpenVRFrameQueue::Compositor {
+public:
+    struct Submit {
+        vr::EVREye eye{};
+        uint32_t frame{0};
+    };
+
+    bool wait_for_copy(const OpenVRFrameQueue::Eye& eye) override {
+        return eye.fence_value != TIMED_OUT;
+    }
+
+    vr::EVRCompositorError submit(vr::EVREye eye, const vr::Texture_t* texture, const vr::VRTextureBounds_t*, vr::EVRSubmitFlags) override {
+        const auto with_pose = (const vr::VRTextureWithPose_t*)texture;
+        const auto frame = (uint32_t)with_pose->mDeviceToAbsoluteTracking.m[0][3];
+
+        std::scoped_lock _{m_mtx};
+        m_submits.push_back({eye, frame});
+
+        return frame == fail_frame ? vr::VRCompositorError_TextureIsOnWrongDevice : vr::VRCompositorError_None;
+    }
+
+    void post_present_handoff() override {
+        std::scoped_lock _{m_mtx};
+        ++m_handoffs;
+    }
+
+    vr::EVRCompositorError wait_get_poses(std::span<vr::TrackedDevicePose_t> render_poses, std::span<vr::TrackedDevicePose_t>) override {
+        std::unique_lock lock{m_mtx};
+
+        ++m_waiting;
+        m_cv.notify_all();
+        m_cv.wait(lock, [&]() { return !m_blocking || m_vsyncs > 0; });
+
+        if (m_blocking) {
+            --m_vsyncs;
+        }
+
+        --m_waiting;
+        ++m_poses;
+        render_poses[0].bPoseIsValid = true;
+        render_poses[0].mDeviceToAbsoluteTracking.m[0][3] = (float)m_poses;
+
+        return m_poses == fail_poses ? vr::VRCompositorError_DoNotHaveFocus : vr::VRCompositorError_None;
+    }
+
+    // Test thread
+    void wait_until_blocked() {
+        std::unique_lock lock{m_mtx};
+        m_cv.wait(lock, [&]() { return m_waiting > 0; });
+    }
+
+    void vsync() {
+        std::scoped_lock _{m_mtx};
+        ++m_vsyncs;
+        m_cv.notify_all();
+    }
+
+    void unblock() {
+        std::scoped_lock _{m_mtx};
+        m_blocking = false;
+        m_cv.notify_all();
+    }
+
+    std::vector<Submit> get_submits() const {
+        std::scoped_lock _{m_mtx};
+        return m_submits;
+    }
+
+    uint32_t get_handoffs() const {
+        std::scoped_lock _{m_mtx};
+        return m_handoffs;
+    }
+
+    static constexpr uint64_t TIMED_OUT = ~0ull;
+    uint32_t fail_frame{~0u};
+    uint32_t fail_poses{~0u};
+
+private:
+    mutable std::mutex m_mtx{};
+    std::condition_variable m_cv{};
+    bool m_blocking{true};
+    uint32_t m_vsyncs{0};
+    uint32_t m_waiting{0};
+    uint32_t m_poses{0};
+    uint32_t m_handoffs{0};
+    std::vector<Submit> m_submits{};
+};
+
+OpenVRFrameQueue::Eye make_eye(uint32_t frame) {
+    OpenVRFrameQueue::Eye eye{};
+    eye.pose.m[0][3] = (float)frame;
+    return eye;
+}
+
+OpenVRFrameQueue::Frame make_frame(uint32_t frame, bool afr = false) {
+    OpenVRFrameQueue::Frame result{};
+    result.frame_count = frame;
+    result.right = make_eye(frame);
+
+    if (!afr) {
+        result.left = make_eye(frame);
+    }
+
+    return result;
+}
+
+std::vector<uint32_t> submitted_frames(const FakeCompositor& compositor, vr::EVREye eye = vr::Eye_Right) {
+    std::vector<uint32_t> frames{};
+
+    for (const auto& submit : compositor.get_submits()) {
+        if (submit.eye == eye) {
+            frames.push_back(submit.frame);
+        }
+    }
+
+    return frames;
+}
+
+struct Fixture {
+    FakeCompositor* compositor{new FakeCompositor{}};
+    OpenVRFrameQueue queue{std::unique_ptr<OpenVRFrameQueue::Compositor>{compositor}};
+};
+}
+
+TEST(openvr_frame_queue_stalls_then_drops_the_oldest_pending_frame) {
+    Fixture f{};
+    const OpenVRFrameQueue::Settings settings{.depth = 1, .stall_timeout = 5ms};
+
+    f.queue.push(make_frame(1), settings);
+    f.compositor->wait_until_blocked();
+
+    // The worker is stuck in WaitGetPoses with frame 1, frame 2 waits for it, gives up and goes one over the depth
+    f.queue.push(make_frame(2), settings);
+
+    auto stats = f.queue.get_stats();
+    CHECK(stats.stalls == 1);
+    CHECK(stats.dropped == 0);
+    CHECK(stats.max_depth == 2);
+    CHECK(stats.stall_ms >= 4.0f);
+
+    // Frame 3 replaces frame 2, which would only have gone out late
+    f.queue.push(make_frame(3), settings);
+
+    stats = f.queue.get_stats();
+    CHECK(stats.pushed == 3);
+    CHECK(stats.stalls == 2);
+    CHECK(stats.dropped == 1);
+    CHECK(stats.max_depth == 2);
+
+    f.compositor->unblock();
+    f.queue.stop();
+
+    CHECK((submitted_frames(*f.compositor) == std::vector<uint32_t>{1, 3}));
+    CHECK((submitted_frames(*f.compositor, vr::Eye_Left) == std::vector<uint32_t>{1, 3}));
+    CHECK(f.compositor->get_handoffs() == 2);
+
+    stats = f.queue.get_stats();
+    CHECK(stats.submitted == 2);
+    CHECK(stats.pushed == stats.submitted + stats.dropped);
+}
+
+TEST(openvr_frame_queue_stall_ends_when_the_compositor_catches_up) {
+    Fixture f{};
+    const OpenVRFrameQueue::Settings settings{.depth = 1, .stall_timeout = 1000ms};
+
+    f.queue.push(make_frame(1), settings);
+    f.compositor->wait_until_blocked();
+
+    std::jthread vsync{[&]() {
+        std::this_thread::sleep_for(10ms);
+        f.compositor->vsync();
+    }};
+
+    // Only waits until frame 1 is done, not the whole timeout
+    f.queue.push(make_frame(2), settings);
+
+    const auto stats = f.queue.get_stats();
+    CHECK(stats.stalls == 1);
+    CHECK(stats.dropped == 0);
+    CHECK(stats.max_depth == 1);
+    CHECK(stats.stall_ms >= 5.0f && stats.stall_ms < 500.0f);
+
+    f.compositor->unblock();
+    f.queue.stop();
+
+    CHECK((submitted_frames(*f.compositor) == std::vector<uint32_t>{1, 2}));
+}
+
+TEST(openvr_frame_queue_zero_timeout_never_stalls) {
+    Fixture f{};
+    const OpenVRFrameQueue::Settings settings{.depth = 2, .stall_timeout = 0ms};
+
+    f.queue.push(make_frame(1), settings);
+    f.compositor->wait_until_blocked();
+
+    for (uint32_t frame = 2; frame <= 10; ++frame) {
+        f.queue.push(make_frame(frame), settings);
+    }
+
+    const auto stats = f.queue.get_stats();
+    CHECK(stats.stalls == 0);
+    CHECK(stats.stall_ms == 0.0f);
+    CHECK(stats.dropped == 8);
+    CHECK(stats.max_depth == 2);
+
+    f.compositor->unblock();
+    f.queue.stop();
+
+    // The one in flight and the newest
+    CHECK((submitted_frames(*f.compositor) == std::vector<uint32_t>{1, 10}));
+}
+
+TEST(openvr_frame_queue_stop_drains_pending_frames) {
+    Fixture f{};
+    const OpenVRFrameQueue::Settings settings{.depth = 2, .stall_timeout = 0ms};
+
+    f.queue.push(make_frame(1), settings);
+    f.compositor->wait_until_blocked();
+    f.queue.push(make_frame(2), settings);
+
+    CHECK(f.queue.is_running());
+
+    // stop() can't return before frame 2 went out, which needs the compositor to let frame 1 through first
+    std::jthread stopper{[&]() { f.queue.stop(); }};
+
+    std::this_thread::sleep_for(10ms);
+    CHECK(submitted_frames(*f.compositor).size() == 1);
+
+    f.compositor->unblock();
+    stopper.join();
+
+    CHECK(!f.queue.is_running());
+    CHECK((submitted_frames(*f.compositor) == std::vector<uint32_t>{1, 2}));
+    CHECK(f.queue.get_stats().submitted == 2);
+    CHECK(f.queue.get_stats().dropped == 0);
+
+    // Poses from before the stop are stale
+    CHECK(!f.queue.get_poses(0).has_value());
+
+    // And it starts again on the next push
+    f.queue.push(make_frame(3), settings);
+    CHECK(f.queue.is_running());
+    f.queue.stop();
+    CHECK((submitted_frames(*f.compositor) == std::vector<uint32_t>{1, 2, 3}));
+}
+
+TEST(openvr_frame_queue_publishes_poses) {
+    Fixture f{};
+    const OpenVRFrameQueue::Settings settings{.depth = 1, .stall_timeout = 0ms};
+    f.compositor->unblock();
+    f.compositor->fail_poses = 2;
+
+    f.queue.push(make_frame(1), settings);
+
+    // Pushing waits for nothing here, so give the worker a moment
+    for (auto i = 0; i < 1000 && !f.queue.get_poses(0).has_value(); ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    const auto poses = f.queue.get_poses(0);
+    CHECK(poses.has_value() && poses->version == 1);
+    CHECK(poses.has_value() && poses->render[0].mDeviceToAbsoluteTracking.m[0][3] == 1.0f);
+    CHECK(!f.queue.get_poses(1).has_value());
+
+    // A failed WaitGetPoses doesn't replace the last good poses
+    f.queue.push(make_frame(2), settings);
+
+    for (auto i = 0; i < 1000 && submitted_frames(*f.compositor).size() < 2; ++i) {
+        std::this_thread::sleep_for(1ms);
+    }
+
+    std::this_thread::sleep_for(5ms);
+    CHECK(!f.queue.get_poses(1).has_value());
+
+    f.queue.stop();
+}
+
+TEST(openvr_frame_queue_counts_failures) {
+    Fixture f{};
+    const OpenVRFrameQueue::Settings settings{.depth = 2, .stall_timeout = 100ms};
+    f.compositor->unblock();
+    f.compositor->fail_frame = 2;
+
+    // AFR, the left eye went out with the previous frame
+    f.queue.push(make_frame(1, true), settings);
+    f.queue.push(make_frame(2), settings);
+
+    auto late = make_frame(3);
+    late.right.fence_value = FakeCompositor::TIMED_OUT;
+    f.queue.push(std::move(late), settings);
+
+    f.queue.stop();
+
+    CHECK((submitted_frames(*f.compositor) == std::vector<uint32_t>{1, 2, 3}));
+    CHECK((submitted_frames(*f.compositor, vr::Eye_Left) == std::vector<uint32_t>{2, 3}));
+
+    const auto stats = f.queue.get_stats();
+    CHECK(stats.submitted == 3);
+    CHECK(stats.failed == 2);
+    CHECK(stats.fence_timeouts == 1);
+}
@@ -0,0 +1,123 @@
+#include <cstdint>
+
+#include <mods/vr/OpenVROverlayState.hpp>
+
+#include "RecordingOverlay.hpp"
+#include "Test.hpp"
+
+using vrmod::OpenVROverlayState;
+
+namespace {
+constexpr vr::VROverlayHandle_t HANDLE = 42;
+
+Matrix3x4f make_transform(float x) {
+    Matrix3x4f m{};
+    m[0][0] = 1.0f;
+    m[1][1] = 1.0f;
+    m[2][2] = 1.0f;
+    m[0][3] = x;
+    return m;
+}
+
+// What OverlayComponent sends for the framework UI every frame it's open.
+void draw_framework_ui(OpenVROverlayState& state, const Matrix3x4f& transform, const void* render_target) {
+    state.set_texture_bounds(vr::VRTextureBounds_t{0.0f, 0.0f, 1.0f, 1.0f});
+    state.set_mouse_scale(vr::HmdVector2_t{1920.0f, 1080.0f});
+    state.set_intersection_rect(vr::IntersectionMaskRectangle_t{0.0f, 0.0f, 1920.0f, 1080.0f});
+    state.set_transform_absolute(transform);
+    state.set_flag(vr::VROverlayFlags_MakeOverlaysInteractiveIfVisible, true);
+    state.show();
+    state.set_width_in_meters(0.25f);
+
+    const vr::Texture_t texture{(void*)render_target, vr::TextureType_DirectX, vr::ColorSpace_Auto};
+    state.set_texture(texture, render_target, true);
+}
+}
+
+TEST(openvr_overlay_state_static_overlay_only_submits_the_texture) {
+    test::RecordingOverlay overlay{};
+    OpenVROverlayState state{};
+    state.reset(&overlay, HANDLE);
+
+    int render_target{};
+    const auto transform = make_transform(1.0f);
+
+    draw_framework_ui(state, transform, &render_target);
+
+    // Everything goes out once
+    CHECK(overlay.calls.size() == 8);
+
+    overlay.calls.clear();
+
+    for (auto frame = 0; frame < 100; ++frame) {
+        draw_framework_ui(state, transform, &render_target);
+    }
+
+    // After that it's only the render target, which is drawn into every frame
+    CHECK(overlay.calls.size() == 100);
+    CHECK(overlay.count("SetOverlayTexture") == 100);
+}
+
+TEST(openvr_overlay_state_moving_overlay_submits_the_transform) {
+    test::RecordingOverlay overlay{};
+    OpenVROverlayState state{};
+    state.reset(&overlay, HANDLE);
+
+    int render_target{};
+    draw_framework_ui(state, make_transform(0.0f), &render_target);
+    overlay.calls.clear();
+
+    // Following the HMD or a controller
+    for (auto frame = 1; frame <= 100; ++frame) {
+        draw_framework_ui(state, make_transform((float)frame * 0.01f), &render_target);
+    }
+
+    CHECK(overlay.calls.size() == 200);
+    CHECK(overlay.count("SetOverlayTransformAbsolute") == 100);
+    CHECK(overlay.count("SetOverlayTexture") == 100);
+
+    // Stopping is the same as static again
+    overlay.calls.clear();
+
+    for (auto frame = 0; frame < 10; ++frame) {
+        draw_framework_ui(state, make_transform(1.0f), &render_target);
+    }
+
+    CHECK(overlay.count("SetOverlayTransformAbsolute") == 0);
+}
+
+TEST(openvr_overlay_state_sends_changes_and_forgets_on_reset) {
+    test::RecordingOverlay overlay{};
+    OpenVROverlayState state{};
+    state.reset(&overlay, HANDLE);
+
+    int blank{};
+    const vr::Texture_t texture{(void*)&blank, vr::TextureType_DirectX, vr::ColorSpace_Auto};
+
+    // A texture that isn't drawn into every frame only goes out when it changes
+    state.set_texture(texture, &blank, false);
+    state.set_texture(texture, &blank, false);
+    CHECK(overlay.count("SetOverlayTexture") == 1);
+
+    state.clear_texture();
+    state.clear_texture();
+    CHECK(overlay.count("ClearOverlayTexture") == 1);
+
+    state.hide();
+    state.hide();
+    state.show();
+    CHECK(overlay.count("HideOverlay") == 1);
+    CHECK(overlay.count("ShowOverlay") == 1);
+
+    state.set_flag(vr::VROverlayFlags_MakeOverlaysInteractiveIfVisible, false);
+    state.set_flag(vr::VROverlayFlags_MakeOverlaysInteractiveIfVisible, false);
+    state.set_flag(vr::VROverlayFlags_MakeOverlaysInteractiveIfVisible, true);
+    CHECK(overlay.count("SetOverlayFlag") == 2);
+
+    // After a device reset the compositor's copy can't be trusted, everything is sent again
+    overlay.calls.clear();
+    state.reset(HANDLE);
+    state.show();
+    state.set_texture(texture, &blank, false);
+    CHECK(overlay.calls.size() == 2);
+}
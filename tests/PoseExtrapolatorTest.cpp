@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <mods/vr/PoseExtrapolator.hpp>
+
+#include "Test.hpp"
+
+namespace {
+constexpr int64_t FRAME_NS = 11'111'111; // 90 Hz
+
+// A controller swinging around a circle while turning with it, the way a pose stream recorded at 90 Hz would come in.
+// Velocities are what the runtime reports alongside each pose. noise_mm adds repeatable tracking jitter.
+std::vector<PoseExtrapolator::Sample> record_swing(size_t count, float radius, float rad_per_second, float noise_mm = 0.0f) {
+    std::vector<PoseExtrapolator::Sample> samples{};
+    uint32_t seed = 12345;
+
+    const auto jitter = [&]() {
+        seed = seed * 1664525 + 1013904223;
+        return ((float)(seed >> 8) / (float)(1 << 24) - 0.5f) * 2.0f * noise_mm / 1000.0f;
+    };
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto t = (float)((double)(i * FRAME_NS) / 1'000'000'000.0);
+        const auto angle = rad_per_second * t;
+
+        PoseExtrapolator::Sample sample{};
+        sample.transform = glm::rotate(glm::identity<Matrix4x4f>(), angle, Vector3f{0.0f, 1.0f, 0.0f});
+        sample.transform[3] = Vector4f{radius * glm::cos(angle) + jitter(), 1.5f + jitter(), radius * glm::sin(angle) + jitter(), 1.0f};
+        sample.velocity = Vector3f{-radius * rad_per_second * glm::sin(angle), 0.0f, radius * rad_per_second * glm::cos(angle)};
+        sample.angular_velocity = Vector3f{0.0f, rad_per_second, 0.0f};
+        sample.display_time_ns = 1'000'000'000 + (int64_t)i * FRAME_NS;
+        sample.valid = true;
+
+        samples.push_back(sample);
+    }
+
+    return samples;
+}
+
+struct ReplayResult {
+    PoseExtrapolator::Error total{};
+    PoseExtrapolator::Error worst{};
+    size_t measured{0};
+};
+
+ReplayResult replay(const PoseExtrapolator::Settings& settings, const std::vector<PoseExtrapolator::Sample>& samples) {
+    ReplayResult result{};
+
+    for (size_t i = 1; i < samples.size(); ++i) {
+        const auto error = PoseExtrapolator::measure(settings, samples[i - 1], samples[i]);
+
+        if (!error) {
+            continue;
+        }
+
+        result.total.predicted_mm += error->predicted_mm;
+        result.total.unpredicted_mm += error->unpredicted_mm;
+        result.total.predicted_deg += error->predicted_deg;
+        result.total.unpredicted_deg += error->unpredicted_deg;
+        result.worst.predicted_mm = std::max(result.worst.predicted_mm, error->predicted_mm);
+        result.worst.predicted_deg = std::max(result.worst.predicted_deg, error->predicted_deg);
+        ++result.measured;
+    }
+
+    return result;
+}
+}
+
+TEST(pose_lead_starts_at_display_time) {
+    const PoseExtrapolator::Settings settings{};
+    const int64_t display = 5'000'000'000;
+
+    CHECK(PoseExtrapolator::get_lead_seconds(settings, display, display - 8'000'000) == 0.0f);
+    CHECK(PoseExtrapolator::get_lead_seconds(settings, display, display) == 0.0f);
+    CHECK_NEAR(PoseExtrapolator::get_lead_seconds(settings, display, display + 5'000'000), 0.005, 1e-6);
+
+    // Not sampled yet, or stale
+    CHECK(PoseExtrapolator::get_lead_seconds(settings, 0, display) == 0.0f);
+    CHECK(PoseExtrapolator::get_lead_seconds(settings, display, display + PoseExtrapolator::MAX_SAMPLE_AGE_NS + 1) == 0.0f);
+}
+
+TEST(pose_lead_extra_and_clamp) {
+    PoseExtrapolator::Settings settings{};
+    settings.extra_lead_ms = 4.0f;
+    settings.max_prediction_ms = 10.0f;
+
+    const int64_t display = 5'000'000'000;
+
+    CHECK_NEAR(PoseExtrapolator::get_lead_seconds(settings, display, display), 0.004, 1e-6);
+    CHECK_NEAR(PoseExtrapolator::get_lead_seconds(settings, display, display - 2'000'000), 0.002, 1e-6);
+    CHECK(PoseExtrapolator::get_lead_seconds(settings, display, display - 6'000'000) == 0.0f);
+    CHECK_NEAR(PoseExtrapolator::get_lead_seconds(settings, display, display + 50'000'000), 0.010, 1e-6);
+}
+
+TEST(pose_predict_before_display_time_is_untouched) {
+    const auto samples = record_swing(2, 0.3f, 6.0f);
+    const auto& sample = samples[0];
+
+    const auto predicted = PoseExtrapolator::predict(PoseExtrapolator::Settings{}, sample, sample.display_time_ns - 3'000'000);
+
+    CHECK(predicted == sample.transform);
+}
+
+TEST(pose_replay_constant_motion_is_exact) {
+    // Straight line at constant velocity and a constant spin, extrapolation should land right on the next sample.
+    std::vector<PoseExtrapolator::Sample> samples{};
+
+    for (int64_t i = 0; i < 90; ++i) {
+        const auto t = (float)((double)(i * FRAME_NS) / 1'000'000'000.0);
+
+        PoseExtrapolator::Sample sample{};
+        sample.transform = glm::rotate(glm::identity<Matrix4x4f>(), 2.0f * t, Vector3f{0.0f, 0.0f, 1.0f});
+        sample.transform[3] = Vector4f{0.5f * t, 1.0f, -0.25f * t, 1.0f};
+        sample.velocity = Vector3f{0.5f, 0.0f, -0.25f};
+        sample.angular_velocity = Vector3f{0.0f, 0.0f, 2.0f};
+        sample.display_time_ns = 1'000'000'000 + i * FRAME_NS;
+        sample.valid = true;
+
+        samples.push_back(sample);
+    }
+
+    const auto result = replay(PoseExtrapolator::Settings{}, samples);
+
+    CHECK(result.measured == samples.size() - 1);
+    CHECK(result.worst.predicted_mm < 0.01f);
+    CHECK(result.worst.predicted_deg < 0.1f);
+    CHECK(result.total.unpredicted_mm / result.measured > 5.0f);
+}
+
+TEST(pose_replay_swing_beats_no_prediction) {
+    const auto samples = record_swing(180, 0.3f, 6.0f, 0.2f);
+    const auto result = replay(PoseExtrapolator::Settings{}, samples);
+
+    CHECK(result.measured == samples.size() - 1);
+
+    const auto predicted_mm = result.total.predicted_mm / result.measured;
+    const auto unpredicted_mm = result.total.unpredicted_mm / result.measured;
+
+    // ~20 mm of movement per frame, linear extrapolation is off by well under a millimeter plus the jitter
+    CHECK(unpredicted_mm > 15.0f);
+    CHECK(predicted_mm < 1.5f);
+    CHECK(result.total.predicted_deg < result.total.unpredicted_deg * 0.05f);
+}
+
+TEST(pose_replay_is_deterministic) {
+    const auto samples = record_swing(120, 0.25f, 4.0f, 0.5f);
+
+    const auto a = replay(PoseExtrapolator::Settings{}, samples);
+    const auto b = replay(PoseExtrapolator::Settings{}, samples);
+
+    CHECK(a.measured == b.measured);
+    CHECK(a.total.predicted_mm == b.total.predicted_mm);
+    CHECK(a.total.predicted_deg == b.total.predicted_deg);
+}
+
+TEST(pose_replay_skips_gaps) {
+    auto samples = record_swing(3, 0.3f, 6.0f);
+
+    samples[1].valid = false;
+    CHECK(!PoseExtrapolator::measure(PoseExtrapolator::Settings{}, samples[0], samples[1]));
+
+    // A pause longer than MAX_SAMPLE_AGE_NS between samples
+    samples[2].display_time_ns = samples[0].display_time_ns + PoseExtrapolator::MAX_SAMPLE_AGE_NS + 1;
+    CHECK(!PoseExtrapolator::measure(PoseExtrapolator::Settings{}, samples[0], samples[2]));
+}
@@ -0,0 +1,191 @@
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <mods/pluginloader/PreparedCommand.hpp>
+
+#include "Test.hpp"
+
+namespace {
+// A console with a couple of objects in it that remembers everything it was asked to do.
+class FakeConsole final : public PreparedCommand::Console {
+public:
+    struct Entry {
+        bool command{false};
+        std::wstring value{};
+        std::vector<std::vector<std::wstring>> runs{};
+    };
+
+    bool ready{true};
+    bool has_engine{true};
+    std::map<std::wstring, Entry, std::less<>> objects{};
+    std::vector<std::wstring> exec_lines{};
+    uint32_t finds{0};
+
+    bool is_ready() override {
+        return ready;
+    }
+
+    PreparedCommand::Object find(std::wstring_view name) override {
+        ++finds;
+
+        const auto it = objects.find(name);
+        return it != objects.end() ? &it->second : nullptr;
+    }
+
+    bool is_command(PreparedCommand::Object object) override {
+        return ((Entry*)object)->command;
+    }
+
+    void set_variable(PreparedCommand::Object variable, const std::wstring& value) override {
+        ((Entry*)variable)->value = value;
+    }
+
+    void execute_command(PreparedCommand::Object command, const std::vector<std::wstring>& args) override {
+        ((Entry*)command)->runs.push_back(args);
+    }
+
+    bool exec(const std::wstring& line) override {
+        if (!has_engine) {
+            return false;
+        }
+
+        exec_lines.push_back(line);
+        return true;
+    }
+};
+
+using Tokens = std::vector<std::wstring>;
+}
+
+TEST(prepared_command_tokenize) {
+    CHECK(PreparedCommand::tokenize(L"").empty());
+    CHECK(PreparedCommand::tokenize(L"  \t ").empty());
+    CHECK((PreparedCommand::tokenize(L"r.ScreenPercentage 100") == Tokens{L"r.ScreenPercentage", L"100"}));
+    CHECK((PreparedCommand::tokenize(L"  a \t b\r\n") == Tokens{L"a", L"b"}));
+
+    // Quotes keep spaces in and are dropped
+    CHECK((PreparedCommand::tokenize(L"say \"hello there\" x") == Tokens{L"say", L"hello there", L"x"}));
+    CHECK((PreparedCommand::tokenize(L"a\"b c\"d") == Tokens{L"ab cd"}));
+
+    // An empty pair of quotes is still an argument
+    CHECK((PreparedCommand::tokenize(L"cmd \"\" x") == Tokens{L"cmd", L"", L"x"}));
+
+    // Unterminated quotes run to the end
+    CHECK((PreparedCommand::tokenize(L"cmd \"a b") == Tokens{L"cmd", L"a b"}));
+}
+
+TEST(prepared_command_parses_the_line_once) {
+    const PreparedCommand command{L"  r.Foo  \"1 2\"  "};
+
+    CHECK(command.get_line() == L"r.Foo  \"1 2\"");
+    CHECK(command.get_name() == L"r.Foo");
+    CHECK((command.get_args() == Tokens{L"1 2"}));
+    CHECK(command.get_target() == PreparedCommand::Target::UNRESOLVED);
+}
+
+TEST(prepared_command_resolves_a_variable_once) {
+    FakeConsole console{};
+    console.objects[L"r.ScreenPercentage"] = {};
+
+    PreparedCommand command{L"r.ScreenPercentage \"150\""};
+
+    for (auto i = 0; i < 10; ++i) {
+        CHECK(command.execute(console));
+    }
+
+    CHECK(command.get_target() == PreparedCommand::Target::VARIABLE);
+    CHECK(console.objects[L"r.ScreenPercentage"].value == L"150");
+    CHECK(console.finds == 1);
+    CHECK(command.get_stats().resolves == 1);
+    CHECK(command.get_stats().direct == 10);
+    CHECK(console.exec_lines.empty());
+}
+
+TEST(prepared_command_resolves_a_command) {
+    FakeConsole console{};
+    console.objects[L"ToggleDebugCamera"] = {.command = true};
+    console.objects[L"Teleport"] = {.command = true};
+
+    PreparedCommand toggle{L"ToggleDebugCamera"};
+    PreparedCommand teleport{L"Teleport 1 \"2 3\""};
+
+    CHECK(toggle.execute(console));
+    CHECK(teleport.execute(console));
+    CHECK(teleport.execute(console));
+
+    CHECK(toggle.get_target() == PreparedCommand::Target::COMMAND);
+    CHECK(console.objects[L"ToggleDebugCamera"].runs.size() == 1);
+    CHECK(console.objects[L"ToggleDebugCamera"].runs[0].empty());
+
+    const auto& runs = console.objects[L"Teleport"].runs;
+    CHECK(runs.size() == 2);
+    CHECK((runs[0] == Tokens{L"1", L"2 3"}));
+    CHECK(console.exec_lines.empty());
+}
+
+TEST(prepared_command_falls_back_to_exec) {
+    FakeConsole console{};
+    console.objects[L"r.Foo"] = {.value = L"1"};
+
+    // Not a console object at all
+    PreparedCommand stat{L"stat fps"};
+    CHECK(stat.execute(console));
+    CHECK(stat.execute(console));
+    CHECK(stat.get_target() == PreparedCommand::Target::EXEC);
+    CHECK(stat.get_stats().resolves == 1);
+    CHECK(stat.get_stats().exec == 2);
+
+    // A variable without a value, or with "?", is printed by the console, not set
+    PreparedCommand print{L"r.Foo"};
+    PreparedCommand query{L"r.Foo ?"};
+    CHECK(print.execute(console));
+    CHECK(query.execute(console));
+    CHECK(print.get_target() == PreparedCommand::Target::EXEC);
+    CHECK(query.get_target() == PreparedCommand::Target::EXEC);
+    CHECK(console.objects[L"r.Foo"].value == L"1");
+
+    CHECK((console.exec_lines == Tokens{L"stat fps", L"stat fps", L"r.Foo", L"r.Foo ?"}));
+
+    // Nothing to run it on
+    console.has_engine = false;
+    CHECK(!stat.execute(console));
+    CHECK(stat.get_stats().exec == 2);
+}
+
+TEST(prepared_command_waits_for_the_console) {
+    FakeConsole console{};
+    console.ready = false;
+    console.objects[L"r.Foo"] = {};
+
+    PreparedCommand command{L"r.Foo 2"};
+
+    // Not resolved yet, goes through Exec until the console manager is there
+    CHECK(command.execute(console));
+    CHECK(command.get_target() == PreparedCommand::Target::UNRESOLVED);
+    CHECK(console.finds == 0);
+    CHECK(console.exec_lines.size() == 1);
+
+    console.ready = true;
+    CHECK(command.execute(console));
+    CHECK(command.get_target() == PreparedCommand::Target::VARIABLE);
+    CHECK(console.objects[L"r.Foo"].value == L"2");
+
+    // Looked up again after an invalidate, e.g. the object went away with a level change
+    console.objects.erase(L"r.Foo");
+    command.invalidate();
+    CHECK(command.execute(console));
+    CHECK(command.get_target() == PreparedCommand::Target::EXEC);
+    CHECK(command.get_stats().resolves == 2);
+}
+
+TEST(prepared_command_empty_line) {
+    FakeConsole console{};
+    PreparedCommand command{L"   "};
+
+    CHECK(!command.execute(console));
+    CHECK(console.finds == 0);
+    CHECK(console.exec_lines.empty());
+}
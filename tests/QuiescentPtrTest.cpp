@@ -0,0 +1,146 @@
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <utility/QuiescentPtr.hpp>
+
+#include "Test.hpp"
+
+namespace {
+constexpr uint32_t ALIVE = 0xA11CE;
+constexpr uint32_t DEAD = 0xDEAD;
+constexpr size_t MAX_STATES = 1 << 16;
+
+// Marks itself dead before the memory goes away, so a reader that still has it can tell.
+struct State {
+    State(uint32_t id, std::array<std::atomic<bool>, MAX_STATES>& freed)
+        : id{id}, freed{&freed}
+    {
+    }
+
+    ~State() {
+        canary.store(DEAD);
+        (*freed)[id].store(true);
+    }
+
+    uint32_t id{};
+    std::array<std::atomic<bool>, MAX_STATES>* freed{};
+    std::atomic<uint32_t> canary{ALIVE};
+};
+
+struct Storm {
+    std::unique_ptr<std::array<std::atomic<bool>, MAX_STATES>> freed{std::make_unique<std::array<std::atomic<bool>, MAX_STATES>>()};
+    std::atomic<uint32_t> reads{0};
+    std::atomic<uint32_t> used_after_free{0};
+    std::atomic<bool> done{false};
+};
+
+// A window procedure: grab the state, use it for a bit (handing the CPU to the writers now and then,
+// like calling into the game would), let go.
+void read_messages(const utility::QuiescentPtr<State>& ptr, Storm& storm) {
+    while (!storm.done.load()) {
+        auto state = ptr.read();
+
+        if (!state) {
+            continue;
+        }
+
+        for (auto i = 0; i < 8; ++i) {
+            if (state->canary.load() != ALIVE) {
+                ++storm.used_after_free;
+                break;
+            }
+
+            if (i % 4 == 0) {
+                std::this_thread::yield();
+            }
+        }
+
+        if ((*storm.freed)[state->id % MAX_STATES].load()) {
+            ++storm.used_after_free;
+        }
+
+        ++storm.reads;
+    }
+}
+}
+
+TEST(quiescent_ptr_message_storm) {
+    Storm storm{};
+    utility::QuiescentPtr<State> ptr{};
+    ptr.publish(std::make_unique<State>(0, *storm.freed));
+
+    std::vector<std::thread> readers{};
+
+    for (auto i = 0; i < 4; ++i) {
+        readers.emplace_back([&] { read_messages(ptr, storm); });
+    }
+
+    // Hooking and unhooking, the same two ways WindowsMessageHook does it
+    constexpr uint32_t WRITES = MAX_STATES - 1;
+
+    for (uint32_t id = 1; id <= WRITES; ++id) {
+        auto next = std::make_unique<State>(id, *storm.freed);
+
+        if (id % 2 == 0) {
+            ptr.publish(std::move(next));
+        } else {
+            auto old = ptr.exchange(std::move(next));
+            ptr.retire(std::move(old));
+        }
+
+        std::this_thread::yield();
+    }
+
+    storm.done.store(true);
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    std::printf("  %u reads over %u writes\n", storm.reads.load(), WRITES);
+    CHECK(storm.used_after_free.load() == 0);
+    CHECK(storm.reads.load() > 0);
+
+    // With the readers gone everything but the current state is freed on the next chance
+    ptr.reclaim();
+    CHECK(ptr.get_retired_count() == 0);
+
+    uint32_t still_alive{0};
+
+    for (uint32_t id = 0; id <= WRITES; ++id) {
+        still_alive += (*storm.freed)[id].load() ? 0 : 1;
+    }
+
+    CHECK(still_alive == 1);
+    CHECK(!(*storm.freed)[WRITES].load());
+}
+
+TEST(quiescent_ptr_last_reader_out_reclaims) {
+    std::array<std::atomic<bool>, MAX_STATES> freed{};
+    utility::QuiescentPtr<State> ptr{};
+    ptr.publish(std::make_unique<State>(0, freed));
+
+    auto first = ptr.read();
+    auto second = ptr.read();
+
+    // Can't be freed while it's being read
+    ptr.publish(std::make_unique<State>(1, freed));
+    ptr.retire(ptr.exchange(std::make_unique<State>(2, freed)));
+    CHECK(ptr.get_retired_count() == 2);
+    CHECK(!freed[0].load() && !freed[1].load());
+
+    first.release();
+    CHECK(ptr.get_retired_count() == 2);
+    CHECK(second->canary.load() == ALIVE);
+
+    // No write needed to get it back
+    second.release();
+    CHECK(ptr.get_retired_count() == 0);
+    CHECK(freed[0].load() && freed[1].load());
+    CHECK(!freed[2].load());
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include <openvr.h>
+
+namespace test {
+// An IVROverlay that doesn't show anything, it only remembers which calls were made and in what order.
+// Every call is an IPC round trip with the real compositor, so the count is what matters.
+class RecordingOverlay final : public vr::IVROverlay {
+public:
+    std::vector<std::string_view> calls{};
+
+    size_t count(std::string_view name) const {
+        size_t n{0};
+
+        for (const auto& call : calls) {
+            n += call == name ? 1 : 0;
+        }
+
+        return n;
+    }
+
+    vr::EVROverlayError FindOverlay(const char*, vr::VROverlayHandle_t*) override { calls.push_back("FindOverlay"); return {}; }
+    vr::EVROverlayError CreateOverlay(const char*, const char*, vr::VROverlayHandle_t*) override { calls.push_back("CreateOverlay"); return {}; }
+    vr::EVROverlayError DestroyOverlay(vr::VROverlayHandle_t) override { calls.push_back("DestroyOverlay"); return {}; }
+    uint32_t GetOverlayKey(vr::VROverlayHandle_t, char*, uint32_t, vr::EVROverlayError*) override { calls.push_back("GetOverlayKey"); return {}; }
+    uint32_t GetOverlayName(vr::VROverlayHandle_t, char*, uint32_t, vr::EVROverlayError*) override { calls.push_back("GetOverlayName"); return {}; }
+    vr::EVROverlayError SetOverlayName(vr::VROverlayHandle_t, const char*) override { calls.push_back("SetOverlayName"); return {}; }
+    vr::EVROverlayError GetOverlayImageData(vr::VROverlayHandle_t, void*, uint32_t, uint32_t*, uint32_t*) override { calls.push_back("GetOverlayImageData"); return {}; }
+    const char* GetOverlayErrorNameFromEnum(vr::EVROverlayError) override { calls.push_back("GetOverlayErrorNameFromEnum"); return ""; }
+    vr::EVROverlayError SetOverlayRenderingPid(vr::VROverlayHandle_t, uint32_t) override { calls.push_back("SetOverlayRenderingPid"); return {}; }
+    uint32_t GetOverlayRenderingPid(vr::VROverlayHandle_t) override { calls.push_back("GetOverlayRenderingPid"); return {}; }
+    vr::EVROverlayError SetOverlayFlag(vr::VROverlayHandle_t, vr::VROverlayFlags, bool) override { calls.push_back("SetOverlayFlag"); return {}; }
+    vr::EVROverlayError GetOverlayFlag(vr::VROverlayHandle_t, vr::VROverlayFlags, bool*) override { calls.push_back("GetOverlayFlag"); return {}; }
+    vr::EVROverlayError GetOverlayFlags(vr::VROverlayHandle_t, uint32_t*) override { calls.push_back("GetOverlayFlags"); return {}; }
+    vr::EVROverlayError SetOverlayColor(vr::VROverlayHandle_t, float, float, float) override { calls.push_back("SetOverlayColor"); return {}; }
+    vr::EVROverlayError GetOverlayColor(vr::VROverlayHandle_t, float*, float*, float*) override { calls.push_back("GetOverlayColor"); return {}; }
+    vr::EVROverlayError SetOverlayAlpha(vr::VROverlayHandle_t, float) override { calls.push_back("SetOverlayAlpha"); return {}; }
+    vr::EVROverlayError GetOverlayAlpha(vr::VROverlayHandle_t, float*) override { calls.push_back("GetOverlayAlpha"); return {}; }
+    vr::EVROverlayError SetOverlayTexelAspect(vr::VROverlayHandle_t, float) override { calls.push_back("SetOverlayTexelAspect"); return {}; }
+    vr::EVROverlayError GetOverlayTexelAspect(vr::VROverlayHandle_t, float*) override { calls.push_back("GetOverlayTexelAspect"); return {}; }
+    vr::EVROverlayError SetOverlaySortOrder(vr::VROverlayHandle_t, uint32_t) override { calls.push_back("SetOverlaySortOrder"); return {}; }
+    vr::EVROverlayError GetOverlaySortOrder(vr::VROverlayHandle_t, uint32_t*) override { calls.push_back("GetOverlaySortOrder"); return {}; }
+    vr::EVROverlayError SetOverlayWidthInMeters(vr::VROverlayHandle_t, float) override { calls.push_back("SetOverlayWidthInMeters"); return {}; }
+    vr::EVROverlayError GetOverlayWidthInMeters(vr::VROverlayHandle_t, float*) override { calls.push_back("GetOverlayWidthInMeters"); return {}; }
+    vr::EVROverlayError SetOverlayCurvature(vr::VROverlayHandle_t, float) override { calls.push_back("SetOverlayCurvature"); return {}; }
+    vr::EVROverlayError GetOverlayCurvature(vr::VROverlayHandle_t, float*) override { calls.push_back("GetOverlayCurvature"); return {}; }
+    vr::EVROverlayError SetOverlayPreCurvePitch(vr::VROverlayHandle_t, float) override { calls.push_back("SetOverlayPreCurvePitch"); return {}; }
+    vr::EVROverlayError GetOverlayPreCurvePitch(vr::VROverlayHandle_t, float*) override { calls.push_back("GetOverlayPreCurvePitch"); return {}; }
+    vr::EVROverlayError SetOverlayTextureColorSpace(vr::VROverlayHandle_t, vr::EColorSpace) override { calls.push_back("SetOverlayTextureColorSpace"); return {}; }
+    vr::EVROverlayError GetOverlayTextureColorSpace(vr::VROverlayHandle_t, vr::EColorSpace*) override { calls.push_back("GetOverlayTextureColorSpace"); return {}; }
+    vr::EVROverlayError SetOverlayTextureBounds(vr::VROverlayHandle_t, const vr::VRTextureBounds_t*) override { calls.push_back("SetOverlayTextureBounds"); return {}; }
+    vr::EVROverlayError GetOverlayTextureBounds(vr::VROverlayHandle_t, vr::VRTextureBounds_t*) override { calls.push_back("GetOverlayTextureBounds"); return {}; }
+    vr::EVROverlayError GetOverlayTransformType(vr::VROverlayHandle_t, vr::VROverlayTransformType*) override { calls.push_back("GetOverlayTransformType"); return {}; }
+    vr::EVROverlayError SetOverlayTransformAbsolute(vr::VROverlayHandle_t, vr::ETrackingUniverseOrigin, const vr::HmdMatrix34_t*) override { calls.push_back("SetOverlayTransformAbsolute"); return {}; }
+    vr::EVROverlayError GetOverlayTransformAbsolute(vr::VROverlayHandle_t, vr::ETrackingUniverseOrigin*, vr::HmdMatrix34_t*) override { calls.push_back("GetOverlayTransformAbsolute"); return {}; }
+    vr::EVROverlayError SetOverlayTransformTrackedDeviceRelative(vr::VROverlayHandle_t, vr::TrackedDeviceIndex_t, const vr::HmdMatrix34_t*) override { calls.push_back("SetOverlayTransformTrackedDeviceRelative"); return {}; }
+    vr::EVROverlayError GetOverlayTransformTrackedDeviceRelative(vr::VROverlayHandle_t, vr::TrackedDeviceIndex_t*, vr::HmdMatrix34_t*) override { calls.push_back("GetOverlayTransformTrackedDeviceRelative"); return {}; }
+    vr::EVROverlayError SetOverlayTransformTrackedDeviceComponent(vr::VROverlayHandle_t, vr::TrackedDeviceIndex_t, const char*) override { calls.push_back("SetOverlayTransformTrackedDeviceComponent"); return {}; }
+    vr::EVROverlayError GetOverlayTransformTrackedDeviceComponent(vr::VROverlayHandle_t, vr::TrackedDeviceIndex_t*, char*, uint32_t) override { calls.push_back("GetOverlayTransformTrackedDeviceComponent"); return {}; }
+    vr::EVROverlayError GetOverlayTransformOverlayRelative(vr::VROverlayHandle_t, vr::VROverlayHandle_t*, vr::HmdMatrix34_t*) override { calls.push_back("GetOverlayTransformOverlayRelative"); return {}; }
+    vr::EVROverlayError SetOverlayTransformOverlayRelative(vr::VROverlayHandle_t, vr::VROverlayHandle_t, const vr::HmdMatrix34_t*) override { calls.push_back("SetOverlayTransformOverlayRelative"); return {}; }
+    vr::EVROverlayError SetOverlayTransformCursor(vr::VROverlayHandle_t, const vr::HmdVector2_t*) override { calls.push_back("SetOverlayTransformCursor"); return {}; }
+    vr::EVROverlayError GetOverlayTransformCursor(vr::VROverlayHandle_t, vr::HmdVector2_t*) override { calls.push_back("GetOverlayTransformCursor"); return {}; }
+    vr::EVROverlayError SetOverlayTransformProjection(vr::VROverlayHandle_t, vr::ETrackingUniverseOrigin, const vr::HmdMatrix34_t*, const vr::VROverlayProjection_t*, vr::EVREye) override { calls.push_back("SetOverlayTransformProjection"); return {}; }
+    vr::EVROverlayError ShowOverlay(vr::VROverlayHandle_t) override { calls.push_back("ShowOverlay"); return {}; }
+    vr::EVROverlayError HideOverlay(vr::VROverlayHandle_t) override { calls.push_back("HideOverlay"); return {}; }
+    bool IsOverlayVisible(vr::VROverlayHandle_t) override { calls.push_back("IsOverlayVisible"); return {}; }
+    vr::EVROverlayError GetTransformForOverlayCoordinates(vr::VROverlayHandle_t, vr::ETrackingUniverseOrigin, vr::HmdVector2_t, vr::HmdMatrix34_t*) override { calls.push_back("GetTransformForOverlayCoordinates"); return {}; }
+    vr::EVROverlayError WaitFrameSync(uint32_t) override { calls.push_back("WaitFrameSync"); return {}; }
+    bool PollNextOverlayEvent(vr::VROverlayHandle_t, vr::VREvent_t*, uint32_t) override { calls.push_back("PollNextOverlayEvent"); return {}; }
+    vr::EVROverlayError GetOverlayInputMethod(vr::VROverlayHandle_t, vr::VROverlayInputMethod*) override { calls.push_back("GetOverlayInputMethod"); return {}; }
+    vr::EVROverlayError SetOverlayInputMethod(vr::VROverlayHandle_t, vr::VROverlayInputMethod) override { calls.push_back("SetOverlayInputMethod"); return {}; }
+    vr::EVROverlayError GetOverlayMouseScale(vr::VROverlayHandle_t, vr::HmdVector2_t*) override { calls.push_back("GetOverlayMouseScale"); return {}; }
+    vr::EVROverlayError SetOverlayMouseScale(vr::VROverlayHandle_t, const vr::HmdVector2_t*) override { calls.push_back("SetOverlayMouseScale"); return {}; }
+    bool ComputeOverlayIntersection(vr::VROverlayHandle_t, const vr::VROverlayIntersectionParams_t*, vr::VROverlayIntersectionResults_t*) override { calls.push_back("ComputeOverlayIntersection"); return {}; }
+    bool IsHoverTargetOverlay(vr::VROverlayHandle_t) override { calls.push_back("IsHoverTargetOverlay"); return {}; }
+    vr::EVROverlayError SetOverlayIntersectionMask(vr::VROverlayHandle_t, vr::VROverlayIntersectionMaskPrimitive_t*, uint32_t, uint32_t) override { calls.push_back("SetOverlayIntersectionMask"); return {}; }
+    vr::EVROverlayError TriggerLaserMouseHapticVibration(vr::VROverlayHandle_t, float, float, float) override { calls.push_back("TriggerLaserMouseHapticVibration"); return {}; }
+    vr::EVROverlayError SetOverlayCursor(vr::VROverlayHandle_t, vr::VROverlayHandle_t) override { calls.push_back("SetOverlayCursor"); return {}; }
+    vr::EVROverlayError SetOverlayCursorPositionOverride(vr::VROverlayHandle_t, const vr::HmdVector2_t*) override { calls.push_back("SetOverlayCursorPositionOverride"); return {}; }
+    vr::EVROverlayError ClearOverlayCursorPositionOverride(vr::VROverlayHandle_t) override { calls.push_back("ClearOverlayCursorPositionOverride"); return {}; }
+    vr::EVROverlayError SetOverlayTexture(vr::VROverlayHandle_t, const vr::Texture_t*) override { calls.push_back("SetOverlayTexture"); return {}; }
+    vr::EVROverlayError ClearOverlayTexture(vr::VROverlayHandle_t) override { calls.push_back("ClearOverlayTexture"); return {}; }
+    vr::EVROverlayError SetOverlayRaw(vr::VROverlayHandle_t, void*, uint32_t, uint32_t, uint32_t) override { calls.push_back("SetOverlayRaw"); return {}; }
+    vr::EVROverlayError SetOverlayFromFile(vr::VROverlayHandle_t, const char*) override { calls.push_back("SetOverlayFromFile"); return {}; }
+    vr::EVROverlayError GetOverlayTexture(vr::VROverlayHandle_t, void**, void*, uint32_t*, uint32_t*, uint32_t*, vr::ETextureType*, vr::EColorSpace*, vr::VRTextureBounds_t*) override { calls.push_back("GetOverlayTexture"); return {}; }
+    vr::EVROverlayError ReleaseNativeOverlayHandle(vr::VROverlayHandle_t, void*) override { calls.push_back("ReleaseNativeOverlayHandle"); return {}; }
+    vr::EVROverlayError GetOverlayTextureSize(vr::VROverlayHandle_t, uint32_t*, uint32_t*) override { calls.push_back("GetOverlayTextureSize"); return {}; }
+    vr::EVROverlayError CreateDashboardOverlay(const char*, const char*, vr::VROverlayHandle_t*, vr::VROverlayHandle_t*) override { calls.push_back("CreateDashboardOverlay"); return {}; }
+    bool IsDashboardVisible() override { calls.push_back("IsDashboardVisible"); return {}; }
+    bool IsActiveDashboardOverlay(vr::VROverlayHandle_t) override { calls.push_back("IsActiveDashboardOverlay"); return {}; }
+    vr::EVROverlayError SetDashboardOverlaySceneProcess(vr::VROverlayHandle_t, uint32_t) override { calls.push_back("SetDashboardOverlaySceneProcess"); return {}; }
+    vr::EVROverlayError GetDashboardOverlaySceneProcess(vr::VROverlayHandle_t, uint32_t*) override { calls.push_back("GetDashboardOverlaySceneProcess"); return {}; }
+    void ShowDashboard(const char*) override { calls.push_back("ShowDashboard"); }
+    vr::TrackedDeviceIndex_t GetPrimaryDashboardDevice() override { calls.push_back("GetPrimaryDashboardDevice"); return {}; }
+    vr::EVROverlayError ShowKeyboard(vr::EGamepadTextInputMode, vr::EGamepadTextInputLineMode, uint32_t, const char*, uint32_t, const char*, uint64_t) override { calls.push_back("ShowKeyboard"); return {}; }
+    vr::EVROverlayError ShowKeyboardForOverlay(vr::VROverlayHandle_t, vr::EGamepadTextInputMode, vr::EGamepadTextInputLineMode, uint32_t, const char*, uint32_t, const char*, uint64_t) override { calls.push_back("ShowKeyboardForOverlay"); return {}; }
+    uint32_t GetKeyboardText(char*, uint32_t) override { calls.push_back("GetKeyboardText"); return {}; }
+    void HideKeyboard() override { calls.push_back("HideKeyboard"); }
+    void SetKeyboardTransformAbsolute(vr::ETrackingUniverseOrigin, const vr::HmdMatrix34_t*) override { calls.push_back("SetKeyboardTransformAbsolute"); }
+    void SetKeyboardPositionForOverlay(vr::VROverlayHandle_t, vr::HmdRect2_t) override { calls.push_back("SetKeyboardPositionForOverlay"); }
+    vr::VRMessageOverlayResponse ShowMessageOverlay(const char*, const char*, const char*, const char*, const char*, const char*) override { calls.push_back("ShowMessageOverlay"); return {}; }
+    void CloseMessageOverlay() override { calls.push_back("CloseMessageOverlay"); }
+};
+}
@@ -0,0 +1,340 @@
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <mods/vr/d3d12/ResourceStateTracker.hpp>
+
+#include "Test.hpp"
+
+using d3d12::ResourceStateTracker;
+
+namespace {
+using State = ResourceStateTracker::State;
+
+// Same values as D3D12_RESOURCE_STATES
+constexpr State RENDER_TARGET = 0x4;
+constexpr State DEPTH_WRITE = 0x10;
+constexpr State DEPTH_READ = 0x20;
+constexpr State NON_PIXEL_SHADER_RESOURCE = 0x40;
+constexpr State PIXEL_SHADER_RESOURCE = 0x80;
+constexpr State COPY_DEST = 0x400;
+constexpr State COPY_SOURCE = 0x800;
+
+// What D3D12Component uses for the engine's textures
+constexpr State ENGINE_SRC_COLOR = NON_PIXEL_SHADER_RESOURCE | PIXEL_SHADER_RESOURCE;
+constexpr State ENGINE_SRC_DEPTH = DEPTH_READ | NON_PIXEL_SHADER_RESOURCE | PIXEL_SHADER_RESOURCE;
+
+// Records every ResourceBarrier call and plays the transitions out on the resources,
+// so a barrier whose before state doesn't match what the resource is actually in gets caught.
+class RecordingCommandList final : public ResourceStateTracker::CommandList {
+public:
+    void resource_barrier(std::span<const ResourceStateTracker::Transition> transitions) override {
+        batches.emplace_back(transitions.begin(), transitions.end());
+
+        for (const auto& t : transitions) {
+            auto& state = states.at(t.resource);
+
+            if (state != t.before) {
+                ++mismatched;
+            }
+
+            state = t.after;
+        }
+    }
+
+    // Anything recorded without a barrier in front of it has to find the resource in the state it needs.
+    void command(const std::string& name, std::initializer_list<std::pair<ID3D12Resource*, State>> needs) {
+        commands.push_back(name);
+
+        for (const auto& [resource, state] : needs) {
+            if (states.at(resource) != state) {
+                ++wrong_state;
+            }
+        }
+    }
+
+    size_t barrier_count() const {
+        size_t count{0};
+
+        for (const auto& batch : batches) {
+            count += batch.size();
+        }
+
+        return count;
+    }
+
+    std::map<ID3D12Resource*, State> states{};
+    std::vector<std::vector<ResourceStateTracker::Transition>> batches{};
+    std::vector<std::string> commands{};
+    uint32_t mismatched{0};
+    uint32_t wrong_state{0};
+};
+
+// Records the same way d3d12::CommandContext does, which needs a real device and queue to exist.
+struct Context {
+    void copy(ID3D12Resource* src, ID3D12Resource* dst, State src_state, State dst_state) {
+        states.transition(src, src_state, COPY_SOURCE);
+        states.transition(dst, dst_state, COPY_DEST);
+        states.flush(cmd_list);
+        cmd_list.command("CopyResource", {{src, COPY_SOURCE}, {dst, COPY_DEST}});
+    }
+
+    void copy_region(ID3D12Resource* src, ID3D12Resource* dst, State src_state, State dst_state) {
+        states.transition(src, src_state, COPY_SOURCE);
+        states.transition(dst, dst_state, COPY_DEST);
+        states.flush(cmd_list);
+        cmd_list.command("CopyTextureRegion", {{src, COPY_SOURCE}, {dst, COPY_DEST}});
+    }
+
+    void clear_rtv(ID3D12Resource* dst, State dst_state) {
+        states.transition(dst, dst_state, RENDER_TARGET);
+        states.flush(cmd_list);
+        cmd_list.command("ClearRenderTargetView", {{dst, RENDER_TARGET}});
+    }
+
+    void transition(ID3D12Resource* resource, State assumed_state, State state) {
+        states.transition(resource, assumed_state, state);
+    }
+
+    void restore_states() {
+        states.restore(cmd_list);
+    }
+
+    void execute() {
+        restore_states();
+        cmd_list.command("Close", {});
+    }
+
+    ResourceStateTracker states{};
+    RecordingCommandList cmd_list{};
+};
+
+// Stand-ins for the textures D3D12Component works with, only the addresses matter.
+struct Resources {
+    std::array<int, 9> storage{};
+
+    ID3D12Resource* get(size_t i) {
+        return reinterpret_cast<ID3D12Resource*>(&storage[i]);
+    }
+
+    ID3D12Resource* backbuffer() { return get(0); }
+    ID3D12Resource* scene_depth() { return get(1); }
+    ID3D12Resource* ui_target() { return get(2); }
+    ID3D12Resource* game_tex() { return get(3); }
+    ID3D12Resource* game_ui_tex() { return get(4); }
+    ID3D12Resource* screen(size_t i) { return get(5 + i); }
+    ID3D12Resource* swapchain_image() { return get(7); }
+    ID3D12Resource* depth_swapchain_image() { return get(8); }
+
+    // Where everything sits when a frame starts
+    void seed(RecordingCommandList& cmd_list) {
+        cmd_list.states = {
+            {backbuffer(), RENDER_TARGET},
+            {scene_depth(), ENGINE_SRC_DEPTH},
+            {ui_target(), ENGINE_SRC_COLOR},
+            {game_tex(), RENDER_TARGET},
+            {game_ui_tex(), ENGINE_SRC_COLOR},
+            {screen(0), ENGINE_SRC_COLOR},
+            {screen(1), ENGINE_SRC_COLOR},
+            {swapchain_image(), RENDER_TARGET},
+            {depth_swapchain_image(), DEPTH_WRITE},
+        };
+    }
+
+    // Everything has to be back where it started once the command list is closed
+    uint32_t count_moved(const RecordingCommandList& cmd_list) {
+        RecordingCommandList initial{};
+        seed(initial);
+
+        uint32_t moved{0};
+
+        for (const auto& [resource, state] : cmd_list.states) {
+            if (initial.states.at(resource) != state) {
+                ++moved;
+            }
+        }
+
+        return moved;
+    }
+};
+
+void check_consistent(Resources& resources, const RecordingCommandList& cmd_list) {
+    CHECK(cmd_list.mismatched == 0);
+    CHECK(cmd_list.wrong_state == 0);
+    CHECK(resources.count_moved(cmd_list) == 0);
+}
+
+// The clear_rt lambda
+void clear_ui(Context& ctx, Resources& resources) {
+    ctx.clear_rtv(resources.game_ui_tex(), ENGINE_SRC_COLOR);
+}
+
+// The draw_2d_view lambda with the 2D screen on
+void draw_2d_screens(Context& ctx, Resources& resources) {
+    ctx.restore_states();
+    ctx.cmd_list.command("draw_spectator_view", {});
+
+    for (auto i = 0; i < 2; ++i) {
+        ctx.transition(resources.screen(i), ENGINE_SRC_COLOR, RENDER_TARGET);
+    }
+
+    for (auto i = 0; i < 2; ++i) {
+        ctx.clear_rtv(resources.screen(i), ENGINE_SRC_COLOR);
+    }
+
+    ctx.restore_states();
+
+    // render_srv_to_rtv goes around the tracker, the screens have to be back in ENGINE_SRC_COLOR for it
+    for (auto i = 0; i < 2; ++i) {
+        ctx.cmd_list.command("render_srv_to_rtv", {{resources.screen(i), ENGINE_SRC_COLOR}});
+    }
+
+    ctx.clear_rtv(resources.game_tex(), RENDER_TARGET);
+}
+}
+
+TEST(resource_state_tracker_double_wide_eye_copy) {
+    Resources resources{};
+
+    // OpenXR::copy into the DOUBLE_WIDE swapchain, then the DEPTH one, each its own command list
+    Context color{};
+    resources.seed(color.cmd_list);
+    color.copy(resources.backbuffer(), resources.swapchain_image(), RENDER_TARGET, RENDER_TARGET);
+    color.execute();
+
+    Context depth{};
+    resources.seed(depth.cmd_list);
+    depth.copy(resources.scene_depth(), resources.depth_swapchain_image(), ENGINE_SRC_DEPTH, DEPTH_WRITE);
+    depth.execute();
+
+    for (auto* ctx : {&color, &depth}) {
+        check_consistent(resources, ctx->cmd_list);
+
+        // In for the copy, back out on execute, both resources in each
+        CHECK(ctx->cmd_list.batches.size() == 2);
+        CHECK(ctx->cmd_list.barrier_count() == 4);
+        CHECK(ctx->states.get_stats().batches == 2);
+        CHECK(ctx->states.get_stats().emitted == 4);
+    }
+
+    CHECK((color.cmd_list.commands == std::vector<std::string>{"CopyResource", "Close"}));
+}
+
+TEST(resource_state_tracker_afr_eye_copies) {
+    Resources resources{};
+
+    // Each AFR frame copies the whole backbuffer region into that eye's swapchain, plus depth.
+    // Two frames, one per eye, the same command list gets reused after a reset.
+    Context color{};
+    Context depth{};
+
+    for (auto eye = 0; eye < 2; ++eye) {
+        for (auto* ctx : {&color, &depth}) {
+            ctx->states.reset();
+            ctx->cmd_list = RecordingCommandList{};
+            resources.seed(ctx->cmd_list);
+        }
+
+        color.copy_region(resources.backbuffer(), resources.swapchain_image(), RENDER_TARGET, RENDER_TARGET);
+        color.execute();
+
+        depth.copy(resources.scene_depth(), resources.depth_swapchain_image(), ENGINE_SRC_DEPTH, DEPTH_WRITE);
+        depth.execute();
+
+        for (auto* ctx : {&color, &depth}) {
+            check_consistent(resources, ctx->cmd_list);
+            CHECK(ctx->cmd_list.batches.size() == 2);
+            CHECK(ctx->cmd_list.barrier_count() == 4);
+        }
+
+        CHECK((color.cmd_list.commands == std::vector<std::string>{"CopyTextureRegion", "Close"}));
+    }
+
+    CHECK(color.states.get_stats().batches == 4);
+    CHECK(color.states.get_stats().emitted == 8);
+}
+
+TEST(resource_state_tracker_ui_copy_and_clear) {
+    Resources resources{};
+
+    // OpenXR::copy into the UI swapchain from the UI render target, draw_2d_view has nothing to do
+    // without the 2D screen, then clear_rt clears the UI texture for the next frame
+    Context ctx{};
+    resources.seed(ctx.cmd_list);
+
+    ctx.restore_states();
+    ctx.cmd_list.command("draw_spectator_view", {});
+    ctx.copy(resources.ui_target(), resources.swapchain_image(), ENGINE_SRC_COLOR, RENDER_TARGET);
+    clear_ui(ctx, resources);
+    ctx.execute();
+
+    check_consistent(resources, ctx.cmd_list);
+
+    // copy in, clear in, and everything back out together. Round tripping each command
+    // on its own would be 4 calls with 8 barriers.
+    CHECK(ctx.cmd_list.batches.size() == 3);
+    CHECK(ctx.cmd_list.batches[0].size() == 2);
+    CHECK(ctx.cmd_list.batches[1].size() == 1);
+    CHECK(ctx.cmd_list.batches[2].size() == 3);
+    CHECK(ctx.cmd_list.barrier_count() == 6);
+}
+
+TEST(resource_state_tracker_ui_2d_screens) {
+    Resources resources{};
+
+    // The non-AFR 2D screen path, the left screen goes to UI with draw_2d_view in front of it,
+    // the right screen to UI_RIGHT with clear_rt after it.
+    Context left{};
+    resources.seed(left.cmd_list);
+    draw_2d_screens(left, resources);
+    left.copy(resources.screen(0), resources.swapchain_image(), ENGINE_SRC_COLOR, RENDER_TARGET);
+    left.execute();
+
+    check_consistent(resources, left.cmd_list);
+
+    // Both screens go to RENDER_TARGET in one call and come back in one before the blits,
+    // clearing the game texture needs nothing since it already is a render target.
+    CHECK(left.cmd_list.batches.size() == 4);
+    CHECK(left.cmd_list.batches[0].size() == 2);
+    CHECK(left.cmd_list.batches[1].size() == 2);
+    CHECK(left.cmd_list.barrier_count() == 8);
+    CHECK(left.states.get_stats().requested == 7);
+
+    Context right{};
+    resources.seed(right.cmd_list);
+    right.copy(resources.screen(1), resources.swapchain_image(), ENGINE_SRC_COLOR, RENDER_TARGET);
+    clear_ui(right, resources);
+    right.execute();
+
+    check_consistent(resources, right.cmd_list);
+    CHECK(right.cmd_list.batches.size() == 3);
+    CHECK(right.cmd_list.barrier_count() == 6);
+}
+
+TEST(resource_state_tracker_folds_repeated_transitions) {
+    Resources resources{};
+    Context ctx{};
+    resources.seed(ctx.cmd_list);
+
+    // Clearing the same texture over and over only needs it moved once
+    for (auto i = 0; i < 8; ++i) {
+        ctx.clear_rtv(resources.game_ui_tex(), ENGINE_SRC_COLOR);
+    }
+
+    // And going somewhere and straight back before anything is recorded needs nothing
+    ctx.transition(resources.ui_target(), ENGINE_SRC_COLOR, COPY_SOURCE);
+    ctx.transition(resources.ui_target(), ENGINE_SRC_COLOR, ENGINE_SRC_COLOR);
+    ctx.execute();
+
+    check_consistent(resources, ctx.cmd_list);
+    CHECK(ctx.cmd_list.batches.size() == 2);
+    CHECK(ctx.cmd_list.barrier_count() == 2);
+    CHECK(ctx.states.empty());
+
+    // Nothing tracked, nothing recorded
+    const auto batches = ctx.states.get_stats().batches;
+    ctx.restore_states();
+    CHECK(ctx.states.get_stats().batches == batches);
+}
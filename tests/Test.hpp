@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+// Just enough of a test harness for the parts of the backend that don't need a game or a runtime.
+// Each TEST registers itself, Main.cpp runs all of them and returns non-zero if any check failed.
+namespace test {
+struct Case {
+    std::string_view name{};
+    std::function<void()> fn{};
+};
+
+inline std::vector<Case>& get_cases() {
+    static std::vector<Case> cases{};
+    return cases;
+}
+
+inline int& get_failures() {
+    static int failures{0};
+    return failures;
+}
+
+struct Registrar {
+    Registrar(std::string_view name, std::function<void()> fn) {
+        get_cases().push_back(Case{name, std::move(fn)});
+    }
+};
+
+// Every operator new in the process, Main.cpp replaces the global one to count them.
+size_t get_allocations();
+
+inline void fail(const char* file, int line, const char* expr) {
+    std::printf("  %s(%d): CHECK(%s) failed\n", file, line, expr);
+    ++get_failures();
+}
+}
+
+#define TEST_CONCAT_IMPL(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_IMPL(a, b)
+
+#define TEST(name) \
+    static void TEST_CONCAT(test_, name)(); \
+    static ::test::Registrar TEST_CONCAT(test_registrar_, name){#name, &TEST_CONCAT(test_, name)}; \
+    static void TEST_CONCAT(test_, name)()
+
+#define CHECK(expr) \
+    do { \
+        if (!(expr)) { \
+            ::test::fail(__FILE__, __LINE__, #expr); \
+        } \
+    } while (false)
+
+#define CHECK_NEAR(a, b, eps) CHECK(std::abs((double)(a) - (double)(b)) <= (double)(eps))
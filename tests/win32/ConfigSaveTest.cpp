@@ -0,0 +1,173 @@
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <ConfigSync.hpp>
+#include <ConfigWriter.hpp>
+
+#include "Test.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+// Loads and saves the way ModValue does, counting how often it actually serializes itself.
+struct FakeValue {
+    std::string name{};
+    int value{0};
+    ConfigSync<int> sync{};
+
+    static inline uint32_t writes{0};
+
+    void load(const utility::Config& cfg) {
+        if (const auto v = cfg.get<int>(name); v) {
+            value = *v;
+            sync.mark(&cfg, value);
+            return;
+        }
+
+        sync.mark(nullptr, value);
+    }
+
+    void save(utility::Config& cfg) {
+        if (!sync.needs_save(cfg, value)) {
+            return;
+        }
+
+        cfg.set<int>(name, value);
+        sync.mark(&cfg, value);
+        ++writes;
+    }
+};
+
+std::vector<FakeValue> make_values(size_t count) {
+    std::vector<FakeValue> values(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        values[i].name = "Value_" + std::to_string(i);
+    }
+
+    return values;
+}
+
+uint32_t save_all(std::vector<FakeValue>& values, utility::Config& cfg) {
+    const auto before = FakeValue::writes;
+
+    for (auto& value : values) {
+        value.save(cfg);
+    }
+
+    return FakeValue::writes - before;
+}
+
+fs::path get_test_dir(const char* name) {
+    const auto dir = fs::temp_directory_path() / "uevr-tests" / name;
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    return dir;
+}
+}
+
+TEST(config_sync_only_saves_what_changed) {
+    utility::Config cfg{};
+    auto values = make_values(50);
+
+    // Nothing in the config yet, everything has to go in once
+    for (auto& value : values) {
+        value.load(cfg);
+    }
+
+    CHECK(save_all(values, cfg) == 50);
+    CHECK(save_all(values, cfg) == 0);
+
+    values[7].value = 3;
+    CHECK(save_all(values, cfg) == 1);
+    CHECK(cfg.get<int>("Value_7") == 3);
+
+    // Changed and changed back before the save, the config already has it
+    values[7].value = 4;
+    values[7].value = 3;
+    CHECK(save_all(values, cfg) == 0);
+
+    // Loaded from the config it's saved into, nothing to do until something changes
+    utility::Config reloaded{};
+    cfg.set<int>("Value_7", 5);
+
+    for (auto& value : values) {
+        value.load(cfg);
+    }
+
+    CHECK(values[7].value == 5);
+    CHECK(save_all(values, cfg) == 0);
+
+    // A different config doesn't have any of it
+    CHECK(save_all(values, reloaded) == 50);
+}
+
+TEST(config_writer_coalesces_writes) {
+    const auto dir = get_test_dir("config_writer_coalesces_writes");
+    const auto path = dir / "config.txt";
+
+    std::atomic<uint32_t> callbacks{0};
+    ConfigWriter writer{path, [&]() { ++callbacks; }};
+
+    CHECK(writer.is_idle());
+
+    utility::Config cfg{};
+
+    for (auto i = 0; i < 100; ++i) {
+        cfg.set<int>("Frame", i);
+        writer.write(cfg);
+    }
+
+    writer.flush();
+    CHECK(writer.is_idle());
+
+    const auto stats = writer.get_stats();
+    CHECK(stats.requested == 100);
+    CHECK(stats.failed == 0);
+    CHECK(stats.written >= 1);
+    CHECK(stats.written + stats.coalesced == 100); // every one either written or replaced by a newer one
+    CHECK(callbacks == stats.written);
+
+    // Only the newest one matters
+    const utility::Config on_disk{path.string()};
+    CHECK(on_disk.get<int>("Frame") == 99);
+
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    CHECK(!fs::exists(tmp_path));
+}
+
+TEST(config_writer_drains_on_destruction) {
+    const auto dir = get_test_dir("config_writer_drains_on_destruction");
+    const auto path = dir / "config.txt";
+
+    {
+        ConfigWriter writer{path};
+
+        utility::Config cfg{};
+        cfg.set<int>("Value", 1);
+        writer.write(cfg);
+        cfg.set<int>("Value", 2);
+        writer.write(cfg);
+    }
+
+    const utility::Config on_disk{path.string()};
+    CHECK(on_disk.get<int>("Value") == 2);
+}
+
+TEST(config_writer_never_starts_without_a_write) {
+    const auto dir = get_test_dir("config_writer_never_starts_without_a_write");
+    const auto path = dir / "config.txt";
+
+    {
+        ConfigWriter writer{path};
+        writer.flush();
+        CHECK(writer.get_stats().requested == 0);
+    }
+
+    CHECK(!fs::exists(path));
+}
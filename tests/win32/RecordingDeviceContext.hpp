@@ -0,0 +1,296 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include <d3d11.h>
+
+namespace test {
+// An immediate context that doesn't draw anything, it only remembers which state calls were made and in what order.
+// Gets hand back what a freshly created context would: no objects bound, one viewport and scissor rect so there's
+// something to check restore() puts back. Everything else is a no-op.
+class RecordingDeviceContext final : public ID3D11DeviceContext {
+public:
+    static constexpr D3D11_VIEWPORT VIEWPORT{0.0f, 0.0f, 1920.0f, 1080.0f, 0.0f, 1.0f};
+    static constexpr D3D11_RECT SCISSOR_RECT{0, 0, 1920, 1080};
+
+    std::vector<std::string_view> calls{};
+    std::vector<D3D11_VIEWPORT> set_viewports{};
+    std::vector<D3D11_RECT> set_scissor_rects{};
+    ULONG refs{1};
+
+    size_t count(std::string_view name) const {
+        size_t n{0};
+
+        for (const auto& call : calls) {
+            n += call == name ? 1 : 0;
+        }
+
+        return n;
+    }
+
+    // "Get" or "Set", in the order they were made
+    std::vector<std::string_view> get_calls(std::string_view kind) const {
+        std::vector<std::string_view> result{};
+
+        for (const auto& call : calls) {
+            if (call.substr(2, 3) == kind) {
+                result.push_back(call);
+            }
+        }
+
+        return result;
+    }
+
+    void clear_calls() {
+        calls.clear();
+        set_viewports.clear();
+        set_scissor_rects.clear();
+    }
+
+    // IUnknown
+    HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** out) override {
+        if (out == nullptr) {
+            return E_POINTER;
+        }
+
+        if (riid == __uuidof(IUnknown) || riid == __uuidof(ID3D11DeviceChild) || riid == __uuidof(ID3D11DeviceContext)) {
+            AddRef();
+            *out = this;
+            return S_OK;
+        }
+
+        *out = nullptr;
+        return E_NOINTERFACE;
+    }
+
+    ULONG STDMETHODCALLTYPE AddRef() override { return ++refs; }
+    ULONG STDMETHODCALLTYPE Release() override { return --refs; } // lives on the stack
+
+    // ID3D11DeviceChild
+    void STDMETHODCALLTYPE GetDevice(ID3D11Device** device) override { *device = nullptr; }
+    HRESULT STDMETHODCALLTYPE GetPrivateData(REFGUID, UINT*, void*) override { return DXGI_ERROR_NOT_FOUND; }
+    HRESULT STDMETHODCALLTYPE SetPrivateData(REFGUID, UINT, const void*) override { return E_NOTIMPL; }
+    HRESULT STDMETHODCALLTYPE SetPrivateDataInterface(REFGUID, const IUnknown*) override { return E_NOTIMPL; }
+
+    // State StateBackup touches, recorded
+    void STDMETHODCALLTYPE RSGetScissorRects(UINT* count, D3D11_RECT* rects) override {
+        calls.push_back("RSGetScissorRects");
+
+        if (rects != nullptr && *count > 0) {
+            rects[0] = SCISSOR_RECT;
+        }
+
+        *count = 1;
+    }
+
+    void STDMETHODCALLTYPE RSGetViewports(UINT* count, D3D11_VIEWPORT* viewports) override {
+        calls.push_back("RSGetViewports");
+
+        if (viewports != nullptr && *count > 0) {
+            viewports[0] = VIEWPORT;
+        }
+
+        *count = 1;
+    }
+
+    void STDMETHODCALLTYPE RSSetScissorRects(UINT count, const D3D11_RECT* rects) override {
+        calls.push_back("RSSetScissorRects");
+        set_scissor_rects.assign(rects, rects + count);
+    }
+
+    void STDMETHODCALLTYPE RSSetViewports(UINT count, const D3D11_VIEWPORT* viewports) override {
+        calls.push_back("RSSetViewports");
+        set_viewports.assign(viewports, viewports + count);
+    }
+
+    void STDMETHODCALLTYPE RSGetState(ID3D11RasterizerState** state) override { calls.push_back("RSGetState"); *state = nullptr; }
+    void STDMETHODCALLTYPE RSSetState(ID3D11RasterizerState*) override { calls.push_back("RSSetState"); }
+
+    void STDMETHODCALLTYPE OMGetBlendState(ID3D11BlendState** state, FLOAT factor[4], UINT* mask) override {
+        calls.push_back("OMGetBlendState");
+        *state = nullptr;
+
+        for (auto i = 0; i < 4; ++i) {
+            factor[i] = 1.0f;
+        }
+
+        *mask = 0xffffffff;
+    }
+
+    void STDMETHODCALLTYPE OMSetBlendState(ID3D11BlendState*, const FLOAT[4], UINT) override { calls.push_back("OMSetBlendState"); }
+
+    void STDMETHODCALLTYPE OMGetDepthStencilState(ID3D11DepthStencilState** state, UINT* ref) override {
+        calls.push_back("OMGetDepthStencilState");
+        *state = nullptr;
+        *ref = 0;
+    }
+
+    void STDMETHODCALLTYPE OMSetDepthStencilState(ID3D11DepthStencilState*, UINT) override { calls.push_back("OMSetDepthStencilState"); }
+
+    void STDMETHODCALLTYPE OMGetRenderTargets(UINT count, ID3D11RenderTargetView** rtvs, ID3D11DepthStencilView** dsv) override {
+        calls.push_back("OMGetRenderTargets");
+
+        for (UINT i = 0; rtvs != nullptr && i < count; ++i) {
+            rtvs[i] = nullptr;
+        }
+
+        if (dsv != nullptr) {
+            *dsv = nullptr;
+        }
+    }
+
+    void STDMETHODCALLTYPE OMSetRenderTargets(UINT, ID3D11RenderTargetView* const*, ID3D11DepthStencilView*) override { calls.push_back("OMSetRenderTargets"); }
+
+    void STDMETHODCALLTYPE PSGetShader(ID3D11PixelShader** shader, ID3D11ClassInstance**, UINT* count) override { calls.push_back("PSGetShader"); *shader = nullptr; *count = 0; }
+    void STDMETHODCALLTYPE PSGetShaderResources(UINT, UINT count, ID3D11ShaderResourceView** views) override { calls.push_back("PSGetShaderResources"); clear(views, count); }
+    void STDMETHODCALLTYPE PSGetSamplers(UINT, UINT count, ID3D11SamplerState** samplers) override { calls.push_back("PSGetSamplers"); clear(samplers, count); }
+    void STDMETHODCALLTYPE PSGetConstantBuffers(UINT, UINT count, ID3D11Buffer** buffers) override { calls.push_back("PSGetConstantBuffers"); clear(buffers, count); }
+    void STDMETHODCALLTYPE PSSetShader(ID3D11PixelShader*, ID3D11ClassInstance* const*, UINT) override { calls.push_back("PSSetShader"); }
+    void STDMETHODCALLTYPE PSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override { calls.push_back("PSSetShaderResources"); }
+    void STDMETHODCALLTYPE PSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override { calls.push_back("PSSetSamplers"); }
+    void STDMETHODCALLTYPE PSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override { calls.push_back("PSSetConstantBuffers"); }
+
+    void STDMETHODCALLTYPE VSGetShader(ID3D11VertexShader** shader, ID3D11ClassInstance**, UINT* count) override { calls.push_back("VSGetShader"); *shader = nullptr; *count = 0; }
+    void STDMETHODCALLTYPE VSGetConstantBuffers(UINT, UINT count, ID3D11Buffer** buffers) override { calls.push_back("VSGetConstantBuffers"); clear(buffers, count); }
+    void STDMETHODCALLTYPE VSSetShader(ID3D11VertexShader*, ID3D11ClassInstance* const*, UINT) override { calls.push_back("VSSetShader"); }
+    void STDMETHODCALLTYPE VSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override { calls.push_back("VSSetConstantBuffers"); }
+
+    void STDMETHODCALLTYPE GSGetShader(ID3D11GeometryShader** shader, ID3D11ClassInstance**, UINT* count) override { calls.push_back("GSGetShader"); *shader = nullptr; *count = 0; }
+    void STDMETHODCALLTYPE HSGetShader(ID3D11HullShader** shader, ID3D11ClassInstance**, UINT* count) override { calls.push_back("HSGetShader"); *shader = nullptr; *count = 0; }
+    void STDMETHODCALLTYPE DSGetShader(ID3D11DomainShader** shader, ID3D11ClassInstance**, UINT* count) override { calls.push_back("DSGetShader"); *shader = nullptr; *count = 0; }
+    void STDMETHODCALLTYPE CSGetShader(ID3D11ComputeShader** shader, ID3D11ClassInstance**, UINT* count) override { calls.push_back("CSGetShader"); *shader = nullptr; *count = 0; }
+    void STDMETHODCALLTYPE GSSetShader(ID3D11GeometryShader*, ID3D11ClassInstance* const*, UINT) override { calls.push_back("GSSetShader"); }
+    void STDMETHODCALLTYPE HSSetShader(ID3D11HullShader*, ID3D11ClassInstance* const*, UINT) override { calls.push_back("HSSetShader"); }
+    void STDMETHODCALLTYPE DSSetShader(ID3D11DomainShader*, ID3D11ClassInstance* const*, UINT) override { calls.push_back("DSSetShader"); }
+    void STDMETHODCALLTYPE CSSetShader(ID3D11ComputeShader*, ID3D11ClassInstance* const*, UINT) override { calls.push_back("CSSetShader"); }
+
+    void STDMETHODCALLTYPE IAGetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY* topology) override { calls.push_back("IAGetPrimitiveTopology"); *topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED; }
+    void STDMETHODCALLTYPE IAGetInputLayout(ID3D11InputLayout** layout) override { calls.push_back("IAGetInputLayout"); *layout = nullptr; }
+
+    void STDMETHODCALLTYPE IAGetIndexBuffer(ID3D11Buffer** buffer, DXGI_FORMAT* format, UINT* offset) override {
+        calls.push_back("IAGetIndexBuffer");
+        *buffer = nullptr;
+        *format = DXGI_FORMAT_UNKNOWN;
+        *offset = 0;
+    }
+
+    void STDMETHODCALLTYPE IAGetVertexBuffers(UINT, UINT count, ID3D11Buffer** buffers, UINT* strides, UINT* offsets) override {
+        calls.push_back("IAGetVertexBuffers");
+        clear(buffers, count);
+
+        for (UINT i = 0; i < count; ++i) {
+            strides[i] = offsets[i] = 0;
+        }
+    }
+
+    void STDMETHODCALLTYPE IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY) override { calls.push_back("IASetPrimitiveTopology"); }
+    void STDMETHODCALLTYPE IASetInputLayout(ID3D11InputLayout*) override { calls.push_back("IASetInputLayout"); }
+    void STDMETHODCALLTYPE IASetIndexBuffer(ID3D11Buffer*, DXGI_FORMAT, UINT) override { calls.push_back("IASetIndexBuffer"); }
+    void STDMETHODCALLTYPE IASetVertexBuffers(UINT, UINT, ID3D11Buffer* const*, const UINT*, const UINT*) override { calls.push_back("IASetVertexBuffers"); }
+
+    // Everything else
+    void STDMETHODCALLTYPE VSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override {}
+    void STDMETHODCALLTYPE VSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override {}
+    void STDMETHODCALLTYPE VSGetShaderResources(UINT, UINT count, ID3D11ShaderResourceView** views) override { clear(views, count); }
+    void STDMETHODCALLTYPE VSGetSamplers(UINT, UINT count, ID3D11SamplerState** samplers) override { clear(samplers, count); }
+
+    void STDMETHODCALLTYPE GSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override {}
+    void STDMETHODCALLTYPE GSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override {}
+    void STDMETHODCALLTYPE GSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override {}
+    void STDMETHODCALLTYPE GSGetConstantBuffers(UINT, UINT count, ID3D11Buffer** buffers) override { clear(buffers, count); }
+    void STDMETHODCALLTYPE GSGetShaderResources(UINT, UINT count, ID3D11ShaderResourceView** views) override { clear(views, count); }
+    void STDMETHODCALLTYPE GSGetSamplers(UINT, UINT count, ID3D11SamplerState** samplers) override { clear(samplers, count); }
+
+    void STDMETHODCALLTYPE HSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override {}
+    void STDMETHODCALLTYPE HSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override {}
+    void STDMETHODCALLTYPE HSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override {}
+    void STDMETHODCALLTYPE HSGetShaderResources(UINT, UINT count, ID3D11ShaderResourceView** views) override { clear(views, count); }
+    void STDMETHODCALLTYPE HSGetSamplers(UINT, UINT count, ID3D11SamplerState** samplers) override { clear(samplers, count); }
+    void STDMETHODCALLTYPE HSGetConstantBuffers(UINT, UINT count, ID3D11Buffer** buffers) override { clear(buffers, count); }
+
+    void STDMETHODCALLTYPE DSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override {}
+    void STDMETHODCALLTYPE DSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override {}
+    void STDMETHODCALLTYPE DSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override {}
+    void STDMETHODCALLTYPE DSGetShaderResources(UINT, UINT count, ID3D11ShaderResourceView** views) override { clear(views, count); }
+    void STDMETHODCALLTYPE DSGetSamplers(UINT, UINT count, ID3D11SamplerState** samplers) override { clear(samplers, count); }
+    void STDMETHODCALLTYPE DSGetConstantBuffers(UINT, UINT count, ID3D11Buffer** buffers) override { clear(buffers, count); }
+
+    void STDMETHODCALLTYPE CSSetShaderResources(UINT, UINT, ID3D11ShaderResourceView* const*) override {}
+    void STDMETHODCALLTYPE CSSetUnorderedAccessViews(UINT, UINT, ID3D11UnorderedAccessView* const*, const UINT*) override {}
+    void STDMETHODCALLTYPE CSSetSamplers(UINT, UINT, ID3D11SamplerState* const*) override {}
+    void STDMETHODCALLTYPE CSSetConstantBuffers(UINT, UINT, ID3D11Buffer* const*) override {}
+    void STDMETHODCALLTYPE CSGetShaderResources(UINT, UINT count, ID3D11ShaderResourceView** views) override { clear(views, count); }
+    void STDMETHODCALLTYPE CSGetUnorderedAccessViews(UINT, UINT count, ID3D11UnorderedAccessView** views) override { clear(views, count); }
+    void STDMETHODCALLTYPE CSGetSamplers(UINT, UINT count, ID3D11SamplerState** samplers) override { clear(samplers, count); }
+    void STDMETHODCALLTYPE CSGetConstantBuffers(UINT, UINT count, ID3D11Buffer** buffers) override { clear(buffers, count); }
+
+    void STDMETHODCALLTYPE OMSetRenderTargetsAndUnorderedAccessViews(UINT, ID3D11RenderTargetView* const*, ID3D11DepthStencilView*, UINT, UINT, ID3D11UnorderedAccessView* const*, const UINT*) override {}
+    void STDMETHODCALLTYPE OMGetRenderTargetsAndUnorderedAccessViews(UINT num_rtvs, ID3D11RenderTargetView** rtvs, ID3D11DepthStencilView** dsv, UINT, UINT num_uavs, ID3D11UnorderedAccessView** uavs) override {
+        clear(rtvs, num_rtvs);
+        clear(uavs, num_uavs);
+
+        if (dsv != nullptr) {
+            *dsv = nullptr;
+        }
+    }
+
+    void STDMETHODCALLTYPE SOSetTargets(UINT, ID3D11Buffer* const*, const UINT*) override {}
+    void STDMETHODCALLTYPE SOGetTargets(UINT count, ID3D11Buffer** buffers) override { clear(buffers, count); }
+
+    void STDMETHODCALLTYPE SetPredication(ID3D11Predicate*, BOOL) override {}
+    void STDMETHODCALLTYPE GetPredication(ID3D11Predicate** predicate, BOOL* value) override {
+        if (predicate != nullptr) {
+            *predicate = nullptr;
+        }
+
+        if (value != nullptr) {
+            *value = FALSE;
+        }
+    }
+
+    void STDMETHODCALLTYPE DrawIndexed(UINT, UINT, INT) override {}
+    void STDMETHODCALLTYPE Draw(UINT, UINT) override {}
+    void STDMETHODCALLTYPE DrawIndexedInstanced(UINT, UINT, UINT, INT, UINT) override {}
+    void STDMETHODCALLTYPE DrawInstanced(UINT, UINT, UINT, UINT) override {}
+    void STDMETHODCALLTYPE DrawAuto() override {}
+    void STDMETHODCALLTYPE DrawIndexedInstancedIndirect(ID3D11Buffer*, UINT) override {}
+    void STDMETHODCALLTYPE DrawInstancedIndirect(ID3D11Buffer*, UINT) override {}
+    void STDMETHODCALLTYPE Dispatch(UINT, UINT, UINT) override {}
+    void STDMETHODCALLTYPE DispatchIndirect(ID3D11Buffer*, UINT) override {}
+
+    HRESULT STDMETHODCALLTYPE Map(ID3D11Resource*, UINT, D3D11_MAP, UINT, D3D11_MAPPED_SUBRESOURCE*) override { return E_NOTIMPL; }
+    void STDMETHODCALLTYPE Unmap(ID3D11Resource*, UINT) override {}
+    void STDMETHODCALLTYPE Begin(ID3D11Asynchronous*) override {}
+    void STDMETHODCALLTYPE End(ID3D11Asynchronous*) override {}
+    HRESULT STDMETHODCALLTYPE GetData(ID3D11Asynchronous*, void*, UINT, UINT) override { return E_NOTIMPL; }
+
+    void STDMETHODCALLTYPE CopySubresourceRegion(ID3D11Resource*, UINT, UINT, UINT, UINT, ID3D11Resource*, UINT, const D3D11_BOX*) override {}
+    void STDMETHODCALLTYPE CopyResource(ID3D11Resource*, ID3D11Resource*) override {}
+    void STDMETHODCALLTYPE UpdateSubresource(ID3D11Resource*, UINT, const D3D11_BOX*, const void*, UINT, UINT) override {}
+    void STDMETHODCALLTYPE CopyStructureCount(ID3D11Buffer*, UINT, ID3D11UnorderedAccessView*) override {}
+    void STDMETHODCALLTYPE ClearRenderTargetView(ID3D11RenderTargetView*, const FLOAT[4]) override {}
+    void STDMETHODCALLTYPE ClearUnorderedAccessViewUint(ID3D11UnorderedAccessView*, const UINT[4]) override {}
+    void STDMETHODCALLTYPE ClearUnorderedAccessViewFloat(ID3D11UnorderedAccessView*, const FLOAT[4]) override {}
+    void STDMETHODCALLTYPE ClearDepthStencilView(ID3D11DepthStencilView*, UINT, FLOAT, UINT8) override {}
+    void STDMETHODCALLTYPE GenerateMips(ID3D11ShaderResourceView*) override {}
+    void STDMETHODCALLTYPE SetResourceMinLOD(ID3D11Resource*, FLOAT) override {}
+    FLOAT STDMETHODCALLTYPE GetResourceMinLOD(ID3D11Resource*) override { return 0.0f; }
+    void STDMETHODCALLTYPE ResolveSubresource(ID3D11Resource*, UINT, ID3D11Resource*, UINT, DXGI_FORMAT) override {}
+    void STDMETHODCALLTYPE ExecuteCommandList(ID3D11CommandList*, BOOL) override {}
+
+    void STDMETHODCALLTYPE ClearState() override {}
+    void STDMETHODCALLTYPE Flush() override {}
+    D3D11_DEVICE_CONTEXT_TYPE STDMETHODCALLTYPE GetType() override { return D3D11_DEVICE_CONTEXT_IMMEDIATE; }
+    UINT STDMETHODCALLTYPE GetContextFlags() override { return 0; }
+    HRESULT STDMETHODCALLTYPE FinishCommandList(BOOL, ID3D11CommandList** list) override { *list = nullptr; return DXGI_ERROR_INVALID_CALL; }
+
+private:
+    template <typename T>
+    static void clear(T** objects, UINT count) {
+        for (UINT i = 0; objects != nullptr && i < count; ++i) {
+            objects[i] = nullptr;
+        }
+    }
+};
+}
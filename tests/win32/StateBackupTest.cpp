@@ -0,0 +1,153 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <mods/vr/d3d11/StateBackup.hpp>
+
+#include "RecordingDeviceContext.hpp"
+#include "Test.hpp"
+
+using d3d11::StateBackup;
+using test::RecordingDeviceContext;
+
+namespace {
+using Calls = std::vector<std::string_view>;
+
+// What capture(ALL) should ask the context for, group by group
+const Calls ALL_GETS{
+    "RSGetScissorRects", "RSGetViewports",
+    "RSGetState",
+    "OMGetBlendState",
+    "OMGetDepthStencilState",
+    "OMGetRenderTargets",
+    "PSGetShader", "PSGetShaderResources", "PSGetSamplers", "PSGetConstantBuffers",
+    "VSGetShader", "VSGetConstantBuffers",
+    "GSGetShader", "HSGetShader", "DSGetShader", "CSGetShader",
+    "IAGetPrimitiveTopology", "IAGetInputLayout", "IAGetIndexBuffer", "IAGetVertexBuffers",
+};
+
+// And what restore() should put back, in the same order
+const Calls ALL_SETS{
+    "RSSetScissorRects", "RSSetViewports",
+    "RSSetState",
+    "OMSetBlendState",
+    "OMSetDepthStencilState",
+    "OMSetRenderTargets",
+    "PSSetShader", "PSSetShaderResources", "PSSetSamplers", "PSSetConstantBuffers",
+    "VSSetShader", "VSSetConstantBuffers",
+    "GSSetShader", "HSSetShader", "DSSetShader", "CSSetShader",
+    "IASetPrimitiveTopology", "IASetInputLayout", "IASetIndexBuffer", "IASetVertexBuffers",
+};
+}
+
+TEST(state_backup_captures_and_restores_everything_in_order) {
+    RecordingDeviceContext context{};
+
+    {
+        StateBackup backup{&context};
+
+        backup.capture(StateBackup::ALL);
+        CHECK(context.get_calls("Get") == ALL_GETS);
+        CHECK(context.get_calls("Set").empty());
+
+        context.clear_calls();
+        backup.restore();
+        CHECK(context.get_calls("Set") == ALL_SETS);
+        CHECK(context.get_calls("Get").empty());
+
+        // Same viewport and scissor rect the context had, not the whole array
+        CHECK(context.set_viewports.size() == 1);
+        CHECK(context.set_viewports[0].Width == RecordingDeviceContext::VIEWPORT.Width);
+        CHECK(context.set_scissor_rects.size() == 1);
+        CHECK(context.set_scissor_rects[0].bottom == RecordingDeviceContext::SCISSOR_RECT.bottom);
+
+        // Nothing left to put back when it goes away
+        context.clear_calls();
+    }
+
+    CHECK(context.calls.empty());
+    CHECK(context.refs == 1);
+}
+
+TEST(state_backup_captures_each_group_once) {
+    RecordingDeviceContext context{};
+    StateBackup backup{&context};
+
+    backup.capture(StateBackup::BLEND | StateBackup::RASTERIZER);
+    backup.capture(StateBackup::BLEND); // would overwrite the game's state with ours
+    backup.capture(StateBackup::RASTERIZER | StateBackup::DEPTH_STENCIL);
+
+    CHECK(context.count("OMGetBlendState") == 1);
+    CHECK(context.count("RSGetState") == 1);
+    CHECK(context.count("OMGetDepthStencilState") == 1);
+    CHECK(context.get_calls("Get").size() == 3);
+
+    // Only the groups that were captured come back
+    context.clear_calls();
+    backup.restore();
+    CHECK((context.get_calls("Set") == Calls{"RSSetState", "OMSetBlendState", "OMSetDepthStencilState"}));
+
+    // After a restore it starts over
+    context.clear_calls();
+    backup.restore();
+    CHECK(context.calls.empty());
+
+    backup.capture(StateBackup::BLEND);
+    CHECK(context.count("OMGetBlendState") == 1);
+}
+
+TEST(state_backup_skips_redundant_binds) {
+    RecordingDeviceContext context{};
+    StateBackup backup{&context};
+
+    const D3D11_VIEWPORT viewport{0.0f, 0.0f, 1024.0f, 1024.0f, 0.0f, 1.0f};
+    const D3D11_RECT rect{0, 0, 1024, 1024};
+    auto rtv = (ID3D11RenderTargetView*)(uintptr_t)0x1000; // never dereferenced, only compared
+
+    for (auto i = 0; i < 3; ++i) {
+        backup.set_render_target(rtv);
+        backup.set_viewport(viewport);
+        backup.set_scissor_rect(rect);
+    }
+
+    // Captured the first time, bound once
+    CHECK(context.count("OMGetRenderTargets") == 1);
+    CHECK(context.count("RSGetViewports") == 1);
+    CHECK(context.count("RSGetScissorRects") == 1);
+    CHECK(context.count("OMSetRenderTargets") == 1);
+    CHECK(context.count("RSSetViewports") == 1);
+    CHECK(context.count("RSSetScissorRects") == 1);
+
+    // Something else may have used the context in between
+    backup.forget_bindings();
+    backup.set_render_target(rtv);
+    backup.set_viewport(viewport);
+    CHECK(context.count("OMSetRenderTargets") == 2);
+    CHECK(context.count("RSSetViewports") == 2);
+
+    // A different viewport always goes through
+    auto other = viewport;
+    other.Width = 512.0f;
+    backup.set_viewport(other);
+    CHECK(context.count("RSSetViewports") == 3);
+
+    // Restoring forgets what we bound, the next frame binds again
+    backup.restore();
+    context.clear_calls();
+    backup.set_render_target(rtv);
+    CHECK(context.count("OMGetRenderTargets") == 1);
+    CHECK(context.count("OMSetRenderTargets") == 1);
+}
+
+TEST(state_backup_rejects_null_context) {
+    bool threw{false};
+
+    try {
+        StateBackup backup{nullptr};
+    } catch (const std::exception&) {
+        threw = true;
+    }
+
+    CHECK(threw);
+}
@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cwchar>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <utility/String.hpp>
+#include <datatypes/StructLayout.hpp>
+
+#include "Test.hpp"
+
+using lua::datatypes::StructLayout;
+
+namespace {
+// Just enough of the engine behind the plugin SDK for a UFunction's parameter list.
+// Every handle the SDK hands out is a pointer to one of these.
+struct FakeName {
+    std::wstring text{};
+};
+
+struct FakeFieldClass {
+    FakeName name{};
+};
+
+struct FakeField {
+    FakeField* next{nullptr};
+    FakeFieldClass* klass{nullptr};
+    FakeName name{};
+};
+
+struct FakeStruct {
+    FakeField* children{nullptr};
+};
+
+FakeFieldClass g_float_property{{L"FloatProperty"}};
+FakeFieldClass g_struct_property{{L"StructProperty"}};
+FakeFieldClass g_bool_property{{L"BoolProperty"}};
+FakeFieldClass g_object_property{{L"ObjectProperty"}};
+FakeFieldClass g_not_a_property{{L"Field"}};
+
+UEVR_FFieldHandle ffield_get_next(UEVR_FFieldHandle field) {
+    return (UEVR_FFieldHandle)((FakeField*)field)->next;
+}
+
+UEVR_FFieldClassHandle ffield_get_class(UEVR_FFieldHandle field) {
+    return (UEVR_FFieldClassHandle)((FakeField*)field)->klass;
+}
+
+UEVR_FNameHandle ffield_get_fname(UEVR_FFieldHandle field) {
+    return (UEVR_FNameHandle)&((FakeField*)field)->name;
+}
+
+UEVR_FNameHandle ffield_class_get_fname(UEVR_FFieldClassHandle field_class) {
+    return (UEVR_FNameHandle)&((FakeFieldClass*)field_class)->name;
+}
+
+unsigned int fname_to_string(UEVR_FNameHandle name, wchar_t* buffer, unsigned int buffer_size) {
+    const auto& text = ((FakeName*)name)->text;
+
+    if (buffer != nullptr && buffer_size > 0) {
+        const auto count = std::min<size_t>(text.size(), buffer_size - 1);
+        std::wmemcpy(buffer, text.data(), count);
+        buffer[count] = L'\0';
+    }
+
+    return (unsigned int)text.size();
+}
+
+UEVR_FFieldHandle ustruct_get_child_properties(UEVR_UStructHandle klass) {
+    return (UEVR_FFieldHandle)((FakeStruct*)klass)->children;
+}
+
+const UEVR_FFieldFunctions g_ffield{ffield_get_next, ffield_get_class, ffield_get_fname};
+const UEVR_FFieldClassFunctions g_ffield_class{ffield_class_get_fname};
+const UEVR_FNameFunctions g_fname{fname_to_string, nullptr};
+
+const UEVR_UStructFunctions g_ustruct = [] {
+    UEVR_UStructFunctions functions{};
+    functions.get_child_properties = ustruct_get_child_properties;
+    return functions;
+}();
+
+const UEVR_SDKData g_sdk = [] {
+    UEVR_SDKData sdk{};
+    sdk.ffield = &g_ffield;
+    sdk.ffield_class = &g_ffield_class;
+    sdk.fname = &g_fname;
+    sdk.ustruct = &g_ustruct;
+    return sdk;
+}();
+
+const UEVR_PluginInitializeParam g_param = [] {
+    UEVR_PluginInitializeParam param{};
+    param.sdk = &g_sdk;
+    return param;
+}();
+
+// A UFunction's parameters, in the order the engine links them.
+struct FakeFunction {
+    FakeFunction(std::initializer_list<std::pair<const wchar_t*, FakeFieldClass*>> params) {
+        uevr::API::initialize(&g_param);
+        set_params(params);
+    }
+
+    // Like the engine regenerating the function (hot reload, a new object at the same address),
+    // the old list is left alone and a new one takes its place.
+    void set_params(std::initializer_list<std::pair<const wchar_t*, FakeFieldClass*>> params) {
+        auto& list = lists.emplace_back();
+
+        for (const auto& [name, klass] : params) {
+            list.push_back(std::make_unique<FakeField>(FakeField{nullptr, klass, {name}}));
+        }
+
+        for (size_t i = 0; i + 1 < list.size(); ++i) {
+            list[i]->next = list[i + 1].get();
+        }
+
+        def.children = list.empty() ? nullptr : list.front().get();
+    }
+
+    uevr::API::UFunction* get() {
+        return (uevr::API::UFunction*)&def;
+    }
+
+    FakeStruct def{};
+    std::vector<std::vector<std::unique_ptr<FakeField>>> lists{};
+};
+
+// Roughly what a hooked AActor::K2_SetActorLocation hands to its Lua callbacks
+FakeFunction make_set_actor_location() {
+    return FakeFunction{
+        {L"NewLocation", &g_struct_property},
+        {L"bSweep", &g_bool_property},
+        {L"SweepHitResult", &g_struct_property},
+        {L"bTeleport", &g_bool_property},
+        {L"ReturnValue", &g_bool_property},
+        {L"CallFunc_MakeVector_ReturnValue", &g_struct_property},
+        {L"Temp_float_Variable", &g_float_property},
+        {L"OwningActor", &g_object_property},
+        {L"K2Node_Event", &g_not_a_property},
+    };
+}
+
+// How a param gets found without a layout, UStruct::find_property walks the list
+// and compares every name, after the Lua string was widened to call it.
+uevr::API::FProperty* find_by_name(uevr::API::UStruct* def, const std::string& name) {
+    const auto wide_name = ::utility::widen(name);
+
+    for (auto field = def->get_child_properties(); field != nullptr; field = field->get_next()) {
+        if (field->get_fname()->to_string() == wide_name) {
+            return (uevr::API::FProperty*)field;
+        }
+    }
+
+    return nullptr;
+}
+}
+
+TEST(struct_layout_finds_params) {
+    auto fn = make_set_actor_location();
+    const StructLayout layout{fn.get()};
+
+    CHECK(layout.matches(fn.get()));
+    CHECK(layout.properties.size() == 8);
+    CHECK(layout.find_property("NewLocation") == find_by_name(fn.get(), "NewLocation"));
+    CHECK(layout.find_property("OwningActor") == find_by_name(fn.get(), "OwningActor"));
+    CHECK(layout.find_property("ReturnValue") != nullptr);
+
+    // Not a property, and not there at all
+    CHECK(layout.find_property("K2Node_Event") == nullptr);
+    CHECK(layout.find_property("newlocation") == nullptr);
+}
+
+TEST(struct_layout_invalidated_by_new_child_properties) {
+    auto fn = make_set_actor_location();
+    const StructLayout layout{fn.get()};
+
+    CHECK(layout.matches(fn.get()));
+
+    // Something else took over the same UFunction, acquire_locals has to rebuild
+    fn.set_params({
+        {L"DeltaSeconds", &g_float_property},
+        {L"NewLocation", &g_struct_property},
+    });
+
+    CHECK(!layout.matches(fn.get()));
+
+    const StructLayout rebuilt{fn.get()};
+    CHECK(rebuilt.matches(fn.get()));
+    CHECK(rebuilt.properties.size() == 2);
+    CHECK(rebuilt.find_property("DeltaSeconds") != nullptr);
+    CHECK(rebuilt.find_property("bSweep") == nullptr);
+    CHECK(rebuilt.find_property("NewLocation") != layout.find_property("NewLocation"));
+
+    // Lost all of its params
+    fn.set_params({});
+    CHECK(!rebuilt.matches(fn.get()));
+
+    // A different function, or none at all
+    auto other = make_set_actor_location();
+    CHECK(!rebuilt.matches(other.get()));
+    CHECK(!rebuilt.matches(nullptr));
+    CHECK(!StructLayout{nullptr}.matches(nullptr));
+}
+
+TEST(struct_layout_benchmark_hooked_params) {
+    auto fn = make_set_actor_location();
+
+    // A callback reading a few params on every call, the way acquire_locals gets used:
+    // check the layout is still good, then look the params up through it.
+    const std::vector<std::string> reads{"NewLocation", "bSweep", "ReturnValue", "OwningActor"};
+
+    constexpr auto CALLS = 20000;
+    using Clock = std::chrono::steady_clock;
+
+    const StructLayout layout{fn.get()};
+    size_t found_by_layout{0};
+    size_t found_by_name{0};
+
+    auto start = Clock::now();
+    auto allocations = test::get_allocations();
+
+    for (auto call = 0; call < CALLS; ++call) {
+        if (!layout.matches(fn.get())) {
+            break;
+        }
+
+        for (const auto& name : reads) {
+            found_by_layout += layout.find_property(name) != nullptr;
+        }
+    }
+
+    const auto layout_time = Clock::now() - start;
+    const auto layout_allocations = test::get_allocations() - allocations;
+
+    start = Clock::now();
+    allocations = test::get_allocations();
+
+    for (auto call = 0; call < CALLS; ++call) {
+        for (const auto& name : reads) {
+            found_by_name += find_by_name(fn.get(), name) != nullptr;
+        }
+    }
+
+    const auto name_time = Clock::now() - start;
+    const auto name_allocations = test::get_allocations() - allocations;
+
+    const auto ns = [](Clock::duration d) { return std::chrono::duration<double, std::nano>(d).count() / CALLS; };
+    std::printf("  %d calls, %zu reads each: layout %.0f ns, %zu allocations; by name %.0f ns, %zu allocations\n",
+        CALLS, reads.size(), ns(layout_time), layout_allocations, ns(name_time), name_allocations);
+
+    CHECK(found_by_layout == CALLS * reads.size());
+    CHECK(found_by_name == found_by_layout);
+
+    // Timings are only printed, they're too noisy to fail on. The allocations aren't.
+    CHECK(layout_allocations == 0);
+    CHECK(name_allocations >= CALLS * reads.size());
+}